@@ -0,0 +1,192 @@
+/*
+hipcc -c -fgpu-rdc -x hip rocshmem_host_rma_latency_test.cc \
+  -I/opt/rocm/include \
+  -I$ROCSHMEM_INSTALL_DIR/include \
+  -I$OPENMPI_UCX_INSTALL_DIR/include/
+
+hipcc -fgpu-rdc --hip-link rocshmem_host_rma_latency_test.o \
+  -o rocshmem_host_rma_latency_test \
+  $ROCSHMEM_INSTALL_DIR/lib/librocshmem.a \
+  $OPENMPI_UCX_INSTALL_DIR/lib/libmpi.so \
+  -L/opt/rocm/lib -lamdhip64 -lhsa-runtime64
+
+Host RMA latency at each threading level, one level per run:
+
+for level in single funneled serialized multiple; do
+  mpirun -np 2 ./rocshmem_host_rma_latency_test $level
+done
+
+  mpirun -np 2 ./rocshmem_host_rma_latency_test multiple 4 8
+*/
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <hip/hip_runtime_api.h>
+#include <hip/hip_runtime.h>
+#include <rocshmem/rocshmem.hpp>
+
+#define CHECK_HIP(condition) {                                            \
+        hipError_t error = condition;                                     \
+        if(error != hipSuccess){                                          \
+            fprintf(stderr,"HIP error: %d line: %d\n", error,  __LINE__); \
+            MPI_Abort(MPI_COMM_WORLD, error);                             \
+        }                                                                 \
+    }
+
+using namespace rocshmem;
+
+#define SKIP 100
+#define LOOP 10000
+
+struct Level {
+    const char *name;
+    int value;
+};
+
+static const Level levels[] = {
+    {"single", ROCSHMEM_THREAD_SINGLE},
+    {"funneled", ROCSHMEM_THREAD_FUNNELED},
+    {"serialized", ROCSHMEM_THREAD_SERIALIZED},
+    {"multiple", ROCSHMEM_THREAD_MULTIPLE},
+};
+
+/*
+ * Average latency in microseconds of a blocking put followed by a quiet,
+ * and of a blocking get, issued to peer on ctx (the default context when
+ * ctx is NULL).
+ */
+static void measure(rocshmem_ctx_t *ctx, char *buf, size_t size, int peer,
+                    double *put_us, double *get_us)
+{
+    char *local = static_cast<char *>(malloc(size));
+    memset(local, 0, size);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SKIP + LOOP; i++) {
+        if (i == SKIP) {
+            start = std::chrono::steady_clock::now();
+        }
+        if (ctx) {
+            rocshmem_ctx_putmem(*ctx, buf, local, size, peer);
+            rocshmem_ctx_quiet(*ctx);
+        } else {
+            rocshmem_putmem(buf, local, size, peer);
+            rocshmem_quiet();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    *put_us = std::chrono::duration<double, std::micro>(end - start).count()
+              / LOOP;
+
+    for (int i = 0; i < SKIP + LOOP; i++) {
+        if (i == SKIP) {
+            start = std::chrono::steady_clock::now();
+        }
+        if (ctx) {
+            rocshmem_ctx_getmem(*ctx, local, buf, size, peer);
+        } else {
+            rocshmem_getmem(local, buf, size, peer);
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    *get_us = std::chrono::duration<double, std::micro>(end - start).count()
+              / LOOP;
+
+    free(local);
+}
+
+int main (int argc, char **argv)
+{
+    /*
+     * Pick the device from the launcher's local rank: asking rocshmem for
+     * the rank here would bring MPI up before the thread level is known.
+     */
+    int local_rank = 0;
+    if (const char *env = getenv("OMPI_COMM_WORLD_LOCAL_RANK")) {
+        local_rank = atoi(env);
+    } else if (const char *env = getenv("MPI_LOCALRANKID")) {
+        local_rank = atoi(env);
+    }
+    int ndevices;
+    CHECK_HIP(hipGetDeviceCount(&ndevices));
+    CHECK_HIP(hipSetDevice(local_rank % ndevices));
+
+    const Level *level = &levels[0];
+    if (argc > 1) {
+        for (const Level &l : levels) {
+            if (!strcmp(argv[1], l.name)) {
+                level = &l;
+            }
+        }
+    }
+    int nthreads = (argc > 2) ? atoi(argv[2]) : 1;
+    size_t size = (argc > 3) ? strtoull(argv[3], nullptr, 10) : 8;
+    if (level->value != ROCSHMEM_THREAD_MULTIPLE) {
+        nthreads = 1;
+    }
+
+    int provided;
+    rocshmem_init_thread(level->value, &provided);
+
+    int rank = rocshmem_my_pe();
+    if (rocshmem_n_pes() < 2) {
+        std::cout << "Run with at least 2 PEs" << std::endl;
+        rocshmem_global_exit(1);
+    }
+
+    char *buf = (char *)rocshmem_malloc(size * nthreads);
+    if (NULL == buf) {
+        std::cout << "Error allocating memory from symmetric heap" << std::endl;
+        rocshmem_global_exit(1);
+    }
+    rocshmem_barrier_all();
+
+    std::vector<double> put_us(nthreads);
+    std::vector<double> get_us(nthreads);
+
+    if (rank == 0) {
+        if (nthreads == 1) {
+            measure(NULL, buf, size, 1, &put_us[0], &get_us[0]);
+        } else {
+            /*
+             * Under THREAD_MULTIPLE every thread drives its own context
+             * rather than contending on the default one.
+             */
+            std::vector<std::thread> threads;
+            for (int t = 0; t < nthreads; t++) {
+                threads.emplace_back([&, t] {
+                    rocshmem_ctx_t ctx;
+                    if (rocshmem_ctx_create(0, &ctx)) {
+                        std::cout << "Error creating context" << std::endl;
+                        rocshmem_global_exit(1);
+                    }
+                    measure(&ctx, buf + t * size, size, 1, &put_us[t],
+                            &get_us[t]);
+                    rocshmem_ctx_destroy(ctx);
+                });
+            }
+            for (auto &thread : threads) {
+                thread.join();
+            }
+        }
+
+        double put_avg = 0, get_avg = 0;
+        for (int t = 0; t < nthreads; t++) {
+            put_avg += put_us[t] / nthreads;
+            get_avg += get_us[t] / nthreads;
+        }
+        printf("level %s (provided %d) threads %d size %zu: "
+               "put+quiet %.3f us, get %.3f us\n",
+               level->name, provided, nthreads, size, put_avg, get_avg);
+    }
+
+    rocshmem_barrier_all();
+    rocshmem_free(buf);
+    rocshmem_finalize();
+    return 0;
+}
@@ -0,0 +1,119 @@
+/*
+Built with the library (BUILD_EXAMPLES=ON): the size-class allocator is
+internal, so this example includes it from the source tree and runs it
+on the host, with no GPU or MPI involved.
+
+Average malloc+free latency of the slab heap's size-class strategy:
+
+  ./rocshmem_slab_alloc_latency_test [threads] [min size] [max size]
+
+  ./rocshmem_slab_alloc_latency_test 1 64 4096
+  ./rocshmem_slab_alloc_latency_test 8 64 4096
+
+Each thread keeps a window of live blocks and frees one for every one it
+allocates. Threads use their own cache, then all share cache 0, to show
+what the contended path to the shared pool costs.
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "../src/memory/dev_size_classes.hpp"
+#include "../src/memory/heap_memory.hpp"
+#include "../src/memory/hip_allocator.hpp"
+
+using namespace rocshmem;
+
+#define SKIP 1000
+#define LOOP 1000000
+#define WINDOW 64
+
+using HEAP_T = HeapMemory<HostAllocator>;
+using STRAT_T = DevSizeClasses<HEAP_T>;
+
+/*
+ * Average latency in nanoseconds of one allocate plus one release through
+ * cache, with request sizes drawn from [min_size, max_size].
+ */
+static double measure(STRAT_T *strat, unsigned cache, int seed,
+                      size_t min_size, size_t max_size)
+{
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<size_t> size_dist(min_size, max_size);
+    std::vector<char *> live(WINDOW, nullptr);
+
+    for (int w = 0; w < WINDOW; w++) {
+        live[w] = strat->allocate(size_dist(gen), cache);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < SKIP + LOOP; i++) {
+        if (i == SKIP) {
+            start = std::chrono::steady_clock::now();
+        }
+        int w = i % WINDOW;
+        strat->release(live[w], cache);
+        live[w] = strat->allocate(size_dist(gen), cache);
+        if (NULL == live[w]) {
+            std::cout << "Error allocating from the slab heap" << std::endl;
+            exit(1);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    for (int w = 0; w < WINDOW; w++) {
+        strat->release(live[w], cache);
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count()
+           / LOOP;
+}
+
+static double run(int nthreads, bool shared_cache, size_t min_size,
+                  size_t max_size)
+{
+    HEAP_T heap_mem(size_t{256} << 20);
+    STRAT_T strat(&heap_mem);
+
+    std::vector<double> ns(nthreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nthreads; t++) {
+        threads.emplace_back([&, t] {
+            unsigned cache = shared_cache ? 0 : t;
+            ns[t] = measure(&strat, cache, t, min_size, max_size);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    double avg = 0;
+    for (int t = 0; t < nthreads; t++) {
+        avg += ns[t] / nthreads;
+    }
+    return avg;
+}
+
+int main (int argc, char **argv)
+{
+    int nthreads = (argc > 1) ? atoi(argv[1]) : 1;
+    size_t min_size = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 64;
+    size_t max_size = (argc > 3) ? strtoull(argv[3], nullptr, 10) : 4096;
+    if (nthreads < 1 || min_size < 1 || max_size < min_size) {
+        std::cout << "Usage: " << argv[0]
+                  << " [threads] [min size] [max size]" << std::endl;
+        return 1;
+    }
+
+    double own_ns = run(nthreads, false, min_size, max_size);
+    double shared_ns = run(nthreads, true, min_size, max_size);
+
+    printf("threads %d sizes %zu-%zu: malloc+free %.1f ns own cache, "
+           "%.1f ns shared cache\n",
+           nthreads, min_size, max_size, own_ns, shared_ns);
+    return 0;
+}
@@ -94,11 +94,69 @@ __host__ void rocshmem_dump_stats();
  */
 __host__ void rocshmem_reset_stats();
 
+/**
+ * @brief Write the operations and bytes every PE sent to every other PE,
+ * per operation class, as CSV. Recording is enabled by setting
+ * ROCSHMEM_TRAFFIC_MATRIX, which also names the file written at finalize.
+ * Must be called by all PEs; PE 0 writes the file.
+ *
+ * @param[in] path File to write.
+ *
+ * @return ROCSHMEM_SUCCESS, or ROCSHMEM_ERROR if recording is off or the
+ * file cannot be written.
+ */
+__host__ int rocshmem_dump_traffic_matrix(const char *path);
+
+/**
+ * @brief Zero the traffic matrix counters of the calling PE.
+ */
+__host__ void rocshmem_reset_traffic_matrix();
+
 /**
  * @brief Finalize the rocSHMEM runtime.
  */
 __host__ void rocshmem_finalize();
 
+/**
+ * @brief Run \p fn on \p npes host threads of this process, each acting as
+ * one PE, and return after all of them have returned. No rocshmem_init is
+ * needed: the PEs' symmetric heaps (ROCSHMEM_HEAP_SIZE bytes each) are
+ * carved from one host mapping, RMA and AMOs become direct loads, stores
+ * and atomics, and barriers use shared memory. Inside \p fn the host
+ * functions keep their usual semantics, with these limits: all contexts
+ * alias the default one, team-based collectives run over all PEs, and the
+ * active-set collectives, teams and device API are not available.
+ *
+ * @param[in] npes Number of PEs (threads) to start.
+ * @param[in] fn   Function run by every PE.
+ * @param[in] arg  Argument passed to \p fn.
+ *
+ * @return ROCSHMEM_SUCCESS, or ROCSHMEM_ERROR if \p npes is not positive,
+ *         \p fn is null or the caller is itself a thread PE.
+ */
+__host__ int rocshmem_thread_pes_run(int npes, void (*fn)(void *), void *arg);
+
+/**
+ * @brief Register \p handler under \p handler_id for active messages sent
+ * to this PE with rocshmem_am. Every PE that may receive the message must
+ * register the handler before it is sent; registering an id again
+ * replaces its handler. Only the reverse offload backend runs handlers.
+ *
+ * Handlers run one at a time on the proxy thread and touch the symmetric
+ * heap from the CPU, so the heap must be host accessible. They are not
+ * atomic with respect to RMA or AMOs from other PEs on the same data.
+ *
+ * @param[in] handler_id Id in [0, ROCSHMEM_AM_MAX_HANDLERS).
+ * @param[in] handler    Function run for each message.
+ * @param[in] user_arg   Argument passed to \p handler.
+ *
+ * @return ROCSHMEM_SUCCESS, or ROCSHMEM_ERROR if the id is out of range,
+ *         \p handler is null or the backend cannot run handlers.
+ */
+__host__ int rocshmem_am_register(int handler_id,
+                                  rocshmem_am_handler_t handler,
+                                  void *user_arg);
+
 /**
  * @brief Allocate memory of \p size bytes from the symmetric heap.
  * This is a collective operation and must be called by all PEs.
@@ -111,6 +169,22 @@ __host__ void rocshmem_finalize();
  */
 __host__ void *rocshmem_malloc(size_t size);
 
+/**
+ * @brief Allocate memory of \p size bytes from the symmetric heap whose
+ * memory kind suits \p hints. Remote atomics and signals get fine-grained
+ * memory (ROCSHMEM_HEAP_SIZE_FINE); bulk data gets coarse-grained memory
+ * (ROCSHMEM_HEAP_SIZE_COARSE). When the matching heap was not created,
+ * the allocation comes from the primary heap.
+ * This is a collective operation and must be called by all PEs with the
+ * same hints.
+ *
+ * @param[in] size  Memory allocation size in bytes.
+ * @param[in] hints Bitwise OR of rocshmem_malloc_hints, or zero.
+ *
+ * @return A pointer to the allocated memory on the symmetric heap.
+ */
+__host__ void *rocshmem_malloc_with_hints(size_t size, long hints);
+
 /**
  * @brief Free a memory allocation from the symmetric heap.
  * This is a collective operation and must be called by all PEs.
@@ -119,6 +193,31 @@ __host__ void *rocshmem_malloc(size_t size);
  */
 __host__ void rocshmem_free(void *ptr);
 
+/**
+ * @brief Save the allocated contents of the symmetric heap, along with the
+ * allocator state, to one file per PE named \p path followed by ".pe<N>".
+ * No kernel or host thread may write the heap during the call.
+ * This is a collective operation and must be called by all PEs.
+ *
+ * @param[in] path Prefix of the snapshot files.
+ *
+ * @return 0 if every PE wrote its file, -1 otherwise.
+ */
+__host__ int rocshmem_heap_snapshot(const char *path);
+
+/**
+ * @brief Restore a snapshot taken by rocshmem_heap_snapshot. The job must
+ * have the same number of PEs and the same heap sizes. Every allocation
+ * comes back at the same offset from the heap base, and allocations made
+ * before the call are discarded.
+ * This is a collective operation and must be called by all PEs.
+ *
+ * @param[in] path Prefix of the snapshot files.
+ *
+ * @return 0 if every PE restored its heap, -1 otherwise.
+ */
+__host__ int rocshmem_heap_restore(const char *path);
+
 /**
  * @brief Query for the number of PEs.
  *
@@ -213,6 +312,18 @@ __host__ int rocshmem_team_split_strided(rocshmem_team_t parent_team,
                                           long config_mask,
                                           rocshmem_team_t *new_team);
 
+/**
+ * @brief Query the configuration a team was created with.
+ *
+ * @param[in] team        The team to query.
+ * @param[in] config_mask Bitwise mask of the parameters to return.
+ * @param[out] config     Receives the requested parameters.
+ *
+ * @return Zero on success; non-zero if team is invalid.
+ */
+__host__ int rocshmem_team_get_config(rocshmem_team_t team, long config_mask,
+                                      rocshmem_team_config_t *config);
+
 /**
  * @brief Destroy a team. Must be called by all PEs in the team.
  * The user must destroy all private contexts created in the
@@ -512,6 +623,36 @@ __device__ ATTR_NO_INLINE void rocshmem_wg_team_sync(rocshmem_team_t team);
  */
 __device__ ATTR_NO_INLINE void *rocshmem_ptr(const void *dest, int pe);
 
+/**
+ * @brief Run the handler registered under \p handler_id on \p pe against
+ * its copy of \p dest and return the handler's reply. One active message
+ * replaces the several dependent round trips a compound remote update
+ * (such as a hash table insert or a queue append) otherwise needs.
+ *
+ * Like an atomic, the call blocks until the reply arrives. It is not
+ * ordered with respect to earlier puts unless a fence or quiet separates
+ * them. Only the reverse offload backend supports it.
+ *
+ * Can be called per thread with no performance penalty.
+ *
+ * @param[in] ctx        Context with which to perform this operation.
+ * @param[in] dest       Symmetric object handed to the handler.
+ * @param[in] handler_id Id the handler was registered under.
+ * @param[in] arg0       First argument word.
+ * @param[in] arg1       Second argument word.
+ * @param[in] pe         PE that runs the handler.
+ *
+ * @return The handler's reply.
+ */
+__device__ ATTR_NO_INLINE uint64_t rocshmem_ctx_am(rocshmem_ctx_t ctx,
+                                                   void *dest, int handler_id,
+                                                   uint64_t arg0,
+                                                   uint64_t arg1, int pe);
+
+__device__ ATTR_NO_INLINE uint64_t rocshmem_am(void *dest, int handler_id,
+                                               uint64_t arg0, uint64_t arg1,
+                                               int pe);
+
 /**
  * @brief Query the current time. Similar to gettimeofday() on the CPU. To use
  * this function, rocSHMEM must be configured with profiling support
@@ -1089,6 +1089,207 @@ __host__ void rocshmem_ctx_ptrdiff_atomic_add(
 __host__ void rocshmem_ptrdiff_atomic_add(
     ptrdiff_t *dest, ptrdiff_t value, int pe);
 
+/**
+ * @name SHMEM_ATOMIC_ADD_VECTOR
+ * @brief Atomically add values[i] to dest[indices[i]] on pes[i] for each of
+ * the \p nelems elements.
+ *
+ * The operation is blocking. Remote completion is ensured by a subsequent
+ * quiet. With the reverse offload backend the whole vector is handed to the
+ * host as a single command, so \p indices, \p values and \p pes must be
+ * host-accessible (e.g. allocated on the symmetric heap).
+ *
+ * This function can be called from divergent control paths at per-thread
+ * granularity.
+ *
+ * @param[in] ctx     Context with which to perform this operation.
+ * @param[in] dest    Destination base address. Must be an address on the
+                      symmetric heap.
+ * @param[in] indices Element offsets from \p dest.
+ * @param[in] values  The values to be atomically added.
+ * @param[in] pes     PE of the remote process for each element.
+ * @param[in] nelems  Number of elements.
+ *
+ * @return void
+ */
+__device__ ATTR_NO_INLINE void rocshmem_ctx_int_atomic_add_vector(
+    rocshmem_ctx_t ctx, int *dest, const size_t *indices, const int *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_int_atomic_add_vector(
+    int *dest, const size_t *indices, const int *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_long_atomic_add_vector(
+    rocshmem_ctx_t ctx, long *dest, const size_t *indices, const long *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_long_atomic_add_vector(
+    long *dest, const size_t *indices, const long *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_longlong_atomic_add_vector(
+    rocshmem_ctx_t ctx, long long *dest, const size_t *indices, const long long *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_longlong_atomic_add_vector(
+    long long *dest, const size_t *indices, const long long *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uint_atomic_add_vector(
+    rocshmem_ctx_t ctx, unsigned int *dest, const size_t *indices, const unsigned int *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_uint_atomic_add_vector(
+    unsigned int *dest, const size_t *indices, const unsigned int *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ulong_atomic_add_vector(
+    rocshmem_ctx_t ctx, unsigned long *dest, const size_t *indices, const unsigned long *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_ulong_atomic_add_vector(
+    unsigned long *dest, const size_t *indices, const unsigned long *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ulonglong_atomic_add_vector(
+    rocshmem_ctx_t ctx, unsigned long long *dest, const size_t *indices, const unsigned long long *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_ulonglong_atomic_add_vector(
+    unsigned long long *dest, const size_t *indices, const unsigned long long *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_int32_atomic_add_vector(
+    rocshmem_ctx_t ctx, int32_t *dest, const size_t *indices, const int32_t *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_int32_atomic_add_vector(
+    int32_t *dest, const size_t *indices, const int32_t *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_int64_atomic_add_vector(
+    rocshmem_ctx_t ctx, int64_t *dest, const size_t *indices, const int64_t *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_int64_atomic_add_vector(
+    int64_t *dest, const size_t *indices, const int64_t *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uint32_atomic_add_vector(
+    rocshmem_ctx_t ctx, uint32_t *dest, const size_t *indices, const uint32_t *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_uint32_atomic_add_vector(
+    uint32_t *dest, const size_t *indices, const uint32_t *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uint64_atomic_add_vector(
+    rocshmem_ctx_t ctx, uint64_t *dest, const size_t *indices, const uint64_t *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_uint64_atomic_add_vector(
+    uint64_t *dest, const size_t *indices, const uint64_t *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_size_atomic_add_vector(
+    rocshmem_ctx_t ctx, size_t *dest, const size_t *indices, const size_t *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_size_atomic_add_vector(
+    size_t *dest, const size_t *indices, const size_t *values, const int *pes,
+    size_t nelems);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ptrdiff_atomic_add_vector(
+    rocshmem_ctx_t ctx, ptrdiff_t *dest, const size_t *indices, const ptrdiff_t *values,
+    const int *pes, size_t nelems);
+__device__ ATTR_NO_INLINE void rocshmem_ptrdiff_atomic_add_vector(
+    ptrdiff_t *dest, const size_t *indices, const ptrdiff_t *values, const int *pes,
+    size_t nelems);
+
+
+/**
+ * @name SHMEM_ATOMIC_ADD_STRIDED
+ * @brief Atomically add values[i] to dest[i * dst_stride] on \p pe for each
+ * of the \p nelems elements.
+ *
+ * The operation is blocking. Remote completion is ensured by a subsequent
+ * quiet.
+ *
+ * This function can be called from divergent control paths at per-thread
+ * granularity.
+ *
+ * @param[in] ctx        Context with which to perform this operation.
+ * @param[in] dest       Destination base address. Must be an address on the
+                         symmetric heap.
+ * @param[in] dst_stride Positive stride, in elements, between destinations.
+ * @param[in] values     Contiguous values to be atomically added.
+ * @param[in] nelems     Number of elements.
+ * @param[in] pe         PE of the remote process.
+ *
+ * @return void
+ */
+__device__ ATTR_NO_INLINE void rocshmem_ctx_int_atomic_add_strided(
+    rocshmem_ctx_t ctx, int *dest, ptrdiff_t dst_stride, const int *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_int_atomic_add_strided(
+    int *dest, ptrdiff_t dst_stride, const int *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_long_atomic_add_strided(
+    rocshmem_ctx_t ctx, long *dest, ptrdiff_t dst_stride, const long *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_long_atomic_add_strided(
+    long *dest, ptrdiff_t dst_stride, const long *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_longlong_atomic_add_strided(
+    rocshmem_ctx_t ctx, long long *dest, ptrdiff_t dst_stride, const long long *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_longlong_atomic_add_strided(
+    long long *dest, ptrdiff_t dst_stride, const long long *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uint_atomic_add_strided(
+    rocshmem_ctx_t ctx, unsigned int *dest, ptrdiff_t dst_stride, const unsigned int *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_uint_atomic_add_strided(
+    unsigned int *dest, ptrdiff_t dst_stride, const unsigned int *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ulong_atomic_add_strided(
+    rocshmem_ctx_t ctx, unsigned long *dest, ptrdiff_t dst_stride, const unsigned long *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_ulong_atomic_add_strided(
+    unsigned long *dest, ptrdiff_t dst_stride, const unsigned long *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ulonglong_atomic_add_strided(
+    rocshmem_ctx_t ctx, unsigned long long *dest, ptrdiff_t dst_stride, const unsigned long long *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_ulonglong_atomic_add_strided(
+    unsigned long long *dest, ptrdiff_t dst_stride, const unsigned long long *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_int32_atomic_add_strided(
+    rocshmem_ctx_t ctx, int32_t *dest, ptrdiff_t dst_stride, const int32_t *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_int32_atomic_add_strided(
+    int32_t *dest, ptrdiff_t dst_stride, const int32_t *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_int64_atomic_add_strided(
+    rocshmem_ctx_t ctx, int64_t *dest, ptrdiff_t dst_stride, const int64_t *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_int64_atomic_add_strided(
+    int64_t *dest, ptrdiff_t dst_stride, const int64_t *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uint32_atomic_add_strided(
+    rocshmem_ctx_t ctx, uint32_t *dest, ptrdiff_t dst_stride, const uint32_t *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_uint32_atomic_add_strided(
+    uint32_t *dest, ptrdiff_t dst_stride, const uint32_t *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uint64_atomic_add_strided(
+    rocshmem_ctx_t ctx, uint64_t *dest, ptrdiff_t dst_stride, const uint64_t *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_uint64_atomic_add_strided(
+    uint64_t *dest, ptrdiff_t dst_stride, const uint64_t *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_size_atomic_add_strided(
+    rocshmem_ctx_t ctx, size_t *dest, ptrdiff_t dst_stride, const size_t *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_size_atomic_add_strided(
+    size_t *dest, ptrdiff_t dst_stride, const size_t *values, size_t nelems, int pe);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ptrdiff_atomic_add_strided(
+    rocshmem_ctx_t ctx, ptrdiff_t *dest, ptrdiff_t dst_stride, const ptrdiff_t *values,
+    size_t nelems, int pe);
+__device__ ATTR_NO_INLINE void rocshmem_ptrdiff_atomic_add_strided(
+    ptrdiff_t *dest, ptrdiff_t dst_stride, const ptrdiff_t *values, size_t nelems, int pe);
+
 
 /**
  * @name SHMEM_ATOMIC_FETCH_AND
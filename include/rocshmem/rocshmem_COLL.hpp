@@ -329,6 +329,220 @@ __device__ ATTR_NO_INLINE void rocshmem_ctx_ulonglong_wg_fcollect(
     const unsigned long long *source, int nelems);
 
 
+/**
+ * @name SHMEM_FCOLLECTV
+ * @brief Concatenates blocks of varying size from multiple PEs to an array
+ * in every PE participating in the collective routine. The block of the
+ * i-th PE in the team is placed after the blocks of PEs 0 to i-1.
+ *
+ * This function must be called as a work-group collective.
+ *
+ * @param[in] team         The team participating in the collective.
+ * @param[in] dest         Destination address. Must be an address on the
+ *                         symmetric heap.
+ * @param[in] source       Source address. Must be an address on the symmetric
+                           heap.
+ * @param[in] counts       Number of elements contributed by each PE of the
+ *                         team. Must hold the same values on every PE.
+ *
+ * @return void
+ */
+__device__ ATTR_NO_INLINE void rocshmem_ctx_float_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, float *dest,
+    const float *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_double_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, double *dest,
+    const double *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_char_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, char *dest,
+    const char *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_schar_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, signed char *dest,
+    const signed char *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_short_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest,
+    const short *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_int_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest,
+    const int *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_long_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest,
+    const long *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_longlong_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest,
+    const long long *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uchar_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned char *dest,
+    const unsigned char *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ushort_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned short *dest,
+    const unsigned short *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uint_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned int *dest,
+    const unsigned int *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ulong_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned long *dest,
+    const unsigned long *source, const int *counts);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ulonglong_wg_fcollectv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned long long *dest,
+    const unsigned long long *source, const int *counts);
+
+
+/**
+ * @name SHMEM_ALLTOALLV
+ * @brief Exchanges blocks of varying size between all pairs of PEs
+ * participating in the collective routine. PE i sends
+ * source_counts[j] elements starting at source + source_displs[j] to PE j,
+ * which places them at dest + dest_displs[i]. dest_counts[i] on PE j must
+ * equal source_counts[j] on PE i. Counts of zero skip the pair.
+ *
+ * The device version must be called as a work-group collective.
+ *
+ * @param[in] team          The team participating in the collective.
+ * @param[in] dest          Destination address. Must be an address on the
+ *                          symmetric heap.
+ * @param[in] source        Source address. Must be an address on the
+ *                          symmetric heap.
+ * @param[in] source_counts Number of elements sent to each PE of the team.
+ * @param[in] source_displs Offset in elements of each PE's block in source.
+ * @param[in] dest_counts   Number of elements received from each PE.
+ * @param[in] dest_displs   Offset in elements of each PE's block in dest.
+ *
+ * The four arrays hold one entry per PE of the team and must be on the
+ * symmetric heap.
+ *
+ * @return void
+ */
+__device__ ATTR_NO_INLINE void rocshmem_ctx_float_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, float *dest,
+    const float *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_float_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, float *dest,
+    const float *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_double_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, double *dest,
+    const double *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_double_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, double *dest,
+    const double *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_char_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, char *dest,
+    const char *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_char_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, char *dest,
+    const char *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_schar_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, signed char *dest,
+    const signed char *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_schar_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, signed char *dest,
+    const signed char *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_short_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest,
+    const short *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_short_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest,
+    const short *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_int_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest,
+    const int *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_int_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest,
+    const int *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_long_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest,
+    const long *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_long_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest,
+    const long *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_longlong_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest,
+    const long long *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_longlong_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest,
+    const long long *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uchar_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned char *dest,
+    const unsigned char *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_uchar_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned char *dest,
+    const unsigned char *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ushort_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned short *dest,
+    const unsigned short *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_ushort_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned short *dest,
+    const unsigned short *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_uint_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned int *dest,
+    const unsigned int *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_uint_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned int *dest,
+    const unsigned int *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ulong_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned long *dest,
+    const unsigned long *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_ulong_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned long *dest,
+    const unsigned long *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+__device__ ATTR_NO_INLINE void rocshmem_ctx_ulonglong_wg_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned long long *dest,
+    const unsigned long long *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+__host__ void rocshmem_ctx_ulonglong_alltoallv(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, unsigned long long *dest,
+    const unsigned long long *source, const int *source_counts,
+    const int *source_displs, const int *dest_counts, const int *dest_displs);
+
+
 /**
  * @name SHMEM_REDUCTIONS
  * @brief Perform an allreduce between PEs in the active set. The caller
@@ -597,6 +811,170 @@ __host__ int rocshmem_ctx_double_prod_reduce(
     rocshmem_ctx_t ctx, rocshmem_team_t team, double *dest, const double *source,
     int nreduce);
 
+/**
+ * @name SHMEM_REDUCE_SCATTER
+ * @brief Perform a reduction between PEs in the active set and scatter the
+ * result, so that the i-th PE of the team receives the i-th block of
+ * nreduce elements. The caller is blocked until the operation completes.
+ *
+ * This function must be called as a work-group collective.
+ *
+ * @param[in] team         The team participating in the collective.
+ * @param[in] dest         Destination address holding nreduce elements. Must
+ *                         be an address on the symmetric heap. May equal
+ *                         source, in which case the result overwrites the
+ *                         first nreduce elements of source.
+ * @param[in] source       Source address holding nreduce elements for every
+ *                         PE of the team. Must be an address on the symmetric
+                           heap.
+ * @param[in] nreduce      Number of elements reduced into each PE's block.
+ *
+ * @return int (Zero on successful local completion. Nonzero otherwise.)
+ */
+__device__ ATTR_NO_INLINE int rocshmem_ctx_short_sum_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest, const short *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_short_min_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest, const short *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_short_max_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest, const short *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_short_prod_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest, const short *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_short_or_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest, const short *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_short_and_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest, const short *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_short_xor_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, short *dest, const short *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_int_sum_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest, const int *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_int_min_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest, const int *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_int_max_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest, const int *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_int_prod_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest, const int *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_int_or_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest, const int *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_int_and_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest, const int *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_int_xor_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, int *dest, const int *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_long_sum_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest, const long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_long_min_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest, const long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_long_max_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest, const long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_long_prod_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest, const long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_long_or_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest, const long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_long_and_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest, const long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_long_xor_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long *dest, const long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_longlong_sum_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest, const long long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_longlong_min_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest, const long long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_longlong_max_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest, const long long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_longlong_prod_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest, const long long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_longlong_or_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest, const long long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_longlong_and_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest, const long long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_longlong_xor_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, long long *dest, const long long *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_float_sum_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, float *dest, const float *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_float_min_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, float *dest, const float *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_float_max_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, float *dest, const float *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_float_prod_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, float *dest, const float *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_double_sum_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, double *dest, const double *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_double_min_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, double *dest, const double *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_double_max_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, double *dest, const double *source,
+    int nreduce);
+
+__device__ ATTR_NO_INLINE int rocshmem_ctx_double_prod_wg_reduce_scatter(
+    rocshmem_ctx_t ctx, rocshmem_team_t team, double *dest, const double *source,
+    int nreduce);
+
 
 }  // namespace rocshmem
 
@@ -23,6 +23,8 @@
 #ifndef LIBRARY_INCLUDE_ROCSHMEM_COMMON_HPP
 #define LIBRARY_INCLUDE_ROCSHMEM_COMMON_HPP
 
+#include <cstdint>
+
 namespace rocshmem {
 
 #ifdef USE_FUNC_CALL
@@ -77,12 +79,52 @@ enum rocshmem_thread_ops {
  * @brief Bitwise flags to mask configuration parameters.
  */
 enum rocshmem_team_configs {
-  ROCSHMEM_TEAM_DEFAULT_CONFIGS,
-  ROCSHMEM_TEAM_NUM_CONTEXTS
+  ROCSHMEM_TEAM_DEFAULT_CONFIGS = 0,
+  ROCSHMEM_TEAM_NUM_CONTEXTS = 1 << 0,
+  ROCSHMEM_TEAM_MAX_REDUCE_SIZE = 1 << 1,
+  ROCSHMEM_TEAM_COLLECTIVES = 1 << 2
+};
+
+/**
+ * @brief Bitwise flags naming the collectives a team will run. Used with
+ * the ROCSHMEM_TEAM_COLLECTIVES configuration parameter.
+ */
+enum rocshmem_team_collectives {
+  ROCSHMEM_TEAM_COLL_REDUCE = 1 << 0,
+  ROCSHMEM_TEAM_COLL_BROADCAST = 1 << 1,
+  ROCSHMEM_TEAM_COLL_ALLTOALL = 1 << 2,
+  ROCSHMEM_TEAM_COLL_FCOLLECT = 1 << 3,
+  ROCSHMEM_TEAM_COLL_ALL = (1 << 4) - 1
+};
+
+/**
+ * @brief Bitwise flags describing how a symmetric allocation will be used.
+ * Passed to rocshmem_malloc_with_hints.
+ */
+enum rocshmem_malloc_hints {
+  ROCSHMEM_MALLOC_ATOMICS_REMOTE = 1 << 0,
+  ROCSHMEM_MALLOC_SIGNAL_REMOTE = 1 << 1,
+  ROCSHMEM_MALLOC_BULK_DATA = 1 << 2
 };
 
 typedef struct {
+  /**
+   * Number of contexts the team expects to create. The split fails if
+   * more than ROCSHMEM_MAX_NUM_CONTEXTS are asked for.
+   */
   int num_contexts;
+  /**
+   * Largest reduction, in elements, the team expects to run. Scratch for
+   * a single-pass reduction of this size is taken from the symmetric heap
+   * when the team is split from ROCSHMEM_TEAM_WORLD, and reused by later
+   * teams once it is destroyed. Zero keeps the default scratch.
+   */
+  size_t max_reduce_size;
+  /**
+   * Bitwise OR of rocshmem_team_collectives the team will run. Scratch
+   * for collectives that are not listed is not reserved.
+   */
+  int collectives;
 } rocshmem_team_config_t;
 
 constexpr size_t ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE = 1024;
@@ -95,6 +137,22 @@ constexpr size_t ROCSHMEM_ALLTOALL_SYNC_SIZE = ROCSHMEM_BARRIER_SYNC_SIZE + 1;
 constexpr size_t ROCSHMEM_FCOLLECT_SYNC_SIZE = ROCSHMEM_ALLTOALL_SYNC_SIZE;
 constexpr size_t ROCSHMEM_SYNC_VALUE = 0;
 
+/**
+ * @brief Host handler run by an active message on the target PE.
+ *
+ * @param[in] dest      The target's copy of the symmetric object the
+ *                      sender named.
+ * @param[in] args      The two argument words of the message.
+ * @param[in] source_pe PE that sent the message.
+ * @param[in] user_arg  Argument given when the handler was registered.
+ *
+ * @return Reply word returned to the sender.
+ */
+typedef uint64_t (*rocshmem_am_handler_t)(void *dest, const uint64_t *args,
+                                          int source_pe, void *user_arg);
+
+constexpr int ROCSHMEM_AM_MAX_HANDLERS = 64;
+
 const int ROCSHMEM_CTX_ZERO = 0;
 const int ROCSHMEM_CTX_NOSTORE = 1;
 const int ROCSHMEM_CTX_SERIALIZED = 2;
@@ -115,6 +115,15 @@ ExecTest() {
 
   # Construct Test Command
   TEST_LOG_NAME="$TEST_NAME"_n"$NUM_RANKS"_w"$NUM_WG"_z"$NUM_THREADS"
+
+  if [[ "" != "$RO_NET_COUNTER_COMPLETION" ]]
+  then
+    OPTIONS+=" -x RO_NET_COUNTER_COMPLETION"
+    if [[ "0" != "$RO_NET_COUNTER_COMPLETION" ]]
+    then
+      TEST_LOG_NAME+=_counter
+    fi
+  fi
   CMD="$LAUNCHER $OPTIONS $APP -a $TEST_NUM -w $NUM_WG -z $NUM_THREADS"
 
   if [[ "" != "$MAX_MSG_SIZE" ]]
@@ -296,6 +305,8 @@ TestColl() {
 
   ExecTest  "alltoall"         2       1            1         512
 
+  ExecTest  "alltoalls"        2       1            1         512
+
   ExecTest  "teambroadcast"    2       1            1         32768
 
   ExecTest  "fcollect"         2       1            1         512
@@ -320,6 +331,58 @@ TestOther() {
   unset ROCSHMEM_MAX_NUM_CONTEXTS
 }
 
+CompareCompletion() {
+  # Print the request-mode and counter-mode results of one test next to
+  # each other, one row per message size.
+  REQUEST_LOG=$LOG_DIR/$1_$2.log
+  COUNTER_LOG=$LOG_DIR/$1_counter_$2.log
+
+  if [[ ! -f "$REQUEST_LOG" || ! -f "$COUNTER_LOG" ]]
+  then
+    return
+  fi
+
+  echo "# $1 up to $2"
+  printf "%-10s%16s%16s%16s%16s%16s%16s\n" "# Size (B)" \
+         "Lat req (us)" "Lat ctr (us)" "Lat ratio" \
+         "BW req (GB/s)" "BW ctr (GB/s)" "BW ratio"
+  awk 'NR == FNR && $1 ~ /^[0-9]+$/ { lat[$1] = $2; bw[$1] = $3; next }
+       $1 ~ /^[0-9]+$/ && ($1 in lat) {
+         printf "%-10s%16.2f%16.2f%16.2f%16.2f%16.2f%16.2f\n", $1,
+                lat[$1], $2, (lat[$1] > 0 ? $2 / lat[$1] : 0),
+                bw[$1], $3, (bw[$1] > 0 ? $3 / bw[$1] : 0)
+       }' "$REQUEST_LOG" "$COUNTER_LOG"
+}
+
+BenchCompletion() {
+  # Small-message RMA under request-based and counter-based completion,
+  # followed by a side-by-side table of the two modes. A ratio below 1 in
+  # the latency column, or above 1 in the bandwidth column, favours
+  # counter mode.
+  for MODE in 0 1
+  do
+    export RO_NET_COUNTER_COMPLETION=$MODE
+    ############################################################################
+    #       | Name             | Ranks | Workgroups | Threads | Max Message Size
+    ############################################################################
+    ExecTest  "put"              2       1            1         512
+    ExecTest  "put"              2       16           128       8
+    ExecTest  "putnbi"           2       1            1         512
+    ExecTest  "putnbi"           2       16           128       8
+    ExecTest  "get"              2       1            1         512
+    ExecTest  "get"              2       16           128       8
+    ExecTest  "getnbi"           2       1            1         512
+    ExecTest  "getnbi"           2       16           128       8
+  done
+  unset RO_NET_COUNTER_COMPLETION
+
+  for BENCH_NAME in put putnbi get getnbi
+  do
+    CompareCompletion "$BENCH_NAME"_n2_w1_z1 512B
+    CompareCompletion "$BENCH_NAME"_n2_w16_z128 8B
+  done | tee $LOG_DIR/benchcompletion.log
+}
+
 ValidateInput() {
   INPUT_COUNT=$1
   if [ $INPUT_COUNT -eq 0 ] ; then
@@ -350,6 +413,9 @@ case $TEST in
     TestColl
     TestOther
     ;;
+  *"benchcompletion")
+    BenchCompletion
+    ;;
   *"rma")
     TestRMA
     ;;
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "am_handlers.hpp"
+
+namespace rocshmem {
+
+AmHandlers &AmHandlers::GetInstance() {
+  static AmHandlers handlers{};
+  return handlers;
+}
+
+bool AmHandlers::register_handler(int handler_id, AmHandler handler,
+                                  void *user_arg) {
+  if (handler_id < 0 || handler_id >= MAX_HANDLERS || handler == nullptr) {
+    return false;
+  }
+  /*
+   * Handlers are registered before messages for them are sent, so the
+   * release on the handler is enough for the proxy to see the argument.
+   */
+  Entry &entry{entries_[handler_id]};
+  entry.user_arg.store(user_arg, std::memory_order_relaxed);
+  entry.handler.store(handler, std::memory_order_release);
+  return true;
+}
+
+bool AmHandlers::execute(const AmRequest &request, char *heap_base,
+                         int source_pe, uint64_t *reply) const {
+  if (request.handler_id < 0 || request.handler_id >= MAX_HANDLERS) {
+    return false;
+  }
+  const Entry &entry{entries_[request.handler_id]};
+  auto handler{entry.handler.load(std::memory_order_acquire)};
+  if (handler == nullptr) {
+    return false;
+  }
+  *reply = handler(heap_base + request.offset, request.args, source_pe,
+                   entry.user_arg.load(std::memory_order_relaxed));
+  return true;
+}
+
+}  // namespace rocshmem
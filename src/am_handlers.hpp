@@ -0,0 +1,125 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_AM_HANDLERS_HPP_
+#define LIBRARY_SRC_AM_HANDLERS_HPP_
+
+/**
+ * @file am_handlers.hpp
+ * Host handlers run by active messages
+ *
+ * An active message names a handler registered on the target PE, a
+ * symmetric object and two argument words. The target's proxy runs the
+ * handler against its own copy of the object and sends the handler's
+ * return value back as the reply. This file holds the handler table and
+ * the wire format of a request; the transport moves the requests.
+ *
+ * Nothing here touches HIP or MPI so that the dispatch can be tested on
+ * any host.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace rocshmem {
+
+/**
+ * @brief Same signature as the public rocshmem_am_handler_t
+ */
+using AmHandler = uint64_t (*)(void *dest, const uint64_t *args,
+                               int source_pe, void *user_arg);
+
+/**
+ * @brief Active message as sent from the initiator's proxy to the target's
+ */
+struct AmRequest {
+  int32_t handler_id{0};
+
+  /**
+   * @brief Heap holding the object on the target
+   */
+  int32_t heap_idx{0};
+
+  /**
+   * @brief Offset of the object from the base of that heap
+   */
+  uint64_t offset{0};
+
+  uint64_t args[2]{};
+
+  /**
+   * @brief Tag the target sends the reply with
+   */
+  int32_t reply_tag{0};
+};
+
+/**
+ * @class AmHandlers am_handlers.hpp
+ *
+ * @brief Table of the handlers registered on this PE
+ *
+ * Registration happens on application threads while the proxy may be
+ * executing messages, so each entry is published through an atomic.
+ */
+class AmHandlers {
+ public:
+  /**
+   * @brief The table of this process
+   */
+  static AmHandlers &GetInstance();
+
+  static constexpr int MAX_HANDLERS{64};
+
+  /**
+   * @brief Register handler under handler_id, replacing any earlier one
+   *
+   * @return false for an id out of range or a null handler
+   */
+  bool register_handler(int handler_id, AmHandler handler, void *user_arg);
+
+  /**
+   * @brief Run the handler request names
+   *
+   * @param[in] request Message to run
+   * @param[in] heap_base Local base of the heap request->heap_idx names
+   * @param[in] source_pe PE that sent request
+   * @param[out] reply Value the handler returned
+   *
+   * @return false if no handler is registered under the id
+   */
+  bool execute(const AmRequest &request, char *heap_base, int source_pe,
+               uint64_t *reply) const;
+
+ private:
+  struct Entry {
+    std::atomic<AmHandler> handler{nullptr};
+
+    std::atomic<void *> user_arg{nullptr};
+  };
+
+  std::array<Entry, MAX_HANDLERS> entries_{};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_AM_HANDLERS_HPP_
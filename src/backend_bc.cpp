@@ -105,6 +105,30 @@ void Backend::destroy_remaining_ctxs() {
   }
 }
 
+void Backend::reserve_team_scratch(size_t bytes, MPI_Comm world_comm) {
+  bool member{bytes > 0};
+  unsigned long needed{TeamScratchArena::round_up(bytes)};  // NOLINT
+  MPI_Allreduce(MPI_IN_PLACE, &needed, 1, MPI_UNSIGNED_LONG, MPI_MAX,
+                world_comm);
+  if (!needed || team_scratch.reserve(needed, member, world_comm)) {
+    return;
+  }
+
+  /* Every PE takes the chunk so the heap stays symmetric */
+  void* chunk{nullptr};
+  heap.malloc(&chunk, needed);
+  if (chunk) {
+    team_scratch.add(chunk, needed, member);
+  }
+}
+
+void Backend::free_team_scratch() {
+  for (void* chunk : team_scratch.chunks()) {
+    heap.free(chunk);
+  }
+  team_scratch.init(nullptr);
+}
+
 Backend::~Backend() { CHECK_HIP(hipFree(print_lock)); }
 
 void Backend::dump_stats() {
@@ -131,6 +155,13 @@ void Backend::dump_stats() {
   printf("Fences %llu\n", device_stats.getStat(NUM_FENCE));
   printf("Quiets %llu\n", device_stats.getStat(NUM_QUIET));
   printf("ToAll %llu\n", device_stats.getStat(NUM_TO_ALL));
+  printf("ReduceScatter %llu\n", device_stats.getStat(NUM_REDUCE_SCATTER));
+  printf("Alltoall (Fixed/Variable) %llu/%llu\n",
+         device_stats.getStat(NUM_ALLTOALL),
+         device_stats.getStat(NUM_ALLTOALLV));
+  printf("Fcollect (Fixed/Variable) %llu/%llu\n",
+         device_stats.getStat(NUM_FCOLLECT),
+         device_stats.getStat(NUM_FCOLLECTV));
   printf("BarrierAll %llu\n", device_stats.getStat(NUM_BARRIER_ALL));
   printf("Wait Until %llu\n", device_stats.getStat(NUM_WAIT_UNTIL));
   printf("Wait Until Any %llu\n", device_stats.getStat(NUM_WAIT_UNTIL_ANY));
@@ -149,11 +180,15 @@ void Backend::dump_stats() {
   printf("Atomic_FInc %llu\n", device_stats.getStat(NUM_ATOMIC_FINC));
   printf("Atomic_Fetch %llu\n", device_stats.getStat(NUM_ATOMIC_FETCH));
   printf("Atomic_Add %llu\n", device_stats.getStat(NUM_ATOMIC_ADD));
+  printf("Atomic_Add (Vector/Strided) %llu/%llu\n",
+         device_stats.getStat(NUM_ATOMIC_ADD_VECTOR),
+         device_stats.getStat(NUM_ATOMIC_ADD_STRIDED));
   printf("Atomic_Set %llu\n", device_stats.getStat(NUM_ATOMIC_SET));
   printf("Atomic_Cswap %llu\n", device_stats.getStat(NUM_ATOMIC_CSWAP));
   printf("Atomic_Inc %llu\n", device_stats.getStat(NUM_ATOMIC_INC));
   printf("Tests %llu\n", device_stats.getStat(NUM_TEST));
   printf("SHMEM_PTR %llu\n", device_stats.getStat(NUM_SHMEM_PTR));
+  printf("Active Messages %llu\n", device_stats.getStat(NUM_AM));
   printf("SyncAll %llu\n", device_stats.getStat(NUM_SYNC_ALL));
 
   const auto& host_stats{globalHostStats};
@@ -167,6 +202,7 @@ void Backend::dump_stats() {
   printf("Fences %llu\n", host_stats.getStat(NUM_HOST_FENCE));
   printf("Quiets %llu\n", host_stats.getStat(NUM_HOST_QUIET));
   printf("ToAll %llu\n", host_stats.getStat(NUM_HOST_TO_ALL));
+  printf("Alltoallv %llu\n", host_stats.getStat(NUM_HOST_ALLTOALLV));
   printf("BarrierAll %llu\n", host_stats.getStat(NUM_HOST_BARRIER_ALL));
   printf("Wait Until %llu\n", host_stats.getStat(NUM_HOST_WAIT_UNTIL));
   printf("Wait Until Any %llu\n", host_stats.getStat(NUM_HOST_WAIT_UNTIL_ANY));
@@ -41,6 +41,7 @@
 #include "ipc_policy.hpp"
 #include "memory/symmetric_heap.hpp"
 #include "stats.hpp"
+#include "team_cache.hpp"
 #include "team_tracker.hpp"
 
 namespace rocshmem {
@@ -86,6 +87,7 @@ class Backend {
    * @param[in] num_pes Number of PEs in this team.
    * @param[in] my_pe_in_new_team Index of this PE in the new team.
    * @param[in] team_comm MPI communicator for this team.
+   * @param[in] config Resolved team configuration hints.
    *
    * @param[out] new_team pointer to the new team.
    */
@@ -93,6 +95,7 @@ class Backend {
                                TeamInfo* team_info_wrt_parent,
                                TeamInfo* team_info_wrt_world, int num_pes,
                                int my_pe_in_new_team, MPI_Comm team_comm,
+                               const rocshmem_team_config_t& config,
                                rocshmem_team_t* new_team) = 0;
 
   /**
@@ -102,6 +105,43 @@ class Backend {
    */
   virtual void team_destroy(rocshmem_team_t team) = 0;
 
+  /**
+   * @brief Scratch a team needs beyond its pool slot.
+   *
+   * @param[in] config Resolved team configuration hints.
+   * @param[in] num_pes Number of PEs in the team.
+   *
+   * @return Bytes to take from the team scratch arena, 0 if the pool slot
+   * is enough.
+   */
+  virtual size_t team_scratch_bytes(
+      [[maybe_unused]] const rocshmem_team_config_t& config,
+      [[maybe_unused]] int num_pes) const {
+    return 0;
+  }
+
+  /**
+   * @brief Make room in the team scratch arena for a new team.
+   *
+   * Must be called by every PE when a team is split from TEAM_WORLD,
+   * before the non-members leave. Grows the arena from the symmetric heap
+   * if no common free block is large enough.
+   *
+   * @param[in] bytes Scratch this PE needs, 0 if it does not join.
+   * @param[in] world_comm MPI communicator over every PE.
+   */
+  void reserve_team_scratch(size_t bytes, MPI_Comm world_comm);
+
+  /**
+   * @brief Return the team scratch arena to the symmetric heap.
+   */
+  void free_team_scratch();
+
+  /**
+   * @brief Contexts a single team may ask for with num_contexts.
+   */
+  virtual size_t get_max_num_contexts() const = 0;
+
   /**
    * @brief Reports processing element number id.
    *
@@ -266,6 +306,21 @@ class Backend {
    */
   TeamTracker team_tracker{};
 
+  /**
+   * @brief Communicators of user-created teams, kept across teams
+   */
+  TeamCommCache team_comm_cache{};
+
+  /**
+   * @brief Backend team objects and the TeamInfos of user-created teams
+   */
+  TeamBlockPool<HIPAllocator> team_metadata_pool{};
+
+  /**
+   * @brief Scratch of teams that asked for more than their pool slot
+   */
+  TeamScratchArena team_scratch{};
+
  protected:
   /**
    * @brief Required to support static inheritance for device calls.
@@ -0,0 +1,245 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "coll_schedule.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace rocshmem {
+
+static int wrap(int value, int n) { return ((value % n) + n) % n; }
+
+static bool is_pow2(int n) { return n > 0 && (n & (n - 1)) == 0; }
+
+static CollStep make_step(int send_peer, int recv_peer, int send_block,
+                          int recv_block, int nblocks, int sync_slot,
+                          CollStepOp op) {
+  CollStep step{};
+  step.send_peer = send_peer;
+  step.recv_peer = recv_peer;
+  step.send_block = static_cast<uint16_t>(send_block);
+  step.recv_block = static_cast<uint16_t>(recv_block);
+  step.nblocks = static_cast<uint16_t>(nblocks);
+  step.send_stage = static_cast<uint16_t>(send_block);
+  step.recv_stage = static_cast<uint16_t>(recv_block);
+  step.sync_slot = static_cast<uint16_t>(sync_slot);
+  step.op = op;
+  return step;
+}
+
+int HostCollSchedule::num_sync_slots() const {
+  int slots{0};
+  for (const auto &step : steps) {
+    slots = std::max(slots, step.sync_slot + 1);
+  }
+  return slots;
+}
+
+void HostCollSchedule::to_world(int pe_start, int stride) {
+  for (auto &step : steps) {
+    step.send_peer = pe_start + step.send_peer * stride;
+    step.recv_peer = pe_start + step.recv_peer * stride;
+  }
+}
+
+HostCollSchedule compile_ring_allreduce(int my_pe, int num_pes) {
+  HostCollSchedule sched{};
+  sched.algorithm = CollAlgorithm::RING;
+  sched.num_blocks = num_pes;
+  sched.num_stage_blocks = num_pes;
+
+  int send_peer{(my_pe + 1) % num_pes};
+  int recv_peer{wrap(my_pe - 1, num_pes)};
+
+  // The first num_pes - 1 steps reduce-scatter, the rest allgather.
+  for (int iter{0}; iter < 2 * num_pes - 2; iter++) {
+    CollStepOp op{iter < num_pes - 1 ? CollStepOp::REDUCE : CollStepOp::COPY};
+    sched.steps.push_back(make_step(send_peer, recv_peer,
+                                    wrap(my_pe + 1 - iter, num_pes),
+                                    wrap(my_pe - iter, num_pes), 1, iter, op));
+  }
+  return sched;
+}
+
+HostCollSchedule compile_recursive_doubling_allreduce(int my_pe,
+                                                      int num_pes) {
+  HostCollSchedule sched{};
+  sched.algorithm = CollAlgorithm::RECURSIVE_DOUBLING;
+  sched.num_blocks = 1;
+
+  int step_i{0};
+  for (int dist{1}; dist < num_pes; dist <<= 1, step_i++) {
+    int peer{my_pe ^ dist};
+    CollStep step{make_step(peer, peer, 0, 0, 1, step_i, CollStepOp::REDUCE)};
+    // Each round gets its own scratch slot so a fast partner in round
+    // k + 1 cannot overwrite data still being reduced from round k.
+    step.send_stage = static_cast<uint16_t>(step_i);
+    step.recv_stage = static_cast<uint16_t>(step_i);
+    sched.steps.push_back(step);
+  }
+  sched.num_stage_blocks = std::max(step_i, 1);
+  return sched;
+}
+
+HostCollSchedule compile_hierarchical_allreduce(int my_pe, int num_pes,
+                                                int group_size) {
+  HostCollSchedule sched{};
+  sched.algorithm = CollAlgorithm::HIERARCHICAL;
+
+  int local_size{group_size};
+  int num_groups{num_pes / group_size};
+  int group{my_pe / local_size};
+  int local{my_pe % local_size};
+  int group_base{group * local_size};
+
+  /*
+   * Block b = big * num_groups + sub: one big block per local rank, cut
+   * into one sub-block per group. Scratch holds every block for the
+   * intra-group phase plus one big block for the inter-group phase.
+   */
+  sched.num_blocks = local_size * num_groups;
+  sched.num_stage_blocks = local_size * num_groups + num_groups;
+
+  int slot{0};
+  int intra_send{group_base + (local + 1) % local_size};
+  int intra_recv{group_base + wrap(local - 1, local_size)};
+
+  // Phase 1: ring reduce-scatter of big blocks inside the group.
+  for (int iter{0}; iter < local_size - 1; iter++, slot++) {
+    int send_big{wrap(local + 1 - iter, local_size)};
+    int recv_big{wrap(local - iter, local_size)};
+    sched.steps.push_back(make_step(intra_send, intra_recv,
+                                    send_big * num_groups,
+                                    recv_big * num_groups, num_groups, slot,
+                                    CollStepOp::REDUCE));
+  }
+
+  // Phase 2: ring allreduce of the owned big block across groups.
+  int owned{wrap(local - (local_size - 2), local_size)};
+  int inter_send{((group + 1) % num_groups) * local_size + local};
+  int inter_recv{wrap(group - 1, num_groups) * local_size + local};
+  for (int iter{0}; iter < 2 * num_groups - 2; iter++, slot++) {
+    int send_sub{wrap(group + 1 - iter, num_groups)};
+    int recv_sub{wrap(group - iter, num_groups)};
+    CollStepOp op{iter < num_groups - 1 ? CollStepOp::REDUCE
+                                        : CollStepOp::COPY};
+    CollStep step{make_step(inter_send, inter_recv,
+                            owned * num_groups + send_sub,
+                            owned * num_groups + recv_sub, 1, slot, op)};
+    step.send_stage = static_cast<uint16_t>(sched.num_blocks + send_sub);
+    step.recv_stage = static_cast<uint16_t>(sched.num_blocks + recv_sub);
+    sched.steps.push_back(step);
+  }
+
+  // Phase 3: ring allgather of big blocks inside the group.
+  for (int iter{local_size - 1}; iter < 2 * local_size - 2; iter++, slot++) {
+    int send_big{wrap(local + 1 - iter, local_size)};
+    int recv_big{wrap(local - iter, local_size)};
+    sched.steps.push_back(make_step(intra_send, intra_recv,
+                                    send_big * num_groups,
+                                    recv_big * num_groups, num_groups, slot,
+                                    CollStepOp::COPY));
+  }
+  return sched;
+}
+
+HostCollSchedule compile_ring_allgather(int my_pe, int num_pes) {
+  HostCollSchedule sched{};
+  sched.algorithm = CollAlgorithm::RING;
+  sched.num_blocks = num_pes;
+
+  int send_peer{(my_pe + 1) % num_pes};
+  int recv_peer{wrap(my_pe - 1, num_pes)};
+  for (int iter{0}; iter < num_pes - 1; iter++) {
+    sched.steps.push_back(make_step(send_peer, recv_peer,
+                                    wrap(my_pe - iter, num_pes),
+                                    wrap(my_pe - 1 - iter, num_pes), 1, iter,
+                                    CollStepOp::COPY));
+  }
+  return sched;
+}
+
+HostCollSchedule compile_recursive_doubling_allgather(int my_pe,
+                                                      int num_pes) {
+  HostCollSchedule sched{};
+  sched.algorithm = CollAlgorithm::RECURSIVE_DOUBLING;
+  sched.num_blocks = num_pes;
+
+  int step_i{0};
+  for (int dist{1}; dist < num_pes; dist <<= 1, step_i++) {
+    int peer{my_pe ^ dist};
+    // Before round k each PE holds the aligned run of 2^k blocks it
+    // belongs to; the partner holds the neighbouring run.
+    sched.steps.push_back(make_step(peer, peer, my_pe & ~(dist - 1),
+                                    peer & ~(dist - 1), dist, step_i,
+                                    CollStepOp::COPY));
+  }
+  return sched;
+}
+
+HostCollSchedule compile_bruck_allgather(int my_pe, int num_pes) {
+  HostCollSchedule sched{};
+  sched.algorithm = CollAlgorithm::BRUCK;
+  sched.num_blocks = num_pes;
+
+  int step_i{0};
+  for (int dist{1}; dist < num_pes; dist <<= 1, step_i++) {
+    // I hold blocks [my_pe, my_pe + dist); they extend the run held by
+    // my_pe - dist.
+    sched.steps.push_back(make_step(wrap(my_pe - dist, num_pes),
+                                    (my_pe + dist) % num_pes, my_pe,
+                                    (my_pe + dist) % num_pes,
+                                    std::min(dist, num_pes - dist), step_i,
+                                    CollStepOp::COPY));
+  }
+  return sched;
+}
+
+HostCollSchedule compile_allreduce(int my_pe, int num_pes) {
+  char *value{nullptr};
+  if ((value = getenv("ROCSHMEM_REDUCE_ALGORITHM")) != nullptr) {
+    if (!strcmp(value, "rd") && is_pow2(num_pes)) {
+      return compile_recursive_doubling_allreduce(my_pe, num_pes);
+    }
+    if (!strcmp(value, "hierarchical")) {
+      int group_size{0};
+      if ((value = getenv("ROCSHMEM_HIERARCHY_SIZE")) != nullptr) {
+        group_size = atoi(value);
+      }
+      if (group_size > 0 && num_pes % group_size == 0) {
+        return compile_hierarchical_allreduce(my_pe, num_pes, group_size);
+      }
+    }
+  }
+  return compile_ring_allreduce(my_pe, num_pes);
+}
+
+HostCollSchedule compile_allgather(int my_pe, int num_pes) {
+  if (is_pow2(num_pes)) {
+    return compile_recursive_doubling_allgather(my_pe, num_pes);
+  }
+  return compile_bruck_allgather(my_pe, num_pes);
+}
+
+}  // namespace rocshmem
@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_COLL_SCHEDULE_HPP_
+#define LIBRARY_SRC_COLL_SCHEDULE_HPP_
+
+/**
+ * @file coll_schedule.hpp
+ * Defines the step tables executed by device collectives
+ *
+ * A schedule is compiled once on the host when a team is created. The
+ * collective buffer is cut into num_blocks equal blocks; each step names
+ * the peers and block ranges for one round so the device only walks the
+ * table. Peers are team-relative when compiled and are rewritten to
+ * world PEs before the table is uploaded.
+ */
+
+#include <cstdint>
+#include <vector>
+
+namespace rocshmem {
+
+enum class CollAlgorithm : uint8_t {
+  RING = 0,
+  RECURSIVE_DOUBLING = 1,
+  BRUCK = 2,
+  HIERARCHICAL = 3,
+};
+
+enum class CollStepOp : uint8_t {
+  /**
+   * @brief The blocks land directly in the peer's destination buffer.
+   */
+  COPY = 0,
+
+  /**
+   * @brief The blocks land in the peer's scratch buffer and the receiver
+   * combines them into its destination.
+   */
+  REDUCE = 1,
+};
+
+/**
+ * @brief One round of a collective as seen by a single PE.
+ *
+ * The PE sends blocks [send_block, send_block + nblocks) to send_peer,
+ * raises sync_slot on send_peer, then waits for its own sync_slot. Block
+ * ranges wrap modulo CollSchedule::num_blocks. For REDUCE steps the
+ * payload is written at send_stage in the peer's scratch buffer and read
+ * back from recv_stage locally; stage ranges never wrap.
+ */
+struct CollStep {
+  int send_peer{-1};
+  int recv_peer{-1};
+  uint16_t send_block{0};
+  uint16_t recv_block{0};
+  uint16_t nblocks{0};
+  uint16_t send_stage{0};
+  uint16_t recv_stage{0};
+  uint16_t sync_slot{0};
+  CollStepOp op{CollStepOp::COPY};
+};
+
+/**
+ * @brief Device view of a compiled schedule.
+ */
+struct CollSchedule {
+  CollAlgorithm algorithm{CollAlgorithm::RING};
+
+  /**
+   * @brief Number of equal blocks the user buffer is cut into.
+   */
+  int num_blocks{0};
+
+  /**
+   * @brief Number of block-sized scratch slots needed by REDUCE steps.
+   */
+  int num_stage_blocks{0};
+
+  int num_steps{0};
+
+  const CollStep *steps{nullptr};
+};
+
+/**
+ * @brief Host-side schedule produced by the compiler functions below.
+ */
+struct HostCollSchedule {
+  CollAlgorithm algorithm{CollAlgorithm::RING};
+  int num_blocks{0};
+  int num_stage_blocks{0};
+  std::vector<CollStep> steps{};
+
+  /**
+   * @brief Number of sync slots used, i.e. highest slot plus one.
+   */
+  int num_sync_slots() const;
+
+  /**
+   * @brief Rewrite team-relative peers as world PEs.
+   */
+  void to_world(int pe_start, int stride);
+};
+
+/**
+ * @brief Reduce-scatter followed by allgather around a ring.
+ *
+ * 2 * (num_pes - 1) steps over num_pes blocks. Matches the block order of
+ * the original IPC ring allreduce.
+ */
+HostCollSchedule compile_ring_allreduce(int my_pe, int num_pes);
+
+/**
+ * @brief Full-vector exchange with my_pe ^ 2^k for each bit k.
+ *
+ * log2(num_pes) steps over one block. Requires num_pes to be a power of
+ * two.
+ */
+HostCollSchedule compile_recursive_doubling_allreduce(int my_pe, int num_pes);
+
+/**
+ * @brief Two-level allreduce over groups of group_size consecutive PEs.
+ *
+ * Ring reduce-scatter inside each group, ring allreduce of the owned
+ * block across groups, then ring allgather inside each group. Requires
+ * group_size to divide num_pes.
+ */
+HostCollSchedule compile_hierarchical_allreduce(int my_pe, int num_pes,
+                                                int group_size);
+
+/**
+ * @brief Allgather around a ring; num_pes - 1 steps.
+ */
+HostCollSchedule compile_ring_allgather(int my_pe, int num_pes);
+
+/**
+ * @brief Allgather by doubling blocks exchanged with my_pe ^ 2^k.
+ *
+ * Requires num_pes to be a power of two.
+ */
+HostCollSchedule compile_recursive_doubling_allgather(int my_pe, int num_pes);
+
+/**
+ * @brief Bruck allgather for any team size; ceil(log2(num_pes)) steps.
+ *
+ * Blocks are placed at their final position on the receiver so no
+ * rotation pass is needed at the end.
+ */
+HostCollSchedule compile_bruck_allgather(int my_pe, int num_pes);
+
+/**
+ * @brief Pick and compile the allreduce schedule for a team.
+ *
+ * Honors ROCSHMEM_REDUCE_ALGORITHM (ring, rd, hierarchical) and
+ * ROCSHMEM_HIERARCHY_SIZE when the requested variant fits the team,
+ * and falls back to the ring otherwise.
+ */
+HostCollSchedule compile_allreduce(int my_pe, int num_pes);
+
+/**
+ * @brief Pick and compile the allgather schedule for a team.
+ *
+ * Recursive doubling for power-of-two teams, Bruck otherwise.
+ */
+HostCollSchedule compile_allgather(int my_pe, int num_pes);
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_COLL_SCHEDULE_HPP_
@@ -0,0 +1,290 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "command_trace.hpp"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <map>
+#include <tuple>
+
+#include "reverse_offload/commands_types.hpp"
+
+namespace rocshmem {
+
+static constexpr char TRACE_MAGIC[8] = {'R', 'O', 'T', 'R', 'A', 'C', 'E', '1'};
+
+TraceWriter::~TraceWriter() { close(); }
+
+bool TraceWriter::open(const std::string &path) {
+  close();
+  file_ = fopen(path.c_str(), "wb");
+  if (!file_) {
+    return false;
+  }
+  fwrite(TRACE_MAGIC, sizeof(TRACE_MAGIC), 1, file_);
+  return true;
+}
+
+void TraceWriter::record(const TraceRecord &record) {
+  if (file_) {
+    fwrite(&record, sizeof(record), 1, file_);
+  }
+}
+
+void TraceWriter::close() {
+  if (file_) {
+    fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+bool read_trace(const std::string &path, std::vector<TraceRecord> *records) {
+  FILE *file{fopen(path.c_str(), "rb")};
+  if (!file) {
+    return false;
+  }
+
+  char magic[sizeof(TRACE_MAGIC)]{};
+  bool valid{fread(magic, sizeof(magic), 1, file) == 1 &&
+             !std::memcmp(magic, TRACE_MAGIC, sizeof(magic))};
+
+  TraceRecord record{};
+  while (valid && fread(&record, sizeof(record), 1, file) == 1) {
+    records->push_back(record);
+  }
+
+  fclose(file);
+  return valid;
+}
+
+WindowStats &WindowStats::operator+=(const WindowStats &other) {
+  commands += other.commands;
+  puts += other.puts;
+  bytes += other.bytes;
+  same_dest += other.same_dest;
+  adjacent += other.adjacent;
+  adjacent_same_block += other.adjacent_same_block;
+  return *this;
+}
+
+static bool is_put(int32_t type) {
+  return type == RO_NET_PUT || type == RO_NET_PUT_NBI;
+}
+
+static bool is_global(int32_t type) {
+  switch (type) {
+    case RO_NET_BARRIER_ALL:
+    case RO_NET_SYNC:
+    case RO_NET_TO_ALL:
+    case RO_NET_TEAM_REDUCE:
+    case RO_NET_REDUCE_SCATTER:
+    case RO_NET_BROADCAST:
+    case RO_NET_TEAM_BROADCAST:
+    case RO_NET_ALLTOALL:
+    case RO_NET_FCOLLECT:
+    case RO_NET_FCOLLECTV:
+    case RO_NET_ALLTOALLV:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::vector<WindowStats> analyze_trace(const std::vector<TraceRecord> &records,
+                                       size_t window_size) {
+  window_size = std::max<size_t>(window_size, 1);
+
+  std::vector<WindowStats> windows{};
+
+  // (pe, win_id, dst end, src end) of the puts seen in the current window,
+  // mapped to the block of the latest one.
+  std::map<std::tuple<int, int, uint64_t, uint64_t>, int> ends{};
+  std::map<int, int> pes{};
+
+  for (size_t i{0}; i < records.size(); i++) {
+    if (i % window_size == 0) {
+      windows.emplace_back();
+      ends.clear();
+      pes.clear();
+    }
+
+    const auto &record{records[i]};
+    auto &stats{windows.back()};
+    stats.commands++;
+    if (!is_put(record.type)) {
+      continue;
+    }
+
+    stats.puts++;
+    stats.bytes += record.size;
+
+    if (pes[record.pe]++) {
+      stats.same_dest++;
+    }
+
+    auto it{ends.find({record.pe, record.win_id, record.dst, record.src})};
+    if (it != ends.end()) {
+      stats.adjacent++;
+      if (it->second == record.block) {
+        stats.adjacent_same_block++;
+      }
+    }
+    ends[{record.pe, record.win_id, record.dst + record.size,
+          record.src + record.size}] = record.block;
+  }
+
+  return windows;
+}
+
+bool parse_coalesce_policy(const char *text, CoalescePolicy *policy) {
+  unsigned long long window{};
+  unsigned long long max_bytes{};
+  unsigned long long timeout_us{};
+  char extra{};
+  if (sscanf(text, "%llu,%llu,%llu%c", &window, &max_bytes, &timeout_us,
+             &extra) != 3) {
+    return false;
+  }
+  policy->window = window;
+  policy->max_bytes = max_bytes;
+  policy->timeout_ns = timeout_us * 1000;
+  return true;
+}
+
+std::string to_string(const CoalescePolicy &policy) {
+  return std::to_string(policy.window) + "," +
+         std::to_string(policy.max_bytes) + "," +
+         std::to_string(policy.timeout_ns / 1000);
+}
+
+PutCoalescer::PutCoalescer(const CoalescePolicy &policy, EmitFn emit)
+    : policy_{policy}, emit_{std::move(emit)} {}
+
+void PutCoalescer::add(const TraceRecord &put) {
+  if (static_cast<size_t>(put.block) >= runs_.size()) {
+    runs_.resize(put.block + 1);
+  }
+
+  auto &run{runs_[put.block]};
+  if (run.puts) {
+    bool extends{run.pe == put.pe && run.win_id == put.win_id &&
+                 run.dst + run.size == put.dst &&
+                 run.src + run.size == put.src &&
+                 run.size + put.size <= policy_.max_bytes};
+    if (extends) {
+      run.size += put.size;
+      run.puts++;
+    } else {
+      emit(put.block, FlushReason::BREAK);
+    }
+  }
+
+  if (!run.puts) {
+    run = {put.dst, put.src, put.size, put.pe,
+           put.win_id, put.block, 1, put.time_ns};
+    open_blocks_.push_back(put.block);
+  }
+
+  if (run.puts >= policy_.window || run.size >= policy_.max_bytes) {
+    emit(put.block, FlushReason::FULL);
+  }
+}
+
+void PutCoalescer::flush(int block, FlushReason reason) {
+  if (static_cast<size_t>(block) < runs_.size() && runs_[block].puts) {
+    emit(block, reason);
+  }
+}
+
+void PutCoalescer::flush_all(FlushReason reason) {
+  while (!open_blocks_.empty()) {
+    emit(open_blocks_.front(), reason);
+  }
+}
+
+void PutCoalescer::expire(uint64_t now_ns) {
+  if (!policy_.timeout_ns) {
+    return;
+  }
+
+  // Runs open in time order, so the expired ones lead the list.
+  while (!open_blocks_.empty()) {
+    const auto &run{runs_[open_blocks_.front()]};
+    if (now_ns - run.first_ns < policy_.timeout_ns) {
+      break;
+    }
+    emit(open_blocks_.front(), FlushReason::TIMEOUT);
+  }
+}
+
+void PutCoalescer::emit(int block, FlushReason reason) {
+  CoalescedPut run{runs_[block]};
+  runs_[block].puts = 0;
+  open_blocks_.erase(
+      std::find(open_blocks_.begin(), open_blocks_.end(), block));
+  emit_(run, reason);
+}
+
+CoalesceStats simulate_coalescing(const std::vector<TraceRecord> &records,
+                                  const CoalescePolicy &policy) {
+  CoalesceStats stats{};
+  uint64_t now_ns{0};
+
+  PutCoalescer coalescer{
+      policy, [&](const CoalescedPut &run, FlushReason reason) {
+        stats.puts_out++;
+        stats.flushes[static_cast<int>(reason)]++;
+        stats.delay_ns += now_ns - run.first_ns;
+      }};
+
+  for (const auto &record : records) {
+    now_ns = std::max(now_ns, record.time_ns);
+    coalescer.expire(now_ns);
+
+    if (record.type == RO_NET_PUT_NBI) {
+      stats.puts_in++;
+      stats.bytes += record.size;
+      if (policy.enabled()) {
+        coalescer.add(record);
+      } else {
+        stats.puts_out++;
+      }
+      continue;
+    }
+
+    if (is_global(record.type)) {
+      coalescer.flush_all(FlushReason::SYNC);
+    } else if (record.type == RO_NET_QUIET || record.type == RO_NET_FENCE ||
+               record.type == RO_NET_FINALIZE) {
+      coalescer.flush(record.block, FlushReason::SYNC);
+    } else {
+      coalescer.flush(record.block, FlushReason::BREAK);
+    }
+  }
+
+  coalescer.flush_all(FlushReason::SYNC);
+  return stats;
+}
+
+}  // namespace rocshmem
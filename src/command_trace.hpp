@@ -0,0 +1,300 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_COMMAND_TRACE_HPP_
+#define LIBRARY_SRC_COMMAND_TRACE_HPP_
+
+/**
+ * @file command_trace.hpp
+ * Recording of the RO command stream and put coalescing over it
+ *
+ * The proxy can write every command it pops to a trace file. The analysis
+ * functions measure how many of the traced puts could have been merged
+ * and replay the trace through a PutCoalescer to compare policies. The
+ * proxy runs the same PutCoalescer when coalescing is enabled, so the
+ * replay predicts what it will do.
+ *
+ * Nothing here touches HIP or MPI so that the offline analyzer can be
+ * built on any host.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace rocshmem {
+
+/**
+ * @brief One command as popped by the proxy
+ */
+struct TraceRecord {
+  /**
+   * @brief Time the proxy popped the command (steady clock)
+   */
+  uint64_t time_ns{0};
+
+  uint64_t dst{0};
+
+  uint64_t src{0};
+
+  uint64_t size{0};
+
+  /**
+   * @brief ro_net_cmds value
+   */
+  int32_t type{0};
+
+  /**
+   * @brief Queue (block) the command came from
+   */
+  int32_t block{0};
+
+  int32_t pe{0};
+
+  int32_t win_id{0};
+};
+
+/**
+ * @class TraceWriter command_trace.hpp
+ *
+ * @brief Appends TraceRecords to a binary file
+ */
+class TraceWriter {
+ public:
+  TraceWriter() = default;
+
+  TraceWriter(const TraceWriter &) = delete;
+
+  TraceWriter &operator=(const TraceWriter &) = delete;
+
+  ~TraceWriter();
+
+  /**
+   * @brief Create path and write the file header
+   *
+   * @return false if the file cannot be created
+   */
+  bool open(const std::string &path);
+
+  void record(const TraceRecord &record);
+
+  void close();
+
+ private:
+  FILE *file_{nullptr};
+};
+
+/**
+ * @brief Read a file written by TraceWriter
+ *
+ * @param[in] path Trace file
+ * @param[out] records Records of the file, appended in order
+ *
+ * @return false if the file is missing or not a trace
+ */
+bool read_trace(const std::string &path, std::vector<TraceRecord> *records);
+
+/**
+ * @brief Coalescing opportunity within one window of the trace
+ *
+ * Every put is compared with the puts before it in the same window.
+ */
+struct WindowStats {
+  uint64_t commands{0};
+
+  uint64_t puts{0};
+
+  uint64_t bytes{0};
+
+  /**
+   * @brief Puts targeting a PE an earlier put already targets
+   */
+  uint64_t same_dest{0};
+
+  /**
+   * @brief Puts starting where an earlier put to the same PE and window
+   * ends, on both the source and the destination side
+   */
+  uint64_t adjacent{0};
+
+  /**
+   * @brief Adjacent puts whose predecessor came from the same block
+   */
+  uint64_t adjacent_same_block{0};
+
+  WindowStats &operator+=(const WindowStats &other);
+};
+
+/**
+ * @brief Split records into windows of window_size commands
+ *
+ * @return one WindowStats per window, the last one possibly partial
+ */
+std::vector<WindowStats> analyze_trace(const std::vector<TraceRecord> &records,
+                                       size_t window_size);
+
+/**
+ * @brief When the proxy merges non-blocking puts
+ */
+struct CoalescePolicy {
+  /**
+   * @brief Most puts merged into one
+   */
+  size_t window{1};
+
+  /**
+   * @brief Most bytes in a merged put
+   */
+  size_t max_bytes{0};
+
+  /**
+   * @brief Longest time a put is held back, zero for no limit
+   */
+  uint64_t timeout_ns{0};
+
+  bool enabled() const { return window > 1 && max_bytes > 0; }
+};
+
+/**
+ * @brief Parse "window,max_bytes,timeout_us", e.g. "16,65536,20"
+ *
+ * @return false if text is malformed
+ */
+bool parse_coalesce_policy(const char *text, CoalescePolicy *policy);
+
+std::string to_string(const CoalescePolicy &policy);
+
+/**
+ * @brief A run of contiguous puts from one block
+ */
+struct CoalescedPut {
+  uint64_t dst{0};
+
+  uint64_t src{0};
+
+  uint64_t size{0};
+
+  int pe{-1};
+
+  int win_id{-1};
+
+  int block{-1};
+
+  uint32_t puts{0};
+
+  uint64_t first_ns{0};
+};
+
+enum class FlushReason {
+  FULL,
+  BREAK,
+  SYNC,
+  TIMEOUT,
+};
+
+/**
+ * @class PutCoalescer command_trace.hpp
+ *
+ * @brief Holds back one run of contiguous puts per block
+ *
+ * A put that starts where the open run of its block ends, on both the
+ * source and the destination side, extends the run. Anything else from
+ * the block closes it. Runs never span blocks, so a block's puts still
+ * leave in the order they arrived relative to its other commands.
+ */
+class PutCoalescer {
+ public:
+  using EmitFn = std::function<void(const CoalescedPut &, FlushReason)>;
+
+  PutCoalescer(const CoalescePolicy &policy, EmitFn emit);
+
+  /**
+   * @brief Add a put, possibly emitting the run it cannot join
+   */
+  void add(const TraceRecord &put);
+
+  /**
+   * @brief Emit the open run of block
+   */
+  void flush(int block, FlushReason reason);
+
+  void flush_all(FlushReason reason);
+
+  /**
+   * @brief Emit the runs opened at least timeout_ns before now_ns
+   */
+  void expire(uint64_t now_ns);
+
+  /**
+   * @brief Number of open runs
+   */
+  size_t pending() const { return open_blocks_.size(); }
+
+ private:
+  void emit(int block, FlushReason reason);
+
+  CoalescePolicy policy_{};
+
+  EmitFn emit_{};
+
+  // Open run of each block, indexed by block. Empty runs have no puts.
+  std::vector<CoalescedPut> runs_{};
+
+  // Blocks with an open run, in opening order.
+  std::vector<int> open_blocks_{};
+};
+
+/**
+ * @brief Outcome of replaying a trace through a PutCoalescer
+ */
+struct CoalesceStats {
+  uint64_t puts_in{0};
+
+  uint64_t puts_out{0};
+
+  uint64_t bytes{0};
+
+  /**
+   * @brief Runs emitted for each FlushReason
+   */
+  uint64_t flushes[4]{};
+
+  /**
+   * @brief Sum over runs of how long their first put was held back
+   */
+  uint64_t delay_ns{0};
+};
+
+/**
+ * @brief Replay records the way the proxy would with policy enabled
+ *
+ * Only non-blocking puts are coalesced. Another command from a block
+ * closes its run; barriers and collectives close every run.
+ */
+CoalesceStats simulate_coalescing(const std::vector<TraceRecord> &records,
+                                  const CoalescePolicy &policy);
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_COMMAND_TRACE_HPP_
@@ -135,6 +135,9 @@ class Context {
 
   __device__ void* shmem_ptr(const void* dest, int pe);
 
+  __device__ uint64_t am(void* dest, int handler_id, uint64_t arg0,
+                         uint64_t arg1, int pe);
+
   __device__ void barrier_all();
 
   __device__ void sync_all();
@@ -147,6 +150,15 @@ class Context {
   template <typename T>
   __device__ void amo_add(void* dst, T value, int pe);
 
+  template <typename T>
+  __device__ void amo_add_vector(T* dst, const size_t* indices,
+                                 const T* values, const int* pes,
+                                 size_t nelems);
+
+  template <typename T>
+  __device__ void amo_add_strided(T* dst, ptrdiff_t stride, const T* values,
+                                  size_t nelems, int pe);
+
   template <typename T>
   __device__ void amo_set(void* dst, T value, int pe);
 
@@ -194,6 +206,10 @@ class Context {
   template <typename T, ROCSHMEM_OP Op>
   __device__ int reduce(rocshmem_team_t team, T* dest, const T* source, int nreduce);
 
+  template <typename T, ROCSHMEM_OP Op>
+  __device__ int reduce_scatter(rocshmem_team_t team, T* dest,
+                                const T* source, int nreduce);
+
   template <typename T>
   __device__ void put(T* dest, const T* source, size_t nelems, int pe);
 
@@ -210,10 +226,20 @@ class Context {
   __device__ void alltoall(rocshmem_team_t team, T* dest, const T* source,
                            int nelems);
 
+  template <typename T>
+  __device__ void alltoallv(rocshmem_team_t team, T* dest, const T* source,
+                            const int* source_counts,
+                            const int* source_displs, const int* dest_counts,
+                            const int* dest_displs);
+
   template <typename T>
   __device__ void fcollect(rocshmem_team_t team, T* dest, const T* source,
                            int nelems);
 
+  template <typename T>
+  __device__ void fcollectv(rocshmem_team_t team, T* dest, const T* source,
+                            const int* counts);
+
   template <typename T>
   __device__ void broadcast(rocshmem_team_t team, T* dest, const T* source,
                             int nelems, int pe_root);
@@ -381,6 +407,11 @@ class Context {
   __host__ void broadcast(rocshmem_team_t team, T* dest, const T* source,
                           int nelems, int pe_root);
 
+  template <typename T>
+  __host__ void alltoallv(rocshmem_team_t team, T* dest, const T* source,
+                          const int* source_counts, const int* source_displs,
+                          const int* dest_counts, const int* dest_displs);
+
   template <typename T, ROCSHMEM_OP Op>
   __host__ void to_all(T* dest, const T* source, int nreduce, int PE_start,
                        int logPE_stride, int PE_size, T* pWrk,
@@ -142,6 +142,18 @@ __device__ void* Context::shmem_ptr(const void* dest, int pe) {
   DISPATCH_RET_PTR(shmem_ptr(dest, pe));
 }
 
+__device__ uint64_t Context::am(void* dest, int handler_id, uint64_t arg0,
+                                uint64_t arg1, int pe) {
+  ctxStats.incStat(NUM_AM);
+
+#if defined(USE_RO) && !defined(USE_GPU_IB)
+  DISPATCH_RET(am(dest, handler_id, arg0, arg1, pe));
+#else
+  GPU_DPRINTF("Active messages need the reverse offload conduit.\n");
+  return 0;
+#endif
+}
+
 __device__ void Context::barrier_all() {
   ctxStats.incStat(NUM_BARRIER_ALL);
 
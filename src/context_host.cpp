@@ -23,13 +23,16 @@
 #include "rocshmem_config.h"  // NOLINT(build/include_subdir)
 #include "backend_bc.hpp"
 #include "context_incl.hpp"
+#include "mpi_init_singleton.hpp"
 
 namespace rocshmem {
 
 __host__ Context::Context(Backend* handle, bool shareable)
     : num_pes(handle->getNumPEs()),
       my_pe(handle->getMyPE()),
-      fence_(shareable) {}
+      fence_(shareable) {
+  ctxHostStats.set_shared(MPIInitSingleton::thread_multiple());
+}
 
 /******************************************************************************
  ********************** CONTEXT DISPATCH IMPLEMENTATIONS **********************
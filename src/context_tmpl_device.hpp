@@ -32,6 +32,8 @@
 #else
 #include "ipc/context_ipc_device.hpp"
 #endif
+#include "rocshmem_calc.hpp"
+#include "team.hpp"
 
 namespace rocshmem {
 
@@ -93,6 +95,79 @@ __device__ int Context::reduce(rocshmem_team_t team, T *dest, const T *source,
   DISPATCH_RET(reduce<PAIR(T, Op)>(team, dest, source, nreduce));
 }
 
+template <typename T, ROCSHMEM_OP Op>
+__device__ int Context::reduce_scatter(rocshmem_team_t team, T *dest,
+                                       const T *source, int nreduce) {
+  if (nreduce == 0) {
+    return ROCSHMEM_SUCCESS;
+  }
+
+  if (is_thread_zero_in_block()) {
+    ctxStats.incStat(NUM_REDUCE_SCATTER);
+  }
+
+#if defined(USE_RO) && !defined(USE_GPU_IB)
+  DISPATCH_RET(reduce_scatter<PAIR(T, Op)>(team, dest, source, nreduce));
+#else
+  /*
+   * Pull this PE's block from every member and fold it in place. The
+   * syncs keep a peer from reusing its source while it is still read.
+   */
+  Team *team_obj{get_internal_team(team)};
+  const T *block{source + static_cast<size_t>(team_obj->my_pe) * nreduce};
+
+  DISPATCH(sync(team));
+  if (dest != source) {
+    for (int i = get_flat_block_id(); i < nreduce;
+         i += get_flat_block_size()) {
+      T value{};
+      DISPATCH(get<T>(&dest[i], &block[i], 1, team_obj->get_pe_in_world(0)));
+      for (int j{1}; j < team_obj->num_pes; j++) {
+        DISPATCH(get<T>(&value, &block[i], 1, team_obj->get_pe_in_world(j)));
+        OpWrap<Op>::Calc(&value, &dest[i], 0);
+      }
+    }
+  } else {
+    /*
+     * In place, dest is the block the first member reads from every PE.
+     * Each round reduces a slice into registers and writes it back only
+     * after the whole team has read that slice.
+     */
+    constexpr int SLICE{8};
+    int stride{get_flat_block_size()};
+    for (int base{0}; base < nreduce; base += SLICE * stride) {
+      T reduced[SLICE];
+      for (int k{0}; k < SLICE; k++) {
+        int i{base + k * stride + get_flat_block_id()};
+        if (i >= nreduce) {
+          break;
+        }
+        T value{};
+        DISPATCH(get<T>(&reduced[k], &block[i], 1,
+                        team_obj->get_pe_in_world(0)));
+        for (int j{1}; j < team_obj->num_pes; j++) {
+          DISPATCH(get<T>(&value, &block[i], 1,
+                          team_obj->get_pe_in_world(j)));
+          OpWrap<Op>::Calc(&value, &reduced[k], 0);
+        }
+      }
+      __syncthreads();
+      DISPATCH(sync(team));
+      for (int k{0}; k < SLICE; k++) {
+        int i{base + k * stride + get_flat_block_id()};
+        if (i >= nreduce) {
+          break;
+        }
+        dest[i] = reduced[k];
+      }
+    }
+  }
+  __syncthreads();
+  DISPATCH(sync(team));
+  return ROCSHMEM_SUCCESS;
+#endif
+}
+
 template <typename T>
 __device__ void Context::put(T *dest, const T *source, size_t nelems, int pe) {
   if (nelems == 0) {
@@ -153,6 +228,45 @@ __device__ void Context::alltoall(rocshmem_team_t team, T *dest,
   DISPATCH(alltoall<T>(team, dest, source, nelems));
 }
 
+template <typename T>
+__device__ void Context::alltoallv(rocshmem_team_t team, T *dest,
+                                   const T *source, const int *source_counts,
+                                   const int *source_displs,
+                                   const int *dest_counts,
+                                   const int *dest_displs) {
+  if (is_thread_zero_in_block()) {
+    ctxStats.incStat(NUM_ALLTOALLV);
+  }
+
+#if defined(USE_RO) && !defined(USE_GPU_IB)
+  DISPATCH(alltoallv<T>(team, dest, source, source_counts, source_displs,
+                        dest_counts, dest_displs));
+#else
+  /*
+   * Pull every block. Where a block sits in its sender's source is only
+   * known to the sender, so its displacement is read first.
+   */
+  __shared__ int source_displ;
+  Team *team_obj{get_internal_team(team)};
+
+  DISPATCH(sync(team));
+  for (int j{0}; j < team_obj->num_pes; j++) {
+    if (dest_counts[j] != 0) {
+      int pe{team_obj->get_pe_in_world(j)};
+      if (is_thread_zero_in_block()) {
+        source_displ = g(const_cast<int *>(source_displs) + team_obj->my_pe,
+                         pe);
+      }
+      __syncthreads();
+      DISPATCH(getmem_wg(dest + dest_displs[j], source + source_displ,
+                         dest_counts[j] * sizeof(T), pe));
+      __syncthreads();
+    }
+  }
+  DISPATCH(sync(team));
+#endif
+}
+
 template <typename T>
 __device__ void Context::fcollect(rocshmem_team_t team, T *dest,
                                   const T *source, int nelems) {
@@ -167,6 +281,31 @@ __device__ void Context::fcollect(rocshmem_team_t team, T *dest,
   DISPATCH(fcollect<T>(team, dest, source, nelems));
 }
 
+template <typename T>
+__device__ void Context::fcollectv(rocshmem_team_t team, T *dest,
+                                   const T *source, const int *counts) {
+  if (is_thread_zero_in_block()) {
+    ctxStats.incStat(NUM_FCOLLECTV);
+  }
+
+#if defined(USE_RO) && !defined(USE_GPU_IB)
+  DISPATCH(fcollectv<T>(team, dest, source, counts));
+#else
+  Team *team_obj{get_internal_team(team)};
+  size_t displ{0};
+
+  DISPATCH(sync(team));
+  for (int j{0}; j < team_obj->num_pes; j++) {
+    if (counts[j] != 0) {
+      DISPATCH(getmem_wg(dest + displ, source, counts[j] * sizeof(T),
+                         team_obj->get_pe_in_world(j)));
+    }
+    displ += counts[j];
+  }
+  DISPATCH(sync(team));
+#endif
+}
+
 template <typename T>
 __device__ void Context::broadcast(rocshmem_team_t team, T *dest,
                                    const T *source, int nelems, int pe_root) {
@@ -486,6 +625,36 @@ __device__ void Context::amo_add(void *dst, T value, int pe) {
   DISPATCH(amo_add(dst, value, pe));
 }
 
+template <typename T>
+__device__ void Context::amo_add_vector(T *dst, const size_t *indices,
+                                        const T *values, const int *pes,
+                                        size_t nelems) {
+  ctxStats.incStat(NUM_ATOMIC_ADD_VECTOR);
+
+#if defined(USE_RO) && !defined(USE_GPU_IB)
+  DISPATCH(amo_add_vector(dst, indices, values, pes, nelems));
+#else
+  for (size_t i{0}; i < nelems; i++) {
+    DISPATCH(amo_add(&dst[indices[i]], values[i], pes[i]));
+  }
+#endif
+}
+
+template <typename T>
+__device__ void Context::amo_add_strided(T *dst, ptrdiff_t stride,
+                                         const T *values, size_t nelems,
+                                         int pe) {
+  ctxStats.incStat(NUM_ATOMIC_ADD_STRIDED);
+
+#if defined(USE_RO) && !defined(USE_GPU_IB)
+  DISPATCH(amo_add_strided(dst, stride, values, nelems, pe));
+#else
+  for (size_t i{0}; i < nelems; i++) {
+    DISPATCH(amo_add(&dst[i * stride], values[i], pe));
+  }
+#endif
+}
+
 template <typename T>
 __device__ void Context::amo_set(void *dst, T value, int pe) {
   ctxStats.incStat(NUM_ATOMIC_SET);
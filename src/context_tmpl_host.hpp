@@ -206,6 +206,18 @@ __host__ void Context::broadcast(rocshmem_team_t team, T *dest,
   HOST_DISPATCH(broadcast<T>(team, dest, source, nelems, pe_root));
 }
 
+template <typename T>
+__host__ void Context::alltoallv(rocshmem_team_t team, T *dest,
+                                 const T *source, const int *source_counts,
+                                 const int *source_displs,
+                                 const int *dest_counts,
+                                 const int *dest_displs) {
+  ctxHostStats.incStat(NUM_HOST_ALLTOALLV);
+
+  HOST_DISPATCH(alltoallv<T>(team, dest, source, source_counts, source_displs,
+                             dest_counts, dest_displs));
+}
+
 template <typename T, ROCSHMEM_OP Op>
 __host__ void Context::to_all(T *dest, const T *source, int nreduce,
                               int PE_start, int logPE_stride, int PE_size,
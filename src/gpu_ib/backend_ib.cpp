@@ -36,6 +36,8 @@
 #include "gpu_ib_team.hpp"
 #include "queue_pair.hpp"
 #include "../host/host.hpp"
+#include "../mpi_init_singleton.hpp"
+#include "../team_config.hpp"
 
 namespace rocshmem {
 
@@ -203,6 +205,7 @@ void GPUIBBackend::create_new_team([[maybe_unused]] Team *parent_team,
                                    TeamInfo *team_info_wrt_parent,
                                    TeamInfo *team_info_wrt_world, int num_pes,
                                    int my_pe_in_new_team, MPI_Comm team_comm,
+                                   const rocshmem_team_config_t &config,
                                    rocshmem_team_t *new_team) {
   /**
    * Read the bit mask and find out a common index into
@@ -228,15 +231,25 @@ void GPUIBBackend::create_new_team([[maybe_unused]] Team *parent_team,
    * Allocate device-side memory for team_world and
    * construct a GPU_IB team in it
    */
-  GPUIBTeam *new_team_obj;
-  CHECK_HIP(hipMalloc(&new_team_obj, sizeof(GPUIBTeam)));
+  auto *new_team_obj{static_cast<GPUIBTeam *>(
+      team_metadata_pool.allocate(sizeof(GPUIBTeam)))};
   new (new_team_obj)
       GPUIBTeam(this, team_info_wrt_parent, team_info_wrt_world, num_pes,
-                my_pe_in_new_team, team_comm, common_index);
+                my_pe_in_new_team, team_comm, common_index, config);
 
   *new_team = get_external_team(new_team_obj);
 }
 
+size_t GPUIBBackend::team_scratch_bytes(const rocshmem_team_config_t &config,
+                                        [[maybe_unused]] int num_pes) const {
+  /* The direct reduction indexes pWrk by world PE */
+  size_t wrk_elems{team_reduce_scratch_elems(config, this->num_pes)};
+  if (wrk_elems <= ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE) {
+    return 0;
+  }
+  return wrk_elems * sizeof(double);
+}
+
 void GPUIBBackend::team_destroy(rocshmem_team_t team) {
   GPUIBTeam *team_obj = get_internal_gpu_ib_team(team);
 
@@ -245,8 +258,12 @@ void GPUIBBackend::team_destroy(rocshmem_team_t team) {
   int byte_i = bit / CHAR_BIT;
   pool_bitmask_[byte_i] |= 1 << (bit % CHAR_BIT);
 
+  if (team_obj->pWrk_in_arena) {
+    team_scratch.release(team_obj->pWrk);
+  }
+
   team_obj->~GPUIBTeam();
-  CHECK_HIP(hipFree(team_obj));
+  team_metadata_pool.release(team_obj, sizeof(GPUIBTeam));
 }
 
 void GPUIBBackend::dump_backend_stats() {
@@ -324,7 +341,8 @@ void GPUIBBackend::setup_team_world() {
   GPUIBTeam *team_world{nullptr};
   CHECK_HIP(hipMalloc(&team_world, sizeof(GPUIBTeam)));
   new (team_world) GPUIBTeam(this, team_info_wrt_parent, team_info_wrt_world,
-                             num_pes, my_pe, team_world_comm, 0);
+                             num_pes, my_pe, team_world_comm, 0,
+                             default_team_config());
   team_tracker.set_team_world(team_world);
 
   /**
@@ -341,8 +359,9 @@ void GPUIBBackend::init_mpi_once(MPI_Comm comm) {
   NET_CHECK(MPI_Initialized(&init_done));
   if (init_done == 0) {
     int provided;
-    NET_CHECK(
-        MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided));
+    NET_CHECK(MPI_Init_thread(nullptr, nullptr,
+                              MPIInitSingleton::mpi_thread_level(),
+                              &provided));
   }
   if (comm == MPI_COMM_NULL) {
     NET_CHECK(MPI_Comm_dup(MPI_COMM_WORLD, &backend_comm));
@@ -396,6 +415,9 @@ void GPUIBBackend::teams_init() {
   pAta_pool = rocshmem_malloc(sizeof(double) * ROCSHMEM_ATA_MAX_WRKDATA_SIZE *
                                max_num_teams);
 
+  /* Config-sized pWrk comes from the heap as teams are split */
+  team_scratch.init(heap.get_local_heap_base());
+
   /**
    * Initialize the sync arrays in the pool with default values.
    */
@@ -463,6 +485,7 @@ void GPUIBBackend::teams_destroy() {
   rocshmem_free(alltoall_pSync_pool);
   rocshmem_free(pWrk_pool);
   rocshmem_free(pAta_pool);
+  free_team_scratch();
 
   free(pool_bitmask_);
   free(reduced_bitmask_);
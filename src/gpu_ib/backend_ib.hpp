@@ -72,6 +72,7 @@ class GPUIBBackend : public Backend {
   void create_new_team(Team *parent_team, TeamInfo *team_info_wrt_parent,
                        TeamInfo *team_info_wrt_world, int num_pes,
                        int my_pe_in_new_team, MPI_Comm team_comm,
+                       const rocshmem_team_config_t &config,
                        rocshmem_team_t *new_team) override;
 
   /**
@@ -79,6 +80,19 @@ class GPUIBBackend : public Backend {
    */
   void team_destroy(rocshmem_team_t team) override;
 
+  /**
+   * @copydoc Backend::team_scratch_bytes
+   */
+  size_t team_scratch_bytes(const rocshmem_team_config_t &config,
+                            int num_pes) const override;
+
+  /**
+   * @copydoc Backend::get_max_num_contexts
+   */
+  size_t get_max_num_contexts() const override {
+    return maximum_num_contexts_;
+  }
+
   /**
    * @copydoc Backend::ctx_create
    */
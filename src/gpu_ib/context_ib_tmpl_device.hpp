@@ -185,6 +185,15 @@ __device__ void GPUIBContext::to_all(rocshmem_team_t team, T *dest,
   long *p_sync = team_obj->reduce_pSync;
   T *pWrk = reinterpret_cast<T *>(team_obj->pWrk);
 
+  // A pWrk sized from the team config may fit a direct reduce that the
+  // pool-sized default in the legacy path below would have to ring.
+  if (team_obj->pWrk_size >= static_cast<size_t>(num_pes) * nreduce &&
+      ROCSHMEM_REDUCE_SYNC_SIZE >= num_pes) {
+    internal_direct_allreduce<T, Op>(dest, source, nreduce, pe_start,
+                                     log_pe_stride, pe_size, pWrk, p_sync);
+    return;
+  }
+
   to_all<T, Op>(dest, source, nreduce, pe_start, log_pe_stride, pe_size, pWrk,
                 p_sync);
 }
@@ -99,6 +99,17 @@ __host__ void GPUIBHostContext::broadcast(rocshmem_team_t team, T *dest,
   host_interface->broadcast<T>(team, dest, source, nelems, pe_root);
 }
 
+template <typename T>
+__host__ void GPUIBHostContext::alltoallv(rocshmem_team_t team, T *dest,
+                                          const T *source,
+                                          const int *source_counts,
+                                          const int *source_displs,
+                                          const int *dest_counts,
+                                          const int *dest_displs) {
+  host_interface->alltoallv<T>(team, dest, source, source_counts,
+                                source_displs, dest_counts, dest_displs);
+}
+
 template <typename T, ROCSHMEM_OP Op>
 __host__ void GPUIBHostContext::to_all(T *dest, const T *source, int nreduce,
                                        int pe_start, int log_pe_stride,
@@ -23,16 +23,19 @@
 #include "gpu_ib_team.hpp"
 
 #include "../backend_type.hpp"
+#include "../team_config.hpp"
 #include "backend_ib.hpp"
 
 namespace rocshmem {
 
 GPUIBTeam::GPUIBTeam(Backend *backend, TeamInfo *team_info_parent,
                      TeamInfo *team_info_world, int num_pes, int my_pe,
-                     MPI_Comm mpi_comm, int pool_index)
+                     MPI_Comm mpi_comm, int pool_index,
+                     const rocshmem_team_config_t &team_config)
     : Team(backend, team_info_parent, team_info_world, num_pes, my_pe,
            mpi_comm) {
   type = BackendType::GPU_IB_BACKEND;
+  config = team_config;
   const GPUIBBackend *b = static_cast<const GPUIBBackend *>(backend);
 
   pool_index_ = pool_index;
@@ -45,10 +48,28 @@ GPUIBTeam::GPUIBTeam(Backend *backend, TeamInfo *team_info_parent,
   alltoall_pSync =
       &(b->alltoall_pSync_pool[pool_index * ROCSHMEM_ALLTOALL_SYNC_SIZE]);
 
-  pWrk = reinterpret_cast<char *>(b->pWrk_pool) +
-         ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE * sizeof(double) * pool_index;
-  pAta = reinterpret_cast<char *>(b->pAta_pool) +
-         ROCSHMEM_ATA_MAX_WRKDATA_SIZE * sizeof(double) * pool_index;
+  /*
+   * A team that announced a large max_reduce_size gets a pWrk big enough
+   * to reduce it in one direct pass. The team pool slot is the fallback.
+   */
+  size_t wrk_bytes{backend->team_scratch_bytes(config, num_pes)};
+  if (wrk_bytes) {
+    pWrk = backend->team_scratch.allocate(wrk_bytes, mpi_comm);
+    if (pWrk) {
+      pWrk_size = wrk_bytes / sizeof(double);
+      pWrk_in_arena = true;
+    }
+  }
+  if (!pWrk) {
+    pWrk = reinterpret_cast<char *>(b->pWrk_pool) +
+           ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE * sizeof(double) * pool_index;
+  }
+
+  if (team_uses(config, ROCSHMEM_TEAM_COLL_ALLTOALL) ||
+      team_uses(config, ROCSHMEM_TEAM_COLL_FCOLLECT)) {
+    pAta = reinterpret_cast<char *>(b->pAta_pool) +
+           ROCSHMEM_ATA_MAX_WRKDATA_SIZE * sizeof(double) * pool_index;
+  }
 }
 
 GPUIBTeam::~GPUIBTeam() {}
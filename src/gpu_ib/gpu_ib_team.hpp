@@ -31,7 +31,8 @@ class GPUIBTeam : public Team {
  public:
   GPUIBTeam(Backend* handle, TeamInfo* team_info_wrt_parent,
             TeamInfo* team_info_wrt_world, int num_pes, int my_pe,
-            MPI_Comm team_comm, int pool_index);
+            MPI_Comm team_comm, int pool_index,
+            const rocshmem_team_config_t& config);
 
   virtual ~GPUIBTeam();
 
@@ -42,6 +43,12 @@ class GPUIBTeam : public Team {
   void* pWrk{nullptr};
   void* pAta{nullptr};
 
+  /* Elements of the largest type that fit in pWrk */
+  size_t pWrk_size{ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE};
+
+  /* pWrk was sized from the team config and lives in the team scratch arena */
+  bool pWrk_in_arena{false};
+
   int pool_index_{-1};
 };
 
@@ -27,6 +27,7 @@
 #include "rocshmem_config.h"  // NOLINT(build/include_subdir)
 #include "host_helpers.hpp"
 #include "../memory/window_info.hpp"
+#include "../mpi_init_singleton.hpp"
 #include "../util.hpp"
 
 namespace rocshmem {
@@ -42,6 +43,11 @@ __host__ HostContextWindowInfo::~HostContextWindowInfo() {
 }
 
 WindowInfo* HostInterface::acquire_window_context() {
+  std::unique_lock<std::mutex> lock{pool_mutex_, std::defer_lock};
+  if (thread_multiple_) {
+    lock.lock();
+  }
+
   auto index{find_avail_pool_entry()};
 
   HostContextWindowInfo* acquired_win_info = host_window_context_pool_[index];
@@ -52,6 +58,11 @@ WindowInfo* HostInterface::acquire_window_context() {
 }
 
 __host__ void HostInterface::release_window_context(WindowInfo* window_info) {
+  std::unique_lock<std::mutex> lock{pool_mutex_, std::defer_lock};
+  if (thread_multiple_) {
+    lock.lock();
+  }
+
   auto index{find_win_info_in_pool(window_info)};
 
   host_window_context_pool_[index]->mark_avail();
@@ -99,6 +110,11 @@ __host__ HostInterface::HostInterface(HdpPolicy* hdp_policy,
    */
   hdp_policy_ = hdp_policy;
 
+  /*
+   * Contexts only come and go concurrently under THREAD_MULTIPLE
+   */
+  thread_multiple_ = MPIInitSingleton::thread_multiple();
+
   /*
    * Allocate and initialize pool of windows for contexts
    */
@@ -35,6 +35,7 @@
 #include <mpi.h>
 
 #include <map>
+#include <mutex>  // NOLINT(build/c++11)
 
 #include "rocshmem/rocshmem.hpp"
 #include "../hdp_policy.hpp"
@@ -201,6 +202,11 @@ class HostInterface {
   __host__ void broadcast(rocshmem_team_t team, T* dest, const T* source,
                           int nelems, int pe_root);
 
+  template <typename T>
+  __host__ void alltoallv(rocshmem_team_t team, T* dest, const T* source,
+                          const int* source_counts, const int* source_displs,
+                          const int* dest_counts, const int* dest_displs);
+
   template <typename T, ROCSHMEM_OP Op>
   __host__ void to_all(T* dest, const T* source, int nreduce, int pe_start,
                        int log_pe_stride, int pe_size, T* p_wrk,
@@ -348,6 +354,16 @@ class HostInterface {
    */
   HostContextWindowInfo** host_window_context_pool_{nullptr};
 
+  /**
+   * @brief Guards the pool when contexts are created from several threads
+   */
+  std::mutex pool_mutex_{};
+
+  /**
+   * @brief Take pool_mutex_ only under ROCSHMEM_THREAD_MULTIPLE
+   */
+  bool thread_multiple_{true};
+
   int find_win_info_in_pool(WindowInfo* window_info);
 
   int find_avail_pool_entry();
@@ -25,6 +25,7 @@
 
 #include "host.hpp"
 #include "../memory/window_info.hpp"
+#include "../traffic_matrix.hpp"
 
 namespace rocshmem {
 
@@ -69,6 +70,8 @@ __host__ inline void HostInterface::initiate_put(void* dest, const void* source,
    */
   hdp_policy_->hdp_flush();
 
+  TrafficMatrix::GetInstance().record(TrafficClass::PUT, pe, nelems);
+
   /* Offload remote write operation to MPI */
   MPI_Put(source, nelems, MPI_CHAR, pe, offset, nelems, MPI_CHAR, win);
 }
@@ -83,6 +86,8 @@ __host__ inline void HostInterface::initiate_get(void* dest, const void* source,
   /* Calculate offset of remote source from base address of window */
   MPI_Aint offset = compute_offset(source, win_start, win_end);
 
+  TrafficMatrix::GetInstance().record(TrafficClass::GET, pe, nelems);
+
   /* Offload remote fetch operation to MPI */
   MPI_Get(dest, nelems, MPI_CHAR, pe, offset, nelems, MPI_CHAR, win);
 }
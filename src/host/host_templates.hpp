@@ -163,6 +163,8 @@ __host__ void HostInterface::broadcast_internal(MPI_Comm mpi_comm, T* dest,
   MPI_Comm_rank(mpi_comm, &active_set_rank);
   if (pe_root == active_set_rank) {
     buffer = const_cast<T*>(source);
+    TrafficMatrix::GetInstance().record_team(TrafficClass::COLL, mpi_comm,
+                                             nelems * sizeof(T));
   } else {
     buffer = const_cast<T*>(dest);
   }
@@ -216,6 +218,30 @@ __host__ void HostInterface::broadcast(rocshmem_team_t team, T* dest,
   return;
 }
 
+template <typename T>
+__host__ void HostInterface::alltoallv(rocshmem_team_t team, T* dest,
+                                       const T* source,
+                                       const int* source_counts,
+                                       const int* source_displs,
+                                       const int* dest_counts,
+                                       const int* dest_displs) {
+  DPRINTF("Function: Team-based host_alltoallv\n");
+
+  Team* team_obj{get_internal_team(team)};
+
+  /*
+   * Flush my HDP so that the NIC does not read stale values
+   */
+  hdp_policy_->hdp_flush();
+
+  TrafficMatrix::GetInstance().record_team(
+      TrafficClass::COLL, team_obj->mpi_comm, source_counts, sizeof(T));
+
+  MPI_Datatype mpi_type{get_mpi_type<T>()};
+  MPI_Alltoallv(source, source_counts, source_displs, mpi_type, dest,
+                dest_counts, dest_displs, mpi_type, team_obj->mpi_comm);
+}
+
 __host__ inline MPI_Op HostInterface::get_mpi_op(ROCSHMEM_OP Op) {
   switch (Op) {
     case ROCSHMEM_SUM:
@@ -295,6 +321,8 @@ __host__ T HostInterface::amo_fetch_add(void* dst, T value, int pe,
    */
   flush_remote_hdp(pe);
 
+  TrafficMatrix::GetInstance().record(TrafficClass::AMO, pe, sizeof(T));
+
   /* Offload remote fetch and op operation to MPI */
   T ret{};
   MPI_Win win{window_info->get_win()};
@@ -319,6 +347,8 @@ __host__ T HostInterface::amo_fetch_cas(void* dst, T value, T cond, int pe,
    */
   flush_remote_hdp(pe);
 
+  TrafficMatrix::GetInstance().record(TrafficClass::AMO, pe, sizeof(T));
+
   /* Offload remote compare and swap operation to MPI */
   T ret{};
   MPI_Win win{window_info->get_win()};
@@ -347,6 +377,9 @@ __host__ void HostInterface::to_all_internal(MPI_Comm mpi_comm, T* dest,
    */
   hdp_policy_->hdp_flush();
 
+  TrafficMatrix::GetInstance().record_team(TrafficClass::COLL, mpi_comm,
+                                           nreduce * sizeof(T));
+
   /*
    * Offload the allreduce to MPI
    */
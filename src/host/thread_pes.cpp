@@ -0,0 +1,138 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "thread_pes.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace rocshmem {
+
+namespace {
+
+/*
+ * Set for the lifetime of each thread started by ThreadPes::run.
+ */
+thread_local ThreadPes* current_world{nullptr};
+
+thread_local int current_pe{-1};
+
+size_t round_up_to_page(size_t size) {
+  size_t page{static_cast<size_t>(sysconf(_SC_PAGESIZE))};
+  return (size + page - 1) / page * page;
+}
+
+char* map_heaps(int num_pes, size_t heap_size) {
+  /*
+   * Reserve address space only; a PE's heap is backed by physical pages
+   * as it is touched, so idle PEs cost nothing beyond the mapping.
+   */
+  void* ptr{mmap(nullptr, num_pes * heap_size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0)};
+  if (ptr == MAP_FAILED) {
+    fprintf(stderr, "ROCSHMEM_ERROR: cannot map %d heaps of %zu bytes\n",
+            num_pes, heap_size);
+    abort();
+  }
+  return static_cast<char*>(ptr);
+}
+
+}  // namespace
+
+ThreadPes::ThreadPes(int num_pes, size_t heap_size)
+    : num_pes_{num_pes},
+      heap_size_{round_up_to_page(heap_size)},
+      base_{map_heaps(num_pes_, heap_size_)},
+      slice_{base_, heap_size_},
+      strat_{&slice_} {}
+
+ThreadPes::~ThreadPes() { munmap(base_, num_pes_ * heap_size_); }
+
+ThreadPes* ThreadPes::current() { return current_world; }
+
+int ThreadPes::my_pe() { return current_pe; }
+
+void ThreadPes::run(void (*fn)(void*), void* arg) {
+  std::vector<std::thread> threads{};
+  threads.reserve(num_pes_);
+  for (int pe{0}; pe < num_pes_; pe++) {
+    threads.emplace_back([this, pe, fn, arg]() {
+      current_world = this;
+      current_pe = pe;
+      fn(arg);
+      current_world = nullptr;
+      current_pe = -1;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+void* ThreadPes::malloc(size_t size) {
+  /*
+   * The offset is published by PE 0 between two barriers; the next
+   * collective call starts with a barrier, so every PE has read it
+   * before PE 0 can overwrite it.
+   */
+  barrier_all();
+  if (my_pe() == 0) {
+    char* ptr{nullptr};
+    strat_.alloc(&ptr, size);
+    malloc_offset_ = ptr ? ptr - base_ : SIZE_MAX;
+  }
+  barrier_all();
+
+  if (malloc_offset_ == SIZE_MAX) {
+    return nullptr;
+  }
+  return base_ + my_pe() * heap_size_ + malloc_offset_;
+}
+
+void ThreadPes::free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  barrier_all();
+  if (my_pe() == 0) {
+    strat_.free(peer_address(ptr, 0));
+  }
+}
+
+void ThreadPes::barrier_all() {
+  unsigned generation{generation_.load(std::memory_order_acquire)};
+  if (arrived_.fetch_add(1, std::memory_order_acq_rel) == num_pes_ - 1) {
+    arrived_.store(0, std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_release);
+    return;
+  }
+  while (generation_.load(std::memory_order_acquire) == generation) {
+    std::this_thread::yield();
+  }
+}
+
+}  // namespace rocshmem
@@ -0,0 +1,421 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_HOST_THREAD_PES_HPP_
+#define LIBRARY_SRC_HOST_THREAD_PES_HPP_
+
+/**
+ * @file thread_pes.hpp
+ * Defines the ThreadPes class.
+ *
+ * Runs several PEs as threads of one process. The symmetric heaps of all
+ * PEs are carved from one anonymous mapping, so a remote access is a plain
+ * load, store or atomic at the peer's copy of the address and the
+ * synchronization primitives reduce to shared-memory counters. No MPI
+ * communicator, window or GPU is involved.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <thread>  // NOLINT
+#include <type_traits>
+#include <vector>
+
+#include "rocshmem/rocshmem.hpp"
+#include "../memory/address_record.hpp"
+#include "../memory/pow2_bins.hpp"
+
+namespace rocshmem {
+
+class ThreadPes {
+  /**
+   * @brief Heap memory type handed to the allocation strategy
+   *
+   * Only describes the first PE's slice of the mapping; the offsets it
+   * hands out are valid in every slice.
+   */
+  class SliceMemory {
+   public:
+    SliceMemory() = default;
+
+    SliceMemory(char* ptr, size_t size) : ptr_{ptr}, size_{size} {}
+
+    char* get_ptr() { return ptr_; }
+
+    size_t get_size() { return size_; }
+
+   private:
+    char* ptr_{nullptr};
+
+    size_t size_{0};
+  };
+
+  /**
+   * @brief Helper type for allocation strategy
+   */
+  using STRAT_T = Pow2Bins<AddressRecord, SliceMemory>;
+
+ public:
+  /**
+   * @brief Primary constructor
+   *
+   * @param[in] num_pes Number of PEs (threads) in the world
+   * @param[in] heap_size Size in bytes of each PE's symmetric heap
+   */
+  ThreadPes(int num_pes, size_t heap_size);
+
+  /**
+   * @brief Destructor
+   */
+  ~ThreadPes();
+
+  ThreadPes(const ThreadPes&) = delete;
+  ThreadPes& operator=(const ThreadPes&) = delete;
+
+  /**
+   * @brief World the calling thread belongs to
+   *
+   * @return nullptr unless called from a thread started by run
+   */
+  static ThreadPes* current();
+
+  /**
+   * @brief Run fn(arg) once on each PE and wait for all of them
+   *
+   * @param[in] fn Function executed by every PE
+   * @param[in] arg Argument passed through to fn
+   */
+  void run(void (*fn)(void*), void* arg);
+
+  int my_pe();
+
+  int n_pes() { return num_pes_; }
+
+  /**************************************************************************
+   ************************** COLLECTIVE MEMORY *****************************
+   *************************************************************************/
+  void* malloc(size_t size);
+
+  void free(void* ptr);
+
+  /**************************************************************************
+   ***************************** HOST FUNCTIONS *****************************
+   *************************************************************************/
+  void putmem(void* dest, const void* source, size_t nelems, int pe) {
+    std::memcpy(peer_address(dest, pe), source, nelems);
+  }
+
+  void getmem(void* dest, const void* source, size_t nelems, int pe) {
+    std::memcpy(dest, peer_address(source, pe), nelems);
+  }
+
+  /*
+   * A copy into another thread's heap is complete when it returns, so the
+   * non-blocking forms need no tracking.
+   */
+  void putmem_nbi(void* dest, const void* source, size_t nelems, int pe) {
+    putmem(dest, source, nelems, pe);
+  }
+
+  void getmem_nbi(void* dest, const void* source, size_t nelems, int pe) {
+    getmem(dest, source, nelems, pe);
+  }
+
+  template <typename T>
+  void put(T* dest, const T* source, size_t nelems, int pe) {
+    putmem(dest, source, nelems * sizeof(T), pe);
+  }
+
+  template <typename T>
+  void get(T* dest, const T* source, size_t nelems, int pe) {
+    getmem(dest, source, nelems * sizeof(T), pe);
+  }
+
+  template <typename T>
+  void put_nbi(T* dest, const T* source, size_t nelems, int pe) {
+    put(dest, source, nelems, pe);
+  }
+
+  template <typename T>
+  void get_nbi(T* dest, const T* source, size_t nelems, int pe) {
+    get(dest, source, nelems, pe);
+  }
+
+  template <typename T>
+  void p(T* dest, T value, int pe) {
+    __atomic_store(remote(dest, pe), &value, __ATOMIC_RELAXED);
+  }
+
+  template <typename T>
+  T g(const T* source, int pe) {
+    T ret{};
+    __atomic_load(remote(source, pe), &ret, __ATOMIC_RELAXED);
+    return ret;
+  }
+
+  template <typename T>
+  T amo_fetch_add(T* dest, T value, int pe) {
+    return __atomic_fetch_add(remote(dest, pe), value, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  T amo_fetch(const T* source, int pe) {
+    T ret{};
+    __atomic_load(remote(source, pe), &ret, __ATOMIC_SEQ_CST);
+    return ret;
+  }
+
+  template <typename T>
+  void amo_add(T* dest, T value, int pe) {
+    amo_fetch_add(dest, value, pe);
+  }
+
+  template <typename T>
+  T amo_fetch_cas(T* dest, T value, T cond, int pe) {
+    __atomic_compare_exchange(remote(dest, pe), &cond, &value, false,
+                              __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return cond;
+  }
+
+  template <typename T>
+  void amo_set(T* dest, T value, int pe) {
+    __atomic_store(remote(dest, pe), &value, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  T amo_swap(T* dest, T value, int pe) {
+    T ret{};
+    __atomic_exchange(remote(dest, pe), &value, &ret, __ATOMIC_SEQ_CST);
+    return ret;
+  }
+
+  template <typename T>
+  T amo_fetch_and(T* dest, T value, int pe) {
+    return __atomic_fetch_and(remote(dest, pe), value, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  void amo_and(T* dest, T value, int pe) {
+    amo_fetch_and(dest, value, pe);
+  }
+
+  template <typename T>
+  T amo_fetch_or(T* dest, T value, int pe) {
+    return __atomic_fetch_or(remote(dest, pe), value, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  void amo_or(T* dest, T value, int pe) {
+    amo_fetch_or(dest, value, pe);
+  }
+
+  template <typename T>
+  T amo_fetch_xor(T* dest, T value, int pe) {
+    return __atomic_fetch_xor(remote(dest, pe), value, __ATOMIC_SEQ_CST);
+  }
+
+  template <typename T>
+  void amo_xor(T* dest, T value, int pe) {
+    amo_fetch_xor(dest, value, pe);
+  }
+
+  void fence() { std::atomic_thread_fence(std::memory_order_seq_cst); }
+
+  void quiet() { std::atomic_thread_fence(std::memory_order_seq_cst); }
+
+  void barrier_all();
+
+  void sync_all() { barrier_all(); }
+
+  /**
+   * @brief Copy nelems from the root's source into every PE's dest
+   */
+  template <typename T>
+  void broadcast(T* dest, const T* source, int nelems, int pe_root) {
+    barrier_all();
+    std::memmove(dest, peer_address(source, pe_root), nelems * sizeof(T));
+    barrier_all();
+  }
+
+  /**
+   * @brief Every PE pulls its blocks, reading where each sits in its
+   * sender's source from the sender's source_displs
+   */
+  template <typename T>
+  void alltoallv(T* dest, const T* source, const int* source_counts,
+                 const int* source_displs, const int* dest_counts,
+                 const int* dest_displs) {
+    int me{my_pe()};
+    barrier_all();
+    for (int pe{0}; pe < num_pes_; pe++) {
+      if (dest_counts[pe] != 0) {
+        const T* block{remote(source, pe) + remote(source_displs, pe)[me]};
+        std::memmove(dest + dest_displs[pe], block,
+                     dest_counts[pe] * sizeof(T));
+      }
+    }
+    barrier_all();
+  }
+
+  /**
+   * @brief Every PE combines all sources itself; no PE writes another's dest
+   */
+  template <typename T, ROCSHMEM_OP Op>
+  int reduce(T* dest, const T* source, int nreduce);
+
+  template <typename T>
+  void wait_until(T* ivar, int cmp, T val) {
+    while (!test(ivar, cmp, val)) {
+      std::this_thread::yield();
+    }
+  }
+
+  template <typename T>
+  int test(T* ivar, int cmp, T val) {
+    T current{};
+    __atomic_load(ivar, &current, __ATOMIC_ACQUIRE);
+    return compare(cmp, current, val);
+  }
+
+ private:
+  /**
+   * @brief Translate a symmetric address to its copy in pe's heap
+   */
+  char* peer_address(const void* addr, int pe) {
+    const char* ptr{static_cast<const char*>(addr)};
+    size_t offset{static_cast<size_t>(ptr - base_) % heap_size_};
+    return base_ + pe * heap_size_ + offset;
+  }
+
+  template <typename T>
+  T* remote(const T* addr, int pe) {
+    return reinterpret_cast<T*>(peer_address(addr, pe));
+  }
+
+  template <typename T>
+  static int compare(int cmp, T input_val, T target_val);
+
+  /**
+   * @brief Number of PEs in the world
+   */
+  int num_pes_{0};
+
+  /**
+   * @brief Size of each PE's slice of the mapping
+   */
+  size_t heap_size_{0};
+
+  /**
+   * @brief Start of the mapping; PE n's heap starts at n * heap_size_
+   */
+  char* base_{nullptr};
+
+  /**
+   * @brief Describes PE 0's slice to the allocation strategy
+   */
+  SliceMemory slice_{};
+
+  /**
+   * @brief Allocation strategy shared by all PEs
+   *
+   * PE 0 drives it during the collective malloc and free calls.
+   */
+  STRAT_T strat_{};
+
+  /**
+   * @brief Offset handed from PE 0 to the other PEs by malloc
+   */
+  size_t malloc_offset_{0};
+
+  /**
+   * @brief Number of PEs that reached the current barrier
+   */
+  std::atomic<int> arrived_{0};
+
+  /**
+   * @brief Bumped by the last PE to reach a barrier; releases the others
+   */
+  std::atomic<unsigned> generation_{0};
+};
+
+template <typename T, ROCSHMEM_OP Op>
+int ThreadPes::reduce(T* dest, const T* source, int nreduce) {
+  /*
+   * Combine into a private buffer first: dest may alias source, and
+   * other PEs keep reading this PE's source until the second barrier.
+   */
+  std::vector<T> result(nreduce);
+  barrier_all();
+  for (int i{0}; i < nreduce; i++) {
+    T acc{*remote(source + i, 0)};
+    for (int pe{1}; pe < num_pes_; pe++) {
+      T val{*remote(source + i, pe)};
+      if constexpr (Op == ROCSHMEM_SUM) {
+        acc += val;
+      } else if constexpr (Op == ROCSHMEM_PROD) {
+        acc *= val;
+      } else if constexpr (Op == ROCSHMEM_MAX) {
+        acc = std::max(acc, val);
+      } else if constexpr (Op == ROCSHMEM_MIN) {
+        acc = std::min(acc, val);
+      } else if constexpr (std::is_integral_v<T> && Op == ROCSHMEM_AND) {
+        acc &= val;
+      } else if constexpr (std::is_integral_v<T> && Op == ROCSHMEM_OR) {
+        acc |= val;
+      } else if constexpr (std::is_integral_v<T> && Op == ROCSHMEM_XOR) {
+        acc ^= val;
+      } else {
+        return ROCSHMEM_ERROR;
+      }
+    }
+    result[i] = acc;
+  }
+  barrier_all();
+  std::copy(result.begin(), result.end(), dest);
+  return ROCSHMEM_SUCCESS;
+}
+
+template <typename T>
+int ThreadPes::compare(int cmp, T input_val, T target_val) {
+  switch (cmp) {
+    case ROCSHMEM_CMP_EQ:
+      return input_val == target_val;
+    case ROCSHMEM_CMP_NE:
+      return input_val != target_val;
+    case ROCSHMEM_CMP_GT:
+      return input_val > target_val;
+    case ROCSHMEM_CMP_GE:
+      return input_val >= target_val;
+    case ROCSHMEM_CMP_LT:
+      return input_val < target_val;
+    case ROCSHMEM_CMP_LE:
+      return input_val <= target_val;
+    default:
+      return 0;
+  }
+}
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_HOST_THREAD_PES_HPP_
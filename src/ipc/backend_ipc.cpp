@@ -22,6 +22,8 @@
 
 #include "backend_ipc.hpp"
 #include "ipc_team.hpp"
+#include "../mpi_init_singleton.hpp"
+#include "../team_config.hpp"
 
 namespace rocshmem {
 
@@ -155,7 +157,8 @@ void IPCBackend::setup_team_world() {
   IPCTeam *team_world{nullptr};
   CHECK_HIP(hipMalloc(&team_world, sizeof(IPCTeam)));
   new (team_world) IPCTeam(this, team_info_wrt_parent, team_info_wrt_world,
-                             num_pes, my_pe, thread_comm, 0);
+                             num_pes, my_pe, thread_comm, 0,
+                             default_team_config());
   team_tracker.set_team_world(team_world);
 
   /**
@@ -170,9 +173,10 @@ void IPCBackend::init_mpi_once(MPI_Comm comm) {
 
   int provided{};
   if (!init_done) {
-    NET_CHECK(MPI_Init_thread(0, 0, MPI_THREAD_MULTIPLE, &provided));
-    if (provided != MPI_THREAD_MULTIPLE) {
-      std::cerr << "MPI_THREAD_MULTIPLE support disabled.\n";
+    int required{MPIInitSingleton::mpi_thread_level()};
+    NET_CHECK(MPI_Init_thread(0, 0, required, &provided));
+    if (provided < required) {
+      std::cerr << "Requested MPI thread level not supported.\n";
     }
   }
   if (comm == MPI_COMM_NULL) comm = MPI_COMM_WORLD;
@@ -190,14 +194,28 @@ void IPCBackend::team_destroy(rocshmem_team_t team) {
   int byte_i = bit / CHAR_BIT;
   pool_bitmask_[byte_i] |= 1 << (bit % CHAR_BIT);
 
+  if (team_obj->pWrk_in_arena) {
+    team_scratch.release(team_obj->pWrk);
+  }
+
   team_obj->~IPCTeam();
-  CHECK_HIP(hipFree(team_obj));
+  team_metadata_pool.release(team_obj, sizeof(IPCTeam));
+}
+
+size_t IPCBackend::team_scratch_bytes(const rocshmem_team_config_t &config,
+                                      int num_pes) const {
+  size_t wrk_elems{team_reduce_scratch_elems(config, num_pes)};
+  if (wrk_elems <= ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE) {
+    return 0;
+  }
+  return wrk_elems * sizeof(double);
 }
 
 void IPCBackend::create_new_team([[maybe_unused]] Team *parent_team,
                                 TeamInfo *team_info_wrt_parent,
                                 TeamInfo *team_info_wrt_world, int num_pes,
                                 int my_pe_in_new_team, MPI_Comm team_comm,
+                                const rocshmem_team_config_t &config,
                                 rocshmem_team_t *new_team) {
   /**
    * Read the bit mask and find out a common index into
@@ -223,11 +241,11 @@ void IPCBackend::create_new_team([[maybe_unused]] Team *parent_team,
    * Allocate device-side memory for team_world and
    * construct a GPU_IB team in it
    */
-  GPUIBTeam *new_team_obj;
-  CHECK_HIP(hipMalloc(&new_team_obj, sizeof(IPCTeam)));
+  auto *new_team_obj{
+      static_cast<GPUIBTeam *>(team_metadata_pool.allocate(sizeof(IPCTeam)))};
   new (new_team_obj)
       IPCTeam(this, team_info_wrt_parent, team_info_wrt_world, num_pes,
-                my_pe_in_new_team, team_comm, common_index);
+                my_pe_in_new_team, team_comm, common_index, config);
 
   *new_team = get_external_team(new_team_obj);
 }
@@ -256,10 +274,16 @@ void IPCBackend::dump_backend_stats() {
 }
 
 void IPCBackend::initIPC() {
+  heap.create_kind_heaps();
+
   const auto &heap_bases{heap.get_heap_bases()};
 
   ipcImpl.ipcHostInit(my_pe, heap_bases,
                       thread_comm);
+
+  for (int h{1}; h < heap.num_heaps(); h++) {
+    ipcImpl.ipcHostAddHeap(heap.get_local_heap_base(h), heap.get_size(h));
+  }
 }
 
 void IPCBackend::global_exit(int status) {
@@ -267,6 +291,7 @@ void IPCBackend::global_exit(int status) {
 }
 
 void IPCBackend::teams_destroy() {
+  free_team_scratch();
   free(pool_bitmask_);
   free(reduced_bitmask_);
 }
@@ -429,6 +454,9 @@ void IPCBackend::teams_init() {
   temp_Wrk_Sync_buff_ptr_ += sizeof(double) * ROCSHMEM_ATA_MAX_WRKDATA_SIZE
                             * max_num_teams;
 
+  /* Config-sized pWrk comes from the heap as teams are split */
+  team_scratch.init(heap.get_local_heap_base());
+
   /**
    * Initialize the sync arrays in the pool with default values.
    */
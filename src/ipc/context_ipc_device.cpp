@@ -41,6 +41,8 @@ __host__ IPCContext::IPCContext(Backend *b)
   IPCBackend *backend{static_cast<IPCBackend *>(b)};
   ipcImpl_.ipc_bases = b->ipcImpl.ipc_bases;
   ipcImpl_.shm_size = b->ipcImpl.shm_size;
+  ipcImpl_.num_extra_heaps = b->ipcImpl.num_extra_heaps;
+  ipcImpl_.extra_heaps = b->ipcImpl.extra_heaps;
 
   barrier_sync = backend->barrier_sync;
   fence_pool = backend->fence_pool;
@@ -61,9 +63,9 @@ __device__ void IPCContext::ctx_destroy(){
 
 __device__ void IPCContext::putmem(void *dest, const void *source, size_t nelems,
                                   int pe) {
-  uint64_t L_offset =
-      reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-  ipcImpl_.ipcCopy(ipcImpl_.ipc_bases[pe] + L_offset,
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
+  ipcImpl_.ipcCopy(remote_addr,
                    const_cast<void *>(source), nelems);
   ipcImpl_.ipcFence();
 }
@@ -71,9 +73,9 @@ __device__ void IPCContext::putmem(void *dest, const void *source, size_t nelems
 __device__ void IPCContext::getmem(void *dest, const void *source, size_t nelems,
                                   int pe) {
   const char *src_typed = reinterpret_cast<const char *>(source);
-  uint64_t L_offset =
-      const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-  ipcImpl_.ipcCopy(dest, ipcImpl_.ipc_bases[pe] + L_offset, nelems);
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, pe)};
+  ipcImpl_.ipcCopy(dest, remote_addr, nelems);
   ipcImpl_.ipcFence();
 }
 
@@ -108,9 +110,9 @@ __device__ void *IPCContext::shmem_ptr(const void *dest, int pe) {
 
 __device__ void IPCContext::putmem_wg(void *dest, const void *source,
                                      size_t nelems, int pe) {
-  uint64_t L_offset =
-      reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-  ipcImpl_.ipcCopy_wg(ipcImpl_.ipc_bases[pe] + L_offset,
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
+  ipcImpl_.ipcCopy_wg(remote_addr,
                       const_cast<void *>(source), nelems);
   __syncthreads();
 }
@@ -118,9 +120,9 @@ __device__ void IPCContext::putmem_wg(void *dest, const void *source,
 __device__ void IPCContext::getmem_wg(void *dest, const void *source,
                                      size_t nelems, int pe) {
   const char *src_typed = reinterpret_cast<const char *>(source);
-  uint64_t L_offset =
-      const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-  ipcImpl_.ipcCopy_wg(dest, ipcImpl_.ipc_bases[pe] + L_offset, nelems);
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, pe)};
+  ipcImpl_.ipcCopy_wg(dest, remote_addr, nelems);
   __syncthreads();
 }
 
@@ -136,9 +138,9 @@ __device__ void IPCContext::getmem_nbi_wg(void *dest, const void *source,
 
 __device__ void IPCContext::putmem_wave(void *dest, const void *source,
                                        size_t nelems, int pe) {
-  uint64_t L_offset =
-      reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-  ipcImpl_.ipcCopy_wave(ipcImpl_.ipc_bases[pe] + L_offset,
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
+  ipcImpl_.ipcCopy_wave(remote_addr,
                         const_cast<void *>(source), nelems);
   ipcImpl_.ipcFence();
 }
@@ -146,9 +148,9 @@ __device__ void IPCContext::putmem_wave(void *dest, const void *source,
 __device__ void IPCContext::getmem_wave(void *dest, const void *source,
                                        size_t nelems, int pe) {
   const char *src_typed = reinterpret_cast<const char *>(source);
-  uint64_t L_offset =
-      const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-  ipcImpl_.ipcCopy_wave(dest, ipcImpl_.ipc_bases[pe] + L_offset,
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, pe)};
+  ipcImpl_.ipcCopy_wave(dest, remote_addr,
                         nelems);
   ipcImpl_.ipcFence();
 }
@@ -190,6 +192,17 @@ __device__ void IPCContext::internal_putmem_wg(void *dest, const void *source,
   __syncthreads();
 }
 
+__device__ void IPCContext::internal_put_pwrk_wg(IPCTeam *team_obj,
+                                                 void *dest,
+                                                 const void *source,
+                                                 size_t nelems, int pe) {
+  if (team_obj->pWrk_in_arena) {
+    putmem_wg(dest, source, nelems, pe);
+  } else {
+    internal_putmem_wg(dest, source, nelems, pe);
+  }
+}
+
 __device__ void IPCContext::internal_getmem_wg(void *dest, const void *source,
                                      size_t nelems, int pe) {
   const char *src_typed = reinterpret_cast<const char *>(source);
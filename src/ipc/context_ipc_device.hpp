@@ -25,6 +25,7 @@
 
 #include "../context.hpp"
 #include "../atomic.hpp"
+#include "../coll_schedule.hpp"
 #include "../team.hpp"
 
 namespace rocshmem {
@@ -231,6 +232,10 @@ class IPCContext : public Context {
   __device__ void fcollect_linear(rocshmem_team_t team, T *dest,
                                   const T *source, int nelems);
 
+  template <typename T>
+  __device__ void fcollect_scheduled(rocshmem_team_t team, T *dest,
+                                     const T *source, int nelems);
+
   template <typename T>
   __device__ void alltoall_linear(rocshmem_team_t team, T *dest,
                                   const T *source, int nelems);
@@ -252,6 +257,23 @@ class IPCContext : public Context {
                                           int nelems, IPCTeam *team_obj,
 					  int n_seg, int seg_size, int chunk_size);
 
+  template <typename T, ROCSHMEM_OP Op>
+  __device__ void internal_scheduled_allreduce(T *dst, const T *src,
+                                               int nelems, IPCTeam *team_obj);
+
+  template <typename T, ROCSHMEM_OP Op>
+  __device__ void internal_schedule_segment(T *dst, int chunk_size,
+                                            IPCTeam *team_obj,
+                                            int64_t signal);
+
+  /**
+   * @brief Put the (possibly wrapping) block range of a COPY step from
+   * buf into the same blocks of buf on the step's send_peer.
+   */
+  template <typename T>
+  __device__ void internal_put_blocks(T *buf, const CollSchedule &sched,
+                                      const CollStep &step, int chunk_size);
+
   //internal functions used by collectives routines to write/read to
   //work/sync buffers
   __device__ void internal_putmem(void *dest, const void *source,
@@ -263,6 +285,11 @@ class IPCContext : public Context {
   __device__ void internal_putmem_wg(void *dest, const void *source,
                                     size_t nelems, int pe);
 
+  // pWrk sized from the team config lives in the symmetric heap instead
+  __device__ void internal_put_pwrk_wg(IPCTeam *team_obj, void *dest,
+                                       const void *source, size_t nelems,
+                                       int pe);
+
   __device__ void internal_getmem_wg(void *dest, const void *source,
                                     size_t nelems, int pe);
 
@@ -24,14 +24,32 @@
 
 #include <mpi.h>
 
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
 #include "rocshmem_config.h"  // NOLINT(build/include_subdir)
 #include "../backend_type.hpp"
 #include "../context_incl.hpp"
 #include "backend_ipc.hpp"
 #include "../host/host.hpp"
+#include "../util.hpp"
 
 namespace rocshmem {
 
+/*
+ * Puts at least this large bypass the host caches. The destination is
+ * device memory across the fabric, so keeping it in the local LLC only
+ * evicts lines the caller still needs.
+ */
+constexpr size_t NT_COPY_THRESHOLD{64 * 1024};
+
 __host__ IPCHostContext::IPCHostContext(Backend *backend,
                                             [[maybe_unused]] int64_t options)
     : Context(backend, true) {
@@ -40,37 +58,126 @@ __host__ IPCHostContext::IPCHostContext(Backend *backend,
   host_interface = b->host_interface;
 
   context_window_info = host_interface->acquire_window_context();
+
+  /*
+   * The IPC policy keeps the peer heap bases in device memory for the
+   * GPU contexts; take a host copy so the CPU can address peers directly.
+   */
+  ipc_bases.resize(b->ipcImpl.shm_size);
+  CHECK_HIP(hipMemcpy(ipc_bases.data(), b->ipcImpl.ipc_bases,
+                      ipc_bases.size() * sizeof(char *),
+                      hipMemcpyDeviceToHost));
+
+  for (int i{0}; i < b->ipcImpl.num_extra_heaps; i++) {
+    IpcHeap heap{};
+    CHECK_HIP(hipMemcpy(&heap, &b->ipcImpl.extra_heaps[i], sizeof(heap),
+                        hipMemcpyDeviceToHost));
+    std::vector<char *> bases(b->ipcImpl.shm_size);
+    CHECK_HIP(hipMemcpy(bases.data(), heap.bases,
+                        bases.size() * sizeof(char *),
+                        hipMemcpyDeviceToHost));
+    extra_heap_bases.push_back(std::move(bases));
+    extra_heap_sizes.push_back(heap.size);
+  }
+
+  char *value{nullptr};
+  if ((value = getenv("ROCSHMEM_IPC_HOST_MPI_RMA")) != nullptr) {
+    use_mpi_rma = atoi(value) != 0;
+  }
 }
 
 __host__ IPCHostContext::~IPCHostContext() {
   host_interface->release_window_context(context_window_info);
 }
 
+__host__ char *IPCHostContext::peer_address(const void *addr, int pe) {
+  const char *ptr{static_cast<const char *>(addr)};
+  for (size_t i{0}; i < extra_heap_bases.size(); i++) {
+    size_t offset{static_cast<size_t>(ptr - extra_heap_bases[i][my_pe])};
+    if (offset < extra_heap_sizes[i]) {
+      return extra_heap_bases[i][pe] + offset;
+    }
+  }
+  size_t offset{static_cast<size_t>(ptr - ipc_bases[my_pe])};
+  return ipc_bases[pe] + offset;
+}
+
+__host__ void IPCHostContext::direct_copy(void *dest, const void *source,
+                                          size_t nelems) {
+#if defined(__SSE2__)
+  if (nelems >= NT_COPY_THRESHOLD) {
+    char *dst{static_cast<char *>(dest)};
+    const char *src{static_cast<const char *>(source)};
+
+    size_t head{(16 - reinterpret_cast<uintptr_t>(dst) % 16) % 16};
+    std::memcpy(dst, src, head);
+    dst += head;
+    src += head;
+    nelems -= head;
+
+    size_t body{nelems & ~static_cast<size_t>(15)};
+    for (size_t i{0}; i < body; i += 16) {
+      __m128i v{_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i))};
+      _mm_stream_si128(reinterpret_cast<__m128i *>(dst + i), v);
+    }
+    std::memcpy(dst + body, src + body, nelems - body);
+
+    // Streaming stores are weakly ordered; drain them before returning.
+    _mm_sfence();
+    return;
+  }
+#endif
+  std::memcpy(dest, source, nelems);
+}
+
 __host__ void IPCHostContext::putmem_nbi(void *dest, const void *source,
                                            size_t nelems, int pe) {
-  host_interface->putmem_nbi(dest, source, nelems, pe, context_window_info);
+  if (use_mpi_rma) {
+    host_interface->putmem_nbi(dest, source, nelems, pe, context_window_info);
+    return;
+  }
+  // A direct store is complete locally when it returns.
+  direct_copy(peer_address(dest, pe), source, nelems);
 }
 
 __host__ void IPCHostContext::getmem_nbi(void *dest, const void *source,
                                            size_t nelems, int pe) {
-  host_interface->getmem_nbi(dest, source, nelems, pe, context_window_info);
+  if (use_mpi_rma) {
+    host_interface->getmem_nbi(dest, source, nelems, pe, context_window_info);
+    return;
+  }
+  std::memcpy(dest, peer_address(source, pe), nelems);
 }
 
 __host__ void IPCHostContext::putmem(void *dest, const void *source,
                                        size_t nelems, int pe) {
-  host_interface->putmem(dest, source, nelems, pe, context_window_info);
+  if (use_mpi_rma) {
+    host_interface->putmem(dest, source, nelems, pe, context_window_info);
+    return;
+  }
+  direct_copy(peer_address(dest, pe), source, nelems);
 }
 
 __host__ void IPCHostContext::getmem(void *dest, const void *source,
                                        size_t nelems, int pe) {
-  host_interface->getmem(dest, source, nelems, pe, context_window_info);
+  if (use_mpi_rma) {
+    host_interface->getmem(dest, source, nelems, pe, context_window_info);
+    return;
+  }
+  std::memcpy(dest, peer_address(source, pe), nelems);
 }
 
 __host__ void IPCHostContext::fence() {
+  /*
+   * Order the direct stores ahead of the HDP flushes issued by the host
+   * interface so peers observe them once the fence completes.
+   */
+  std::atomic_thread_fence(std::memory_order_seq_cst);
   host_interface->fence(context_window_info);
 }
 
 __host__ void IPCHostContext::quiet() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
   host_interface->quiet(context_window_info);
 }
 
@@ -23,6 +23,8 @@
 #ifndef LIBRARY_SRC_IPC_CONTEXT_HOST_HPP_
 #define LIBRARY_SRC_IPC_CONTEXT_HOST_HPP_
 
+#include <vector>
+
 #include "../context.hpp"
 
 namespace rocshmem {
@@ -89,6 +91,11 @@ class IPCHostContext : public Context {
   __host__ void broadcast(rocshmem_team_t team, T *dest, const T *source,
                           int nelems, int pe_root);
 
+  template <typename T>
+  __host__ void alltoallv(rocshmem_team_t team, T *dest, const T *source,
+                          const int *source_counts, const int *source_displs,
+                          const int *dest_counts, const int *dest_displs);
+
   template <typename T, ROCSHMEM_OP Op>
   __host__ void to_all(T *dest, const T *source, int nreduce, int pe_start,
                        int log_pe_stride, int pe_size, T *p_wrk,
@@ -135,12 +142,36 @@ class IPCHostContext : public Context {
   template <typename T>
   __host__ int test(T *ivars, int cmp, T val);
 
+ private:
+  /**
+   * @brief Translate a local symmetric heap address into the address of
+   * the same object in the heap of \p pe, as mapped into this process.
+   */
+  __host__ char *peer_address(const void *addr, int pe);
+
+  /**
+   * @brief Copy with non-temporal stores for large transfers.
+   */
+  __host__ void direct_copy(void *dest, const void *source, size_t nelems);
+
  public:
   /* Shared pointer to the backend's host interface */
   std::shared_ptr<HostInterface> host_interface{nullptr};
 
   /* An MPI Window implements a context */
   WindowInfo *context_window_info{nullptr};
+
+  /* Host copy of the peer heap bases mapped by the IPC policy */
+  std::vector<char *> ipc_bases{};
+
+  /* Host copy of the peer bases of each extra (per memory kind) heap */
+  std::vector<std::vector<char *>> extra_heap_bases{};
+
+  /* Size of each extra heap, indexed like extra_heap_bases */
+  std::vector<size_t> extra_heap_sizes{};
+
+  /* Route RMA and atomics through the host interface (MPI) instead */
+  bool use_mpi_rma{false};
 };
 
 }  // namespace rocshmem
@@ -74,18 +74,18 @@ __device__ void IPCContext::get_nbi(T *dest, const T *source, size_t nelems,
 // Atomics
 template <typename T>
 __device__ void IPCContext::amo_add(void *dest, T value, int pe) {
-  uint64_t L_offset =
-      reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
   ipcImpl_.ipcAMOAdd(
-      reinterpret_cast<T *>(ipcImpl_.ipc_bases[pe] + L_offset), value);
+      reinterpret_cast<T *>(remote_addr), value);
 }
 
 template <typename T>
 __device__ void IPCContext::amo_set(void *dest, T value, int pe) {
-  uint64_t L_offset =
-      reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
   ipcImpl_.ipcAMOSet(
-      reinterpret_cast<T *>(ipcImpl_.ipc_bases[pe] + L_offset), value);
+      reinterpret_cast<T *>(remote_addr), value);
 }
 
 template <typename T>
@@ -129,27 +129,27 @@ __device__ void IPCContext::amo_xor(void *dst, T value, int pe) {
 
 template <typename T>
 __device__ void IPCContext::amo_cas(void *dest, T value, T cond, int pe) {
-  uint64_t L_offset =
-      reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
   ipcImpl_.ipcAMOCas(
-      reinterpret_cast<T *>(ipcImpl_.ipc_bases[pe] + L_offset), cond,
+      reinterpret_cast<T *>(remote_addr), cond,
       value);
 }
 
 template <typename T>
 __device__ T IPCContext::amo_fetch_add(void *dest, T value, int pe) {
-  uint64_t L_offset =
-      reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
   return ipcImpl_.ipcAMOFetchAdd(
-      reinterpret_cast<T *>(ipcImpl_.ipc_bases[pe] + L_offset), value);
+      reinterpret_cast<T *>(remote_addr), value);
 }
 
 template <typename T>
 __device__ T IPCContext::amo_fetch_cas(void *dest, T value, T cond, int pe) {
-  uint64_t L_offset =
-      reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
+  char *remote_addr{
+      ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
   return ipcImpl_.ipcAMOFetchCas(
-      reinterpret_cast<T *>(ipcImpl_.ipc_bases[pe] + L_offset), cond,
+      reinterpret_cast<T *>(remote_addr), cond,
       value);
 }
 
@@ -175,6 +175,8 @@ __device__ void IPCContext::internal_direct_allreduce(
 
   int finish = PE_start + stride * PE_size;
   int pe = my_pe;
+  // pWrk holds one slot per team member, not per world PE.
+  int my_slot = team_obj->my_pe;
 
   int wg_id = get_flat_block_id();
   int wg_size = get_flat_block_size();
@@ -187,8 +189,9 @@ __device__ void IPCContext::internal_direct_allreduce(
 
   for (int i = PE_start; i < finish; i += stride) {
     if (i != pe) {
-      internal_putmem_wg(&pWrk[pe * nelems], reinterpret_cast<const void *>(src),
-                    nelems * sizeof(T), i);
+      internal_put_pwrk_wg(team_obj, &pWrk[my_slot * nelems],
+                           reinterpret_cast<const void *>(src),
+                           nelems * sizeof(T), i);
 
       if (is_thread_zero_in_block()) {
         fence();
@@ -208,7 +211,7 @@ __device__ void IPCContext::internal_direct_allreduce(
       }
       __syncthreads();
 
-      T *ptr = &pWrk[i * nelems];
+      T *ptr = &pWrk[((i - PE_start) / stride) * nelems];
       compute_reduce<T, Op>(ptr, dst, nelems, wg_id, wg_size);
       threadfence_system();
     }
@@ -312,9 +315,10 @@ __device__ void IPCContext::internal_ring_allreduce(
       off_send = (((my_pe_in_team + 1 - iter + 2 * PE_size) % PE_size) * chunk_size);
       off_recv = (((my_pe_in_team - iter + 2 * PE_size) % PE_size) * chunk_size);
 
-      internal_putmem_wg(reinterpret_cast<void *>(&pWrk[off_send]),
-                    reinterpret_cast<void *>(&dst[off_send + off_seg]),
-                    chunk_size * sizeof(T), send_pe);
+      internal_put_pwrk_wg(team_obj,
+                           reinterpret_cast<void *>(&pWrk[off_send]),
+                           reinterpret_cast<void *>(&dst[off_send + off_seg]),
+                           chunk_size * sizeof(T), send_pe);
 
       if (is_thread_zero_in_block()) {
         fence();
@@ -358,6 +362,117 @@ __device__ void IPCContext::internal_ring_allreduce(
   __syncthreads();
 }
 
+template <typename T>
+__device__ void IPCContext::internal_put_blocks(T *buf,
+                                                const CollSchedule &sched,
+                                                const CollStep &step,
+                                                int chunk_size) {
+  int first = min(static_cast<int>(step.nblocks),
+                  sched.num_blocks - step.send_block);
+  T *head = &buf[step.send_block * chunk_size];
+  put_nbi_wg(head, head, first * chunk_size, step.send_peer);
+  if (first < step.nblocks) {
+    put_nbi_wg(buf, buf, (step.nblocks - first) * chunk_size, step.send_peer);
+  }
+}
+
+template <typename T, ROCSHMEM_OP Op>
+__device__ void IPCContext::internal_schedule_segment(T *dst, int chunk_size,
+                                                      IPCTeam *team_obj,
+                                                      int64_t signal) {
+  const CollSchedule &sched = team_obj->allreduce_sched;
+  long *pSync = team_obj->reduce_pSync;
+  T *pWrk = reinterpret_cast<T *>(team_obj->pWrk);
+
+  int wg_size = get_flat_block_size();
+  int wg_id = get_flat_block_id();
+
+  for (int i = 0; i < sched.num_steps; i++) {
+    const CollStep &step = sched.steps[i];
+    size_t step_elems = step.nblocks * chunk_size;
+
+    if (step.op == CollStepOp::REDUCE) {
+      internal_put_pwrk_wg(team_obj, &pWrk[step.send_stage * chunk_size],
+                           &dst[step.send_block * chunk_size],
+                           step_elems * sizeof(T), step.send_peer);
+    } else {
+      internal_put_blocks(dst, sched, step, chunk_size);
+    }
+
+    if (is_thread_zero_in_block()) {
+      fence();
+      internal_putmem(&pSync[step.sync_slot], &signal, sizeof(*pSync),
+                      step.send_peer);
+#if defined(__gfx90a__)
+      __threadfence_system();
+#endif /* __gfx90a__ */
+      wait_until(&pSync[step.sync_slot], ROCSHMEM_CMP_GE, signal);
+    }
+    __syncthreads();
+
+    if (step.op == CollStepOp::REDUCE) {
+      compute_reduce<T, Op>(&pWrk[step.recv_stage * chunk_size],
+                            &dst[step.recv_block * chunk_size], step_elems,
+                            wg_id, wg_size);
+    }
+  }
+}
+
+/*
+ * Executes the step table compiled for the team at creation (see
+ * coll_schedule.hpp). The buffer is processed in segments of num_blocks
+ * chunks sized so the scratch blocks fit in pWrk; the tail that does not
+ * fill a block per chunk goes through the direct algorithm.
+ */
+template <typename T, ROCSHMEM_OP Op>
+__device__ void IPCContext::internal_scheduled_allreduce(
+    T *dst, const T *src, int nelems, IPCTeam *team_obj) {
+  const CollSchedule &sched = team_obj->allreduce_sched;
+  long *pSync = team_obj->reduce_pSync;
+
+  int wg_size = get_flat_block_size();
+  int wg_id = get_flat_block_id();
+
+  for (int i = wg_id; i < nelems; i += wg_size) {
+    dst[i] = src[i];
+  }
+  __syncthreads();
+
+  int chunk_size = team_obj->pWrk_size / sched.num_stage_blocks;
+  int seg_size = chunk_size * sched.num_blocks;
+  int offset = 0;
+  // Signals grow per segment so a fast peer's next segment is never lost.
+  int64_t signal = 0;
+
+  for (; offset + seg_size <= nelems; offset += seg_size) {
+    internal_schedule_segment<T, Op>(&dst[offset], chunk_size, team_obj,
+                                     ++signal);
+  }
+
+  int tail_chunk = (nelems - offset) / sched.num_blocks;
+  if (tail_chunk > 0) {
+    internal_schedule_segment<T, Op>(&dst[offset], tail_chunk, team_obj,
+                                     ++signal);
+    offset += tail_chunk * sched.num_blocks;
+  }
+
+  for (int i = wg_id; i < sched.num_steps; i += wg_size) {
+    pSync[sched.steps[i].sync_slot] = ROCSHMEM_SYNC_VALUE;
+  }
+  threadfence_system();
+  __syncthreads();
+
+  // Nobody may signal the next collective before every slot is reset.
+  internal_sync(my_pe, team_obj->tinfo_wrt_world->pe_start,
+                team_obj->tinfo_wrt_world->stride, team_obj->num_pes,
+                team_obj->barrier_pSync);
+
+  if (offset < nelems) {
+    internal_direct_allreduce<T, Op>(&dst[offset], &src[offset],
+                                     nelems - offset, team_obj);
+  }
+}
+
 template <typename T, ROCSHMEM_OP Op>
 __device__ int IPCContext::reduce(rocshmem_team_t team, T *dest,
                                   const T *source, int nreduce) {
@@ -368,14 +483,16 @@ __device__ int IPCContext::reduce(rocshmem_team_t team, T *dest,
   size_t direct_pWrk = PE_size * nreduce;
   size_t direct_pSync = PE_size;
   size_t ring_pSync = 2 * PE_size;
-  size_t provided_pWrk = max(nreduce / 2 + 1, ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE);
+  size_t provided_pWrk = team_obj->pWrk_size;
   size_t provided_pSync = ROCSHMEM_REDUCE_SYNC_SIZE;
 
   if (provided_pWrk >= direct_pWrk && provided_pSync >= direct_pSync) {
     internal_direct_allreduce<T, Op>(dest, source, nreduce, team_obj);
+  } else if (team_obj->allreduce_sched.num_blocks > 0) {
+    internal_scheduled_allreduce<T, Op>(dest, source, nreduce, team_obj);
   } else {
     if (ring_pSync <= ROCSHMEM_REDUCE_SYNC_SIZE) {
-      size_t ring_pWrk = ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE;
+      size_t ring_pWrk = team_obj->pWrk_size;
       // integer division truncating value
       int chunk_size = ring_pWrk / PE_size;
       int seg_size = chunk_size * PE_size;
@@ -503,7 +620,57 @@ __device__ void IPCContext::alltoall_linear(rocshmem_team_t team, T *dst,
 template <typename T>
 __device__ void IPCContext::fcollect(rocshmem_team_t team, T *dst,
 				     const T *src, int nelems) {
-  fcollect_linear(team, dst, src, nelems);
+  IPCTeam *team_obj = reinterpret_cast<IPCTeam *>(team);
+  if (team_obj->allgather_sched.num_blocks > 0) {
+    fcollect_scheduled(team, dst, src, nelems);
+  } else {
+    fcollect_linear(team, dst, src, nelems);
+  }
+}
+
+template <typename T>
+__device__ void IPCContext::fcollect_scheduled(rocshmem_team_t team, T *dst,
+                                               const T *src, int nelems) {
+  IPCTeam *team_obj = reinterpret_cast<IPCTeam *>(team);
+  const CollSchedule &sched = team_obj->allgather_sched;
+  long *pSync = team_obj->reduce_pSync;
+  int64_t signal = 1;
+
+  int wg_size = get_flat_block_size();
+  int wg_id = get_flat_block_id();
+
+  // Place my own block; every step forwards blocks already in dst.
+  T *mine = &dst[team_obj->my_pe * nelems];
+  for (int i = wg_id; i < nelems; i += wg_size) {
+    mine[i] = src[i];
+  }
+  __syncthreads();
+
+  for (int i = 0; i < sched.num_steps; i++) {
+    const CollStep &step = sched.steps[i];
+    internal_put_blocks(dst, sched, step, nelems);
+
+    if (is_thread_zero_in_block()) {
+      fence();
+      internal_putmem(&pSync[step.sync_slot], &signal, sizeof(*pSync),
+                      step.send_peer);
+#if defined(__gfx90a__)
+      __threadfence_system();
+#endif /* __gfx90a__ */
+      wait_until(&pSync[step.sync_slot], ROCSHMEM_CMP_GE, signal);
+    }
+    __syncthreads();
+  }
+
+  for (int i = wg_id; i < sched.num_steps; i += wg_size) {
+    pSync[sched.steps[i].sync_slot] = ROCSHMEM_SYNC_VALUE;
+  }
+  threadfence_system();
+  __syncthreads();
+
+  internal_sync(my_pe, team_obj->tinfo_wrt_world->pe_start,
+                team_obj->tinfo_wrt_world->stride, team_obj->num_pes,
+                team_obj->alltoall_pSync);
 }
 
 template <typename T>
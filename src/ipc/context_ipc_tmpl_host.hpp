@@ -23,6 +23,8 @@
 #ifndef LIBRARY_SRC_IPC_CONTEXT_TMPL_HOST_HPP_
 #define LIBRARY_SRC_IPC_CONTEXT_TMPL_HOST_HPP_
 
+#include <type_traits>
+
 #include "rocshmem_config.h"  // NOLINT(build/include_subdir)
 #include "../host/host_templates.hpp"
 
@@ -30,57 +32,90 @@ namespace rocshmem {
 
 template <typename T>
 __host__ void IPCHostContext::p(T *dest, T value, int pe) {
-  host_interface->p<T>(dest, value, pe, context_window_info);
+  putmem(dest, &value, sizeof(T), pe);
 }
 
 template <typename T>
 __host__ T IPCHostContext::g(const T *source, int pe) {
-  return host_interface->g<T>(source, pe, context_window_info);
+  T ret;
+  getmem(&ret, source, sizeof(T), pe);
+  return ret;
 }
 
 template <typename T>
 __host__ void IPCHostContext::put(T *dest, const T *source, size_t nelems,
                                     int pe) {
-  host_interface->put<T>(dest, source, nelems, pe, context_window_info);
+  putmem(dest, source, nelems * sizeof(T), pe);
 }
 
 template <typename T>
 __host__ void IPCHostContext::get(T *dest, const T *source, size_t nelems,
                                     int pe) {
-  host_interface->get<T>(dest, source, nelems, pe, context_window_info);
+  getmem(dest, source, nelems * sizeof(T), pe);
 }
 
 template <typename T>
 __host__ void IPCHostContext::put_nbi(T *dest, const T *source, size_t nelems,
                                         int pe) {
-  host_interface->put_nbi<T>(dest, source, nelems, pe, context_window_info);
+  putmem_nbi(dest, source, nelems * sizeof(T), pe);
 }
 
 template <typename T>
 __host__ void IPCHostContext::get_nbi(T *dest, const T *source, size_t nelems,
                                         int pe) {
-  host_interface->get_nbi<T>(dest, source, nelems, pe, context_window_info);
+  getmem_nbi(dest, source, nelems * sizeof(T), pe);
 }
 
 template <typename T>
 __host__ void IPCHostContext::amo_add(void *dst, T value, int pe) {
-  host_interface->amo_add(dst, value, pe, context_window_info);
+  if (use_mpi_rma) {
+    host_interface->amo_add(dst, value, pe, context_window_info);
+    return;
+  }
+  amo_fetch_add<T>(dst, value, pe);
 }
 
 template <typename T>
 __host__ void IPCHostContext::amo_cas(void *dst, T value, T cond, int pe) {
-  host_interface->amo_cas(dst, value, cond, pe, context_window_info);
+  if (use_mpi_rma) {
+    host_interface->amo_cas(dst, value, cond, pe, context_window_info);
+    return;
+  }
+  amo_fetch_cas<T>(dst, value, cond, pe);
 }
 
 template <typename T>
 __host__ T IPCHostContext::amo_fetch_add(void *dst, T value, int pe) {
-  return host_interface->amo_fetch_add(dst, value, pe, context_window_info);
+  if (use_mpi_rma) {
+    return host_interface->amo_fetch_add(dst, value, pe, context_window_info);
+  }
+  T *target{reinterpret_cast<T *>(peer_address(dst, pe))};
+  if constexpr (std::is_integral_v<T>) {
+    return __atomic_fetch_add(target, value, __ATOMIC_SEQ_CST);
+  } else {
+    // No native fetch-add for floating point; retry a compare-exchange.
+    T expected;
+    __atomic_load(target, &expected, __ATOMIC_RELAXED);
+    T desired{expected + value};
+    while (!__atomic_compare_exchange(target, &expected, &desired, false,
+                                      __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+      desired = expected + value;
+    }
+    return expected;
+  }
 }
 
 template <typename T>
 __host__ T IPCHostContext::amo_fetch_cas(void *dst, T value, T cond, int pe) {
-  return host_interface->amo_fetch_cas(dst, value, cond, pe,
-                                       context_window_info);
+  if (use_mpi_rma) {
+    return host_interface->amo_fetch_cas(dst, value, cond, pe,
+                                         context_window_info);
+  }
+  T *target{reinterpret_cast<T *>(peer_address(dst, pe))};
+  // On failure the builtin writes the observed value back into cond.
+  __atomic_compare_exchange(target, &cond, &value, false, __ATOMIC_SEQ_CST,
+                            __ATOMIC_SEQ_CST);
+  return cond;
 }
 
 template <typename T>
@@ -99,6 +134,17 @@ __host__ void IPCHostContext::broadcast(rocshmem_team_t team, T *dest,
   host_interface->broadcast<T>(team, dest, source, nelems, pe_root);
 }
 
+template <typename T>
+__host__ void IPCHostContext::alltoallv(rocshmem_team_t team, T *dest,
+                                        const T *source,
+                                        const int *source_counts,
+                                        const int *source_displs,
+                                        const int *dest_counts,
+                                        const int *dest_displs) {
+  host_interface->alltoallv<T>(team, dest, source, source_counts,
+                                source_displs, dest_counts, dest_displs);
+}
+
 template <typename T, ROCSHMEM_OP Op>
 __host__ void IPCHostContext::to_all(T *dest, const T *source, int nreduce,
                                        int pe_start, int log_pe_stride,
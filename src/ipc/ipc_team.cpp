@@ -23,16 +23,49 @@
 #include "ipc_team.hpp"
 
 #include "../backend_type.hpp"
+#include "../team_config.hpp"
+#include "../util.hpp"
 #include "backend_ipc.hpp"
 
 namespace rocshmem {
 
+/*
+ * Copy a compiled schedule into device memory. Schedules that need more
+ * sync slots or scratch blocks than the team pools provide are left
+ * empty (num_blocks == 0) and the collective falls back to its previous
+ * implementation.
+ */
+static void upload_schedule(HostCollSchedule host, const TeamInfo *tinfo,
+                            size_t max_stage_blocks, CollSchedule *sched) {
+  if (static_cast<size_t>(host.num_sync_slots()) > ROCSHMEM_REDUCE_SYNC_SIZE ||
+      static_cast<size_t>(host.num_stage_blocks) > max_stage_blocks) {
+    return;
+  }
+  host.to_world(tinfo->pe_start, tinfo->stride);
+
+  CollStep *steps{nullptr};
+  size_t size{host.steps.size() * sizeof(CollStep)};
+  if (size) {
+    CHECK_HIP(hipMalloc(&steps, size));
+    CHECK_HIP(
+        hipMemcpy(steps, host.steps.data(), size, hipMemcpyHostToDevice));
+  }
+
+  sched->algorithm = host.algorithm;
+  sched->num_blocks = host.num_blocks;
+  sched->num_stage_blocks = host.num_stage_blocks;
+  sched->num_steps = host.steps.size();
+  sched->steps = steps;
+}
+
 IPCTeam::IPCTeam(Backend *backend, TeamInfo *team_info_parent,
                      TeamInfo *team_info_world, int num_pes, int my_pe,
-                     MPI_Comm mpi_comm, int pool_index)
+                     MPI_Comm mpi_comm, int pool_index,
+                     const rocshmem_team_config_t &team_config)
     : Team(backend, team_info_parent, team_info_world, num_pes, my_pe,
            mpi_comm) {
   type = BackendType::IPC_BACKEND;
+  config = team_config;
   const IPCBackend *b = static_cast<const IPCBackend *>(backend);
 
   pool_index_ = pool_index;
@@ -45,12 +78,46 @@ IPCTeam::IPCTeam(Backend *backend, TeamInfo *team_info_parent,
   alltoall_pSync =
       &(b->alltoall_pSync_pool[pool_index * ROCSHMEM_ALLTOALL_SYNC_SIZE]);
 
-  pWrk = reinterpret_cast<char *>(b->pWrk_pool) +
-         ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE * sizeof(double) * pool_index;
-  pAta = reinterpret_cast<char *>(b->pAta_pool) +
-         ROCSHMEM_ATA_MAX_WRKDATA_SIZE * sizeof(double) * pool_index;
+  /*
+   * A team that announced a large max_reduce_size gets a pWrk big enough
+   * to reduce it in one direct pass. The team pool slot is the fallback.
+   */
+  size_t wrk_bytes{backend->team_scratch_bytes(config, num_pes)};
+  if (wrk_bytes) {
+    pWrk = backend->team_scratch.allocate(wrk_bytes, mpi_comm);
+    if (pWrk) {
+      pWrk_size = wrk_bytes / sizeof(double);
+      pWrk_in_arena = true;
+    }
+  }
+  if (!pWrk) {
+    pWrk = reinterpret_cast<char *>(b->pWrk_pool) +
+           ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE * sizeof(double) * pool_index;
+  }
+
+  if (team_uses(config, ROCSHMEM_TEAM_COLL_ALLTOALL) ||
+      team_uses(config, ROCSHMEM_TEAM_COLL_FCOLLECT)) {
+    pAta = reinterpret_cast<char *>(b->pAta_pool) +
+           ROCSHMEM_ATA_MAX_WRKDATA_SIZE * sizeof(double) * pool_index;
+  }
+
+  if (team_uses(config, ROCSHMEM_TEAM_COLL_REDUCE)) {
+    upload_schedule(compile_allreduce(my_pe, num_pes), team_info_world,
+                    pWrk_size, &allreduce_sched);
+  }
+  if (team_uses(config, ROCSHMEM_TEAM_COLL_FCOLLECT)) {
+    upload_schedule(compile_allgather(my_pe, num_pes), team_info_world, 0,
+                    &allgather_sched);
+  }
 }
 
-IPCTeam::~IPCTeam() {}
+IPCTeam::~IPCTeam() {
+  if (allreduce_sched.steps) {
+    CHECK_HIP(hipFree(const_cast<CollStep *>(allreduce_sched.steps)));
+  }
+  if (allgather_sched.steps) {
+    CHECK_HIP(hipFree(const_cast<CollStep *>(allgather_sched.steps)));
+  }
+}
 
 }  // namespace rocshmem
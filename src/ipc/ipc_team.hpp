@@ -23,6 +23,7 @@
 #ifndef LIBRARY_SRC_IPC_TEAM_HPP_
 #define LIBRARY_SRC_IPC_TEAM_HPP_
 
+#include "../coll_schedule.hpp"
 #include "../team.hpp"
 
 namespace rocshmem {
@@ -31,7 +32,8 @@ class IPCTeam : public Team {
  public:
   IPCTeam(Backend* handle, TeamInfo* team_info_wrt_parent,
             TeamInfo* team_info_wrt_world, int num_pes, int my_pe,
-            MPI_Comm team_comm, int pool_index);
+            MPI_Comm team_comm, int pool_index,
+            const rocshmem_team_config_t& config);
 
   virtual ~IPCTeam();
 
@@ -42,6 +44,16 @@ class IPCTeam : public Team {
   void* pWrk{nullptr};
   void* pAta{nullptr};
 
+  /* Elements of the largest type that fit in pWrk */
+  size_t pWrk_size{ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE};
+
+  /* pWrk was sized from the team config and lives in the team scratch arena */
+  bool pWrk_in_arena{false};
+
+  /* Step tables compiled for this team at creation; steps are in world PEs */
+  CollSchedule allreduce_sched{};
+  CollSchedule allgather_sched{};
+
   int pool_index_{-1};
 };
 
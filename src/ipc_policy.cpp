@@ -24,6 +24,8 @@
 
 #include <mpi.h>
 
+#include <cassert>
+
 #include "rocshmem_config.h"  // NOLINT(build/include_subdir)
 #include "backend_bc.hpp"
 #include "context_incl.hpp"
@@ -36,22 +38,28 @@ __host__ void IpcOnImpl::ipcHostInit(int my_pe, const HEAP_BASES_T &heap_bases,
   /*
    * Create an MPI communicator that deals only with local processes.
    */
-  MPI_Comm shmcomm;
   MPI_Comm_split_type(thread_comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
-                      &shmcomm);
+                      &shm_comm);
 
   /*
    * Figure out how many local process there are.
    */
   int Shm_size;
-  MPI_Comm_size(shmcomm, &Shm_size);
+  MPI_Comm_size(shm_comm, &Shm_size);
   shm_size = Shm_size;
 
   /*
    * Figure out how this process' rank among local processes.
    */
-  MPI_Comm_rank(shmcomm, &shm_rank);
+  MPI_Comm_rank(shm_comm, &shm_rank);
+
+  /*
+   * Set member variables used by subsequent method calls.
+   */
+  ipc_bases = ipcOpenBases(heap_bases[my_pe]);
+}
 
+__host__ char **IpcOnImpl::ipcOpenBases(char *local_base) {
   /*
    * Allocate a host-side c-array to hold the IPC handles.
    */
@@ -64,15 +72,14 @@ __host__ void IpcOnImpl::ipcHostInit(int my_pe, const HEAP_BASES_T &heap_bases,
    * heap and store that IPC handle into the host-side c-array which was
    * just allocated.
    */
-  char *base_heap = heap_bases[my_pe];
-  CHECK_HIP(hipIpcGetMemHandle(&vec_ipc_handle[shm_rank], base_heap));
+  CHECK_HIP(hipIpcGetMemHandle(&vec_ipc_handle[shm_rank], local_base));
 
   /*
    * Do an all-to-all exchange with each local processing element to
    * share the symmetric heap IPC handles.
    */
   MPI_Allgather(MPI_IN_PLACE, sizeof(hipIpcMemHandle_t), MPI_CHAR,
-                vec_ipc_handle, sizeof(hipIpcMemHandle_t), MPI_CHAR, shmcomm);
+                vec_ipc_handle, sizeof(hipIpcMemHandle_t), MPI_CHAR, shm_comm);
 
   /*
    * Allocate device-side array to hold the IPC symmetric heap base
@@ -92,23 +99,49 @@ __host__ void IpcOnImpl::ipcHostInit(int my_pe, const HEAP_BASES_T &heap_bases,
       CHECK_HIP(hipIpcOpenMemHandle(ipc_base_uncast, vec_ipc_handle[i],
                                     hipIpcMemLazyEnablePeerAccess));
     } else {
-      ipc_base[i] = base_heap;
+      ipc_base[i] = local_base;
     }
   }
 
-  /*
-   * Set member variables used by subsequent method calls.
-   */
-  ipc_bases = ipc_base;
-
   /*
    * Free the host-side memory used to exchange the symmetric heap base
    * addresses.
    */
   free(vec_ipc_handle);
+
+  return ipc_base;
+}
+
+__host__ void IpcOnImpl::ipcHostAddHeap(char *local_base, size_t size) {
+  assert(num_extra_heaps < MAX_IPC_EXTRA_HEAPS);
+
+  if (!extra_heaps) {
+    CHECK_HIP(hipMalloc(reinterpret_cast<void **>(&extra_heaps),
+                        MAX_IPC_EXTRA_HEAPS * sizeof(IpcHeap)));
+  }
+
+  IpcHeap heap{ipcOpenBases(local_base), size};
+  CHECK_HIP(hipMemcpy(&extra_heaps[num_extra_heaps], &heap, sizeof(heap),
+                      hipMemcpyHostToDevice));
+  num_extra_heaps++;
 }
 
 __host__ void IpcOnImpl::ipcHostStop() {
+  for (int h = 0; h < num_extra_heaps; h++) {
+    IpcHeap heap{};
+    CHECK_HIP(hipMemcpy(&heap, &extra_heaps[h], sizeof(heap),
+                        hipMemcpyDeviceToHost));
+    for (int i = 0; i < shm_size; i++) {
+      if (i != shm_rank) {
+        CHECK_HIP(hipIpcCloseMemHandle(heap.bases[i]));
+      }
+    }
+    CHECK_HIP(hipFree(heap.bases));
+  }
+  if (extra_heaps) {
+    CHECK_HIP(hipFree(extra_heaps));
+  }
+
   for (int i = 0; i < shm_size; i++) {
     if (i != shm_rank) {
       CHECK_HIP(hipIpcCloseMemHandle(ipc_bases[i]));
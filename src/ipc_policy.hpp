@@ -38,6 +38,20 @@ namespace rocshmem {
 class Backend;
 class Context;
 
+/*
+ * IPC mapping of a symmetric heap other than the primary one. The bases
+ * array is indexed like ipc_bases.
+ */
+struct IpcHeap {
+  char **bases{nullptr};
+  size_t size{0};
+};
+
+/*
+ * Extra heaps one process can map; one per non-default memory kind.
+ */
+constexpr int MAX_IPC_EXTRA_HEAPS{2};
+
 class IpcOnImpl {
   using HEAP_BASES_T = std::vector<char *, StdAllocatorHIP<char *>>;
 
@@ -48,11 +62,39 @@ class IpcOnImpl {
 
   char **ipc_bases{nullptr};
 
+  int num_extra_heaps{0};
+
+  IpcHeap *extra_heaps{nullptr};
+
   __host__ void ipcHostInit(int my_pe, const HEAP_BASES_T &heap_bases,
                             MPI_Comm thread_comm);
 
+  /*
+   * Exchange IPC handles for an extra symmetric heap. Collective over the
+   * processes on the node; call after ipcHostInit.
+   */
+  __host__ void ipcHostAddHeap(char *local_base, size_t size);
+
   __host__ void ipcHostStop();
 
+  /*
+   * Address of addr (a local symmetric address) in the heap of the local
+   * process at index pe. Only extra heaps need a range check; everything
+   * else is in the primary heap.
+   */
+  __device__ char *ipcRemotePtr(const void *addr, int my_pe, int pe) {
+    const char *ptr{static_cast<const char *>(addr)};
+    char **bases{ipc_bases};
+    for (int i = 0; i < num_extra_heaps; i++) {
+      if (static_cast<size_t>(ptr - extra_heaps[i].bases[my_pe]) <
+          extra_heaps[i].size) {
+        bases = extra_heaps[i].bases;
+        break;
+      }
+    }
+    return bases[pe] + (ptr - bases[my_pe]);
+  }
+
   __device__ bool isIpcAvailable(int my_pe, int target_pe) {
     return my_pe / shm_size == target_pe / shm_size;
   }
@@ -104,6 +146,15 @@ class IpcOnImpl {
     volatile uint32_t read_value = __hip_atomic_load(
         pe_ipc_base, __ATOMIC_SEQ_CST, __HIP_MEMORY_SCOPE_SYSTEM);
   }
+
+ private:
+  /*
+   * Share the IPC handle of local_base with the node and open the peers'
+   * handles. Returns a device array of the mapped bases.
+   */
+  __host__ char **ipcOpenBases(char *local_base);
+
+  MPI_Comm shm_comm{MPI_COMM_NULL};
 };
 
 // clang-format off
@@ -116,11 +167,21 @@ class IpcOffImpl {
 
   char **ipc_bases{nullptr};
 
+  int num_extra_heaps{0};
+
+  IpcHeap *extra_heaps{nullptr};
+
   __host__ void ipcHostInit(int my_pe, const HEAP_BASES_T &heap_bases,
                             MPI_Comm thread_comm) {}
 
+  __host__ void ipcHostAddHeap(char *local_base, size_t size) {}
+
   __host__ void ipcHostStop() {}
 
+  __device__ char *ipcRemotePtr(const void *addr, int my_pe, int pe) {
+    return nullptr;
+  }
+
   __device__ bool isIpcAvailable(int my_pe, int target_pe) { return false; }
 
   __device__ void ipcGpuInit(Backend *rocshmem_handle, Context *ctx,
@@ -0,0 +1,532 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_MEMORY_DEV_SIZE_CLASSES_HPP_
+#define LIBRARY_SRC_MEMORY_DEV_SIZE_CLASSES_HPP_
+
+#include <cassert>
+#include <cstdint>
+
+#include "shmem_allocator_strategy.hpp"
+#include "../util.hpp"
+
+/**
+ * @file dev_size_classes.hpp
+ *
+ * @brief Contains a size-class allocator strategy for the slab heap.
+ *
+ * The heap is cut into fixed size slabs. Each slab is dedicated to one
+ * power-of-two size class and split into blocks of that size. Freed blocks
+ * go to a per-workgroup cache first and are handed back to a lock-free
+ * shared pool in bulk once the cache is full. Requests larger than a slab
+ * take a run of whole slabs; when freed, the run is recycled as blocks of
+ * the largest class.
+ *
+ * All of the bookkeeping is plain memory plus atomics, so the host and the
+ * device run the same code.
+ */
+
+namespace rocshmem {
+
+template <typename HM_T>
+class DevSizeClasses : public ShmemAllocatorStrategy {
+ public:
+  /**
+   * @brief Smallest block handed out; also the unit of block indices
+   */
+  static constexpr size_t MIN_BLOCK{64};
+
+  /**
+   * @brief Number of size classes: MIN_BLOCK up to SLAB_SIZE
+   */
+  static constexpr unsigned NUM_CLASSES{11};
+
+  /**
+   * @brief Unit in which memory is taken from the heap
+   */
+  static constexpr size_t SLAB_SIZE{MIN_BLOCK << (NUM_CLASSES - 1)};
+
+  /**
+   * @brief Number of caches; workgroups share them round-robin
+   */
+  static constexpr unsigned NUM_CACHES{32};
+
+  /**
+   * @brief Blocks of one class a cache holds before returning half
+   */
+  static constexpr uint32_t CACHE_DEPTH{64};
+
+  /**
+   * @brief Blocks a cache takes from the shared pool at once
+   */
+  static constexpr uint32_t REFILL_BATCH{16};
+
+  /**
+   * @brief Required for default construction of other objects
+   *
+   * @note Not intended for direct usage.
+   */
+  DevSizeClasses() = default;
+
+  /**
+   * @brief Primary constructor type
+   *
+   * Does not touch the heap memory; slab metadata is written as slabs
+   * are carved.
+   *
+   * @param[in] Raw pointer to heap memory type
+   */
+  explicit DevSizeClasses(HM_T* heap_mem) {
+    char* heap_ptr{heap_mem->get_ptr()};
+    char* heap_end{heap_ptr + heap_mem->get_size()};
+
+    /*
+     * The slab table sits at the start of the heap. Slabs start on an
+     * absolute SLAB_SIZE boundary so each block is aligned to its size.
+     */
+    uint32_t max_slabs{
+        static_cast<uint32_t>(heap_mem->get_size() / SLAB_SIZE)};
+    slab_info_ = reinterpret_cast<uint32_t*>(heap_ptr);
+    uintptr_t table_end{reinterpret_cast<uintptr_t>(slab_info_ + max_slabs)};
+    slab_base_ = reinterpret_cast<char*>((table_end + SLAB_SIZE - 1) /
+                                         SLAB_SIZE * SLAB_SIZE);
+    heap_ptr_ = heap_ptr;
+    num_slabs_ = slab_base_ < heap_end
+                     ? static_cast<uint32_t>((heap_end - slab_base_) /
+                                             SLAB_SIZE)
+                     : 0;
+
+    for (unsigned c{0}; c < NUM_CLASSES; c++) {
+      pool_[c] = NIL;
+    }
+  }
+
+  /**
+   * @brief Allocates memory from the heap
+   *
+   * @param[in, out] Address of raw pointer (&pointer_to_char)
+   * @param[in] Size in bytes of memory allocation
+   */
+  void alloc(char** ptr, size_t request_size) override {
+    assert(ptr);
+    *ptr = allocate(request_size, 0);
+  }
+
+  /**
+   * @brief Allocates memory from the heap
+   *
+   * Only the first thread of the workgroup allocates; it uses the cache
+   * that belongs to its workgroup.
+   *
+   * @param[in, out] Address of raw pointer (&pointer_to_char)
+   * @param[in] Size in bytes of memory allocation
+   */
+  __device__ void alloc(char** ptr, size_t request_size) override {
+    if (is_thread_zero_in_block()) {
+      assert(ptr);
+      *ptr = allocate(request_size, get_flat_grid_id());
+    }
+  }
+
+  /**
+   * @brief Frees memory from the heap
+   *
+   * @param[in] Raw pointer to heap memory
+   */
+  __host__ void free(char* ptr) override { release(ptr, 0); }
+
+  /**
+   * @brief Frees memory from the heap
+   *
+   * Collective over the workgroup, like alloc: the first thread frees.
+   *
+   * @param[in] Raw pointer to heap memory
+   */
+  __device__ void free(char* ptr) override {
+    if (is_thread_zero_in_block()) {
+      release(ptr, get_flat_grid_id());
+    }
+  }
+
+  /**
+   * @brief Allocates through a specific cache
+   *
+   * @param[in] Size in bytes of memory allocation
+   * @param[in] Cache index; taken modulo NUM_CACHES
+   *
+   * @return Raw pointer to heap memory or nullptr
+   */
+  __host__ __device__ char* allocate(size_t request_size, unsigned cache) {
+    if (!request_size) {
+      return nullptr;
+    }
+    if (request_size > SLAB_SIZE) {
+      size_t count{(request_size + SLAB_SIZE - 1) / SLAB_SIZE};
+      if (count > num_slabs_) {
+        return nullptr;
+      }
+      uint32_t run{static_cast<uint32_t>(count)};
+      uint32_t slab{carve_slabs(run, LARGE_RUN | run)};
+      return slab == NIL ? nullptr : slab_base_ + slab * SLAB_SIZE;
+    }
+
+    unsigned size_class{class_of(request_size)};
+    Cache* cache_ptr{&caches_[cache % NUM_CACHES]};
+    uint32_t block{NIL};
+    if (try_lock(cache_ptr)) {
+      block = cache_pop(cache_ptr, size_class);
+      unlock(cache_ptr);
+    } else {
+      block = shared_pop(size_class);
+    }
+    return block == NIL ? nullptr : address(block);
+  }
+
+  /**
+   * @brief Frees through a specific cache
+   *
+   * @param[in] Raw pointer to heap memory
+   * @param[in] Cache index; taken modulo NUM_CACHES
+   */
+  __host__ __device__ void release(char* ptr, unsigned cache) {
+    if (!ptr) {
+      return;
+    }
+    uint32_t slab{slab_of(ptr)};
+    uint32_t info{load(&slab_info_[slab])};
+    if (info & LARGE_RUN) {
+      release_run(slab, info & ~LARGE_RUN);
+      return;
+    }
+
+    uint32_t block{index_of(ptr)};
+    Cache* cache_ptr{&caches_[cache % NUM_CACHES]};
+    if (!try_lock(cache_ptr)) {
+      pool_push(info, block, block);
+      return;
+    }
+    store(link(block), cache_ptr->head[info]);
+    cache_ptr->head[info] = block;
+    if (++cache_ptr->count[info] > CACHE_DEPTH) {
+      /*
+       * Hand the most recently freed half back in one push; the blocks
+       * are already chained through the cache's list.
+       */
+      uint32_t first{cache_ptr->head[info]};
+      uint32_t last{first};
+      for (uint32_t i{1}; i < CACHE_DEPTH / 2; i++) {
+        last = load(link(last));
+      }
+      cache_ptr->head[info] = load(link(last));
+      cache_ptr->count[info] -= CACHE_DEPTH / 2;
+      pool_push(info, first, last);
+    }
+    unlock(cache_ptr);
+  }
+
+  /**
+   * @brief Usable size of an allocation
+   *
+   * @param[in] Raw pointer returned by alloc
+   *
+   * @return Size in bytes of the block or slab run behind ptr
+   */
+  __host__ __device__ size_t block_size(const char* ptr) {
+    uint32_t info{load(&slab_info_[slab_of(ptr)])};
+    if (info & LARGE_RUN) {
+      return (info & ~LARGE_RUN) * SLAB_SIZE;
+    }
+    return MIN_BLOCK << info;
+  }
+
+  /**
+   * @brief Amount of heap handed out to slabs, including the slab table
+   *
+   * @return Bytes from the heap base to the end of the last carved slab
+   */
+  __host__ __device__ size_t carved() {
+    return slab_base_ - heap_ptr_ + load(&next_slab_) * SLAB_SIZE;
+  }
+
+ private:
+  /**
+   * @brief Marks a slab table entry as the head of a multi-slab run
+   */
+  static constexpr uint32_t LARGE_RUN{1U << 31};
+
+  /**
+   * @brief Empty list marker
+   */
+  static constexpr uint32_t NIL{UINT32_MAX};
+
+  /**
+   * @brief Number of MIN_BLOCK units in a slab
+   */
+  static constexpr uint32_t SLAB_UNITS{SLAB_SIZE / MIN_BLOCK};
+
+  /**
+   * @brief Per-workgroup cache of free blocks
+   *
+   * Owned by whoever holds the lock; a contended cache is bypassed, not
+   * waited for.
+   */
+  struct Cache {
+    uint32_t lock{0};
+    uint32_t head[NUM_CLASSES]{};
+    uint32_t count[NUM_CLASSES]{};
+    /*
+     * Uncarved part of the slab this cache is splitting for each class.
+     */
+    uint32_t next[NUM_CLASSES]{};
+    uint32_t end[NUM_CLASSES]{};
+  };
+
+  /*
+   * Host and device may share the heap, hence system scope.
+   */
+  template <typename T>
+  __host__ __device__ static T load(T* address) {
+    return __hip_atomic_load(address, __ATOMIC_ACQUIRE,
+                             __HIP_MEMORY_SCOPE_SYSTEM);
+  }
+
+  template <typename T>
+  __host__ __device__ static void store(T* address, T value) {
+    __hip_atomic_store(address, value, __ATOMIC_RELEASE,
+                       __HIP_MEMORY_SCOPE_SYSTEM);
+  }
+
+  template <typename T>
+  __host__ __device__ static bool cas(T* address, T* expected, T desired) {
+    return __hip_atomic_compare_exchange_strong(
+        address, expected, desired, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE,
+        __HIP_MEMORY_SCOPE_SYSTEM);
+  }
+
+  __host__ __device__ static bool try_lock(Cache* cache) {
+    uint32_t expected{0};
+    return cas(&cache->lock, &expected, 1U);
+  }
+
+  __host__ __device__ static void unlock(Cache* cache) {
+    store(&cache->lock, 0U);
+  }
+
+  __host__ __device__ static unsigned class_of(size_t request_size) {
+    unsigned size_class{0};
+    while ((MIN_BLOCK << size_class) < request_size) {
+      size_class++;
+    }
+    return size_class;
+  }
+
+  __host__ __device__ char* address(uint32_t block) {
+    return slab_base_ + static_cast<size_t>(block) * MIN_BLOCK;
+  }
+
+  __host__ __device__ uint32_t index_of(const char* ptr) {
+    return static_cast<uint32_t>((ptr - slab_base_) / MIN_BLOCK);
+  }
+
+  __host__ __device__ uint32_t slab_of(const char* ptr) {
+    return static_cast<uint32_t>((ptr - slab_base_) / SLAB_SIZE);
+  }
+
+  /**
+   * @brief Free blocks are chained through their first word
+   */
+  __host__ __device__ uint32_t* link(uint32_t block) {
+    return reinterpret_cast<uint32_t*>(address(block));
+  }
+
+  /**
+   * @brief Reserve count consecutive slabs and record info for each
+   *
+   * @return First slab of the run or NIL when the heap is exhausted
+   */
+  __host__ __device__ uint32_t carve_slabs(uint32_t count, uint32_t info) {
+    uint32_t first{load(&next_slab_)};
+    do {
+      if (count > num_slabs_ - first) {
+        return NIL;
+      }
+    } while (!cas(&next_slab_, &first, first + count));
+
+    if (info & LARGE_RUN) {
+      store(&slab_info_[first], info);
+    } else {
+      for (uint32_t i{0}; i < count; i++) {
+        store(&slab_info_[first + i], info);
+      }
+    }
+    return first;
+  }
+
+  /**
+   * @brief Push the chain first..last onto a class's shared pool
+   *
+   * The pool head packs an ABA tag in its upper half.
+   */
+  __host__ __device__ void pool_push(unsigned size_class, uint32_t first,
+                                     uint32_t last) {
+    uint64_t* head{&pool_[size_class]};
+    uint64_t old_head{load(head)};
+    uint64_t new_head{};
+    do {
+      store(link(last), static_cast<uint32_t>(old_head));
+      new_head = ((old_head >> 32) + 1) << 32 | first;
+    } while (!cas(head, &old_head, new_head));
+  }
+
+  __host__ __device__ uint32_t pool_pop(unsigned size_class) {
+    uint64_t* head{&pool_[size_class]};
+    uint64_t old_head{load(head)};
+    while (static_cast<uint32_t>(old_head) != NIL) {
+      /*
+       * The block may be popped and rewritten by another thread before
+       * the CAS; the tag makes that CAS fail, so a stale link is harmless.
+       */
+      uint32_t next{load(link(static_cast<uint32_t>(old_head)))};
+      uint64_t new_head{((old_head >> 32) + 1) << 32 | next};
+      if (cas(head, &old_head, new_head)) {
+        return static_cast<uint32_t>(old_head);
+      }
+    }
+    return NIL;
+  }
+
+  /**
+   * @brief Allocation path used when the cache is held by someone else
+   */
+  __host__ __device__ uint32_t shared_pop(unsigned size_class) {
+    uint32_t block{pool_pop(size_class)};
+    if (block != NIL) {
+      return block;
+    }
+    uint32_t slab{carve_slabs(1, size_class)};
+    if (slab == NIL) {
+      return NIL;
+    }
+    /*
+     * Keep the first block and publish the rest of the slab as a chain.
+     */
+    uint32_t stride{1U << size_class};
+    uint32_t first{slab * SLAB_UNITS};
+    uint32_t last{first + SLAB_UNITS - stride};
+    if (first != last) {
+      for (uint32_t b{first + stride}; b < last; b += stride) {
+        store(link(b), b + stride);
+      }
+      pool_push(size_class, first + stride, last);
+    }
+    return first;
+  }
+
+  /**
+   * @brief Allocation path through an owned cache
+   */
+  __host__ __device__ uint32_t cache_pop(Cache* cache, unsigned size_class) {
+    if (!cache->count[size_class]) {
+      for (uint32_t i{0}; i < REFILL_BATCH; i++) {
+        uint32_t block{pool_pop(size_class)};
+        if (block == NIL) {
+          break;
+        }
+        store(link(block), cache->head[size_class]);
+        cache->head[size_class] = block;
+        cache->count[size_class]++;
+      }
+    }
+
+    if (cache->count[size_class]) {
+      uint32_t block{cache->head[size_class]};
+      cache->head[size_class] = load(link(block));
+      cache->count[size_class]--;
+      return block;
+    }
+
+    if (cache->next[size_class] == cache->end[size_class]) {
+      uint32_t slab{carve_slabs(1, size_class)};
+      if (slab == NIL) {
+        return NIL;
+      }
+      cache->next[size_class] = slab * SLAB_UNITS;
+      cache->end[size_class] = cache->next[size_class] + SLAB_UNITS;
+    }
+    uint32_t block{cache->next[size_class]};
+    cache->next[size_class] += 1U << size_class;
+    return block;
+  }
+
+  /**
+   * @brief Recycle a multi-slab run as blocks of the largest class
+   */
+  __host__ __device__ void release_run(uint32_t slab, uint32_t count) {
+    unsigned top{NUM_CLASSES - 1};
+    for (uint32_t i{0}; i < count; i++) {
+      store(&slab_info_[slab + i], static_cast<uint32_t>(top));
+      store(link((slab + i) * SLAB_UNITS), (slab + i + 1) * SLAB_UNITS);
+    }
+    pool_push(top, slab * SLAB_UNITS, (slab + count - 1) * SLAB_UNITS);
+  }
+
+  /**
+   * @brief Start of the heap memory
+   */
+  char* heap_ptr_{nullptr};
+
+  /**
+   * @brief Start of the first slab
+   */
+  char* slab_base_{nullptr};
+
+  /**
+   * @brief Per-slab size class, or LARGE_RUN | length for a run head
+   *
+   * Lives at the start of the heap memory.
+   */
+  uint32_t* slab_info_{nullptr};
+
+  /**
+   * @brief Number of slabs that fit in the heap
+   */
+  uint32_t num_slabs_{0};
+
+  /**
+   * @brief Number of slabs carved so far
+   */
+  uint32_t next_slab_{0};
+
+  /**
+   * @brief Shared free lists, one per class: tag << 32 | head block
+   */
+  uint64_t pool_[NUM_CLASSES]{};
+
+  /**
+   * @brief Per-workgroup caches
+   */
+  Cache caches_[NUM_CACHES]{};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_MEMORY_DEV_SIZE_CLASSES_HPP_
@@ -52,11 +52,20 @@ class HeapMemory {
    *
    * @param[in] User-specified size used as heap size
    */
-  explicit HeapMemory(size_t size) : size_{size} {
+  explicit HeapMemory(size_t size) : HeapMemory(ALLOCATOR{}, size) {}
+
+  /**
+   * @brief Constructor for allocators chosen at runtime
+   *
+   * @param[in] Allocator instance used for the heap memory
+   * @param[in] User-specified size used as heap size
+   */
+  HeapMemory(ALLOCATOR allocator, size_t size)
+      : allocator_{allocator}, size_{size} {
     char* temp;
     allocator_.allocate(reinterpret_cast<void**>(&temp), size_);
     assert(temp);
-    std::unique_ptr<char, Deleter> up{temp};
+    std::unique_ptr<char, Deleter> up{temp, Deleter{allocator_}};
     up_ = std::move(up);
 
     /*
@@ -97,6 +106,10 @@ class HeapMemory {
    */
   class Deleter {
    public:
+    Deleter() = default;
+
+    explicit Deleter(ALLOCATOR a) : a_{a} {}
+
     void operator()(void* x) { a_.deallocate(x); }
 
    private:
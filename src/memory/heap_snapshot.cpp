@@ -0,0 +1,380 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "heap_snapshot.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <thread>  // NOLINT
+
+#include "../constants.hpp"
+#include "../util.hpp"
+
+namespace rocshmem {
+
+namespace {
+
+constexpr uint64_t SNAPSHOT_MAGIC{0x50414e5348534f52};  // "ROSHSNAP"
+
+constexpr uint64_t SNAPSHOT_VERSION{1};
+
+/*
+ * Alignment of every write: satisfies O_DIRECT on common file systems.
+ */
+constexpr size_t SNAPSHOT_ALIGNMENT{4096};
+
+/*
+ * Unit of work handed to a copy thread; also the staging buffer size.
+ */
+constexpr size_t CHUNK_SIZE{16 << 20};
+
+size_t round_up(size_t value, size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+/*
+ * A run of allocated memory, stored contiguously in the file.
+ */
+struct Range {
+  uint64_t heap_offset{0};
+  uint64_t size{0};
+  uint64_t file_offset{0};
+};
+
+std::vector<Range> used_ranges(const HeapImage& heap) {
+  std::vector<AddressRecord> records{heap.proffered};
+  std::sort(records.begin(), records.end(), [](auto a, auto b) {
+    return a.get_address() < b.get_address();
+  });
+
+  std::vector<Range> ranges{};
+  for (auto record : records) {
+    uint64_t offset = record.get_address() - heap.base;
+    if (!ranges.empty() &&
+        ranges.back().heap_offset + ranges.back().size == offset) {
+      ranges.back().size += record.get_size();
+    } else {
+      ranges.push_back({offset, record.get_size(), 0});
+    }
+  }
+  return ranges;
+}
+
+bool pwrite_all(int fd, const char* buf, size_t size, size_t offset) {
+  while (size) {
+    ssize_t written{pwrite(fd, buf, size, offset)};
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    buf += written;
+    offset += written;
+    size -= written;
+  }
+  return true;
+}
+
+/*
+ * Bounds checked cursor over the metadata words at the start of a file.
+ */
+class MetadataReader {
+ public:
+  MetadataReader(const char* map, size_t size)
+      : words_{reinterpret_cast<const uint64_t*>(map)},
+        count_{size / sizeof(uint64_t)} {}
+
+  bool next(uint64_t* value) {
+    if (pos_ >= count_) {
+      return false;
+    }
+    *value = words_[pos_++];
+    return true;
+  }
+
+ private:
+  const uint64_t* words_{nullptr};
+  size_t count_{0};
+  size_t pos_{0};
+};
+
+}  // namespace
+
+HeapSnapshot::HeapSnapshot(int my_pe, int num_pes)
+    : my_pe_{my_pe}, num_pes_{num_pes} {
+  num_threads_ = std::clamp(
+      static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
+  if (auto threads_cstr = getenv("ROCSHMEM_SNAPSHOT_THREADS")) {
+    num_threads_ = std::max(atoi(threads_cstr), 1);
+  }
+}
+
+std::string HeapSnapshot::file_name(const char* path, int pe) {
+  return std::string{path} + ".pe" + std::to_string(pe);
+}
+
+void HeapSnapshot::copy(void* dst, const void* src, size_t size,
+                        bool on_host) {
+  if (on_host) {
+    std::memcpy(dst, src, size);
+    return;
+  }
+  CHECK_HIP(hipMemcpy(dst, src, size, hipMemcpyDefault));
+}
+
+template <typename FN_T>
+bool HeapSnapshot::for_each_chunk(const std::vector<Chunk>& chunks,
+                                  size_t staging_size, FN_T fn) {
+  std::atomic<size_t> next{0};
+  std::atomic<bool> ok{true};
+
+  auto worker = [&]() {
+    char* staging{nullptr};
+    if (staging_size && posix_memalign(reinterpret_cast<void**>(&staging),
+                                       SNAPSHOT_ALIGNMENT, staging_size)) {
+      ok = false;
+      return;
+    }
+    while (ok) {
+      size_t i{next++};
+      if (i >= chunks.size()) {
+        break;
+      }
+      if (!fn(chunks[i], staging)) {
+        ok = false;
+      }
+    }
+    free(staging);
+  };
+
+  int num_threads{static_cast<int>(
+      std::min<size_t>(num_threads_, chunks.size()))};
+  std::vector<std::thread> threads{};
+  for (int t{1}; t < num_threads; t++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return ok;
+}
+
+int HeapSnapshot::write(const std::string& file,
+                        const std::vector<HeapImage>& heaps) {
+  std::vector<std::vector<Range>> heap_ranges{};
+  size_t num_words{6};
+  for (const auto& heap : heaps) {
+    heap_ranges.push_back(used_ranges(heap));
+    num_words += 5 + 2 * heap.free_records.size() +
+                 2 * heap.proffered.size() + 3 * heap_ranges.back().size();
+  }
+
+  /*
+   * Lay out the data section: every range starts on a page so that each
+   * chunk is written with aligned offsets and lengths.
+   */
+  size_t data_offset{
+      round_up(num_words * sizeof(uint64_t), SNAPSHOT_ALIGNMENT)};
+  size_t file_offset{data_offset};
+  std::vector<Chunk> chunks{};
+  for (size_t h{0}; h < heaps.size(); h++) {
+    for (auto& range : heap_ranges[h]) {
+      range.file_offset = file_offset;
+      for (size_t done{0}; done < range.size; done += CHUNK_SIZE) {
+        chunks.push_back({heaps[h].base + range.heap_offset + done,
+                          std::min<size_t>(CHUNK_SIZE, range.size - done),
+                          file_offset + done, heaps[h].on_host});
+      }
+      file_offset += round_up(range.size, SNAPSHOT_ALIGNMENT);
+    }
+  }
+
+  std::vector<uint64_t> words{SNAPSHOT_MAGIC,
+                              SNAPSHOT_VERSION,
+                              static_cast<uint64_t>(num_pes_),
+                              static_cast<uint64_t>(my_pe_),
+                              heaps.size(),
+                              data_offset};
+  for (size_t h{0}; h < heaps.size(); h++) {
+    const auto& heap{heaps[h]};
+    words.insert(words.end(),
+                 {reinterpret_cast<uint64_t>(heap.base), heap.size,
+                  heap.free_records.size(), heap.proffered.size(),
+                  heap_ranges[h].size()});
+    for (const auto* records : {&heap.free_records, &heap.proffered}) {
+      for (auto record : *records) {
+        words.push_back(record.get_address() - heap.base);
+        words.push_back(record.get_size());
+      }
+    }
+    for (const auto& range : heap_ranges[h]) {
+      words.insert(words.end(),
+                   {range.heap_offset, range.size, range.file_offset});
+    }
+  }
+
+  int fd{open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_DIRECT, 0644)};
+  if (fd < 0) {
+    // Some file systems (tmpfs) refuse O_DIRECT.
+    fd = open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  }
+  if (fd < 0) {
+    return -1;
+  }
+
+  char* header{nullptr};
+  if (posix_memalign(reinterpret_cast<void**>(&header), SNAPSHOT_ALIGNMENT,
+                     data_offset)) {
+    close(fd);
+    return -1;
+  }
+  std::memset(header, 0, data_offset);
+  std::memcpy(header, words.data(), words.size() * sizeof(uint64_t));
+  bool ok{pwrite_all(fd, header, data_offset, 0)};
+  free(header);
+
+  /*
+   * Each worker stages its chunks in a private aligned buffer: device
+   * memory cannot be handed to write(), and O_DIRECT wants alignment the
+   * heap does not guarantee.
+   */
+  auto write_chunk = [&](const Chunk& chunk, char* staging) {
+    size_t padded{round_up(chunk.size, SNAPSHOT_ALIGNMENT)};
+    copy(staging, chunk.heap_ptr, chunk.size, chunk.on_host);
+    std::memset(staging + chunk.size, 0, padded - chunk.size);
+    return pwrite_all(fd, staging, padded, chunk.file_offset);
+  };
+
+  ok = ok && for_each_chunk(chunks, CHUNK_SIZE, write_chunk);
+
+  close(fd);
+  return ok ? 0 : -1;
+}
+
+int HeapSnapshot::read(const std::string& file,
+                       std::vector<HeapImage>* heaps) {
+  int fd{open(file.c_str(), O_RDONLY)};
+  if (fd < 0) {
+    return -1;
+  }
+
+  struct stat st {};
+  if (fstat(fd, &st) || st.st_size == 0) {
+    close(fd);
+    return -1;
+  }
+  size_t file_size{static_cast<size_t>(st.st_size)};
+
+  void* map{mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0)};
+  close(fd);
+  if (map == MAP_FAILED) {
+    return -1;
+  }
+  madvise(map, file_size, MADV_SEQUENTIAL);
+  madvise(map, file_size, MADV_WILLNEED);
+  const char* bytes{static_cast<const char*>(map)};
+
+  MetadataReader reader{bytes, file_size};
+  std::vector<Chunk> chunks{};
+
+  auto parse = [&]() {
+    uint64_t magic{}, version{}, num_pes{}, pe{}, num_heaps{}, data_offset{};
+    if (!reader.next(&magic) || !reader.next(&version) ||
+        !reader.next(&num_pes) || !reader.next(&pe) ||
+        !reader.next(&num_heaps) || !reader.next(&data_offset)) {
+      return false;
+    }
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION ||
+        num_pes != static_cast<uint64_t>(num_pes_) ||
+        pe != static_cast<uint64_t>(my_pe_) || num_heaps != heaps->size()) {
+      return false;
+    }
+
+    for (auto& heap : *heaps) {
+      uint64_t base{}, size{}, num_free{}, num_proffered{}, num_ranges{};
+      if (!reader.next(&base) || !reader.next(&size) ||
+          !reader.next(&num_free) || !reader.next(&num_proffered) ||
+          !reader.next(&num_ranges) || size != heap.size) {
+        return false;
+      }
+
+      // The allocator aligns records relative to the address space, so
+      // the offsets only carry over if the bases agree modulo ALIGNMENT.
+      if ((base - reinterpret_cast<uint64_t>(heap.base)) % ALIGNMENT) {
+        return false;
+      }
+
+      for (auto* list : {&heap.free_records, &heap.proffered}) {
+        list->clear();
+        uint64_t count{list == &heap.free_records ? num_free : num_proffered};
+        for (uint64_t i{0}; i < count; i++) {
+          uint64_t offset{}, record_size{};
+          if (!reader.next(&offset) || !reader.next(&record_size) ||
+              offset + record_size > heap.size) {
+            return false;
+          }
+          list->push_back({heap.base + offset, record_size});
+        }
+      }
+
+      for (uint64_t i{0}; i < num_ranges; i++) {
+        Range range{};
+        if (!reader.next(&range.heap_offset) || !reader.next(&range.size) ||
+            !reader.next(&range.file_offset) ||
+            range.heap_offset + range.size > heap.size ||
+            range.file_offset + range.size > file_size) {
+          return false;
+        }
+        for (size_t done{0}; done < range.size; done += CHUNK_SIZE) {
+          chunks.push_back({heap.base + range.heap_offset + done,
+                            std::min<size_t>(CHUNK_SIZE, range.size - done),
+                            range.file_offset + done, heap.on_host});
+        }
+      }
+    }
+    return true;
+  };
+
+  auto read_chunk = [&](const Chunk& chunk, [[maybe_unused]] char* staging) {
+    copy(chunk.heap_ptr, bytes + chunk.file_offset, chunk.size,
+         chunk.on_host);
+    return true;
+  };
+
+  bool ok{parse() && for_each_chunk(chunks, 0, read_chunk)};
+
+  munmap(map, file_size);
+  return ok ? 0 : -1;
+}
+
+}  // namespace rocshmem
@@ -0,0 +1,154 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_MEMORY_HEAP_SNAPSHOT_HPP_
+#define LIBRARY_SRC_MEMORY_HEAP_SNAPSHOT_HPP_
+
+/**
+ * @file heap_snapshot.hpp
+ * Defines the HeapSnapshot class
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "address_record.hpp"
+
+namespace rocshmem {
+
+/**
+ * @brief One symmetric heap of a processing element, as seen by a snapshot
+ */
+struct HeapImage {
+  /**
+   * @brief Local base address and size of the heap
+   */
+  char* base{nullptr};
+  size_t size{0};
+
+  /**
+   * @brief True if the heap is ordinary host memory (USE_HOST_HEAP)
+   */
+  bool on_host{false};
+
+  /**
+   * @brief Allocator state: free records and records handed to the user
+   */
+  std::vector<AddressRecord> free_records{};
+  std::vector<AddressRecord> proffered{};
+};
+
+/**
+ * @class HeapSnapshot heap_snapshot.hpp
+ *
+ * @brief Saves the used parts of a PE's symmetric heaps to a file and
+ * loads them back.
+ *
+ * Only memory handed out by the allocator is written, coalesced into
+ * ranges that each start at a page aligned file offset. Worker threads
+ * copy chunks of the ranges into page aligned staging buffers and write
+ * them with pwrite, through O_DIRECT when the file system allows it, so
+ * the snapshot does not go through the page cache twice. Restoring maps
+ * the file and copies the chunks back in parallel.
+ *
+ * The allocator records are stored as offsets from the heap base. After a
+ * restore every allocation is at the same offset as before; pointers
+ * stored inside the heap remain valid only if the heap is mapped at the
+ * same address.
+ *
+ * Environment override:
+ *  ROCSHMEM_SNAPSHOT_THREADS  number of copy threads (default: up to 8)
+ */
+class HeapSnapshot {
+ public:
+  /**
+   * @brief Primary constructor
+   *
+   * @param[in] PE writing or reading the snapshot
+   * @param[in] Number of PEs in the job
+   */
+  HeapSnapshot(int my_pe, int num_pes);
+
+  /**
+   * @brief Name of the file holding the snapshot of a PE
+   */
+  static std::string file_name(const char* path, int pe);
+
+  /**
+   * @brief Write the allocator state and used memory of the heaps.
+   *
+   * @return 0 on success, -1 on failure
+   */
+  int write(const std::string& file, const std::vector<HeapImage>& heaps);
+
+  /**
+   * @brief Read a snapshot back into the heaps.
+   *
+   * On input every image holds the base, size and location of a live
+   * heap; the heaps must match the ones the snapshot was taken from. On
+   * success the used memory is copied back and the allocator records are
+   * filled in, rebased onto the live heaps.
+   *
+   * @return 0 on success, -1 on failure (the heaps may be partially
+   * overwritten)
+   */
+  int read(const std::string& file, std::vector<HeapImage>* heaps);
+
+ private:
+  /**
+   * @brief A piece of a used range copied by one worker
+   */
+  struct Chunk {
+    char* heap_ptr{nullptr};
+    size_t size{0};
+    size_t file_offset{0};
+    bool on_host{false};
+  };
+
+  /**
+   * @brief Run fn over every chunk on num_threads_ threads
+   *
+   * Each thread passes fn a page aligned staging buffer of staging_size
+   * bytes (nullptr if zero).
+   *
+   * @return false if any call failed
+   */
+  template <typename FN_T>
+  bool for_each_chunk(const std::vector<Chunk>& chunks, size_t staging_size,
+                      FN_T fn);
+
+  /**
+   * @brief Copy between heap memory and host memory
+   */
+  static void copy(void* dst, const void* src, size_t size, bool on_host);
+
+  int my_pe_{-1};
+
+  int num_pes_{0};
+
+  int num_threads_{1};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_MEMORY_HEAP_SNAPSHOT_HPP_
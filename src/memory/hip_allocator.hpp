@@ -82,6 +82,17 @@ class HIPHostAllocator : public MemoryAllocator {
       : MemoryAllocator(hipHostMalloc, hipFree, hipHostMallocCoherent) {}
 };
 
+/**
+ * Pinned host memory placed by the calling thread's NUMA policy rather
+ * than on the node the driver happens to pick.
+ */
+class HIPHostNumaAllocator : public MemoryAllocator {
+ public:
+  HIPHostNumaAllocator()
+      : MemoryAllocator(hipHostMalloc, hipFree,
+                        hipHostMallocCoherent | hipHostMallocNumaUser) {}
+};
+
 class HostAllocator : public MemoryAllocator {
  public:
   HostAllocator() : MemoryAllocator(std::malloc, std::free) {}
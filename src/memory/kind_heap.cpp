@@ -0,0 +1,46 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "kind_heap.hpp"
+
+namespace rocshmem {
+
+KindHeap::KindHeap(MemoryKind kind, MemoryAllocator allocator, size_t size)
+    : kind_{kind}, heap_mem_{allocator, size} {}
+
+void KindHeap::malloc(void** ptr, size_t size) {
+  strat_.alloc(reinterpret_cast<char**>(ptr), size);
+}
+
+void KindHeap::free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+  strat_.free(reinterpret_cast<char*>(ptr));
+}
+
+bool KindHeap::contains(const void* ptr) {
+  auto* p{static_cast<const char*>(ptr)};
+  return p >= get_base_ptr() && p < get_base_ptr() + get_size();
+}
+
+}  // namespace rocshmem
@@ -0,0 +1,137 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_MEMORY_KIND_HEAP_HPP_
+#define LIBRARY_SRC_MEMORY_KIND_HEAP_HPP_
+
+#include "address_record.hpp"
+#include "heap_memory.hpp"
+#include "memory_allocator.hpp"
+#include "memory_kind.hpp"
+#include "pow2_bins.hpp"
+
+/**
+ * @file kind_heap.hpp
+ *
+ * @brief Contains a local heap whose memory kind is chosen at runtime
+ *
+ * The single heap fixes its memory type at build time. A kind heap takes
+ * its allocator as a constructor argument instead, which is what lets a
+ * processing element hold several heaps of different memory kinds.
+ */
+
+namespace rocshmem {
+
+class KindHeap {
+  /**
+   * @brief Helper type for heap memory
+   */
+  using HM_T = HeapMemory<MemoryAllocator>;
+
+  /**
+   * @brief Helper type for allocation strategy
+   */
+  using STRAT_T = Pow2Bins<AddressRecord, HM_T>;
+
+ public:
+  /**
+   * @brief Primary constructor
+   *
+   * @param[in] Memory kind recorded for this heap
+   * @param[in] Allocator providing memory of that kind
+   * @param[in] Size in bytes of the heap
+   */
+  KindHeap(MemoryKind kind, MemoryAllocator allocator, size_t size);
+
+  /**
+   * @brief The allocation strategy keeps pointers into this object.
+   */
+  KindHeap(const KindHeap&) = delete;
+  KindHeap& operator=(const KindHeap&) = delete;
+
+  /**
+   * @brief Allocates memory from the heap
+   *
+   * @param[in,out] A pointer to memory handle
+   * @param[in] Size in bytes of memory allocation
+   */
+  void malloc(void** ptr, size_t size);
+
+  /**
+   * @brief Frees memory from the heap
+   *
+   * @param[in] Raw pointer to heap memory
+   */
+  void free(void* ptr);
+
+  /**
+   * @brief Checks if an address lies in this heap
+   */
+  bool contains(const void* ptr);
+
+  /**
+   * @brief Accessor for heap base ptr
+   */
+  char* get_base_ptr() { return heap_mem_.get_ptr(); }
+
+  /**
+   * @brief Accessor for heap size
+   */
+  size_t get_size() { return heap_mem_.get_size(); }
+
+  /**
+   * @brief Accessor for heap usage
+   */
+  size_t get_used() { return strat_.amount_proffered(); }
+
+  /**
+   * @brief Accessor for the allocation strategy
+   *
+   * @note Used to save and restore heap snapshots
+   */
+  STRAT_T* get_strat() { return &strat_; }
+
+  /**
+   * @brief Accessor for the memory kind
+   */
+  MemoryKind kind() const { return kind_; }
+
+ private:
+  /**
+   * @brief Memory kind of heap_mem_
+   */
+  MemoryKind kind_{MemoryKind::DEFAULT};
+
+  /**
+   * @brief Heap memory object
+   */
+  HM_T heap_mem_;
+
+  /**
+   * @brief Allocation strategy object
+   */
+  STRAT_T strat_{&heap_mem_};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_MEMORY_KIND_HEAP_HPP_
@@ -0,0 +1,76 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "memory_kind.hpp"
+
+#include <cassert>
+
+#include "rocshmem/rocshmem.hpp"
+#include "hip_allocator.hpp"
+
+namespace rocshmem {
+
+MemoryKind memory_kind_for_hints(long hints) {  // NOLINT(runtime/int)
+  if (hints & (ROCSHMEM_MALLOC_ATOMICS_REMOTE | ROCSHMEM_MALLOC_SIGNAL_REMOTE)) {
+    return MemoryKind::FINE_GRAINED;
+  }
+  if (hints & ROCSHMEM_MALLOC_BULK_DATA) {
+    return MemoryKind::COARSE_GRAINED;
+  }
+  return MemoryKind::DEFAULT;
+}
+
+MemoryAllocator memory_kind_allocator(MemoryKind kind) {
+  switch (kind) {
+    case MemoryKind::FINE_GRAINED:
+      return HIPDefaultFinegrainedAllocator{};
+    case MemoryKind::COARSE_GRAINED:
+      return HIPAllocator{};
+    default:
+      assert(false);
+      return MemoryAllocator{};
+  }
+}
+
+const char* memory_kind_size_env(MemoryKind kind) {
+  switch (kind) {
+    case MemoryKind::FINE_GRAINED:
+      return "ROCSHMEM_HEAP_SIZE_FINE";
+    case MemoryKind::COARSE_GRAINED:
+      return "ROCSHMEM_HEAP_SIZE_COARSE";
+    default:
+      return nullptr;
+  }
+}
+
+const char* memory_kind_name(MemoryKind kind) {
+  switch (kind) {
+    case MemoryKind::FINE_GRAINED:
+      return "fine";
+    case MemoryKind::COARSE_GRAINED:
+      return "coarse";
+    default:
+      return "default";
+  }
+}
+
+}  // namespace rocshmem
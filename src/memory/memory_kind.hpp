@@ -0,0 +1,84 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_MEMORY_MEMORY_KIND_HPP_
+#define LIBRARY_SRC_MEMORY_MEMORY_KIND_HPP_
+
+#include <cstddef>
+
+#include "memory_allocator.hpp"
+
+/**
+ * @file memory_kind.hpp
+ *
+ * @brief Memory kinds a symmetric heap can be allocated from
+ *
+ * The primary symmetric heap uses the kind selected at build time
+ * (see heap_type.hpp). Extra heaps of other kinds can be created at
+ * initialization so that allocations can pick memory suited to their use:
+ * fine-grained memory for flags and remote atomics, coarse-grained memory
+ * for data the GPU computes on.
+ */
+
+namespace rocshmem {
+
+enum class MemoryKind {
+  DEFAULT = 0,
+  FINE_GRAINED,
+  COARSE_GRAINED,
+};
+
+/**
+ * @brief Number of MemoryKind values
+ */
+constexpr int NUM_MEMORY_KINDS{3};
+
+/**
+ * @brief Map rocshmem_malloc_with_hints hints to a memory kind.
+ *
+ * Remote atomics and signals need fine-grained memory. Bulk data prefers
+ * coarse-grained memory. Anything else stays on the primary heap.
+ */
+MemoryKind memory_kind_for_hints(long hints);  // NOLINT(runtime/int)
+
+/**
+ * @brief Allocator that provides memory of the given kind.
+ *
+ * @note Not defined for MemoryKind::DEFAULT, whose allocator is a type.
+ */
+MemoryAllocator memory_kind_allocator(MemoryKind kind);
+
+/**
+ * @brief Environment variable holding the heap size for a kind.
+ *
+ * @return nullptr for MemoryKind::DEFAULT (see ROCSHMEM_HEAP_SIZE).
+ */
+const char* memory_kind_size_env(MemoryKind kind);
+
+/**
+ * @brief Printable name of a memory kind.
+ */
+const char* memory_kind_name(MemoryKind kind);
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_MEMORY_MEMORY_KIND_HPP_
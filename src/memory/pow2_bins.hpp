@@ -23,8 +23,10 @@
 #ifndef LIBRARY_SRC_MEMORY_POW2_BINS_HPP_
 #define LIBRARY_SRC_MEMORY_POW2_BINS_HPP_
 
+#include <algorithm>
 #include <cassert>
 #include <map>
+#include <vector>
 
 #include "../constants.hpp"
 #include "bin.hpp"
@@ -64,6 +66,11 @@ class Pow2Bins : public ShmemAllocatorStrategy {
   using PROFFERED_T = std::map<char*, AR_T>;
 
  public:
+  /**
+   * @brief Helper type for lists of address records
+   */
+  using RECORDS_T = std::vector<AR_T>;
+
   /**
    * @brief Required for default construction of other objects
    *
@@ -186,6 +193,63 @@ class Pow2Bins : public ShmemAllocatorStrategy {
    */
   BINS_T* get_bins() { return &bins_; }
 
+  /**
+   * @brief Copy of every free record
+   *
+   * Within a bin, records are listed in the order restore() has to put
+   * them back for the bin to hand them out in the same order again.
+   *
+   * @return free address records
+   */
+  RECORDS_T free_records() {
+    RECORDS_T records{};
+    for (auto& [IGNORE_BIN_SIZE, bin] : bins_) {
+      BIN_T copy{bin};
+      RECORDS_T bin_records{};
+      while (!copy.empty()) {
+        bin_records.push_back(copy.get());
+      }
+      records.insert(records.end(), bin_records.rbegin(), bin_records.rend());
+    }
+    return records;
+  }
+
+  /**
+   * @brief Copy of every record handed over to the user
+   *
+   * @return proffered address records sorted by address
+   */
+  RECORDS_T proffered_records() {
+    RECORDS_T records{};
+    for (auto& [IGNORE_ADDRESS, record] : proffered_) {
+      records.push_back(record);
+    }
+    return records;
+  }
+
+  /**
+   * @brief Replace the allocator state
+   *
+   * Used to restore a heap snapshot. Every record must lie in this heap
+   * and have the size of one of its bins.
+   *
+   * @param[in] free address records, as listed by free_records()
+   * @param[in] proffered address records
+   */
+  void restore(const RECORDS_T& free_records, const RECORDS_T& proffered) {
+    for (auto& [IGNORE_BIN_SIZE, bin] : bins_) {
+      bin = BIN_T{};
+    }
+    proffered_.clear();
+
+    for (auto record : free_records) {
+      emplace_record_in_bin(record);
+    }
+    for (auto record : proffered) {
+      emplace_in_proffered(record);
+    }
+  }
+
  private:
   /**
    * @brief Store address record in appropriate bin
@@ -30,6 +30,7 @@
 #include <vector>
 
 #include "hip_allocator.hpp"
+#include "../mpi_init_singleton.hpp"
 #include "window_info.hpp"
 
 /**
@@ -55,7 +56,8 @@ class CommunicatorMPI {
     MPI_Initialized(&initialized);
     if (!initialized) {
       int provided;
-      MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+      MPI_Init_thread(nullptr, nullptr, MPIInitSingleton::mpi_thread_level(),
+                      &provided);
     }
     MPI_Comm_rank(comm_, &my_pe_);
     MPI_Comm_size(comm_, &num_pes_);
@@ -145,6 +145,13 @@ class SingleHeap {
    */
   bool is_managed() { return heap_mem_.is_managed(); }
 
+  /**
+   * @brief Accessor for the allocation strategy
+   *
+   * @note Used to save and restore heap snapshots
+   */
+  STRAT_T* get_strat() { return &strat_; }
+
  private:
   /**
    * @brief Heap memory object
@@ -22,6 +22,7 @@
 
 #include "slab_heap.hpp"
 
+#include <algorithm>
 #include <sstream>
 
 #include "../util.hpp"
@@ -44,54 +45,18 @@ void SlabHeap::malloc(void** ptr, size_t size) {
 
 __device__ void SlabHeap::malloc(void** ptr, size_t size) {
   /*
-   * Grab the mutex from the proxy object which owns it.
+   * The strategy is lock-free and only the first thread of the block
+   * allocates; the result reaches the other threads through LDS.
    */
-  auto mutex{mutex_.get()};
-
-  /*
-   * Take the ticketed lock.
-   *
-   * The lock is held jointly by all threads in the block.
-   */
-  auto ticket{mutex->lock()};
-
-  /*
-   * Perform allocation and verify it worked.
-   *
-   * Allocation should only be run by only one thread in the
-   * strategy code.
-   */
-  char** ptr_c{reinterpret_cast<char**>(ptr)};
-  strat_.alloc(ptr_c, size);
-  __threadfence();
-
-  /*
-   * The notifier works with uint64_t for the address broadcasts
-   * between threads (as type erasure for the pointer arithmetic).
-   */
-  uint64_t ptr_deref_u64{reinterpret_cast<uint64_t>(*ptr)};
-
-  /*
-   * Notify other threads in block about the allocation result.
-   */
-  auto notifier{notifier_.get()};
-  if (!threadIdx.x) {
-    notifier->store(ptr_deref_u64);
-    notifier->fence();
-  }
+  __shared__ char* block_ptr;
+  strat_.alloc(&block_ptr, size);
   __syncthreads();
-  uint64_t notification_u64{notifier->load()};
+  *ptr = block_ptr;
 
   /*
-   * Write to the ptr parameter (to return it back up the call stack).
+   * Keep the next call from overwriting block_ptr before all have read it.
    */
-  char* read_value_c{reinterpret_cast<char*>(notification_u64)};
-  *ptr_c = read_value_c;
-
-  /*
-   * Release the lock with our ticket number.
-   */
-  mutex->unlock(ticket);
+  __syncthreads();
 }
 
 __host__ __device__ void SlabHeap::free(void* ptr) {
@@ -101,15 +66,52 @@ __host__ __device__ void SlabHeap::free(void* ptr) {
   strat_.free(reinterpret_cast<char*>(ptr));
 }
 
-void* SlabHeap::realloc(void* ptr, size_t size) { return nullptr; }
+void* SlabHeap::realloc(void* ptr, size_t size) {
+  if (!ptr) {
+    void* new_ptr{nullptr};
+    malloc(&new_ptr, size);
+    return new_ptr;
+  }
+  if (!size) {
+    free(ptr);
+    return nullptr;
+  }
+
+  size_t old_size{strat_.block_size(static_cast<char*>(ptr))};
+  if (size <= old_size) {
+    return ptr;
+  }
+
+  void* new_ptr{nullptr};
+  malloc(&new_ptr, size);
+  if (!new_ptr) {
+    return nullptr;
+  }
+  CHECK_HIP(hipMemcpy(new_ptr, ptr, old_size, hipMemcpyDefault));
+  free(ptr);
+  return new_ptr;
+}
 
-void* SlabHeap::malign(size_t alignment, size_t size) { return nullptr; }
+void* SlabHeap::malign(size_t alignment, size_t size) {
+  /*
+   * Every block is aligned to its own power-of-two size and runs of
+   * slabs to the slab size, so asking for at least alignment bytes is
+   * enough.
+   */
+  if (!alignment || (alignment & (alignment - 1)) ||
+      alignment > STRAT_T::SLAB_SIZE) {
+    return nullptr;
+  }
+  void* ptr{nullptr};
+  malloc(&ptr, std::max(size, alignment));
+  return ptr;
+}
 
 char* SlabHeap::get_base_ptr() { return heap_mem_.get_ptr(); }
 
 size_t SlabHeap::get_size() { return heap_mem_.get_size(); }
 
-size_t SlabHeap::get_used() { return strat_.current() - get_base_ptr(); }
+size_t SlabHeap::get_used() { return strat_.carved(); }
 
 size_t SlabHeap::get_avail() { return get_size() - get_used(); }
 
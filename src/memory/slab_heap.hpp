@@ -23,11 +23,10 @@
 #ifndef LIBRARY_SRC_MEMORY_SLAB_HEAP_HPP_
 #define LIBRARY_SRC_MEMORY_SLAB_HEAP_HPP_
 
-#include "dev_mono_linear.hpp"
+#include "dev_size_classes.hpp"
 #include "heap_memory.hpp"
 #include "heap_type.hpp"
-#include "notifier.hpp"
-#include "../sync/abql_block_mutex.hpp"
+#include "../device_proxy.hpp"
 
 /**
  * @file slab_heap.hpp
@@ -43,17 +42,7 @@ class SlabHeap {
   /**
    * @brief Helper type for allocation strategy
    */
-  using STRAT_T = DevMonoLinear<HEAP_T>;
-
-  /**
-   * @brief Helper type for notifier
-   */
-  using NOTIFIER_PROXY_T = NotifierProxy<HIPAllocator, detail::atomic::memory_scope_workgroup>;
-
-  /**
-   * @brief Helper type for notifier
-   */
-  using MUTEX_PROXY_T = ABQLBlockMutexProxy<HIPAllocator>;
+  using STRAT_T = DevSizeClasses<HEAP_T>;
 
  public:
   /**
@@ -72,6 +61,9 @@ class SlabHeap {
   /**
    * @brief Allocates memory from the heap
    *
+   * Collective over the workgroup: every thread passes the same size and
+   * receives the same pointer.
+   *
    * @param[in,out] A pointer to memory handle
    * @param[in] Size in bytes of memory allocation
    */
@@ -80,27 +72,29 @@ class SlabHeap {
   /**
    * @brief Frees memory from the heap
    *
+   * On the device this is collective over the workgroup, like malloc.
+   *
    * @param[in] Raw pointer to heap memory
    */
   __host__ __device__ void free(void* ptr);
 
   /**
-   * @brief
+   * @brief Resizes an allocation, moving it if its block is too small
    *
-   * @param[in]
-   * @param[in]
+   * @param[in] Raw pointer to heap memory or nullptr
+   * @param[in] Size in bytes of the new allocation
    *
-   * @return
+   * @return Pointer to the resized allocation or nullptr on failure
    */
   void* realloc(void* ptr, size_t size);
 
   /**
-   * @brief
+   * @brief Allocates memory aligned to a power of two
    *
-   * @param[in]
-   * @param[in]
+   * @param[in] Alignment in bytes; at most one slab
+   * @param[in] Size in bytes of memory allocation
    *
-   * @return
+   * @return Pointer to the allocation or nullptr on failure
    */
   void* malign(size_t alignment, size_t size);
 
@@ -121,7 +115,7 @@ class SlabHeap {
   /**
    * @brief Accessor for heap usage
    *
-   * @return Amount of used bytes in heap
+   * @return Amount of bytes carved into slabs; freed blocks stay carved
    */
   size_t get_used();
 
@@ -142,20 +136,6 @@ class SlabHeap {
    * @brief Allocation strategy object
    */
   STRAT_T strat_{&heap_mem_};
-
-  /**
-   * @brief Notifier proxy to share information between threads.
-   *
-   * Need this object to share allocation information between the
-   * leader thread (that does allocation) and the follower threads
-   * (who need the allocation address).
-   */
-  NOTIFIER_PROXY_T notifier_{};
-
-  /**
-   * @brief Mutex to access the heap mutator methods.
-   */
-  MUTEX_PROXY_T mutex_;
 };
 
 template <typename ALLOCATOR>
@@ -0,0 +1,190 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "stream_reader.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace rocshmem {
+
+namespace {
+
+constexpr size_t CACHE_LINE{64};
+
+#if defined(__x86_64__)
+__attribute__((target("avx2")))
+void read_avx2(char *dst, const char *src, size_t bytes) {
+  size_t i{0};
+  for (; i + 32 <= bytes; i += 32) {
+    __m256i v{_mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i))};
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), v);
+  }
+  if (i < bytes) {
+    __m128i v{_mm_load_si128(reinterpret_cast<const __m128i *>(src + i))};
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+  }
+}
+
+void read_sse2(char *dst, const char *src, size_t bytes) {
+  for (size_t i{0}; i < bytes; i += 16) {
+    __m128i v{_mm_load_si128(reinterpret_cast<const __m128i *>(src + i))};
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+  }
+}
+
+/*
+ * Issue all four loads of a line before any store so they share the
+ * streaming load buffer the first one fills.
+ */
+__attribute__((target("sse4.1")))
+void read_stream(char *dst, const char *src, size_t bytes) {
+  size_t i{0};
+  for (; i + CACHE_LINE <= bytes; i += CACHE_LINE) {
+    auto *s{reinterpret_cast<__m128i *>(const_cast<char *>(src + i))};
+    __m128i a{_mm_stream_load_si128(s)};
+    __m128i b{_mm_stream_load_si128(s + 1)};
+    __m128i c{_mm_stream_load_si128(s + 2)};
+    __m128i d{_mm_stream_load_si128(s + 3)};
+    auto *o{reinterpret_cast<__m128i *>(dst + i)};
+    _mm_storeu_si128(o, a);
+    _mm_storeu_si128(o + 1, b);
+    _mm_storeu_si128(o + 2, c);
+    _mm_storeu_si128(o + 3, d);
+  }
+  for (; i < bytes; i += 16) {
+    auto *s{reinterpret_cast<__m128i *>(const_cast<char *>(src + i))};
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                     _mm_stream_load_si128(s));
+  }
+}
+#endif
+
+}  // namespace
+
+StreamReader::StreamReader() {
+  strategy_ = supported(STREAM) ? STREAM : supported(SIMD) ? SIMD : MEMCPY;
+#if defined(__x86_64__)
+  avx2_ = __builtin_cpu_supports("avx2");
+#endif
+
+  char *value{nullptr};
+  if ((value = getenv("RO_NET_QUEUE_READ")) != nullptr) {
+    std::string mode{value};
+    if (mode == "memcpy") {
+      strategy_ = MEMCPY;
+    } else if (mode == "simd" && supported(SIMD)) {
+      strategy_ = SIMD;
+    } else if (mode == "stream" && supported(STREAM)) {
+      strategy_ = STREAM;
+    }
+  }
+}
+
+StreamReader::StreamReader(Strategy strategy)
+    : strategy_{supported(strategy) ? strategy : MEMCPY} {
+#if defined(__x86_64__)
+  avx2_ = __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool StreamReader::supported(Strategy strategy) {
+#if defined(__x86_64__)
+  switch (strategy) {
+    case MEMCPY:
+    case SIMD:
+      // SSE2 is part of x86-64; AVX2 is picked at read time.
+      return true;
+    case STREAM:
+      return __builtin_cpu_supports("sse4.1");
+  }
+  return false;
+#else
+  return strategy == MEMCPY;
+#endif
+}
+
+const char *StreamReader::name(Strategy strategy) {
+  switch (strategy) {
+    case MEMCPY:
+      return "memcpy";
+    case SIMD:
+      return "simd";
+    case STREAM:
+      return "stream";
+  }
+  return "unknown";
+}
+
+void StreamReader::read(void *dst, const void *src, size_t bytes) const {
+  char *out{static_cast<char *>(dst)};
+  const char *in{static_cast<const char *>(src)};
+
+  if (strategy_ == MEMCPY) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    std::memcpy(out, in, bytes);
+    return;
+  }
+
+#if defined(__x86_64__)
+  size_t head{(16 - reinterpret_cast<uintptr_t>(in) % 16) % 16};
+  if (head > bytes) {
+    head = bytes;
+  }
+  size_t body{(bytes - head) & ~static_cast<size_t>(15)};
+
+  // Streaming loads may pass older loads; keep them behind the caller's.
+  _mm_lfence();
+
+  std::memcpy(out, in, head);
+  out += head;
+  in += head;
+
+  if (strategy_ == STREAM) {
+    read_stream(out, in, body);
+  } else if (avx2_) {
+    read_avx2(out, in, body);
+  } else {
+    read_sse2(out, in, body);
+  }
+
+  std::memcpy(out + body, in + body, bytes - head - body);
+#endif
+}
+
+void StreamReader::prefetch(const void *src, size_t bytes) {
+#if defined(__x86_64__)
+  const char *line{static_cast<const char *>(src)};
+  for (size_t i{0}; i < bytes; i += CACHE_LINE) {
+    _mm_prefetch(line + i, _MM_HINT_T0);
+  }
+#endif
+}
+
+}  // namespace rocshmem
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_MEMORY_STREAM_READER_HPP_
+#define LIBRARY_SRC_MEMORY_STREAM_READER_HPP_
+
+/**
+ * @file stream_reader.hpp
+ * Defines the StreamReader class
+ */
+
+#include <cstddef>
+
+namespace rocshmem {
+
+/**
+ * @class StreamReader stream_reader.hpp
+ *
+ * @brief Copies data out of pinned host memory that the GPU writes.
+ *
+ * Scalar loads from uncached or write-combined memory each pay a full
+ * trip to memory. The reader pulls whole cache lines with 16 or 32 byte
+ * loads instead, optionally as non-temporal streaming loads (MOVNTDQA)
+ * which fill a line buffer once per 64 bytes on write-combined memory.
+ *
+ * Environment override:
+ *  RO_NET_QUEUE_READ       memcpy, simd or stream (default: best supported)
+ */
+class StreamReader {
+ public:
+  enum Strategy {
+    /**
+     * @brief Plain memcpy.
+     */
+    MEMCPY,
+    /**
+     * @brief Aligned 32-byte (AVX2) or 16-byte (SSE2) loads.
+     */
+    SIMD,
+    /**
+     * @brief Non-temporal streaming loads (SSE4.1 MOVNTDQA).
+     */
+    STREAM,
+  };
+
+  /**
+   * @brief Use the strategy named by RO_NET_QUEUE_READ, or the best one
+   * the CPU supports.
+   */
+  StreamReader();
+
+  /**
+   * @brief Use the given strategy, or memcpy if the CPU lacks it.
+   */
+  explicit StreamReader(Strategy strategy);
+
+  /**
+   * @brief Copy bytes from src to dst.
+   *
+   * The wide paths cover the 16-byte aligned body of src; any unaligned
+   * head and tail fall back to memcpy. Loads are ordered after every load
+   * the caller made before the call, so a flag observed beforehand covers
+   * the whole copy.
+   */
+  void read(void *dst, const void *src, size_t bytes) const;
+
+  /**
+   * @brief Hint that the cache lines covering src will be read soon.
+   */
+  static void prefetch(const void *src, size_t bytes);
+
+  /**
+   * @brief Whether this CPU can run the strategy.
+   */
+  static bool supported(Strategy strategy);
+
+  /**
+   * @brief Printable name of a strategy.
+   */
+  static const char *name(Strategy strategy);
+
+  Strategy strategy() const { return strategy_; }
+
+ private:
+  Strategy strategy_{MEMCPY};
+
+  /**
+   * @brief Whether the SIMD strategy can use 32-byte loads.
+   */
+  bool avx2_{false};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_MEMORY_STREAM_READER_HPP_
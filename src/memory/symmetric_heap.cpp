@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "symmetric_heap.hpp"
+
+#include <cstdlib>
+#include <sstream>
+
+namespace rocshmem {
+
+void SymmetricHeap::malloc_with_hints(void** ptr, size_t size,
+                                      long hints) {  // NOLINT(runtime/int)
+  int heap_idx{kind_index_[static_cast<int>(memory_kind_for_hints(hints))]};
+  if (!heap_idx) {
+    malloc(ptr, size);
+    return;
+  }
+  extra_heaps_[heap_idx - 1].local->malloc(ptr, size);
+}
+
+void SymmetricHeap::free(void* ptr) {
+  int heap_idx{heap_index(ptr)};
+  if (!heap_idx) {
+    single_heap_.free(ptr);
+    return;
+  }
+  extra_heaps_[heap_idx - 1].local->free(ptr);
+}
+
+void SymmetricHeap::create_kind_heaps() {
+  if (!extra_heaps_.empty()) {
+    return;
+  }
+
+  for (int k{1}; k < NUM_MEMORY_KINDS; k++) {
+    auto kind{static_cast<MemoryKind>(k)};
+
+    size_t heap_size{0};
+    if (auto heap_size_cstr = getenv(memory_kind_size_env(kind))) {
+      std::stringstream sstream(heap_size_cstr);
+      sstream >> heap_size;
+    }
+    if (!heap_size) {
+      continue;
+    }
+
+    ExtraHeap heap{};
+    heap.local = std::make_unique<KindHeap>(
+        kind, memory_kind_allocator(kind), heap_size);
+    heap.remote = std::make_unique<RemoteHeapInfoType>(
+        heap.local->get_base_ptr(), heap.local->get_size());
+    extra_heaps_.push_back(std::move(heap));
+
+    kind_index_[k] = static_cast<int>(extra_heaps_.size());
+  }
+}
+
+std::vector<HeapImage> SymmetricHeap::heap_images() {
+  std::vector<HeapImage> images{};
+
+  HeapImage primary{};
+  primary.base = single_heap_.get_base_ptr();
+  primary.size = single_heap_.get_size();
+#ifdef USE_HOST_HEAP
+  primary.on_host = true;
+#endif
+  images.push_back(primary);
+
+  for (auto& heap : extra_heaps_) {
+    HeapImage image{};
+    image.base = heap.local->get_base_ptr();
+    image.size = heap.local->get_size();
+    images.push_back(image);
+  }
+  return images;
+}
+
+int SymmetricHeap::snapshot(const char* path, int my_pe, int num_pes) {
+  auto images{heap_images()};
+
+  images[0].free_records = single_heap_.get_strat()->free_records();
+  images[0].proffered = single_heap_.get_strat()->proffered_records();
+  for (size_t i{0}; i < extra_heaps_.size(); i++) {
+    auto* strat{extra_heaps_[i].local->get_strat()};
+    images[i + 1].free_records = strat->free_records();
+    images[i + 1].proffered = strat->proffered_records();
+  }
+
+  HeapSnapshot writer{my_pe, num_pes};
+  return writer.write(HeapSnapshot::file_name(path, my_pe), images);
+}
+
+int SymmetricHeap::restore(const char* path, int my_pe, int num_pes) {
+  auto images{heap_images()};
+
+  HeapSnapshot reader{my_pe, num_pes};
+  if (reader.read(HeapSnapshot::file_name(path, my_pe), &images)) {
+    return -1;
+  }
+
+  single_heap_.get_strat()->restore(images[0].free_records,
+                                    images[0].proffered);
+  for (size_t i{0}; i < extra_heaps_.size(); i++) {
+    extra_heaps_[i].local->get_strat()->restore(images[i + 1].free_records,
+                                                images[i + 1].proffered);
+  }
+  return 0;
+}
+
+}  // namespace rocshmem
@@ -38,10 +38,20 @@
  * InfiniBand memory regions. Every memory region has a remote key
  * which needs to be shared across the network (to access the memory
  * region).
+ *
+ * Besides the primary heap, a processing element can hold one extra heap
+ * per memory kind (see memory_kind.hpp). Heap index 0 is always the
+ * primary heap; extra heaps follow in creation order.
  */
 
 #include <hip/hip_runtime_api.h>
 
+#include <memory>
+#include <vector>
+
+#include "heap_snapshot.hpp"
+#include "kind_heap.hpp"
+#include "memory_kind.hpp"
 #include "remote_heap_info.hpp"
 #include "single_heap.hpp"
 
@@ -62,12 +72,96 @@ class SymmetricHeap {
    */
   void malloc(void** ptr, size_t size) { single_heap_.malloc(ptr, size); }
 
+  /**
+   * @brief Allocates from the heap whose memory kind suits the hints
+   *
+   * Falls back to the primary heap when no heap of that kind exists.
+   *
+   * @param[in,out] A pointer to memory handle
+   * @param[in] Number of bytes of requested
+   * @param[in] Bitwise OR of rocshmem_malloc_hints
+   */
+  void malloc_with_hints(void** ptr, size_t size,
+                         long hints);  // NOLINT(runtime/int)
+
   /**
    * @brief Frees previously allocated network visible memory
    *
    * @param[in] Handle of previously allocated memory
    */
-  void free(void* ptr) { single_heap_.free(ptr); }
+  void free(void* ptr);
+
+  /**
+   * @brief Create the extra heaps sized by ROCSHMEM_HEAP_SIZE_<KIND>
+   *
+   * Collective across all processing elements, which must agree on the
+   * sizes. Backends that can address extra heaps call this once during
+   * initialization, before registering the heaps with the network.
+   */
+  void create_kind_heaps();
+
+  /**
+   * @brief Save the used memory and allocator state of every heap
+   *
+   * Writes the file named by HeapSnapshot::file_name(path, my_pe). The
+   * heaps must not be written while the snapshot is taken.
+   *
+   * @return 0 on success, -1 on failure
+   */
+  int snapshot(const char* path, int my_pe, int num_pes);
+
+  /**
+   * @brief Load a snapshot written by snapshot()
+   *
+   * The heaps must have the sizes they had when the snapshot was taken.
+   * Allocations made since then are discarded.
+   *
+   * @return 0 on success, -1 on failure
+   */
+  int restore(const char* path, int my_pe, int num_pes);
+
+  /**
+   * @brief Number of heaps including the primary heap
+   */
+  int num_heaps() { return 1 + static_cast<int>(extra_heaps_.size()); }
+
+  /**
+   * @brief Index of the heap holding an address
+   *
+   * @return 0 (the primary heap) unless the address is in an extra heap
+   */
+  int heap_index(const void* ptr) {
+    for (size_t i{0}; i < extra_heaps_.size(); i++) {
+      if (extra_heaps_[i].local->contains(ptr)) {
+        return static_cast<int>(i) + 1;
+      }
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Accessor for the local base of any heap
+   */
+  __host__ char* get_local_heap_base(int heap_idx) {
+    return heap_idx ? extra_heaps_[heap_idx - 1].local->get_base_ptr()
+                    : get_local_heap_base();
+  }
+
+  /**
+   * @brief Accessor for the size of any heap
+   */
+  size_t get_size(int heap_idx) {
+    return heap_idx ? extra_heaps_[heap_idx - 1].local->get_size()
+                    : single_heap_.get_size();
+  }
+
+  /**
+   * @brief Accessor for the memory kind of any heap
+   */
+  MemoryKind get_kind(int heap_idx) {
+    return heap_idx ? extra_heaps_[heap_idx - 1].local->kind()
+                    : MemoryKind::DEFAULT;
+  }
 
   /**
    * @brief Accessor for local heap base
@@ -111,7 +205,38 @@ class SymmetricHeap {
    */
   bool is_managed() { return single_heap_.is_managed(); }
 
+  /**
+   * @brief Accessor for the heap bases of any heap
+   */
+  __host__ const auto& get_heap_bases(int heap_idx) {
+    return heap_idx ? extra_heaps_[heap_idx - 1].remote->get_heap_bases()
+                    : get_heap_bases();
+  }
+
  private:
+  /**
+   * @brief A heap of a non-default memory kind
+   */
+  struct ExtraHeap {
+    std::unique_ptr<KindHeap> local{};
+    std::unique_ptr<RemoteHeapInfoType> remote{};
+  };
+
+  /**
+   * @brief Snapshot view of every heap, without allocator state
+   */
+  std::vector<HeapImage> heap_images();
+
+  /**
+   * @brief Extra heaps, indexed by heap index minus one
+   */
+  std::vector<ExtraHeap> extra_heaps_{};
+
+  /**
+   * @brief Heap index chosen for each memory kind (0 when absent)
+   */
+  int kind_index_[NUM_MEMORY_KINDS]{};
+
   /**
    * @brief Processing element's implementation of heap
    */
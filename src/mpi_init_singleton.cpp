@@ -22,16 +22,20 @@
 
 #include "mpi_init_singleton.hpp"
 
+#include <algorithm>
+
 namespace rocshmem {
 
 MPIInitSingleton* MPIInitSingleton::instance{nullptr};
 
+int MPIInitSingleton::thread_level_{ROCSHMEM_THREAD_MULTIPLE};
+
 MPIInitSingleton::MPIInitSingleton() {
   MPI_Initialized(&pre_init_done);
 
   if (!pre_init_done) {
     int provided;
-    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+    MPI_Init_thread(nullptr, nullptr, mpi_thread_level(), &provided);
   }
 
   MPI_Comm_size(MPI_COMM_WORLD, &nprocs_);
@@ -58,4 +62,46 @@ int MPIInitSingleton::get_rank() { return my_rank_; }
 
 int MPIInitSingleton::get_nprocs() { return nprocs_; }
 
+void MPIInitSingleton::set_thread_level(int requested) {
+  thread_level_ = std::clamp(requested,
+                             static_cast<int>(ROCSHMEM_THREAD_SINGLE),
+                             static_cast<int>(ROCSHMEM_THREAD_MULTIPLE));
+}
+
+int MPIInitSingleton::get_thread_level() { return thread_level_; }
+
+bool MPIInitSingleton::thread_multiple() {
+  return thread_level_ == ROCSHMEM_THREAD_MULTIPLE;
+}
+
+int MPIInitSingleton::mpi_thread_level() {
+  switch (thread_level_) {
+    case ROCSHMEM_THREAD_SINGLE:
+      return MPI_THREAD_SINGLE;
+    case ROCSHMEM_THREAD_FUNNELED:
+    case ROCSHMEM_THREAD_WG_FUNNELED:
+      /* WG_FUNNELED only means something on the device */
+      return MPI_THREAD_FUNNELED;
+    case ROCSHMEM_THREAD_SERIALIZED:
+      return MPI_THREAD_SERIALIZED;
+    default:
+      return MPI_THREAD_MULTIPLE;
+  }
+}
+
+void MPIInitSingleton::cap_thread_level_to_mpi() {
+  int mpi_provided{MPI_THREAD_MULTIPLE};
+  MPI_Query_thread(&mpi_provided);
+
+  int level{ROCSHMEM_THREAD_MULTIPLE};
+  if (mpi_provided == MPI_THREAD_SINGLE) {
+    level = ROCSHMEM_THREAD_SINGLE;
+  } else if (mpi_provided == MPI_THREAD_FUNNELED) {
+    level = ROCSHMEM_THREAD_FUNNELED;
+  } else if (mpi_provided == MPI_THREAD_SERIALIZED) {
+    level = ROCSHMEM_THREAD_SERIALIZED;
+  }
+  thread_level_ = std::min(thread_level_, level);
+}
+
 }  // namespace rocshmem
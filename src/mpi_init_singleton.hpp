@@ -27,6 +27,8 @@
 
 #include <memory>
 
+#include "rocshmem/rocshmem_common.hpp"
+
 /**
  * @file mpi_init_singleton.hpp
  *
@@ -69,6 +71,46 @@ class MPIInitSingleton {
    */
   int get_nprocs();
 
+  /**
+   * @brief Record the host thread level asked for by the application
+   *
+   * Must be called before the backend initializes MPI so that MPI is
+   * brought up at the matching level.
+   *
+   * @param[in] requested Thread level from rocshmem_thread_ops
+   */
+  static void set_thread_level(int requested);
+
+  /**
+   * @brief Accessor for the host thread level the runtime operates in
+   *
+   * @return Thread level from rocshmem_thread_ops
+   */
+  static int get_thread_level();
+
+  /**
+   * @brief Can host calls arrive from several threads at once
+   *
+   * Below THREAD_MULTIPLE the host side skips its own locks and atomics.
+   *
+   * @return True for ROCSHMEM_THREAD_MULTIPLE
+   */
+  static bool thread_multiple();
+
+  /**
+   * @brief MPI thread level matching the requested host thread level
+   *
+   * @return Value to pass as required to MPI_Init_thread
+   */
+  static int mpi_thread_level();
+
+  /**
+   * @brief Lower the thread level to what MPI actually provides
+   *
+   * Covers MPI initialized by the application before rocshmem.
+   */
+  static void cap_thread_level_to_mpi();
+
  private:
   /**
    * @brief My MPI rank identifier
@@ -85,6 +127,11 @@ class MPIInitSingleton {
    */
   int pre_init_done{0};
 
+  /**
+   * @brief Host thread level (rocshmem_thread_ops) for this run
+   */
+  static int thread_level_;
+
   /**
    * @brief Refers to global variable
    */
@@ -0,0 +1,213 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "proxy_placement.hpp"
+
+#include <hip/hip_runtime_api.h>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "util.hpp"
+
+namespace rocshmem {
+
+static std::string read_first_line(const std::string &path) {
+  std::ifstream file(path);
+  std::string line{};
+  std::getline(file, line);
+  return line;
+}
+
+static int read_env_int(const char *name, int fallback) {
+  char *value{nullptr};
+  if ((value = getenv(name)) != nullptr) {
+    return atoi(value);
+  }
+  return fallback;
+}
+
+std::vector<int> ProxyPlacement::parse_cpulist(const std::string &list) {
+  std::vector<int> cpus{};
+  std::stringstream stream(list);
+  std::string range{};
+  while (std::getline(stream, range, ',')) {
+    if (range.empty() || !isdigit(static_cast<unsigned char>(range[0]))) {
+      continue;
+    }
+    int first{0};
+    int last{0};
+    if (sscanf(range.c_str(), "%d-%d", &first, &last) != 2) {
+      last = first;
+    }
+    for (int cpu{first}; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::pair<int, int> ProxyPlacement::choose_cpus(
+    const std::vector<int> &candidates, int local_rank) {
+  int count = candidates.size();
+  if (count == 0) {
+    return {-1, -1};
+  }
+  if (count == 1) {
+    return {candidates[0], candidates[0]};
+  }
+  int top{count - 1 - (2 * local_rank) % count};
+  int next{top > 0 ? top - 1 : count - 1};
+  return {candidates[top], candidates[next]};
+}
+
+int ProxyPlacement::local_rank() {
+  /*
+   * Runs before the transport has initialized MPI, so use the node-local
+   * rank the common launchers export.
+   */
+  for (const char *name : {"OMPI_COMM_WORLD_LOCAL_RANK", "MPI_LOCALRANKID",
+                           "MV2_COMM_WORLD_LOCAL_RANK", "SLURM_LOCALID"}) {
+    char *value{nullptr};
+    if ((value = getenv(name)) != nullptr) {
+      return atoi(value);
+    }
+  }
+  return 0;
+}
+
+ProxyPlacement::ProxyPlacement() {
+  enabled_ = read_env_int("RO_NET_PIN_THREADS", 1) != 0;
+
+  int device{0};
+  char bus_id[64]{};
+  if (hipGetDevice(&device) == hipSuccess &&
+      hipDeviceGetPCIBusId(bus_id, sizeof(bus_id), device) == hipSuccess) {
+    gpu_bus_id_ = bus_id;
+    std::transform(gpu_bus_id_.begin(), gpu_bus_id_.end(),
+                   gpu_bus_id_.begin(),
+                   [](unsigned char c) { return tolower(c); });
+  }
+
+  std::string device_dir{"/sys/bus/pci/devices/" + gpu_bus_id_};
+  numa_node_ = -1;
+  if (!gpu_bus_id_.empty()) {
+    std::string node{read_first_line(device_dir + "/numa_node")};
+    numa_node_ = node.empty() ? -1 : atoi(node.c_str());
+  }
+  numa_node_ = read_env_int("RO_NET_NUMA_NODE", numa_node_);
+
+  std::vector<int> local_cpus{};
+  if (numa_node_ >= 0) {
+    local_cpus = parse_cpulist(read_first_line(
+        "/sys/devices/system/node/node" + std::to_string(numa_node_) +
+        "/cpulist"));
+  }
+
+  // Stay inside whatever binding the launcher gave this rank.
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  sched_getaffinity(0, sizeof(allowed), &allowed);
+
+  std::vector<int> candidates{};
+  for (int cpu : local_cpus) {
+    if (CPU_ISSET(cpu, &allowed)) {
+      candidates.push_back(cpu);
+    }
+  }
+  if (candidates.empty()) {
+    for (int cpu{0}; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &allowed)) {
+        candidates.push_back(cpu);
+      }
+    }
+  }
+
+  auto [proxy, progress] = choose_cpus(candidates, local_rank());
+  proxy_cpu_ = read_env_int("RO_NET_PROXY_CPU", proxy);
+  progress_cpu_ = read_env_int("RO_NET_PROGRESS_CPU", progress);
+
+  bind_memory();
+}
+
+void ProxyPlacement::bind_memory() {
+  if (!enabled_ || numa_node_ < 0) {
+    return;
+  }
+  unsigned long mask[16]{};  // NOLINT(runtime/int)
+  size_t bits{sizeof(mask[0]) * 8};
+  if (static_cast<size_t>(numa_node_) >= bits * 16) {
+    return;
+  }
+  mask[numa_node_ / bits] = 1UL << (numa_node_ % bits);
+  memory_bound_ = syscall(SYS_set_mempolicy, MPOL_PREFERRED, mask,
+                          bits * 16) == 0;
+}
+
+void ProxyPlacement::restore_memory_policy() {
+  if (memory_bound_) {
+    syscall(SYS_set_mempolicy, MPOL_DEFAULT, nullptr, 0);
+  }
+}
+
+void ProxyPlacement::pin(std::thread *thread, int cpu) {
+  if (!enabled_ || cpu < 0 || cpu >= CPU_SETSIZE) {
+    return;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  pthread_setaffinity_np(thread->native_handle(), sizeof(set), &set);
+}
+
+void ProxyPlacement::report(int my_pe) const {
+  char line[256];
+  if (!enabled_) {
+    snprintf(line, sizeof(line), "ROCSHMEM PE %d: proxy placement disabled\n",
+             my_pe);
+  } else {
+    snprintf(line, sizeof(line),
+             "ROCSHMEM PE %d: GPU %s, NUMA node %d%s, proxy cpu %d, "
+             "progress cpu %d\n",
+             my_pe, gpu_bus_id_.empty() ? "unknown" : gpu_bus_id_.c_str(),
+             numa_node_, memory_bound_ ? " (queues bound)" : "", proxy_cpu_,
+             progress_cpu_);
+  }
+
+  // Quiet unless asked for, so init does not write to the job's stdout.
+  if (read_env_int("RO_NET_PLACEMENT_VERBOSE", 0) != 0) {
+    printf("%s", line);
+  } else {
+    DPRINTF("%s", line);
+  }
+}
+
+}  // namespace rocshmem
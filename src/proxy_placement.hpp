@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_PROXY_PLACEMENT_HPP_
+#define LIBRARY_SRC_PROXY_PLACEMENT_HPP_
+
+/**
+ * @file proxy_placement.hpp
+ * Defines the ProxyPlacement class
+ */
+
+#include <string>
+#include <utility>
+#include <thread>  // NOLINT
+#include <vector>
+
+namespace rocshmem {
+
+/**
+ * @class ProxyPlacement proxy_placement.hpp
+ *
+ * @brief Chooses the NUMA node and cores for host service threads.
+ *
+ * The node is the one sysfs reports for the PCI function of the current
+ * GPU. Cores are taken from the end of that node's CPU list, restricted
+ * to the process affinity mask, and staggered by the rank's index on the
+ * host so co-located ranks do not share service cores.
+ *
+ * Environment overrides:
+ *  RO_NET_PIN_THREADS=0    disable pinning and memory binding
+ *  RO_NET_NUMA_NODE        use this node instead of the GPU's
+ *  RO_NET_PROXY_CPU        core for the queue polling thread
+ *  RO_NET_PROGRESS_CPU     core for the transport progress thread
+ *  RO_NET_PLACEMENT_VERBOSE  print the placement on every PE
+ */
+class ProxyPlacement {
+ public:
+  /**
+   * @brief Discover the topology, pick cores and bind memory.
+   *
+   * Calls bind_memory, so members constructed after this object allocate
+   * on the chosen node until restore_memory_policy is called.
+   */
+  ProxyPlacement();
+
+  /**
+   * @brief Prefer the chosen node for allocations made by this thread
+   * until restore_memory_policy is called.
+   *
+   * Allocators that follow the calling thread's NUMA policy (first-touch
+   * host memory, hipHostMallocNumaUser) then land on the node.
+   */
+  void bind_memory();
+
+  /**
+   * @brief Return the calling thread to the default memory policy.
+   */
+  void restore_memory_policy();
+
+  /**
+   * @brief Pin a thread to a core. Does nothing for a negative core.
+   */
+  void pin(std::thread *thread, int cpu);
+
+  /**
+   * @brief Print the chosen placement for this PE when
+   * RO_NET_PLACEMENT_VERBOSE is nonzero, otherwise only in debug builds.
+   */
+  void report(int my_pe) const;
+
+  int numa_node() const { return numa_node_; }
+
+  int proxy_cpu() const { return proxy_cpu_; }
+
+  int progress_cpu() const { return progress_cpu_; }
+
+  /**
+   * @brief Parse a sysfs CPU list such as "0-3,8,10-11".
+   */
+  static std::vector<int> parse_cpulist(const std::string &list);
+
+  /**
+   * @brief Choose proxy and progress cores from the candidates.
+   *
+   * Walks from the highest candidate down, skipping two cores per lower
+   * local rank. With a single candidate both threads share it.
+   *
+   * @return {proxy core, progress core}, or {-1, -1} with no candidates
+   */
+  static std::pair<int, int> choose_cpus(const std::vector<int> &candidates,
+                                         int local_rank);
+
+ private:
+  /**
+   * @brief This rank's index among the ranks on the same host.
+   */
+  static int local_rank();
+
+  std::string gpu_bus_id_{};
+
+  int numa_node_{-1};
+
+  int proxy_cpu_{-1};
+
+  int progress_cpu_{-1};
+
+  bool enabled_{true};
+
+  bool memory_bound_{false};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_PROXY_PLACEMENT_HPP_
@@ -28,6 +28,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include <thread>  // NOLINT
@@ -38,6 +39,9 @@
 #include "../context_incl.hpp"
 #include "mpi_transport.hpp"
 #include "ro_net_team.hpp"
+#ifdef USE_UCX
+#include "ucx_transport.hpp"
+#endif
 #include "../util.hpp"
 
 namespace rocshmem {
@@ -48,13 +52,33 @@ ROBackend::ROBackend(MPI_Comm comm)
     : profiler_proxy_(MAX_NUM_BLOCKS), Backend() {
   type = BackendType::RO_BACKEND;
 
+  // The queues are allocated by now; later allocations use the default.
+  placement_.restore_memory_policy();
+
   if (auto maximum_num_contexts_str = getenv("ROCSHMEM_MAX_NUM_CONTEXTS")) {
     std::stringstream sstream(maximum_num_contexts_str);
     sstream >> maximum_num_contexts_;
   }
   poll_block_count_ = maximum_num_contexts_;
 
-  transport_ = new MPITransport(comm, &queue_);
+  transport_ = nullptr;
+  if (auto transport_str = getenv("RO_NET_TRANSPORT")) {
+    if (!strcmp(transport_str, "ucx")) {
+#ifdef USE_UCX
+      transport_ = new UCXTransport(comm, &queue_);
+#else
+      fprintf(stderr, "RO_NET_TRANSPORT=ucx needs a build with USE_UCX, "
+                      "using MPI\n");
+#endif
+    } else if (strcmp(transport_str, "mpi")) {
+      fprintf(stderr, "Unknown RO_NET_TRANSPORT=%s, using MPI\n",
+              transport_str);
+    }
+  }
+  if (!transport_) {
+    transport_ = new MPITransport(comm, &queue_);
+  }
+  transport_->comm_cache = &team_comm_cache;
   num_pes = transport_->getNumPes();
   my_pe = transport_->getMyPe();
 
@@ -68,8 +92,16 @@ ROBackend::ROBackend(MPI_Comm comm)
 
   bp->heap_ptr = &heap;
 
+  /*
+   * The extra heaps must exist before the window proxy so that each one
+   * gets its own set of MPI windows.
+   */
+  heap.create_kind_heaps();
+
   ro_window_proxy_ = new WindowProxyT(&heap, transport_->get_world_comm());
   bp->heap_window_info = ro_window_proxy_->get();
+  window_pool_ = ro_window_proxy_->pool();
+  transport_->window_growth = [this] { ro_window_proxy_->progress(); };
 
   initIPC();
 
@@ -78,6 +110,8 @@ ROBackend::ROBackend(MPI_Comm comm)
   allocate_atomic_region(&bp->atomic_ret, MAX_NUM_BLOCKS);
 
   transport_->initTransport(MAX_NUM_BLOCKS, &backend_proxy);
+  placement_.pin(&transport_->get_progress_thread(),
+                 placement_.progress_cpu());
 
   host_interface = transport_->host_interface;
 
@@ -103,6 +137,8 @@ ROBackend::ROBackend(MPI_Comm comm)
   setup_ctxs();
 
   worker_thread = std::thread(&ROBackend::ro_net_poll, this);
+  placement_.pin(&worker_thread, placement_.proxy_cpu());
+  placement_.report(my_pe);
 
   *done_init = 1;
 }
@@ -128,27 +164,38 @@ __device__ bool ROBackend::create_ctx(int64_t options, rocshmem_ctx_t *ctx) {
     return false;
   }
   ctx_ = pop_result.value;
+  ctx_->ro_net_win_id = window_pool_->acquire();
 
   ctx->ctx_opaque = ctx_;
   return true;
 }
 
 __device__ void ROBackend::destroy_ctx(rocshmem_ctx_t *ctx) {
-  ctx_free_list.get()->push_back(static_cast<ROContext *>(ctx->ctx_opaque));
+  auto *ctx_{static_cast<ROContext *>(ctx->ctx_opaque)};
+  window_pool_->release(ctx_->ro_net_win_id);
+  ctx_free_list.get()->push_back(ctx_);
 }
 
 void ROBackend::team_destroy(rocshmem_team_t team) {
   ROTeam *team_obj{get_internal_ro_team(team)};
 
+  ata_buffer_pool.release(team_obj->ata_buffer, MAX_ATA_BUFF_SIZE);
+  team_obj->ata_buffer = nullptr;
+
+  transport_->destroyTeam(team_obj->mpi_comm);
+  ro_window_proxy_->expect_contexts(-team_obj->config.num_contexts);
+
   team_obj->~ROTeam();
-  // CHECK_HIP(hipFree(team_obj));
+  team_metadata_pool.release(team_obj, sizeof(ROTeam));
 }
 
 void ROBackend::create_new_team(Team *parent_team,
                                 TeamInfo *team_info_wrt_parent,
                                 TeamInfo *team_info_wrt_world, int num_pes,
                                 int my_pe_in_new_team, MPI_Comm team_comm,
+                                const rocshmem_team_config_t &config,
                                 rocshmem_team_t *new_team) {
+  ro_window_proxy_->expect_contexts(config.num_contexts);
   transport_->createNewTeam(this, parent_team, team_info_wrt_parent,
                             team_info_wrt_world, num_pes, my_pe_in_new_team,
                             team_comm, new_team);
@@ -283,6 +330,10 @@ void ROBackend::initIPC() {
 
   ipcImpl.ipcHostInit(transport_->getMyPe(), heap_bases,
                       transport_->get_world_comm());
+
+  for (int h{1}; h < heap.num_heaps(); h++) {
+    ipcImpl.ipcHostAddHeap(heap.get_local_heap_base(h), heap.get_size(h));
+  }
 }
 
 void ROBackend::global_exit(int status) { transport_->global_exit(status); }
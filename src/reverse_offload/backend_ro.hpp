@@ -30,6 +30,7 @@
 #include "../containers/free_list_impl.hpp"
 #include "../hdp_proxy.hpp"
 #include "../memory/hip_allocator.hpp"
+#include "../proxy_placement.hpp"
 #include "backend_proxy.hpp"
 #include "block_handle.hpp"
 #include "context_proxy.hpp"
@@ -85,6 +86,7 @@ class ROBackend : public Backend {
   void create_new_team(Team *parent_team, TeamInfo *team_info_wrt_parent,
                        TeamInfo *team_info_wrt_world, int num_pes,
                        int my_pe_in_new_team, MPI_Comm team_comm,
+                       const rocshmem_team_config_t &config,
                        rocshmem_team_t *new_team) override;
 
   /**
@@ -92,6 +94,13 @@ class ROBackend : public Backend {
    */
   void team_destroy(rocshmem_team_t team) override;
 
+  /**
+   * @copydoc Backend::get_max_num_contexts
+   */
+  size_t get_max_num_contexts() const override {
+    return maximum_num_contexts_;
+  }
+
   __device__ bool create_ctx(int64_t options, rocshmem_ctx_t *ctx);
 
   /**
@@ -202,10 +211,20 @@ class ROBackend : public Backend {
 
  public:
   /**
-   * @brief Pool of contexts for RO_NET
+   * @brief MPI windows bound to the device contexts
    */
   WindowProxyT *ro_window_proxy_;
 
+  /**
+   * @brief Window usage of ro_window_proxy_, read by the device
+   */
+  WindowPool *window_pool_{nullptr};
+
+  /**
+   * @brief Alltoall buffers of destroyed teams, handed to new ones
+   */
+  TeamBlockPool<HostAllocator> ata_buffer_pool{};
+
  protected:
   /**
    * @brief Allocates uncacheable host memory for the hdp policy.
@@ -221,6 +240,14 @@ class ROBackend : public Backend {
    */
   ProfilerProxyT profiler_proxy_;  // init handled in constructor
 
+  /**
+   * @brief Cores and NUMA node for the service threads and queues.
+   *
+   * @note Declared ahead of queue_ so the queues are allocated under the
+   * memory policy it sets.
+   */
+  ProxyPlacement placement_{};
+
  public:
   /**
    * @brief Handle to network queues.
@@ -37,7 +37,7 @@ struct BlockHandle {
   volatile uint64_t read_index{};
   volatile uint64_t write_index{};
   volatile uint64_t *host_read_index{};
-  volatile char *status{nullptr};
+  volatile uint64_t *completed_seq{nullptr};
   char *g_ret{nullptr};
   atomic_ret_t atomic_ret{};
   IpcImpl ipc{};
@@ -63,7 +63,7 @@ class DefaultBlockHandleProxy {
     block_handle->read_index = queue_descriptor->read_index;
     block_handle->write_index = queue_descriptor->write_index;
     block_handle->host_read_index = &queue_descriptor->read_index;
-    block_handle->status = queue_descriptor->status;
+    block_handle->completed_seq = &queue_descriptor->completed_seq;
     block_handle->g_ret = g_ret;
     block_handle->atomic_ret.atomic_base_ptr = atomic_ret->atomic_base_ptr;
     block_handle->atomic_ret.atomic_counter = 0;
@@ -100,7 +100,7 @@ class BlockHandleProxy {
       block_handle->read_index = queue_descriptor->read_index;
       block_handle->write_index = queue_descriptor->write_index;
       block_handle->host_read_index = &queue_descriptor->read_index;
-      block_handle->status = queue_descriptor->status;
+      block_handle->completed_seq = &queue_descriptor->completed_seq;
       block_handle->g_ret = g_ret;
       block_handle->atomic_ret.atomic_base_ptr = atomic_ret->atomic_base_ptr;
       block_handle->atomic_ret.atomic_counter = 0;
@@ -45,6 +45,12 @@ enum ro_net_cmds {
   RO_NET_TEAM_BROADCAST,
   RO_NET_ALLTOALL,
   RO_NET_FCOLLECT,
+  RO_NET_AMO_VECTOR,
+  RO_NET_AMO_STRIDED,
+  RO_NET_REDUCE_SCATTER,
+  RO_NET_FCOLLECTV,
+  RO_NET_AM,
+  RO_NET_ALLTOALLV,
 };
 
 enum ro_net_types {
@@ -49,20 +49,24 @@ __host__ ROContext::ROContext(Backend *b, size_t block_id)
   } else {
     auto block_base{backend->block_handle_proxy_.get()};
     block_handle = &block_base[block_id];
+    queue_id = block_id;
   }
-  ro_net_win_id = block_id % backend->ro_window_proxy_->MAX_NUM_WINDOWS;
+  // Block contexts are bound to a window when they are handed out.
+  ro_net_win_id = 0;
 
   ipcImpl_.ipc_bases = b->ipcImpl.ipc_bases;
   ipcImpl_.shm_size = b->ipcImpl.shm_size;
+  ipcImpl_.num_extra_heaps = b->ipcImpl.num_extra_heaps;
+  ipcImpl_.extra_heaps = b->ipcImpl.extra_heaps;
 }
 
 __device__ void ROContext::putmem(void *dest, const void *source, size_t nelems,
                                   int pe) {
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
-    uint64_t L_offset =
-        reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy(ipcImpl_.ipc_bases[local_pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, local_pe)};
+    ipcImpl_.ipcCopy(remote_addr,
                      const_cast<void *>(source), nelems);
   } else {
     bool must_send_message = wf_coal_.coalesce(pe, source, dest, &nelems);
@@ -80,9 +84,9 @@ __device__ void ROContext::getmem(void *dest, const void *source, size_t nelems,
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
     const char *src_typed = reinterpret_cast<const char *>(source);
-    uint64_t L_offset =
-        const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy(dest, ipcImpl_.ipc_bases[local_pe] + L_offset, nelems);
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, local_pe)};
+    ipcImpl_.ipcCopy(dest, remote_addr, nelems);
   } else {
     bool must_send_message = wf_coal_.coalesce(pe, source, dest, &nelems);
     if (!must_send_message) {
@@ -98,9 +102,9 @@ __device__ void ROContext::putmem_nbi(void *dest, const void *source,
                                       size_t nelems, int pe) {
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
-    uint64_t L_offset =
-        reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy(ipcImpl_.ipc_bases[local_pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, local_pe)};
+    ipcImpl_.ipcCopy(remote_addr,
                      const_cast<void *>(source), nelems);
   } else {
     bool must_send_message = wf_coal_.coalesce(pe, source, dest, &nelems);
@@ -118,9 +122,9 @@ __device__ void ROContext::getmem_nbi(void *dest, const void *source,
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
     const char *src_typed = reinterpret_cast<const char *>(source);
-    uint64_t L_offset =
-        const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy(dest, ipcImpl_.ipc_bases[local_pe] + L_offset, nelems);
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, local_pe)};
+    ipcImpl_.ipcCopy(dest, remote_addr, nelems);
   } else {
     bool must_send_message = wf_coal_.coalesce(pe, source, dest, &nelems);
     if (!must_send_message) {
@@ -152,13 +156,21 @@ __device__ void *ROContext::shmem_ptr(const void *dest, int pe) {
   void *ret = nullptr;
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     void *dst = const_cast<void *>(dest);
-    uint64_t L_offset =
-        reinterpret_cast<char *>(dst) - ipcImpl_.ipc_bases[my_pe];
-    ret = ipcImpl_.ipc_bases[pe] + L_offset;
+    ret = ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dst), my_pe, pe);
   }
   return ret;
 }
 
+__device__ uint64_t ROContext::am(void *dest, int handler_id, uint64_t arg0,
+                                  uint64_t arg1, int pe) {
+  auto source{get_unused_atomic()};
+  build_queue_element(RO_NET_AM, dest, source, arg0, pe, 0, 0, handler_id,
+                      reinterpret_cast<void *>(arg1), nullptr, (MPI_Comm)NULL,
+                      ro_net_win_id, block_handle, true);
+  __threadfence();
+  return *source;
+}
+
 __device__ void ROContext::barrier_all() {
   if (is_thread_zero_in_block()) {
     build_queue_element(RO_NET_BARRIER_ALL, nullptr, nullptr, 0, 0, 0, 0, 0,
@@ -197,7 +209,7 @@ __device__ void ROContext::ctx_destroy() {
                         nullptr, nullptr, (MPI_Comm)NULL, ro_net_win_id,
                         block_handle, true);
 
-    int buffer_id = ro_net_win_id;
+    int buffer_id = queue_id;
     backend->queue_.descriptor(buffer_id)->write_index = block_handle->write_index;
 
     ROStats &global_handle = proxy->profiler[buffer_id];
@@ -211,9 +223,9 @@ __device__ void ROContext::putmem_wg(void *dest, const void *source,
                                      size_t nelems, int pe) {
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
-    uint64_t L_offset =
-        reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy_wg(ipcImpl_.ipc_bases[local_pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, local_pe)};
+    ipcImpl_.ipcCopy_wg(remote_addr,
                         const_cast<void *>(source), nelems);
   } else {
     if (is_thread_zero_in_block()) {
@@ -230,9 +242,9 @@ __device__ void ROContext::getmem_wg(void *dest, const void *source,
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
     const char *src_typed = reinterpret_cast<const char *>(source);
-    uint64_t L_offset =
-        const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy_wg(dest, ipcImpl_.ipc_bases[local_pe] + L_offset, nelems);
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, local_pe)};
+    ipcImpl_.ipcCopy_wg(dest, remote_addr, nelems);
   } else {
     if (is_thread_zero_in_block()) {
       build_queue_element(RO_NET_GET, dest, const_cast<void *>(source), nelems,
@@ -247,9 +259,9 @@ __device__ void ROContext::putmem_nbi_wg(void *dest, const void *source,
                                          size_t nelems, int pe) {
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
-    uint64_t L_offset =
-        reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy_wg(ipcImpl_.ipc_bases[local_pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, local_pe)};
+    ipcImpl_.ipcCopy_wg(remote_addr,
                         const_cast<void *>(source), nelems);
   } else {
     if (is_thread_zero_in_block()) {
@@ -266,9 +278,9 @@ __device__ void ROContext::getmem_nbi_wg(void *dest, const void *source,
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
     const char *src_typed = reinterpret_cast<const char *>(source);
-    uint64_t L_offset =
-        const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy_wg(dest, ipcImpl_.ipc_bases[local_pe] + L_offset, nelems);
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, local_pe)};
+    ipcImpl_.ipcCopy_wg(dest, remote_addr, nelems);
   } else {
     if (is_thread_zero_in_block()) {
       build_queue_element(RO_NET_GET_NBI, dest, const_cast<void *>(source),
@@ -283,9 +295,9 @@ __device__ void ROContext::putmem_wave(void *dest, const void *source,
                                        size_t nelems, int pe) {
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
-    uint64_t L_offset =
-        reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy_wave(ipcImpl_.ipc_bases[local_pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, local_pe)};
+    ipcImpl_.ipcCopy_wave(remote_addr,
                           const_cast<void *>(source), nelems);
   } else {
     if (is_thread_zero_in_wave()) {
@@ -301,9 +313,9 @@ __device__ void ROContext::getmem_wave(void *dest, const void *source,
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
     const char *src_typed = reinterpret_cast<const char *>(source);
-    uint64_t L_offset =
-        const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy_wave(dest, ipcImpl_.ipc_bases[local_pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, local_pe)};
+    ipcImpl_.ipcCopy_wave(dest, remote_addr,
                           nelems);
   } else {
     if (is_thread_zero_in_wave()) {
@@ -318,9 +330,9 @@ __device__ void ROContext::putmem_nbi_wave(void *dest, const void *source,
                                            size_t nelems, int pe) {
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
-    uint64_t L_offset =
-        reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy_wave(ipcImpl_.ipc_bases[local_pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, local_pe)};
+    ipcImpl_.ipcCopy_wave(remote_addr,
                           const_cast<void *>(source), nelems);
   } else {
     if (is_thread_zero_in_wave()) {
@@ -336,9 +348,9 @@ __device__ void ROContext::getmem_nbi_wave(void *dest, const void *source,
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     int local_pe = pe % ipcImpl_.shm_size;
     const char *src_typed = reinterpret_cast<const char *>(source);
-    uint64_t L_offset =
-        const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe];
-    ipcImpl_.ipcCopy_wave(dest, ipcImpl_.ipc_bases[local_pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, local_pe)};
+    ipcImpl_.ipcCopy_wave(dest, remote_addr,
                           nelems);
   } else {
     if (is_thread_zero_in_wave()) {
@@ -519,7 +531,7 @@ __device__ uint64_t next_write_slot_o_o_o(BlockHandle *handle) {
   write_slot = handle->write_index;
   handle->write_index += 1;
   __threadfence();
-  return write_slot % handle->queue_size;
+  return write_slot;
 }
 
 __device__ uint64_t next_write_slot_o_o_m(BlockHandle *handle) {
@@ -535,7 +547,7 @@ __device__ uint64_t next_write_slot_o_o_m(BlockHandle *handle) {
   }
   write_slot = broadcast(is_lowest_active_lane, write_slot);
   write_slot += my_active_lane_id;
-  return write_slot % handle->queue_size;
+  return write_slot;
 }
 
 __device__ uint64_t next_write_slot_o_m_o(BlockHandle *handle) {
@@ -546,7 +558,7 @@ __device__ uint64_t next_write_slot_o_m_o(BlockHandle *handle) {
   handle->write_index += 1;
   __threadfence();
   release_lock(handle);
-  return write_slot % handle->queue_size;
+  return write_slot;
 }
 
 __device__ uint64_t next_write_slot_o_m_m(BlockHandle *handle) {
@@ -564,7 +576,7 @@ __device__ uint64_t next_write_slot_o_m_m(BlockHandle *handle) {
   }
   write_slot = broadcast(is_lowest_active_lane, write_slot);
   write_slot += my_active_lane_id;
-  return write_slot % handle->queue_size;
+  return write_slot;
 }
 
 __device__ uint64_t next_write_slot(BlockHandle *handle) {
@@ -578,9 +590,10 @@ __device__ void build_queue_element(
     ro_net_cmds type, void *dst, void *src, size_t size, int pe,
     int logPE_stride, int PE_size, int PE_root, void *pWrk, long *pSync,
     MPI_Comm team_comm, int ro_net_win_id, BlockHandle *handle,
-    bool blocking, ROCSHMEM_OP op, ro_net_types datatype) {
-  auto write_slot{next_write_slot(handle)};
-  auto queue_element = &handle->queue[write_slot];
+    bool blocking, ROCSHMEM_OP op, ro_net_types datatype, int *pes,
+    int *dest_counts, int *dest_displs) {
+  auto ticket{next_write_slot(handle)};
+  auto queue_element = &handle->queue[ticket % handle->queue_size];
 
   queue_element->type = type;
   queue_element->PE = pe;
@@ -594,9 +607,6 @@ __device__ void build_queue_element(
     queue_element->src = src;
   }
 
-  auto threadId {get_flat_id()};
-  queue_element->threadId = threadId;
-
   if (type == RO_NET_AMO_FOP) {
     queue_element->op = op;
     queue_element->datatype = datatype;
@@ -605,6 +615,17 @@ __device__ void build_queue_element(
     queue_element->ol2.pWrk = pWrk;
     queue_element->datatype = datatype;
   }
+  if (type == RO_NET_AMO_VECTOR) {
+    queue_element->ol2.pWrk = pWrk;
+    queue_element->pes = pes;
+    queue_element->op = op;
+    queue_element->datatype = datatype;
+  }
+  if (type == RO_NET_AMO_STRIDED) {
+    queue_element->logPE_stride = logPE_stride;
+    queue_element->op = op;
+    queue_element->datatype = datatype;
+  }
   if (type == RO_NET_TO_ALL) {
     queue_element->logPE_stride = logPE_stride;
     queue_element->PE_size = PE_size;
@@ -618,6 +639,11 @@ __device__ void build_queue_element(
     queue_element->datatype = datatype;
     queue_element->team_comm = team_comm;
   }
+  if (type == RO_NET_REDUCE_SCATTER) {
+    queue_element->op = op;
+    queue_element->datatype = datatype;
+    queue_element->team_comm = team_comm;
+  }
   if (type == RO_NET_BROADCAST) {
     queue_element->logPE_stride = logPE_stride;
     queue_element->PE_size = PE_size;
@@ -640,9 +666,26 @@ __device__ void build_queue_element(
     queue_element->team_comm = team_comm;
     queue_element->ol2.pWrk = pWrk;
   }
+  if (type == RO_NET_FCOLLECTV) {
+    queue_element->datatype = datatype;
+    queue_element->team_comm = team_comm;
+    queue_element->pes = pes;
+  }
+  if (type == RO_NET_ALLTOALLV) {
+    queue_element->datatype = datatype;
+    queue_element->team_comm = team_comm;
+    queue_element->pes = pes;
+    queue_element->ol2.pWrk = pWrk;
+    queue_element->dest_counts = dest_counts;
+    queue_element->dest_displs = dest_displs;
+  }
   if (type == RO_NET_SYNC) {
     queue_element->team_comm = team_comm;
   }
+  if (type == RO_NET_AM) {
+    queue_element->ol2.pWrk = pWrk;
+    queue_element->PE_root = PE_root;
+  }
 
   // Make sure queue element data is visible to CPU
   __threadfence();
@@ -653,13 +696,11 @@ __device__ void build_queue_element(
 
   // Blocking requires the CPU to complete the operation.
   if (blocking) {
-    int network_status{0};
+    uint64_t my_seq{ticket + 1};
+    uint64_t completed_seq{0};
     do {
-      refresh_volatile_sbyte(&network_status, &handle->status[threadId]);
-    } while (network_status == 0);
-
-    handle->status[threadId] = 0;
-    __threadfence();
+      refresh_volatile_dwordx2(&completed_seq, handle->completed_seq);
+    } while (completed_seq < my_seq);
   }
 }
 
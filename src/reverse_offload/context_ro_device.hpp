@@ -35,7 +35,8 @@ __device__ void build_queue_element(
     int logPE_stride, int PE_size, int PE_root, void *pWrk, long *pSync,
     MPI_Comm team_comm, int ro_net_win_id, BlockHandle *handle,
     bool blocking, ROCSHMEM_OP op = ROCSHMEM_SUM,
-    ro_net_types datatype = RO_NET_INT);
+    ro_net_types datatype = RO_NET_INT, int *pes = nullptr,
+    int *dest_counts = nullptr, int *dest_displs = nullptr);
 
 class ROContext : public Context {
  public:
@@ -63,6 +64,9 @@ class ROContext : public Context {
 
   __device__ void *shmem_ptr(const void *dest, int pe);
 
+  __device__ uint64_t am(void *dest, int handler_id, uint64_t arg0,
+                         uint64_t arg1, int pe);
+
   __device__ void barrier_all();
 
   __device__ void sync_all();
@@ -84,6 +88,10 @@ class ROContext : public Context {
   __device__ int reduce(rocshmem_team_t team, T *dest, const T *source,
                         int nreduce);
 
+  template <typename T, ROCSHMEM_OP Op>
+  __device__ int reduce_scatter(rocshmem_team_t team, T *dest,
+                                const T *source, int nreduce);
+
   template <typename T>
   __device__ void put(T *dest, const T *source, size_t nelems, int pe);
 
@@ -108,6 +116,15 @@ class ROContext : public Context {
   template <typename T>
   __device__ void amo_add(void *dst, T value, int pe);
 
+  template <typename T>
+  __device__ void amo_add_vector(T *dst, const size_t *indices,
+                                 const T *values, const int *pes,
+                                 size_t nelems);
+
+  template <typename T>
+  __device__ void amo_add_strided(T *dst, ptrdiff_t stride, const T *values,
+                                  size_t nelems, int pe);
+
   template <typename T>
   __device__ void amo_set(void *dst, T value, int pe);
 
@@ -165,6 +182,16 @@ class ROContext : public Context {
   __device__ void fcollect(rocshmem_team_t team, T *dest, const T *source,
                            int nelems);
 
+  template <typename T>
+  __device__ void alltoallv(rocshmem_team_t team, T *dest, const T *source,
+                            const int *source_counts,
+                            const int *source_displs, const int *dest_counts,
+                            const int *dest_displs);
+
+  template <typename T>
+  __device__ void fcollectv(rocshmem_team_t team, T *dest, const T *source,
+                            const int *counts);
+
   template <typename T>
   __device__ void fcollect_broadcast(rocshmem_team_t team, T *dest,
                                      const T *source, int nelems);
@@ -256,6 +283,11 @@ class ROContext : public Context {
   BlockHandle *block_handle{nullptr};
 
   int ro_net_win_id{-1};
+
+  // Queue of block_handle; the default context shares queue 0.
+  int queue_id{0};
+
+  friend class ROBackend;
 };
 
 }  // namespace rocshmem
@@ -38,6 +38,8 @@ __host__ ROHostContext::ROHostContext(Backend *backend, long options)
 
   host_interface = b->host_interface;
 
+  ro_backend = b;
+
   context_window_info = host_interface->acquire_window_context();
 }
 
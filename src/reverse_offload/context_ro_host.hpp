@@ -27,6 +27,8 @@
 
 namespace rocshmem {
 
+class ROBackend;
+
 class ROContextWindowInfo {
  public:
   /**
@@ -79,6 +81,9 @@ class ROHostContext : public Context {
   /* An MPI Window implements a context */
   WindowInfo *context_window_info = nullptr;
 
+  /* Owner of the device context windows, grown at host barriers */
+  ROBackend *ro_backend = nullptr;
+
   /**************************************************************************
    ****************************** HOST METHODS ******************************
    *************************************************************************/
@@ -138,6 +143,11 @@ class ROHostContext : public Context {
   __host__ void broadcast(rocshmem_team_t team, T *dest, const T *source,
                           int nelems, int pe_root);
 
+  template <typename T>
+  __host__ void alltoallv(rocshmem_team_t team, T *dest, const T *source,
+                          const int *source_counts, const int *source_displs,
+                          const int *dest_counts, const int *dest_displs);
+
   template <typename T, ROCSHMEM_OP Op>
   __host__ void to_all(T *dest, const T *source, int nreduce, int pe_start,
                        int log_pe_stride, int pe_size, T *p_wrk,
@@ -23,6 +23,8 @@
 #ifndef LIBRARY_SRC_REVERSE_OFFLOAD_RO_NET_GPU_TEMPLATES_HPP_
 #define LIBRARY_SRC_REVERSE_OFFLOAD_RO_NET_GPU_TEMPLATES_HPP_
 
+#include <climits>
+
 #include "rocshmem_config.h"  // NOLINT(build/include_subdir)
 #include "commands_types.hpp"
 #include "context_ro_device.hpp"
@@ -126,6 +128,24 @@ __device__ int ROContext::reduce(rocshmem_team_t team, T *dest,
   return ROCSHMEM_SUCCESS;
 }
 
+template <typename T, ROCSHMEM_OP Op>
+__device__ int ROContext::reduce_scatter(rocshmem_team_t team, T *dest,
+                                         const T *source, int nreduce) {
+  if (!is_thread_zero_in_block()) {
+    __syncthreads();
+    return ROCSHMEM_SUCCESS;
+  }
+
+  ROTeam *team_obj{reinterpret_cast<ROTeam *>(team)};
+
+  build_queue_element(RO_NET_REDUCE_SCATTER, dest, const_cast<T *>(source),
+                      nreduce, 0, 0, 0, 0, nullptr, nullptr, team_obj->mpi_comm,
+                      ro_net_win_id, block_handle, true, Op, GetROType<T>::Type);
+
+  __syncthreads();
+  return ROCSHMEM_SUCCESS;
+}
+
 template <typename T, ROCSHMEM_OP Op>
 __device__ void ROContext::to_all(T *dest, const T *source, int nreduce,
                                   int PE_start, int logPE_stride, int PE_size,
@@ -160,8 +180,9 @@ __device__ void ROContext::put_nbi(T *dest, const T *source, size_t nelems,
 template <typename T>
 __device__ void ROContext::p(T *dest, T value, int pe) {
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
-    long L_offset{reinterpret_cast<char *>(dest) - ipcImpl_.ipc_bases[my_pe]};
-    ipcImpl_.ipcCopy(ipcImpl_.ipc_bases[pe] + L_offset,
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(reinterpret_cast<char *>(dest), my_pe, pe)};
+    ipcImpl_.ipcCopy(remote_addr,
                      reinterpret_cast<void *>(&value), sizeof(T));
   } else {
     build_queue_element(RO_NET_P, dest, &value, sizeof(T), pe, 0, 0, 0, nullptr,
@@ -174,9 +195,10 @@ template <typename T>
 __device__ T ROContext::g(const T *source, int pe) {
   if (ipcImpl_.isIpcAvailable(my_pe, pe)) {
     const char *src_typed{reinterpret_cast<const char *>(source)};
-    long L_offset{const_cast<char *>(src_typed) - ipcImpl_.ipc_bases[my_pe]};
     T dest;
-    ipcImpl_.ipcCopy(&dest, ipcImpl_.ipc_bases[pe] + L_offset, sizeof(T));
+    char *remote_addr{
+        ipcImpl_.ipcRemotePtr(const_cast<char *>(src_typed), my_pe, pe)};
+    ipcImpl_.ipcCopy(&dest, remote_addr, sizeof(T));
     return dest;
   } else {
     int thread_id{get_flat_block_id()};
@@ -237,6 +259,36 @@ __device__ void ROContext::amo_add(void *dst, T value, int pe) {
   T ret{amo_fetch_add(dst, value, pe)};
 }
 
+template <typename T>
+__device__ void ROContext::amo_add_vector(T *dst, const size_t *indices,
+                                          const T *values, const int *pes,
+                                          size_t nelems) {
+  build_queue_element(RO_NET_AMO_VECTOR, dst, const_cast<T *>(values), nelems,
+                      -1, 0, 0, 0, const_cast<size_t *>(indices), nullptr,
+                      (MPI_Comm)NULL, ro_net_win_id, block_handle, true,
+                      ROCSHMEM_SUM, GetROType<T>::Type, const_cast<int *>(pes));
+}
+
+template <typename T>
+__device__ void ROContext::amo_add_strided(T *dst, ptrdiff_t stride,
+                                           const T *values, size_t nelems,
+                                           int pe) {
+  // The proxy describes the target with an MPI vector type, whose stride
+  // and count are ints. Anything wider goes one element at a time.
+  if (stride < INT_MIN || stride > INT_MAX || nelems > INT_MAX) {
+    for (size_t i{0}; i < nelems; i++) {
+      amo_add(dst + i * stride, values[i], pe);
+    }
+    return;
+  }
+
+  // The element stride rides in the logPE_stride slot of the command.
+  build_queue_element(RO_NET_AMO_STRIDED, dst, const_cast<T *>(values), nelems,
+                      pe, static_cast<int>(stride), 0, 0, nullptr, nullptr,
+                      (MPI_Comm)NULL, ro_net_win_id, block_handle, true,
+                      ROCSHMEM_SUM, GetROType<T>::Type);
+}
+
 template <typename T>
 __device__ T ROContext::amo_swap(void *dst, T value, int pe) {
   auto source{get_unused_atomic()};
@@ -373,6 +425,49 @@ __device__ void ROContext::fcollect(rocshmem_team_t team, T *dest,
   __syncthreads();
 }
 
+template <typename T>
+__device__ void ROContext::alltoallv(rocshmem_team_t team, T *dest,
+                                     const T *source,
+                                     const int *source_counts,
+                                     const int *source_displs,
+                                     const int *dest_counts,
+                                     const int *dest_displs) {
+  if (!is_thread_zero_in_block()) {
+    __syncthreads();
+    return;
+  }
+
+  ROTeam *team_obj{reinterpret_cast<ROTeam *>(team)};
+
+  build_queue_element(RO_NET_ALLTOALLV, dest, const_cast<T *>(source), 0, 0,
+                      0, 0, 0, const_cast<int *>(source_displs), nullptr,
+                      team_obj->mpi_comm, ro_net_win_id, block_handle, true,
+                      ROCSHMEM_SUM, GetROType<T>::Type,
+                      const_cast<int *>(source_counts),
+                      const_cast<int *>(dest_counts),
+                      const_cast<int *>(dest_displs));
+
+  __syncthreads();
+}
+
+template <typename T>
+__device__ void ROContext::fcollectv(rocshmem_team_t team, T *dest,
+                                     const T *source, const int *counts) {
+  if (!is_thread_zero_in_block()) {
+    __syncthreads();
+    return;
+  }
+
+  ROTeam *team_obj{reinterpret_cast<ROTeam *>(team)};
+
+  build_queue_element(RO_NET_FCOLLECTV, dest, const_cast<T *>(source), 0, 0, 0,
+                      0, 0, nullptr, nullptr, team_obj->mpi_comm,
+                      ro_net_win_id, block_handle, true, ROCSHMEM_SUM,
+                      GetROType<T>::Type, const_cast<int *>(counts));
+
+  __syncthreads();
+}
+
 /**
  * WG and WAVE level API
  */
@@ -122,6 +122,19 @@ __host__ void ROHostContext::broadcast(rocshmem_team_t team, T *dest,
   host_interface->broadcast<T>(team, dest, source, nelems, pe_root);
 }
 
+template <typename T>
+__host__ void ROHostContext::alltoallv(rocshmem_team_t team, T *dest,
+                                       const T *source,
+                                       const int *source_counts,
+                                       const int *source_displs,
+                                       const int *dest_counts,
+                                       const int *dest_displs) {
+  DPRINTF("Function: Team-based ro_net_host_alltoallv\n");
+
+  host_interface->alltoallv<T>(team, dest, source, source_counts,
+                                source_displs, dest_counts, dest_displs);
+}
+
 template <typename T, ROCSHMEM_OP Op>
 __host__ void ROHostContext::to_all(T *dest, const T *source, int nreduce,
                                     int pe_start, int log_pe_stride,
@@ -23,11 +23,16 @@
 #include "mpi_transport.hpp"
 
 #include <algorithm>
+#include <chrono>  // NOLINT
+#include <climits>
 #include <functional>
+#include <numeric>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include "../host/host.hpp"
+#include "../traffic_matrix.hpp"
 #include "backend_ro.hpp"
 #include "ro_net_team.hpp"
 #include "../util.hpp"
@@ -47,6 +52,10 @@ MPITransport::MPITransport(MPI_Comm comm, Queue* q)
   int init_done{};
   NET_CHECK(MPI_Initialized(&init_done));
 
+  /*
+   * The progress thread issues MPI calls alongside the host API, so this
+   * transport needs MPI_THREAD_MULTIPLE whatever level the host asked for.
+   */
   int provided{};
   if (!init_done) {
     NET_CHECK(MPI_Init_thread(0, 0, MPI_THREAD_MULTIPLE, &provided));
@@ -59,6 +68,56 @@ MPITransport::MPITransport(MPI_Comm comm, Queue* q)
   NET_CHECK(MPI_Comm_dup(comm, &ro_net_comm_world));
   NET_CHECK(MPI_Comm_size(ro_net_comm_world, &num_pes));
   NET_CHECK(MPI_Comm_rank(ro_net_comm_world, &my_pe));
+  NET_CHECK(MPI_Comm_dup(ro_net_comm_world, &am_comm));
+  registerAlltoallvComm(ro_net_comm_world);
+
+  char *value{nullptr};
+  if ((value = getenv("RO_NET_COUNTER_COMPLETION")) != nullptr) {
+    counter_completion = atoi(value) != 0;
+  }
+  if ((value = getenv("RO_NET_FLUSH_THRESHOLD")) != nullptr) {
+    pending_flush_threshold = atoi(value);
+  }
+  if ((value = getenv("RO_NET_BARRIER_FLUSH_BATCH")) != nullptr) {
+    barrier_flush_batch = std::max(atoi(value), 1);
+  }
+  if ((value = getenv("RO_NET_STRIPE_LANES")) != nullptr) {
+    stripe_lanes = std::max(atoi(value), 1);
+  }
+  if ((value = getenv("RO_NET_STRIPE_THRESHOLD")) != nullptr) {
+    stripe_threshold = strtoull(value, nullptr, 0);
+  }
+  if ((value = getenv("RO_NET_STRIPE_CHUNK")) != nullptr) {
+    stripe_chunk = std::max<size_t>(strtoull(value, nullptr, 0), 1);
+  }
+  if ((value = getenv("RO_NET_ALLTOALLV_SPARSE")) != nullptr) {
+    alltoallv_sparse_percent = std::clamp(atoi(value), 0, 100);
+  }
+  if ((value = getenv("RO_NET_RECORD")) != nullptr) {
+    std::string path{std::string{value} + "." + std::to_string(my_pe)};
+    trace_writer = std::make_unique<TraceWriter>();
+    if (!trace_writer->open(path)) {
+      fprintf(stderr, "Cannot create RO command trace %s\n", path.c_str());
+      trace_writer.reset();
+    }
+  }
+  if ((value = getenv("RO_NET_COALESCE")) != nullptr) {
+    CoalescePolicy policy{};
+    if (!parse_coalesce_policy(value, &policy)) {
+      fprintf(stderr, "Ignoring malformed RO_NET_COALESCE=%s\n", value);
+    } else if (policy.enabled()) {
+      coalescer = std::make_unique<PutCoalescer>(
+          policy, [this](const CoalescedPut &run, FlushReason) {
+            issueCoalesced(run);
+          });
+    }
+  }
+}
+
+static uint64_t steady_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
 }
 
 MPITransport::~MPITransport() {}
@@ -69,6 +128,10 @@ void MPITransport::threadProgressEngine() {
   transport_up = true;
   while (!(bp->worker_thread_exit)) {
     submitRequestsToMPI();
+    if (coalescer) {
+      coalescer->expire(steady_ns());
+    }
+    advanceBarrier();
     progress();
   }
   transport_up = false;
@@ -77,39 +140,93 @@ void MPITransport::threadProgressEngine() {
 void MPITransport::insertRequest(const queue_element_t *element, int queue_id) {
   std::unique_lock<std::mutex> mlock(queue_mutex);
   q.push(*element);
+  // Elements are consumed in write order, so the read index is the write
+  // ticket the device drew for this element. Its sequence number is the
+  // ticket plus one so that a completed_seq of zero means nothing is done.
+  q.back().seq = queue->descriptor(queue_id)->read_index + 1;
   q_wgid.push(queue_id);
 }
 
+int MPITransport::heapWindowId(const queue_element_t &element) {
+  auto *bp{backend_proxy->get()};
+  if (bp->heap_ptr->num_heaps() == 1) {
+    return element.ro_net_win_id;
+  }
+
+  /*
+   * The device only knows the window slot of its context. The heap that
+   * holds the remote buffer selects which run of windows the slot indexes;
+   * collectives take it from the destination, so both of their buffers
+   * must come from the same heap.
+   */
+  bool remote_is_src{element.type == RO_NET_GET ||
+                     element.type == RO_NET_GET_NBI};
+  const void *target{remote_is_src ? element.src : element.dst};
+  int heap_idx{bp->heap_ptr->heap_index(target)};
+  return element.ro_net_win_id +
+         heap_idx * static_cast<int>(WindowProxyT::MAX_NUM_WINDOWS);
+}
+
 void MPITransport::submitRequestsToMPI() {
   if (q.empty()) return;
 
   std::unique_lock<std::mutex> mlock(queue_mutex);
+
+  // Collectives have to reach MPI in arrival order, so the next one waits
+  // until the pending barrier has been started.
+  if (pending_barrier && isCollective(q.front().type)) {
+    return;
+  }
+
   queue_element_t next_element{q.front()};
   int queue_idx{q_wgid.front()};
   q.pop();
   q_wgid.pop();
   mlock.unlock();
 
+  next_element.ro_net_win_id = heapWindowId(next_element);
+
+  if (trace_writer) {
+    trace_writer->record({steady_ns(),
+                          reinterpret_cast<uint64_t>(next_element.dst),
+                          reinterpret_cast<uint64_t>(next_element.src),
+                          next_element.ol1.size, next_element.type, queue_idx,
+                          next_element.PE, next_element.ro_net_win_id});
+  }
+
+  // Held back puts leave before any other command of their block, and
+  // before any collective since it may complete them for other PEs.
+  if (coalescer && next_element.type != RO_NET_PUT_NBI) {
+    if (isCollective(next_element.type)) {
+      coalescer->flush_all(FlushReason::SYNC);
+    } else if (next_element.type == RO_NET_QUIET ||
+               next_element.type == RO_NET_FENCE ||
+               next_element.type == RO_NET_FINALIZE) {
+      coalescer->flush(queue_idx, FlushReason::SYNC);
+    } else {
+      coalescer->flush(queue_idx, FlushReason::BREAK);
+    }
+  }
+
   switch (next_element.type) {
     case RO_NET_PUT:
       putMem(next_element.dst, next_element.src, next_element.ol1.size,
              next_element.PE, next_element.ro_net_win_id, queue_idx,
-             next_element.threadId, true);
+             next_element.seq, true);
       DPRINTF("Received PUT dst %p src %p size %lu pe %d win_id %d\n",
               next_element.dst, next_element.src, next_element.ol1.size,
               next_element.PE, next_element.ro_net_win_id);
       break;
     case RO_NET_P: {
       // No equivalent inline OP for MPI.
-      // Allocate a temp buffer for value.
-      // TODO(bpotter) this is a memory leak - fix it
+      // Allocate a temp buffer for value (freed when the request completes).
       void *source_buffer{malloc(next_element.ol1.size)};
 
       ::memcpy(source_buffer, &next_element.src, next_element.ol1.size);
 
       putMem(next_element.dst, source_buffer, next_element.ol1.size,
              next_element.PE, next_element.ro_net_win_id, queue_idx,
-             next_element.threadId, true, true);
+             next_element.seq, true, true);
       DPRINTF("Received P dst %p value %p pe %d\n", next_element.dst,
               next_element.src, next_element.PE);
       break;
@@ -117,14 +234,26 @@ void MPITransport::submitRequestsToMPI() {
     case RO_NET_GET:
       getMem(next_element.dst, next_element.src, next_element.ol1.size,
              next_element.PE, next_element.ro_net_win_id, queue_idx,
-             next_element.threadId, true);
+             next_element.seq, true);
       DPRINTF("Received GET dst %p src %p size %lu pe %d\n", next_element.dst,
               next_element.src, next_element.ol1.size, next_element.PE);
       break;
     case RO_NET_PUT_NBI:
+      if (coalescer && next_element.ol1.size < stripe_threshold) {
+        queue->flush_hdp();
+        TrafficMatrix::GetInstance().record(TrafficClass::PUT, next_element.PE,
+                                            next_element.ol1.size);
+        coalescer->add({steady_ns(),
+                        reinterpret_cast<uint64_t>(next_element.dst),
+                        reinterpret_cast<uint64_t>(next_element.src),
+                        next_element.ol1.size, next_element.type, queue_idx,
+                        next_element.PE, next_element.ro_net_win_id});
+        retire(queue_idx, next_element.seq);
+        break;
+      }
       putMem(next_element.dst, next_element.src, next_element.ol1.size,
              next_element.PE, next_element.ro_net_win_id, queue_idx,
-             next_element.threadId, false);
+             next_element.seq, false);
       DPRINTF("Received PUT NBI dst %p src %p size %lu pe %d\n",
               next_element.dst, next_element.src, next_element.ol1.size,
               next_element.PE);
@@ -132,7 +261,7 @@ void MPITransport::submitRequestsToMPI() {
     case RO_NET_GET_NBI:
       getMem(next_element.dst, next_element.src, next_element.ol1.size,
              next_element.PE, next_element.ro_net_win_id, queue_idx,
-             next_element.threadId, false);
+             next_element.seq, false);
       DPRINTF("Received GET NBI dst %p src %p size %lu pe %d\n",
               next_element.dst, next_element.src, next_element.ol1.size,
               next_element.PE);
@@ -141,7 +270,7 @@ void MPITransport::submitRequestsToMPI() {
       amoFOP(next_element.dst, next_element.src,
              const_cast<unsigned long long *>(&next_element.ol1.atomic_value),
              next_element.PE, next_element.ro_net_win_id, queue_idx,
-             next_element.threadId, true,
+             next_element.seq, true,
              static_cast<ROCSHMEM_OP>(next_element.op),
              static_cast<ro_net_types>(next_element.datatype));
       DPRINTF("Received AMO dst %p src %p Val %llu pe %d\n", next_element.dst,
@@ -151,7 +280,7 @@ void MPITransport::submitRequestsToMPI() {
       amoFCAS(next_element.dst, next_element.src,
               const_cast<unsigned long long *>(&next_element.ol1.atomic_value),
               next_element.PE, next_element.ro_net_win_id, queue_idx,
-              next_element.threadId, true,
+              next_element.seq, true,
               const_cast<void **>(&next_element.ol2.pWrk),
               static_cast<ro_net_types>(next_element.datatype));
       DPRINTF("Received F_CSWAP dst %p src %p Val %llu pe %d cond %ld\n",
@@ -159,17 +288,57 @@ void MPITransport::submitRequestsToMPI() {
               next_element.PE,
               reinterpret_cast<int64_t>(next_element.ol2.pWrk));
       break;
+    case RO_NET_AMO_VECTOR:
+      amoVector(next_element.dst, next_element.src,
+                static_cast<size_t *>(next_element.ol2.pWrk), next_element.pes,
+                next_element.ol1.size, next_element.ro_net_win_id, queue_idx,
+                next_element.seq,
+                static_cast<ROCSHMEM_OP>(next_element.op),
+                static_cast<ro_net_types>(next_element.datatype));
+      DPRINTF("Received AMO VECTOR dst %p src %p nelems %lu\n",
+              next_element.dst, next_element.src, next_element.ol1.size);
+      break;
+    case RO_NET_AMO_STRIDED:
+      amoStrided(next_element.dst, next_element.src, next_element.logPE_stride,
+                 next_element.ol1.size, next_element.PE,
+                 next_element.ro_net_win_id, queue_idx, next_element.seq,
+                 static_cast<ROCSHMEM_OP>(next_element.op),
+                 static_cast<ro_net_types>(next_element.datatype));
+      DPRINTF("Received AMO STRIDED dst %p src %p stride %d nelems %lu pe %d\n",
+              next_element.dst, next_element.src, next_element.logPE_stride,
+              next_element.ol1.size, next_element.PE);
+      break;
+    case RO_NET_AM:
+      activeMessage(next_element.dst, next_element.src, next_element.PE_root,
+                    next_element.ol1.atomic_value,
+                    reinterpret_cast<uint64_t>(next_element.ol2.pWrk),
+                    next_element.PE, next_element.ro_net_win_id, queue_idx,
+                    next_element.seq);
+      DPRINTF("Received AM dst %p handler %d pe %d\n", next_element.dst,
+              next_element.PE_root, next_element.PE);
+      break;
     case RO_NET_TEAM_REDUCE:
       team_reduction(next_element.dst, next_element.src, next_element.ol1.size,
                      next_element.ro_net_win_id, queue_idx,
                      next_element.team_comm,
                      static_cast<ROCSHMEM_OP>(next_element.op),
                      static_cast<ro_net_types>(next_element.datatype),
-                     next_element.threadId, true);
+                     next_element.seq, true);
       DPRINTF("Received FLOAT_SUM_TEAM_REDUCE dst %p src %p size %lu team %d\n",
               next_element.dst, next_element.src, next_element.ol1.size,
               next_element.team_comm);
       break;
+    case RO_NET_REDUCE_SCATTER:
+      reduce_scatter(next_element.dst, next_element.src, next_element.ol1.size,
+                     next_element.ro_net_win_id, queue_idx,
+                     next_element.team_comm,
+                     static_cast<ROCSHMEM_OP>(next_element.op),
+                     static_cast<ro_net_types>(next_element.datatype),
+                     next_element.seq, true);
+      DPRINTF("Received REDUCE_SCATTER dst %p src %p size %lu team %d\n",
+              next_element.dst, next_element.src, next_element.ol1.size,
+              next_element.team_comm);
+      break;
     case RO_NET_TO_ALL:
       reduction(next_element.dst, next_element.src, next_element.ol1.size,
                 next_element.PE, next_element.ro_net_win_id, queue_idx,
@@ -177,7 +346,7 @@ void MPITransport::submitRequestsToMPI() {
                 next_element.PE_size, next_element.ol2.pWrk, next_element.pSync,
                 static_cast<ROCSHMEM_OP>(next_element.op),
                 static_cast<ro_net_types>(next_element.datatype),
-                next_element.threadId, true);
+                next_element.seq, true);
       DPRINTF(
           "Received FLOAT_SUM_TO_ALL dst %p src %p size %lu "
           "PE_start %d, logPE_stride %d, PE_size %d, pWrk %p, pSync %p\n",
@@ -190,7 +359,7 @@ void MPITransport::submitRequestsToMPI() {
                      next_element.ro_net_win_id, queue_idx,
                      next_element.team_comm, next_element.PE_root,
                      static_cast<ro_net_types>(next_element.datatype),
-                     next_element.threadId, true);
+                     next_element.seq, true);
       DPRINTF(
           "Received TEAM_BROADCAST dst %p src %p size %lu "
           "team %d, PE_root %d \n",
@@ -203,7 +372,7 @@ void MPITransport::submitRequestsToMPI() {
                 next_element.PE, next_element.logPE_stride,
                 next_element.PE_size, next_element.PE_root, next_element.pSync,
                 static_cast<ro_net_types>(next_element.datatype),
-                next_element.threadId, true);
+                next_element.seq, true);
       DPRINTF(
           "Received BROADCAST dst %p src %p size %lu PE_start %d, "
           "logPE_stride %d, PE_size %d, PE_root %d, pSync %p\n",
@@ -216,7 +385,7 @@ void MPITransport::submitRequestsToMPI() {
                next_element.ro_net_win_id, queue_idx, next_element.team_comm,
                next_element.ol2.pWrk,
                static_cast<ro_net_types>(next_element.datatype),
-               next_element.threadId, true);
+               next_element.seq, true);
       DPRINTF("Received ALLTOALL  dst %p src %p size %lu team %d\n",
               next_element.dst, next_element.src, next_element.ol1.size,
               next_element.team_comm);
@@ -226,26 +395,49 @@ void MPITransport::submitRequestsToMPI() {
                next_element.ro_net_win_id, queue_idx, next_element.team_comm,
                next_element.ol2.pWrk,
                static_cast<ro_net_types>(next_element.datatype),
-               next_element.threadId, true);
+               next_element.seq, true);
       DPRINTF("Received FCOLLECT  dst %p src %p size %lu team %d\n",
               next_element.dst, next_element.src, next_element.ol1.size,
               next_element.team_comm);
       break;
+    case RO_NET_FCOLLECTV:
+      fcollectv(next_element.dst, next_element.src, next_element.pes,
+                next_element.ro_net_win_id, queue_idx, next_element.team_comm,
+                static_cast<ro_net_types>(next_element.datatype),
+                next_element.seq, true);
+      DPRINTF("Received FCOLLECTV dst %p src %p counts %p team %d\n",
+              next_element.dst, next_element.src, next_element.pes,
+              next_element.team_comm);
+      break;
+    case RO_NET_ALLTOALLV:
+      alltoallv(next_element.dst, next_element.src, next_element.pes,
+                static_cast<int *>(next_element.ol2.pWrk),
+                next_element.dest_counts, next_element.dest_displs, queue_idx,
+                next_element.team_comm,
+                static_cast<ro_net_types>(next_element.datatype),
+                next_element.seq, true);
+      DPRINTF("Received ALLTOALLV dst %p src %p team %d\n", next_element.dst,
+              next_element.src, next_element.team_comm);
+      break;
     case RO_NET_BARRIER_ALL:
-      barrier(queue_idx, next_element.threadId, true, ro_net_comm_world);
+      barrierWithCompletion(queue_idx, next_element.seq, ro_net_comm_world);
       DPRINTF("Received Barrier_all\n");
       break;
     case RO_NET_SYNC:
-      barrier(queue_idx, next_element.threadId, true, next_element.team_comm);
+      barrierWithCompletion(queue_idx, next_element.seq,
+                            next_element.team_comm);
       DPRINTF("Received Sync\n");
       break;
     case RO_NET_FENCE:
+      fence(queue_idx, next_element.seq);
+      DPRINTF("Received FENCE\n");
+      break;
     case RO_NET_QUIET:
-      quiet(queue_idx, next_element.threadId);
-      DPRINTF("Received FENCE/QUIET\n");
+      quiet(queue_idx, next_element.seq);
+      DPRINTF("Received QUIET\n");
       break;
     case RO_NET_FINALIZE:
-      quiet(queue_idx, next_element.threadId);
+      quiet(queue_idx, next_element.seq);
       DPRINTF("Received Finalize\n");
       break;
     default:
@@ -256,13 +448,17 @@ void MPITransport::submitRequestsToMPI() {
 }
 
 void MPITransport::initTransport(int num_queues, BackendProxyT *proxy) {
-  waiting_quiet.resize(num_queues, std::vector<int>());
+  waiting_quiet.resize(num_queues, std::vector<uint64_t>());
+  completions.resize(num_queues);
   outstanding.resize(num_queues, 0);
+  dirty_targets.resize(num_queues);
   transport_up = false;
 
   backend_proxy = proxy;
   auto *bp{backend_proxy->get()};
 
+  createStripeLanes();
+
   host_interface =
       new HostInterface(bp->hdp_policy, ro_net_comm_world, bp->heap_ptr);
   progress_thread = std::thread(&MPITransport::threadProgressEngine, this);
@@ -272,7 +468,45 @@ void MPITransport::initTransport(int num_queues, BackendProxyT *proxy) {
 
 void MPITransport::finalizeTransport() {
   progress_thread.join();
+  for (auto &reply : am_replies) {
+    NET_CHECK(MPI_Wait(&reply.request, MPI_STATUS_IGNORE));
+  }
+  am_replies.clear();
+  NET_CHECK(MPI_Comm_free(&am_comm));
+  for (auto &[team, comm] : alltoallv_comms) {
+    NET_CHECK(MPI_Comm_free(&comm));
+  }
+  alltoallv_comms.clear();
   delete host_interface;
+  freeStripeLanes();
+}
+
+void MPITransport::createStripeLanes() {
+  if (stripe_lanes < 2) {
+    return;
+  }
+
+  auto *heap{backend_proxy->get()->heap_ptr};
+
+  stripe_comms.resize(stripe_lanes);
+  for (auto &comm : stripe_comms) {
+    NET_CHECK(MPI_Comm_dup(ro_net_comm_world, &comm));
+  }
+
+  for (int h{0}; h < heap->num_heaps(); h++) {
+    for (const auto comm : stripe_comms) {
+      stripe_windows.push_back(std::make_unique<WindowInfo>(
+          comm, heap->get_local_heap_base(h), heap->get_size(h)));
+    }
+  }
+}
+
+void MPITransport::freeStripeLanes() {
+  stripe_windows.clear();
+  for (auto &comm : stripe_comms) {
+    NET_CHECK(MPI_Comm_free(&comm));
+  }
+  stripe_comms.clear();
 }
 
 rocshmem_team_t get_external_team(ROTeam *team) {
@@ -284,64 +518,102 @@ void MPITransport::createNewTeam(ROBackend *backend, Team *parent_team,
                                    TeamInfo *team_info_wrt_world, int num_pes,
                                    int my_pe_in_new_team, MPI_Comm team_comm,
                                    rocshmem_team_t *new_team) {
-  ROTeam *new_team_obj{nullptr};
-
-  CHECK_HIP(hipMalloc(&new_team_obj, sizeof(ROTeam)));
+  auto *new_team_obj{static_cast<ROTeam *>(
+      backend->team_metadata_pool.allocate(sizeof(ROTeam)))};
 
   new (new_team_obj) ROTeam(backend, team_info_wrt_parent, team_info_wrt_world,
                             num_pes, my_pe_in_new_team, team_comm);
 
+  registerAlltoallvComm(team_comm);
+
   *new_team = get_external_team(new_team_obj);
 }
 
 MPI_Comm MPITransport::createComm(int start, int stride, int size) {
-  CommKey key(start, stride, size);
-  auto it{comm_map.find(key)};
-  if (it != comm_map.end()) {
-    DPRINTF("Using cached communicator\n");
-    return it->second;
-  }
-
-  int world_size{};
-  NET_CHECK(MPI_Comm_size(ro_net_comm_world, &world_size));
-
-  MPI_Comm comm{};
-  if (start == 0 && stride == 1 && size == world_size) {
-    NET_CHECK(MPI_Comm_dup(ro_net_comm_world, &comm));
-  } else {
-    MPI_Group world_group{};
-    NET_CHECK(MPI_Comm_group(ro_net_comm_world, &world_group));
-
-    std::vector<int> group_ranks(size);
-    group_ranks[0] = start;
-    for (int i{1}; i < size; i++) {
-      group_ranks[i] = group_ranks[i - 1] + stride;
-    }
-
-    MPI_Group new_group{};
-    NET_CHECK(MPI_Group_incl(world_group, size, group_ranks.data(), &new_group));
-    NET_CHECK(MPI_Comm_create_group(ro_net_comm_world, new_group, 0, &comm));
-  }
-
-  comm_map.insert(std::pair<CommKey, MPI_Comm>(key, comm));
-  DPRINTF("Creating new communicator\n");
-
-  return comm;
+  return comm_cache->shared(ro_net_comm_world, start, stride, size);
 }
 
 void MPITransport::global_exit(int status) {
   MPI_Abort(ro_net_comm_world, status);
 }
 
-void MPITransport::barrier(int blockId, int threadId, bool blocking,
+void MPITransport::barrier(int blockId, uint64_t seq, bool blocking,
                              MPI_Comm team) {
   MPI_Request request{};
   NET_CHECK(MPI_Ibarrier(team, &request));
 
-  requests.push_back({request, {threadId, blockId, blocking}});
+  requests.push_back({request, {seq, blockId, blocking}});
   outstanding[blockId]++;
 }
 
+void MPITransport::barrierWithCompletion(int blockId, uint64_t seq,
+                                         MPI_Comm team) {
+  assert(!pending_barrier);
+
+  pending_barrier.emplace();
+  pending_barrier->blockId = blockId;
+  pending_barrier->seq = seq;
+  pending_barrier->team = team;
+  takeAllDirty(&pending_barrier->flushes);
+  startBarrierFlush();
+
+  // Counts as in flight from now on so that a quiet issued by the same
+  // block cannot finish ahead of it.
+  outstanding[blockId]++;
+
+  advanceBarrier();
+}
+
+void MPITransport::advanceBarrier(bool drain) {
+  if (!pending_barrier) {
+    return;
+  }
+
+  auto &pending{*pending_barrier};
+  size_t end{pending.flushes.size()};
+  if (!drain) {
+    end = std::min(end, pending.flushed + barrier_flush_batch);
+  }
+
+  for (; pending.flushed < end; pending.flushed++) {
+    const auto &[win, pe] = pending.flushes[pending.flushed];
+    NET_CHECK(MPI_Win_flush(pe, win));
+  }
+
+  if (pending.flushed < pending.flushes.size() || !barrierFlushed()) {
+    return;
+  }
+
+  DPRINTF("Starting barrier for blockId %d after %zu flushes\n",
+          pending.blockId, pending.flushes.size());
+
+  MPI_Request request{};
+  NET_CHECK(MPI_Ibarrier(pending.team, &request));
+  requests.push_back({request, {pending.seq, pending.blockId, true}});
+  pending_barrier.reset();
+}
+
+bool MPITransport::isCollective(ro_net_cmds type) {
+  switch (type) {
+    case RO_NET_PUT:
+    case RO_NET_P:
+    case RO_NET_GET:
+    case RO_NET_PUT_NBI:
+    case RO_NET_GET_NBI:
+    case RO_NET_AMO_FOP:
+    case RO_NET_AMO_FCAS:
+    case RO_NET_AMO_VECTOR:
+    case RO_NET_AMO_STRIDED:
+    case RO_NET_AM:
+    case RO_NET_FENCE:
+    case RO_NET_QUIET:
+    case RO_NET_FINALIZE:
+      return false;
+    default:
+      return true;
+  }
+}
+
 MPI_Op MPITransport::get_mpi_op(ROCSHMEM_OP op) {
   switch (op) {
     case ROCSHMEM_SUM:
@@ -382,6 +654,8 @@ static MPI_Datatype convertType(ro_net_types type) {
       return MPI_LONG_LONG;
     case RO_NET_SHORT:
       return MPI_SHORT;
+    case RO_NET_CHAR:
+      return MPI_CHAR;
     case RO_NET_LONG_DOUBLE:
       return MPI_LONG_DOUBLE;
     default:
@@ -393,13 +667,15 @@ static MPI_Datatype convertType(ro_net_types type) {
 void MPITransport::reduction(void *dst, void *src, int size, int pe,
                                int win_id, int blockId, int start, int logPstride,
                                int sizePE, void *pWrk, long *pSync,
-                               ROCSHMEM_OP op, ro_net_types type, int threadId,
+                               ROCSHMEM_OP op, ro_net_types type, uint64_t seq,
                                bool blocking) {
   MPI_Request request{};
   MPI_Op mpi_op{get_mpi_op(op)};
   MPI_Datatype mpi_type{convertType(type)};
   MPI_Comm comm{createComm(start, 1 << logPstride, sizePE)};
 
+  recordCollective(comm, size, type);
+
   if (dst == src) {
     NET_CHECK(MPI_Iallreduce(MPI_IN_PLACE, dst, size, mpi_type, mpi_op, comm,
                              &request));
@@ -407,14 +683,14 @@ void MPITransport::reduction(void *dst, void *src, int size, int pe,
     NET_CHECK(MPI_Iallreduce(src, dst, size, mpi_type, mpi_op, comm, &request));
   }
 
-  requests.push_back({request, {threadId, blockId, blocking}});
+  requests.push_back({request, {seq, blockId, blocking}});
   outstanding[blockId]++;
 }
 
 void MPITransport::broadcast(void *dst, void *src, int size, int pe,
                                int win_id, int blockId, int start, int logPstride,
                                int sizePE, int root, long *pSync,
-                               ro_net_types type, int threadId, bool blocking) {
+                               ro_net_types type, uint64_t seq, bool blocking) {
   MPI_Comm comm{createComm(start, 1 << logPstride, sizePE)};
 
   int new_rank{};
@@ -423,6 +699,7 @@ void MPITransport::broadcast(void *dst, void *src, int size, int pe,
   void *data{nullptr};
   if (new_rank == root) {
     data = src;
+    recordCollective(comm, size, type);
   } else {
     data = dst;
   }
@@ -431,14 +708,14 @@ void MPITransport::broadcast(void *dst, void *src, int size, int pe,
   MPI_Datatype mpi_type{convertType(type)};
   NET_CHECK(MPI_Ibcast(data, size, mpi_type, root, comm, &request));
 
-  requests.push_back({request, {threadId, blockId, blocking}});
+  requests.push_back({request, {seq, blockId, blocking}});
 
   outstanding[blockId]++;
 }
 
 void MPITransport::team_reduction(void *dst, void *src, int size, int win_id,
                                     int blockId, MPI_Comm team, ROCSHMEM_OP op,
-                                    ro_net_types type, int threadId,
+                                    ro_net_types type, uint64_t seq,
                                     bool blocking) {
   MPI_Request request{};
 
@@ -446,6 +723,8 @@ void MPITransport::team_reduction(void *dst, void *src, int size, int win_id,
   MPI_Datatype mpi_type{convertType(type)};
   MPI_Comm comm{team};
 
+  recordCollective(comm, size, type);
+
   if (dst == src) {
     NET_CHECK(MPI_Iallreduce(MPI_IN_PLACE, dst, size, mpi_type, mpi_op, comm,
                              &request));
@@ -453,14 +732,40 @@ void MPITransport::team_reduction(void *dst, void *src, int size, int win_id,
     NET_CHECK(MPI_Iallreduce(src, dst, size, mpi_type, mpi_op, comm, &request));
   }
 
-  requests.push_back({request, {threadId, blockId, blocking}});
+  requests.push_back({request, {seq, blockId, blocking}});
+
+  outstanding[blockId]++;
+}
+
+void MPITransport::reduce_scatter(void *dst, void *src, int size, int win_id,
+                                  int blockId, MPI_Comm team, ROCSHMEM_OP op,
+                                  ro_net_types type, uint64_t seq,
+                                  bool blocking) {
+  MPI_Request request{};
+
+  MPI_Op mpi_op{get_mpi_op(op)};
+  MPI_Datatype mpi_type{convertType(type)};
+  MPI_Comm comm{team};
+
+  recordCollective(comm, size, type);
+
+  // In place, the full input sits in dst and the result lands at its start.
+  if (dst == src) {
+    NET_CHECK(MPI_Ireduce_scatter_block(MPI_IN_PLACE, dst, size, mpi_type,
+                                        mpi_op, comm, &request));
+  } else {
+    NET_CHECK(MPI_Ireduce_scatter_block(src, dst, size, mpi_type, mpi_op,
+                                        comm, &request));
+  }
+
+  requests.push_back({request, {seq, blockId, blocking}});
 
   outstanding[blockId]++;
 }
 
 void MPITransport::team_broadcast(void *dst, void *src, int size, int win_id,
                                     int blockId, MPI_Comm team, int root,
-                                    ro_net_types type, int threadId,
+                                    ro_net_types type, uint64_t seq,
                                     bool blocking) {
   MPI_Comm comm{team};
   int new_rank{};
@@ -468,6 +773,7 @@ void MPITransport::team_broadcast(void *dst, void *src, int size, int win_id,
   void *data{nullptr};
   if (new_rank == root) {
     data = src;
+    recordCollective(comm, size, type);
   } else {
     data = dst;
   }
@@ -476,20 +782,22 @@ void MPITransport::team_broadcast(void *dst, void *src, int size, int win_id,
   MPI_Request request{};
   NET_CHECK(MPI_Ibcast(data, size, mpi_type, root, comm, &request));
 
-  requests.push_back({request, {threadId, blockId, blocking}});
+  requests.push_back({request, {seq, blockId, blocking}});
 
   outstanding[blockId]++;
 }
 
 void MPITransport::alltoall(void *dst, void *src, int size, int win_id,
                               int blockId, MPI_Comm team, void *ata_buffptr,
-                              ro_net_types type, int threadId, bool blocking) {
+                              ro_net_types type, uint64_t seq, bool blocking) {
   int pe_size{};
   NET_CHECK(MPI_Comm_size(team, &pe_size));
 
   int type_size{};
   NET_CHECK(MPI_Type_size(convertType(type), &type_size));
 
+  recordCollective(team, size, type);
+
   int num_clust = sqrt(pe_size);
   int clust_size{(pe_size + num_clust - 1) / num_clust};
 
@@ -497,15 +805,15 @@ void MPITransport::alltoall(void *dst, void *src, int size, int win_id,
   if ((pe_size >= 8 || type_size * size < 2048) &&
       num_clust * clust_size == pe_size) {
     return alltoall_gcen(dst, src, size, win_id, blockId, team, ata_buffptr, type,
-                         threadId, blocking);
+                         seq, blocking);
   } else if (size <= 512) {
 #endif // A2A_HEURISTICS
     return alltoall_mpi(dst, src, size, blockId, team, ata_buffptr, type,
-                        threadId, blocking);
+                        seq, blocking);
 #ifdef A2A_HEURISTICS
   } else {
     return alltoall_broadcast(dst, src, size, win_id, blockId, team, ata_buffptr,
-                              type, threadId, blocking);
+                              type, seq, blocking);
   }
 #endif // A2A_HEURISTICS
 }
@@ -513,7 +821,7 @@ void MPITransport::alltoall(void *dst, void *src, int size, int win_id,
 void MPITransport::alltoall_broadcast(void *dst, void *src, int size,
                                         int win_id, int blockId, MPI_Comm team,
                                         void *ata_buffptr, ro_net_types type,
-                                        int threadId, bool blocking) {
+                                        uint64_t seq, bool blocking) {
   auto *bp{backend_proxy->get()};
 
   MPI_Comm comm{team};
@@ -557,12 +865,12 @@ void MPITransport::alltoall_broadcast(void *dst, void *src, int size,
   NET_CHECK(MPI_Waitall(pe_size, pe_req.data(), MPI_STATUSES_IGNORE));
   NET_CHECK(MPI_Win_flush_all(bp->heap_window_info[win_id]->get_win()));
 
-  barrier(blockId, threadId, blocking, comm);
+  barrier(blockId, seq, blocking, comm);
 }
 
 void MPITransport::alltoall_mpi(void *dst, void *src, int size, int blockId,
                                   MPI_Comm team, void *ata_buffptr,
-                                  ro_net_types type, int threadId,
+                                  ro_net_types type, uint64_t seq,
                                   bool blocking) {
   int new_rank{};
   NET_CHECK(MPI_Comm_rank(team, &new_rank));
@@ -570,12 +878,12 @@ void MPITransport::alltoall_mpi(void *dst, void *src, int size, int blockId,
   NET_CHECK(MPI_Comm_size(team, &pe_size));
   MPI_Datatype mpi_type{convertType(type)};
   NET_CHECK(MPI_Alltoall(src, size, mpi_type, dst, size, mpi_type, team));
-  quiet(blockId, threadId);
+  quiet(blockId, seq);
 }
 
 void MPITransport::alltoall_gcen(void *dst, void *src, int size, int win_id,
                                    int blockId, MPI_Comm team, void *ata_buffptr,
-                                   ro_net_types type, int threadId,
+                                   ro_net_types type, uint64_t seq,
                                    bool blocking) {
   auto *bp{backend_proxy->get()};
 
@@ -658,13 +966,13 @@ void MPITransport::alltoall_gcen(void *dst, void *src, int size, int win_id,
   MPI_Comm comm_ring{createComm(world_ranks[new_rank % clust_size],
                                 stride * clust_size, num_clust)};
 
-  barrier(blockId, threadId, false, comm_cluster);
-  barrier(blockId, threadId, blocking, comm_ring);
+  barrier(blockId, seq, false, comm_cluster);
+  barrier(blockId, seq, blocking, comm_ring);
 }
 
 void MPITransport::alltoall_gcen2(void *dst, void *src, int size, int win_id,
                                     int blockId, MPI_Comm team, void *ata_buffptr,
-                                    ro_net_types type, int threadId,
+                                    ro_net_types type, uint64_t seq,
                                     bool blocking) {
   // GPU-centric alltoall with in-place blocking synchronization
   auto *bp{backend_proxy->get()};
@@ -753,12 +1061,12 @@ void MPITransport::alltoall_gcen2(void *dst, void *src, int size, int win_id,
   MPI_Comm comm_ring = createComm(world_ranks[new_rank % clust_size],
                                   stride * clust_size, num_clust);
   // Now wait for completion
-  barrier(blockId, threadId, blocking, comm_ring);
+  barrier(blockId, seq, blocking, comm_ring);
 }
 
 void MPITransport::fcollect(void *dst, void *src, int size, int win_id,
                               int blockId, MPI_Comm team, void *ata_buffptr,
-                              ro_net_types type, int threadId, bool blocking) {
+                              ro_net_types type, uint64_t seq, bool blocking) {
   int pe_size, type_size;
   MPI_Comm comm = team;
   NET_CHECK(MPI_Comm_size(comm, &pe_size));
@@ -766,6 +1074,8 @@ void MPITransport::fcollect(void *dst, void *src, int size, int win_id,
   MPI_Datatype mpi_type = convertType(type);
   NET_CHECK(MPI_Type_size(mpi_type, &type_size));
 
+  recordCollective(comm, size, type);
+
   // Currently GPU-centric algo only supports multiples of square root
   // TODO(bpotter) Allow any size of cluster
   int num_clust = sqrt(pe_size);
@@ -775,20 +1085,246 @@ void MPITransport::fcollect(void *dst, void *src, int size, int win_id,
   // But it crashes for > 512 messages
   if (size <= 512) {
     fcollect_mpi(dst, src, size, blockId, team, ata_buffptr, type,
-                        threadId, blocking);
+                        seq, blocking);
   } else if (num_clust * clust_size == pe_size) {
     fcollect_gcen(dst, src, size, win_id, blockId, team, ata_buffptr, type,
-                         threadId, blocking);
+                         seq, blocking);
   } else {
     fcollect_broadcast(dst, src, size, win_id, blockId, team, ata_buffptr,
-                              type, threadId, blocking);
+                              type, seq, blocking);
+  }
+}
+
+void MPITransport::fcollectv(void *dst, void *src, const int *counts,
+                             int win_id, int blockId, MPI_Comm team,
+                             ro_net_types type, uint64_t seq, bool blocking) {
+  // The counts array lives in GPU memory.
+  queue->flush_hdp();
+
+  int rank{}, pe_size{};
+  MPI_Comm comm{team};
+  NET_CHECK(MPI_Comm_rank(comm, &rank));
+  NET_CHECK(MPI_Comm_size(comm, &pe_size));
+
+  /*
+   * MPI reads the counts and displacements until the request completes,
+   * so they are staged in one buffer that is released with the request.
+   */
+  int *staged{static_cast<int *>(malloc(2 * pe_size * sizeof(int)))};
+  int *recv_counts{staged};
+  int *displs{staged + pe_size};
+  int offset{0};
+  for (int i{0}; i < pe_size; i++) {
+    recv_counts[i] = counts[i];
+    displs[i] = offset;
+    offset += counts[i];
+  }
+
+  recordCollective(comm, recv_counts[rank], type);
+
+  MPI_Datatype mpi_type{convertType(type)};
+  MPI_Request request{};
+  NET_CHECK(MPI_Iallgatherv(src, recv_counts[rank], mpi_type, dst,
+                            recv_counts, displs, mpi_type, comm, &request));
+
+  requests.push_back({request, {seq, blockId, blocking, staged, true}});
+
+  outstanding[blockId]++;
+}
+
+void MPITransport::alltoallv(void *dst, void *src, const int *source_counts,
+                             const int *source_displs, const int *dest_counts,
+                             const int *dest_displs, int blockId,
+                             MPI_Comm team, ro_net_types type, uint64_t seq,
+                             bool blocking) {
+  // The counts and displacements live in GPU memory.
+  queue->flush_hdp();
+
+  int rank{}, pe_size{};
+  MPI_Comm comm{team};
+  NET_CHECK(MPI_Comm_rank(comm, &rank));
+  NET_CHECK(MPI_Comm_size(comm, &pe_size));
+
+  int type_size{};
+  NET_CHECK(MPI_Type_size(convertType(type), &type_size));
+  TrafficMatrix::GetInstance().record_team(TrafficClass::COLL, comm,
+                                           source_counts, type_size);
+
+  MPI_Comm data_comm{MPI_COMM_NULL};
+  {
+    std::lock_guard<std::mutex> lock(alltoallv_comms_mutex);
+    auto it{alltoallv_comms.find(comm)};
+    if (it != alltoallv_comms.end()) {
+      data_comm = it->second;
+    }
+  }
+  if (data_comm == MPI_COMM_NULL) {
+    fprintf(stderr, "alltoallv on a communicator without a team on PE %d\n",
+            my_pe);
+    abort();
+  }
+
+  auto &pending{pending_alltoallvs.emplace_back()};
+  pending.dst = static_cast<char *>(dst);
+  pending.src = static_cast<const char *>(src);
+  pending.pe_size = pe_size;
+  pending.rank = rank;
+  pending.comm = data_comm;
+  pending.type = type;
+  pending.blockId = blockId;
+  pending.seq = seq;
+  pending.blocking = blocking;
+
+  // MPI reads the arrays until the exchange completes.
+  pending.staged = static_cast<int *>(malloc(4 * pe_size * sizeof(int)));
+  ::memcpy(pending.staged, source_counts, pe_size * sizeof(int));
+  ::memcpy(pending.staged + pe_size, source_displs, pe_size * sizeof(int));
+  ::memcpy(pending.staged + 2 * pe_size, dest_counts, pe_size * sizeof(int));
+  ::memcpy(pending.staged + 3 * pe_size, dest_displs, pe_size * sizeof(int));
+
+  outstanding[blockId]++;
+
+  /*
+   * Both paths must be taken on every PE of the team, so they agree on the
+   * largest number of peers any one PE exchanges data with. The reduction
+   * is issued now, in command order with the team's other collectives, and
+   * progress() starts the exchange once it has finished.
+   */
+  if (alltoallv_sparse_percent) {
+    for (int i{0}; i < pe_size; i++) {
+      if (i != rank && (source_counts[i] || dest_counts[i])) {
+        pending.peers++;
+      }
+    }
+    NET_CHECK(MPI_Iallreduce(&pending.peers, &pending.max_peers, 1, MPI_INT,
+                             MPI_MAX, comm, &pending.decision));
+  }
+
+  advanceAlltoallv();
+}
+
+void MPITransport::destroyTeam(MPI_Comm team) {
+  std::lock_guard<std::mutex> lock(alltoallv_comms_mutex);
+  auto it{alltoallv_comms.find(team)};
+  if (it == alltoallv_comms.end()) {
+    return;
+  }
+
+  NET_CHECK(MPI_Comm_free(&it->second));
+  alltoallv_comms.erase(it);
+}
+
+void MPITransport::registerAlltoallvComm(MPI_Comm team) {
+  std::lock_guard<std::mutex> lock(alltoallv_comms_mutex);
+  if (alltoallv_comms.count(team)) {
+    return;
+  }
+
+  MPI_Comm comm{MPI_COMM_NULL};
+  NET_CHECK(MPI_Comm_dup(team, &comm));
+  alltoallv_comms.emplace(team, comm);
+}
+
+void MPITransport::advanceAlltoallv() {
+  while (!pending_alltoallvs.empty()) {
+    auto &pending{pending_alltoallvs.front()};
+
+    int decided{0};
+    NET_CHECK(MPI_Test(&pending.decision, &decided, MPI_STATUS_IGNORE));
+    if (!decided) {
+      return;
+    }
+
+    if (alltoallv_sparse_percent &&
+        pending.max_peers * 100 <=
+            alltoallv_sparse_percent * (pending.pe_size - 1)) {
+      alltoallvSparse(pending);
+    } else {
+      int *staged{pending.staged};
+      int pe_size{pending.pe_size};
+      MPI_Datatype mpi_type{convertType(pending.type)};
+      MPI_Request request{};
+      NET_CHECK(MPI_Ialltoallv(pending.src, staged, staged + pe_size,
+                               mpi_type, pending.dst, staged + 2 * pe_size,
+                               staged + 3 * pe_size, mpi_type, pending.comm,
+                               &request));
+
+      requests.push_back({request, {pending.seq, pending.blockId,
+                                    pending.blocking, staged, true}});
+    }
+
+    pending_alltoallvs.pop_front();
+  }
+}
+
+void MPITransport::alltoallvSparse(const PendingAlltoallv &pending) {
+  int rank{pending.rank};
+  int pe_size{pending.pe_size};
+  const int *source_counts{pending.staged};
+  const int *source_displs{pending.staged + pe_size};
+  const int *dest_counts{pending.staged + 2 * pe_size};
+  const int *dest_displs{pending.staged + 3 * pe_size};
+
+  MPI_Datatype mpi_type{convertType(pending.type)};
+  int type_size{};
+  NET_CHECK(MPI_Type_size(mpi_type, &type_size));
+
+  if (source_counts[rank]) {
+    ::memcpy(pending.dst + static_cast<size_t>(dest_displs[rank]) * type_size,
+             pending.src +
+                 static_cast<size_t>(source_displs[rank]) * type_size,
+             static_cast<size_t>(source_counts[rank]) * type_size);
+  }
+
+  int num_requests{0};
+  for (int i{0}; i < pe_size; i++) {
+    if (i != rank) {
+      num_requests += (source_counts[i] != 0) + (dest_counts[i] != 0);
+    }
+  }
+
+  DPRINTF("Sparse alltoallv with %d requests\n", num_requests);
+
+  // Every request carries the staged arrays; the last to finish frees them.
+  RequestProperties properties{pending.seq, pending.blockId, pending.blocking,
+                               pending.staged, true};
+
+  if (!num_requests) {
+    completeRequest(properties);
+    return;
+  }
+
+  /*
+   * Exchanges on the alltoallv communicator start in the same order on
+   * every PE and MPI matches messages in order, so a single tag is enough.
+   */
+  constexpr int tag{0};
+  properties.group = newRequestGroup(num_requests);
+
+  for (int i{0}; i < pe_size; i++) {
+    if (i == rank) {
+      continue;
+    }
+    MPI_Request request{};
+    if (dest_counts[i]) {
+      NET_CHECK(MPI_Irecv(
+          pending.dst + static_cast<size_t>(dest_displs[i]) * type_size,
+          dest_counts[i], mpi_type, i, tag, pending.comm, &request));
+      requests.push_back({request, properties});
+    }
+    if (source_counts[i]) {
+      NET_CHECK(MPI_Isend(
+          pending.src + static_cast<size_t>(source_displs[i]) * type_size,
+          source_counts[i], mpi_type, i, tag, pending.comm, &request));
+      requests.push_back({request, properties});
+    }
   }
 }
 
 void MPITransport::fcollect_broadcast(void *dst, void *src, int size,
                                         int win_id, int blockId, MPI_Comm team,
                                         void *ata_buffptr, ro_net_types type,
-                                        int threadId, bool blocking) {
+                                        uint64_t seq, bool blocking) {
   // Broadcast implementation of fcollect
   auto *bp{backend_proxy->get()};
   int new_rank, pe_size;
@@ -831,12 +1367,12 @@ void MPITransport::fcollect_broadcast(void *dst, void *src, int size,
   NET_CHECK(MPI_Win_flush_all(bp->heap_window_info[win_id]->get_win()));
 
   // Now wait for completion
-  barrier(blockId, threadId, blocking, comm);
+  barrier(blockId, seq, blocking, comm);
 }
 
 void MPITransport::fcollect_mpi(void *dst, void *src, int size, int blockId,
                                   MPI_Comm team, void *ata_buffptr,
-                                  ro_net_types type, int threadId,
+                                  ro_net_types type, uint64_t seq,
                                   bool blocking) {
   // MPI's implementation of fcollect
   int new_rank, pe_size;
@@ -846,12 +1382,12 @@ void MPITransport::fcollect_mpi(void *dst, void *src, int size, int blockId,
   NET_CHECK(MPI_Comm_rank(comm, &new_rank));
   NET_CHECK(MPI_Comm_size(comm, &pe_size));
   NET_CHECK(MPI_Allgather(src, size, mpi_type, dst, size, mpi_type, comm));
-  quiet(blockId, threadId);
+  quiet(blockId, seq);
 }
 
 void MPITransport::fcollect_gcen(void *dst, void *src, int size, int win_id,
                                    int blockId, MPI_Comm team, void *ata_buffptr,
-                                   ro_net_types type, int threadId,
+                                   ro_net_types type, uint64_t seq,
                                    bool blocking) {
   // GPU-centric implementation of fcollect
   auto *bp{backend_proxy->get()};
@@ -932,13 +1468,13 @@ void MPITransport::fcollect_gcen(void *dst, void *src, int size, int win_id,
   MPI_Comm comm_ring = createComm(world_ranks[new_rank % clust_size],
                                   stride * clust_size, num_clust);
   // Now wait for completion
-  barrier(blockId, threadId, false, comm_cluster);
-  barrier(blockId, threadId, blocking, comm_ring);
+  barrier(blockId, seq, false, comm_cluster);
+  barrier(blockId, seq, blocking, comm_ring);
 }
 
 void MPITransport::fcollect_gcen2(void *dst, void *src, int size, int win_id,
                                     int blockId, MPI_Comm team, void *ata_buffptr,
-                                    ro_net_types type, int threadId,
+                                    ro_net_types type, uint64_t seq,
                                     bool blocking) {
   // GPU-centric implementation with in-place, blocking synchronization
   auto *bp{backend_proxy->get()};
@@ -1021,176 +1557,806 @@ void MPITransport::fcollect_gcen2(void *dst, void *src, int size, int win_id,
   MPI_Comm comm_ring = createComm(world_ranks[new_rank % clust_size],
                                   stride * clust_size, num_clust);
   // Now wait for completion
-  barrier(blockId, threadId, blocking, comm_ring);
+  barrier(blockId, seq, blocking, comm_ring);
 }
 
 void MPITransport::putMem(void *dst, void *src, int size, int pe, int win_id,
-                            int blockId, int threadId, bool blocking,
+                            int blockId, uint64_t seq, bool blocking,
                             bool inline_data) {
   queue->flush_hdp();
 
+  TrafficMatrix::GetInstance().record(TrafficClass::PUT, pe, size);
+
+  outstanding[blockId]++;
+  issuePut(dst, src, size, pe, win_id,
+           {seq, blockId, blocking, src, inline_data});
+
+  // Non-blocking commands only need to be consumed; the device observes
+  // their completion through quiet.
+  if (!blocking) {
+    retire(blockId, seq);
+  }
+}
+
+void MPITransport::issuePut(void *dst, void *src, int size, int pe,
+                            int win_id, const RequestProperties &properties) {
+  if (stripeMem(dst, src, size, pe, win_id, properties, true)) {
+    return;
+  }
+
   auto *bp{backend_proxy->get()};
+  MPI_Win win{bp->heap_window_info[win_id]->get_win()};
+  MPI_Aint offset{bp->heap_window_info[win_id]->get_offset(dst)};
+
+  // Both paths only track local completion, which is all a blocking put
+  // promises. The target is flushed at the next quiet or barrier.
+  markDirty(properties.blockId, win_id, pe);
+
+  if (counter_completion) {
+    NET_CHECK(MPI_Put(src, size, MPI_CHAR, pe, offset, size, MPI_CHAR, win));
+    if (properties.blocking) {
+      NET_CHECK(MPI_Win_flush_local(pe, win));
+      completeRequest(properties);
+    } else {
+      countTarget(win_id, pe);
+      pending_flushes.push_back(properties);
+    }
+    return;
+  }
+
   MPI_Request request{};
+  NET_CHECK(MPI_Rput(src, size, MPI_CHAR, pe, offset, size, MPI_CHAR, win,
+                     &request));
+  trackWindowRequest(win_id, request, properties);
+}
 
-  NET_CHECK(MPI_Rput(
-      src, size, MPI_CHAR, pe, bp->heap_window_info[win_id]->get_offset(dst),
-      size, MPI_CHAR, bp->heap_window_info[win_id]->get_win(), &request));
+void MPITransport::issueCoalesced(const CoalescedPut &run) {
+  DPRINTF("Issuing %u coalesced puts of %lu bytes to pe %d\n", run.puts,
+          run.size, run.pe);
 
-  // Since MPI makes puts as complete as soon as the local buffer is free,
-  // we need a flush to satisfy quiet.  Put it here as a hack for now even
-  // though it should be in the progress loop.
-  NET_CHECK(MPI_Win_flush_all(bp->heap_window_info[win_id]->get_win()));
+  outstanding[run.block]++;
+  issuePut(reinterpret_cast<void *>(run.dst),
+           reinterpret_cast<void *>(run.src), static_cast<int>(run.size),
+           run.pe, run.win_id, {0, run.block, false});
+}
 
-  requests.push_back({request, {threadId, blockId, blocking}});
+bool MPITransport::stripeMem(void *dst, void *src, int size, int pe,
+                             int win_id, const RequestProperties &properties,
+                             bool is_put) {
+  if (stripe_windows.empty() ||
+      static_cast<size_t>(size) < stripe_threshold) {
+    return false;
+  }
 
-  outstanding[blockId]++;
+  int heap_idx{win_id / static_cast<int>(WindowProxyT::MAX_NUM_WINDOWS)};
+  auto *lanes{&stripe_windows[heap_idx * stripe_lanes]};
+
+  char *local{static_cast<char *>(is_put ? src : dst)};
+  MPI_Aint offset{lanes[0]->get_offset(is_put ? dst : src)};
+
+  int num_chunks{static_cast<int>((size + stripe_chunk - 1) / stripe_chunk)};
+
+  int group{newRequestGroup(num_chunks)};
+
+  DPRINTF("Striping %s of %d bytes to pe %d over %d chunks\n",
+          is_put ? "put" : "get", size, pe, num_chunks);
+
+  // Striped transfers always use requests: they are large enough that the
+  // per-request cost counter completion saves does not matter.
+  for (int i{0}; i < num_chunks; i++) {
+    size_t chunk_offset{i * stripe_chunk};
+    int chunk_size{static_cast<int>(
+        std::min(stripe_chunk, static_cast<size_t>(size) - chunk_offset))};
+    MPI_Win win{lanes[i % stripe_lanes]->get_win()};
+
+    MPI_Request request{};
+    if (is_put) {
+      NET_CHECK(MPI_Rput(local + chunk_offset, chunk_size, MPI_CHAR, pe,
+                         offset + chunk_offset, chunk_size, MPI_CHAR, win,
+                         &request));
+    } else {
+      NET_CHECK(MPI_Rget(local + chunk_offset, chunk_size, MPI_CHAR, pe,
+                         offset + chunk_offset, chunk_size, MPI_CHAR, win,
+                         &request));
+    }
+
+    RequestProperties chunk{properties};
+    chunk.group = group;
+    requests.push_back({request, chunk});
+  }
+
+  // As in issuePut, the requests only track local completion of the puts.
+  if (is_put) {
+    for (int lane{0}; lane < std::min(num_chunks, stripe_lanes); lane++) {
+      markLaneDirty(properties.blockId, lanes[lane]->get_win(), pe);
+    }
+  }
+  return true;
+}
+
+void MPITransport::recordCollective(MPI_Comm team, int nelems,
+                                    ro_net_types type) {
+  auto &matrix{TrafficMatrix::GetInstance()};
+  if (!matrix.enabled()) {
+    return;
+  }
+  int type_size{};
+  NET_CHECK(MPI_Type_size(convertType(type), &type_size));
+  matrix.record_team(TrafficClass::COLL, team,
+                     static_cast<uint64_t>(nelems) * type_size);
+}
+
+int MPITransport::newRequestGroup(int num_requests) {
+  int group{};
+  if (free_stripe_groups.empty()) {
+    group = static_cast<int>(stripe_remaining.size());
+    stripe_remaining.push_back(0);
+  } else {
+    group = free_stripe_groups.back();
+    free_stripe_groups.pop_back();
+  }
+  stripe_remaining[group] = num_requests;
+  return group;
+}
+
+void MPITransport::markDirty(int blockId, int win_id, int pe) {
+  auto &dirty{dirty_targets[blockId]};
+
+  if (dirty.marked.size() <= static_cast<size_t>(win_id)) {
+    dirty.marked.resize(win_id + 1);
+  }
+
+  auto &marked{dirty.marked[win_id]};
+  if (marked.empty()) {
+    marked.resize(num_pes, false);
+  }
+
+  if (!marked[pe]) {
+    marked[pe] = true;
+    dirty.targets.emplace_back(win_id, pe);
+  }
+
+  if (!dirty.listed) {
+    dirty.listed = true;
+    dirty_blocks.push_back(blockId);
+  }
+}
+
+void MPITransport::markLaneDirty(int blockId, MPI_Win win, int pe) {
+  auto &dirty{dirty_targets[blockId]};
+
+  std::pair<MPI_Win, int> target{win, pe};
+  if (std::find(dirty.lanes.begin(), dirty.lanes.end(), target) ==
+      dirty.lanes.end()) {
+    dirty.lanes.push_back(target);
+  }
+
+  if (!dirty.listed) {
+    dirty.listed = true;
+    dirty_blocks.push_back(blockId);
+  }
+}
+
+void MPITransport::flushDirty(int blockId) {
+  auto &dirty{dirty_targets[blockId]};
+
+  for (const auto &[win, pe] : dirty.lanes) {
+    NET_CHECK(MPI_Win_flush(pe, win));
+  }
+  dirty.lanes.clear();
+
+  if (dirty.targets.empty()) {
+    return;
+  }
+
+  auto *bp{backend_proxy->get()};
+
+  DPRINTF("Flushing %zu dirty targets for blockId %d\n",
+          dirty.targets.size(), blockId);
+
+  for (const auto &[win_id, pe] : dirty.targets) {
+    NET_CHECK(MPI_Win_flush(pe, bp->heap_window_info[win_id]->get_win()));
+    dirty.marked[win_id][pe] = false;
+  }
+  dirty.targets.clear();
+}
+
+void MPITransport::takeAllDirty(
+    std::vector<std::pair<MPI_Win, int>> *targets) {
+  auto *bp{backend_proxy->get()};
+
+  for (const auto blockId : dirty_blocks) {
+    auto &dirty{dirty_targets[blockId]};
+
+    targets->insert(targets->end(), dirty.lanes.begin(), dirty.lanes.end());
+    dirty.lanes.clear();
+
+    for (const auto &[win_id, pe] : dirty.targets) {
+      targets->emplace_back(bp->heap_window_info[win_id]->get_win(), pe);
+      dirty.marked[win_id][pe] = false;
+    }
+    dirty.targets.clear();
+    dirty.listed = false;
+  }
+  dirty_blocks.clear();
+
+  // Blocks writing the same target share one flush.
+  std::sort(targets->begin(), targets->end());
+  targets->erase(std::unique(targets->begin(), targets->end()),
+                 targets->end());
+}
+
+void MPITransport::countTarget(int win_id, int pe) {
+  if (window_counters.size() <= static_cast<size_t>(win_id)) {
+    window_counters.resize(win_id + 1);
+  }
+
+  auto &counters{window_counters[win_id]};
+  if (counters.ops.empty()) {
+    counters.ops.resize(num_pes, 0);
+  }
+
+  if (counters.targets.empty()) {
+    counted_windows.push_back(win_id);
+  }
+
+  if (counters.ops[pe]++ == 0) {
+    counters.targets.push_back(pe);
+  }
+}
+
+bool MPITransport::issueFetchAtomic(
+    [[maybe_unused]] void *dst, [[maybe_unused]] void *src,
+    [[maybe_unused]] const void *val, [[maybe_unused]] const void *cond,
+    [[maybe_unused]] int pe, [[maybe_unused]] ROCSHMEM_OP op,
+    [[maybe_unused]] ro_net_types type,
+    [[maybe_unused]] const RequestProperties &properties) {
+  // MPI carries every atomic on its windows.
+  return false;
 }
 
 void MPITransport::amoFOP(void *dst, void *src, void *val, int pe, int win_id,
-                            int blockId, int threadId, bool blocking,
+                            int blockId, uint64_t seq, bool blocking,
                             ROCSHMEM_OP op, ro_net_types type) {
   queue->flush_hdp();
 
   auto *bp{backend_proxy->get()};
   MPI_Datatype mpi_type{convertType(type)};
-  NET_CHECK(MPI_Fetch_and_op(reinterpret_cast<void *>(val), src, mpi_type, pe,
-                             bp->heap_window_info[win_id]->get_offset(dst),
-                             get_mpi_op(op),
-                             bp->heap_window_info[win_id]->get_win()));
+  int type_size{};
+  NET_CHECK(MPI_Type_size(mpi_type, &type_size));
+  TrafficMatrix::GetInstance().record(TrafficClass::AMO, pe, type_size);
 
-  // Since MPI makes puts as complete as soon as the local buffer is free,
-  // we need a flush to satisfy quiet.  Put it here as a hack for now even
-  // though it should be in the progress loop.
-  NET_CHECK(MPI_Win_flush_local(pe, bp->heap_window_info[win_id]->get_win()));
+  outstanding[blockId]++;
+  if (issueFetchAtomic(dst, src, val, nullptr, pe, op, type,
+                       {seq, blockId, true})) {
+    return;
+  }
 
-  queue->notify(blockId, threadId);
+  // The operand lives in the queue element copy, which is gone by the time
+  // the request completes. Keep a private copy until then.
+  void *operand{malloc(type_size)};
+  ::memcpy(operand, val, type_size);
 
-  queue->sfence_flush_hdp();
+  MPI_Request request{};
+  NET_CHECK(MPI_Rget_accumulate(operand, 1, mpi_type, src, 1, mpi_type, pe,
+                                bp->heap_window_info[win_id]->get_offset(dst),
+                                1, mpi_type, get_mpi_op(op),
+                                bp->heap_window_info[win_id]->get_win(),
+                                &request));
+
+  trackWindowRequest(win_id, request, {seq, blockId, true, operand, true});
 }
 
 void MPITransport::amoFCAS(void *dst, void *src, void *val, int pe,
-                             int win_id, int blockId, int threadId, bool blocking,
+                             int win_id, int blockId, uint64_t seq, bool blocking,
                              void *cond, ro_net_types type) {
   queue->flush_hdp();
 
   auto *bp{backend_proxy->get()};
   MPI_Datatype mpi_type{convertType(type)};
-  NET_CHECK(MPI_Compare_and_swap((const void *)val, (const void *)cond, src,
+  int type_size{};
+  NET_CHECK(MPI_Type_size(mpi_type, &type_size));
+  TrafficMatrix::GetInstance().record(TrafficClass::AMO, pe, type_size);
+
+  outstanding[blockId]++;
+  if (issueFetchAtomic(dst, src, val, cond, pe, ROCSHMEM_REPLACE, type,
+                       {seq, blockId, true})) {
+    return;
+  }
+
+  // Swap value and compare value are stored back to back.
+  char *operands{static_cast<char *>(malloc(2 * type_size))};
+  ::memcpy(operands, val, type_size);
+  ::memcpy(operands + type_size, cond, type_size);
+
+  // MPI has no request-based compare-and-swap. Completion is batched with
+  // other pending swaps by a single local flush in progress().
+  NET_CHECK(MPI_Compare_and_swap(operands, operands + type_size, src,
                                  mpi_type, pe,
                                  bp->heap_window_info[win_id]->get_offset(dst),
                                  bp->heap_window_info[win_id]->get_win()));
 
-  // Since MPI makes puts as complete as soon as the local buffer is free,
-  // we need a flush to satisfy quiet.  Put it here as a hack for now even
-  // though it should be in the progress loop.
-  NET_CHECK(MPI_Win_flush_local(pe, bp->heap_window_info[win_id]->get_win()));
+  countTarget(win_id, pe);
+  pending_flushes.push_back({seq, blockId, true, operands, true});
+}
+
+void MPITransport::amoVector(void *dst, void *src, size_t *indices,
+                             int *pes, size_t nelems, int win_id, int blockId,
+                             uint64_t seq, ROCSHMEM_OP op, ro_net_types type) {
+  queue->flush_hdp();
 
-  queue->notify(blockId, threadId);
+  auto *bp{backend_proxy->get()};
+  MPI_Win win{bp->heap_window_info[win_id]->get_win()};
+  MPI_Aint offset{bp->heap_window_info[win_id]->get_offset(dst)};
+  MPI_Datatype mpi_type{convertType(type)};
+  int type_size{};
+  NET_CHECK(MPI_Type_size(mpi_type, &type_size));
 
-  queue->sfence_flush_hdp();
+  // Group the elements by target so that every PE receives exactly one
+  // accumulate, and bring repeated indices of a target together. The
+  // values are staged in that order; the staging buffer is released when
+  // the command completes.
+  std::vector<size_t> order(nelems);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [pes, indices](size_t a, size_t b) {
+                     return std::tie(pes[a], indices[a]) <
+                            std::tie(pes[b], indices[b]);
+                   });
+
+  char *staged{static_cast<char *>(malloc(nelems * type_size))};
+  const char *values{static_cast<const char *>(src)};
+  std::vector<size_t> targets{};
+  MPI_Op mpi_op{get_mpi_op(op)};
+
+  size_t begin{0};
+  size_t num_staged{0};
+  while (begin < nelems) {
+    int pe{pes[order[begin]]};
+    size_t first{num_staged};
+    targets.clear();
+
+    size_t end{begin};
+    for (; end < nelems && pes[order[end]] == pe; end++) {
+      const char *value{values + order[end] * type_size};
+      size_t index{indices[order[end]]};
+
+      // Overlapping entries in one accumulate are not well defined, so
+      // repeats of an index are combined here first.
+      if (!targets.empty() && targets.back() == index) {
+        char *merged{staged + (num_staged - 1) * type_size};
+        NET_CHECK(MPI_Reduce_local(value, merged, 1, mpi_type, mpi_op));
+        continue;
+      }
+      ::memcpy(staged + num_staged * type_size, value, type_size);
+      targets.push_back(index);
+      num_staged++;
+    }
+
+    // Displacements of an indexed type are ints; beyond that range each
+    // element goes as its own accumulate.
+    if (targets.back() > static_cast<size_t>(INT_MAX)) {
+      for (size_t k{0}; k < targets.size(); k++) {
+        NET_CHECK(MPI_Accumulate(
+            staged + (first + k) * type_size, 1, mpi_type, pe,
+            offset + static_cast<MPI_Aint>(targets[k]) * type_size, 1,
+            mpi_type, mpi_op, win));
+      }
+    } else {
+      std::vector<int> displacements(targets.begin(), targets.end());
+      MPI_Datatype target_type{};
+      NET_CHECK(MPI_Type_create_indexed_block(displacements.size(), 1,
+                                              displacements.data(),
+                                              mpi_type, &target_type));
+      NET_CHECK(MPI_Type_commit(&target_type));
+      NET_CHECK(MPI_Accumulate(staged + first * type_size, targets.size(),
+                               mpi_type, pe, offset, 1, target_type, mpi_op,
+                               win));
+      NET_CHECK(MPI_Type_free(&target_type));
+    }
+
+    TrafficMatrix::GetInstance().record(TrafficClass::AMO, pe,
+                                        targets.size() * type_size);
+    markDirty(blockId, win_id, pe);
+    countTarget(win_id, pe);
+    begin = end;
+  }
+
+  pending_flushes.push_back({seq, blockId, true, staged, true});
+
+  outstanding[blockId]++;
+}
+
+void MPITransport::amoStrided(void *dst, void *src, int stride, size_t nelems,
+                              int pe, int win_id, int blockId, uint64_t seq,
+                              ROCSHMEM_OP op, ro_net_types type) {
+  queue->flush_hdp();
+
+  auto *bp{backend_proxy->get()};
+  MPI_Datatype mpi_type{convertType(type)};
+
+  MPI_Datatype target_type{};
+  NET_CHECK(MPI_Type_vector(nelems, 1, stride, mpi_type, &target_type));
+  NET_CHECK(MPI_Type_commit(&target_type));
+  NET_CHECK(MPI_Accumulate(src, nelems, mpi_type, pe,
+                           bp->heap_window_info[win_id]->get_offset(dst), 1,
+                           target_type, get_mpi_op(op),
+                           bp->heap_window_info[win_id]->get_win()));
+  NET_CHECK(MPI_Type_free(&target_type));
+
+  int type_size{};
+  NET_CHECK(MPI_Type_size(mpi_type, &type_size));
+  TrafficMatrix::GetInstance().record(TrafficClass::AMO, pe,
+                                      nelems * type_size);
+
+  markDirty(blockId, win_id, pe);
+  countTarget(win_id, pe);
+
+  pending_flushes.push_back({seq, blockId, true});
+
+  outstanding[blockId]++;
 }
 
 void MPITransport::getMem(void *dst, void *src, int size, int pe, int win_id,
-                            int blockId, int threadId, bool blocking) {
+                            int blockId, uint64_t seq, bool blocking) {
+  TrafficMatrix::GetInstance().record(TrafficClass::GET, pe, size);
+
   outstanding[blockId]++;
+  issueGet(dst, src, size, pe, win_id, {seq, blockId, blocking});
+
+  if (!blocking) {
+    retire(blockId, seq);
+  }
+}
+
+void MPITransport::issueGet(void *dst, void *src, int size, int pe,
+                            int win_id, const RequestProperties &properties) {
+  if (stripeMem(dst, src, size, pe, win_id, properties, false)) {
+    return;
+  }
 
   auto *bp{backend_proxy->get()};
-  MPI_Request request{};
-  NET_CHECK(MPI_Rget(
-      dst, size, MPI_CHAR, pe, bp->heap_window_info[win_id]->get_offset(src),
-      size, MPI_CHAR, bp->heap_window_info[win_id]->get_win(), &request));
+  MPI_Win win{bp->heap_window_info[win_id]->get_win()};
+  MPI_Aint offset{bp->heap_window_info[win_id]->get_offset(src)};
 
-  requests.push_back({request, {threadId, blockId, blocking}});
+  if (counter_completion) {
+    NET_CHECK(MPI_Get(dst, size, MPI_CHAR, pe, offset, size, MPI_CHAR, win));
+    countTarget(win_id, pe);
+    pending_flushes.push_back(properties);
+  } else {
+    MPI_Request request{};
+    NET_CHECK(MPI_Rget(dst, size, MPI_CHAR, pe, offset, size, MPI_CHAR, win,
+                       &request));
+    trackWindowRequest(win_id, request, properties);
+  }
 }
 
-std::unique_ptr<MPI_Request[]> MPITransport::raw_requests() {
-  auto uptr_arr = std::make_unique<MPI_Request[]>(requests.size());
-  for (size_t i{0}; i < requests.size(); i++) {
-    uptr_arr[i] = requests[i].request;
+std::unique_ptr<MPI_Request[]> MPITransport::raw_requests(
+    const std::vector<Request> &list) {
+  auto uptr_arr = std::make_unique<MPI_Request[]>(list.size());
+  for (size_t i{0}; i < list.size(); i++) {
+    uptr_arr[i] = list[i].request;
   }
   return uptr_arr;
 }
 
+void MPITransport::trackWindowRequest(int win_id, MPI_Request request,
+                                      const RequestProperties &properties) {
+  if (window_requests.size() <= static_cast<size_t>(win_id)) {
+    window_requests.resize(win_id + 1);
+  }
+
+  auto &list{window_requests[win_id]};
+  if (list.empty()) {
+    request_windows.push_back(win_id);
+  }
+  list.push_back({request, properties});
+  num_window_requests++;
+}
+
+void MPITransport::testRequests(std::vector<Request> *list) {
+  int incount = (list->size() < testsome_indices.size())
+                    ? list->size()
+                    : testsome_indices.size();
+  int outcount{};
+
+  auto uptr_req_arr {raw_requests(*list)};
+
+  NET_CHECK(MPI_Testsome(incount, uptr_req_arr.get(), &outcount,
+                         testsome_indices.data(), MPI_STATUSES_IGNORE));
+
+  for (int i{0}; i < outcount; i++) {
+    int index{testsome_indices[i]};
+    completeRequest((*list)[index].properties);
+  }
+
+  sort(testsome_indices.data(), testsome_indices.data() + outcount,
+       std::greater<int>());
+  for (int i{0}; i < outcount; i++) {
+    int index{testsome_indices[i]};
+    list->erase(list->begin() + index);
+  }
+}
+
+void MPITransport::retire(int blockId, uint64_t seq) {
+  auto &block{completions[blockId]};
+  block.retired.push(seq);
+
+  bool advanced{false};
+  while (!block.retired.empty() &&
+         block.retired.top() == block.completed_seq + 1) {
+    block.completed_seq++;
+    block.retired.pop();
+    advanced = true;
+  }
+
+  if (advanced && !block.unpublished) {
+    block.unpublished = true;
+    unpublished_blocks.push_back(blockId);
+  }
+}
+
+void MPITransport::publishCompletions() {
+  if (unpublished_blocks.empty()) {
+    return;
+  }
+
+  for (const auto blockId : unpublished_blocks) {
+    auto &block{completions[blockId]};
+    DPRINTF("Publishing completed_seq %lu for blockId %d\n",
+            block.completed_seq, blockId);
+    queue->notify(blockId, block.completed_seq);
+    block.unpublished = false;
+  }
+  unpublished_blocks.clear();
+
+  queue->sfence_flush_hdp();
+}
+
+void MPITransport::completeRequest(const RequestProperties &properties) {
+  int blockId{properties.blockId};
+  uint64_t seq{properties.seq};
+
+  // Only the last request of a group completes the command.
+  if (properties.group != -1) {
+    if (--stripe_remaining[properties.group]) {
+      return;
+    }
+    free_stripe_groups.push_back(properties.group);
+  }
+
+  if (blockId != -1) {
+    outstanding[blockId]--;
+    DPRINTF(
+        "Finished op for blockId %d at seq %lu "
+        "(%d requests outstanding)\n",
+        blockId, seq, outstanding[blockId]);
+  }
+
+  if (properties.blocking && blockId != -1) {
+    retire(blockId, seq);
+  }
+
+  if (properties.inline_data) {
+    free(properties.src);
+  }
+
+  if (properties.am_tag != -1) {
+    am_free_tags.push_back(properties.am_tag);
+  }
+
+  // If the GPU has requested a quiet, notify it of completion when
+  // all outstanding requests are complete.
+  if (!outstanding[blockId] && !waiting_quiet[blockId].empty()) {
+    for (const auto seq : waiting_quiet[blockId]) {
+      DPRINTF("Finished Quiet for blockId %d at seq %lu\n", blockId, seq);
+      retire(blockId, seq);
+    }
+
+    waiting_quiet[blockId].clear();
+  }
+}
+
+void MPITransport::completePendingFlushes(bool force) {
+  if (pending_flushes.empty()) {
+    return;
+  }
+
+  // Keep issuing while the device is still feeding us commands so that
+  // operations from many blocks share a single flush.
+  if (!force && !q.empty() &&
+      pending_flushes.size() < pending_flush_threshold) {
+    return;
+  }
+
+  auto *bp{backend_proxy->get()};
+  for (const auto win_id : counted_windows) {
+    auto &counters{window_counters[win_id]};
+    MPI_Win win{bp->heap_window_info[win_id]->get_win()};
+
+    DPRINTF("Flushing %zu targets of win_id %d\n", counters.targets.size(),
+            win_id);
+
+    // Flushing a single target avoids touching every connection.
+    if (counters.targets.size() == 1) {
+      NET_CHECK(MPI_Win_flush_local(counters.targets.front(), win));
+    } else {
+      NET_CHECK(MPI_Win_flush_local_all(win));
+    }
+
+    for (const auto pe : counters.targets) {
+      counters.ops[pe] = 0;
+    }
+    counters.targets.clear();
+  }
+  counted_windows.clear();
+
+  for (const auto &pending : pending_flushes) {
+    completeRequest(pending);
+  }
+  pending_flushes.clear();
+}
+
 void MPITransport::progress() {
-  if (requests.size() == 0) {
+  completePendingFlushes();
+
+  if (requests.size() == 0 && num_window_requests == 0) {
     const int tag{1000};
     int flag{0};
     MPI_Status status{};
     NET_CHECK(MPI_Iprobe(MPI_ANY_SOURCE, tag, ro_net_comm_world, &flag, &status));
-  } else {
+  }
+
+  if (requests.size()) {
     DPRINTF("Testing all outstanding requests (%zu)\n", requests.size());
+    testRequests(&requests);
+  }
 
-    int incount = (requests.size() < testsome_indices.size())
-                      ? requests.size()
-                      : testsome_indices.size();
-    int outcount{};
+  for (size_t i{0}; i < request_windows.size();) {
+    int win_id{request_windows[i]};
+    auto &list{window_requests[win_id]};
 
-    auto uptr_req_arr {raw_requests()};
+    DPRINTF("Testing %zu requests of win_id %d\n", list.size(), win_id);
 
-    NET_CHECK(MPI_Testsome(incount, uptr_req_arr.get(), &outcount,
-                           testsome_indices.data(), MPI_STATUSES_IGNORE));
+    size_t before{list.size()};
+    testRequests(&list);
+    num_window_requests -= before - list.size();
 
-    auto *bp{backend_proxy->get()};
-    for (int i{0}; i < outcount; i++) {
-      int index{testsome_indices[i]};
-      int blockId{requests[index].properties.blockId};
-      int threadId{requests[index].properties.threadId};
+    if (list.empty()) {
+      request_windows[i] = request_windows.back();
+      request_windows.pop_back();
+    } else {
+      i++;
+    }
+  }
 
-      if (blockId != -1) {
-        outstanding[blockId]--;
-        DPRINTF(
-            "Finished op for blockId %d at threadId %d "
-            "(%d requests outstanding)\n",
-            blockId, threadId, outstanding[blockId]);
-      }
+  advanceAlltoallv();
 
-      if (requests[index].properties.blocking) {
-        if (blockId != -1) {
-          queue->notify(blockId, threadId);
-        }
-        queue->sfence_flush_hdp();
-      }
+  if (window_growth) {
+    window_growth();
+  }
 
-      if (requests[index].properties.inline_data) {
-        free(requests[index].properties.src);
-      }
+  serveActiveMessages();
 
-      // If the GPU has requested a quiet, notify it of completion when
-      // all outstanding requests are complete.
-      if (!outstanding[blockId] && !waiting_quiet[blockId].empty()) {
-        for (const auto threadId : waiting_quiet[blockId]) {
-          DPRINTF("Finished Quiet for blockId %d at threadId %d\n", blockId,
-                  threadId);
-          queue->notify(blockId, threadId);
-        }
+  publishCompletions();
+}
 
-        waiting_quiet[blockId].clear();
+void MPITransport::activeMessage(void *dst, void *src, int handler_id,
+                                 uint64_t arg0, uint64_t arg1, int pe,
+                                 int win_id, int blockId, uint64_t seq) {
+  // The target finds the object at the same offset in its own heap.
+  auto *heap{backend_proxy->get()->heap_ptr};
+  int heap_idx{win_id / static_cast<int>(WindowProxyT::MAX_NUM_WINDOWS)};
+  auto *base{static_cast<char *>(heap->get_local_heap_base(heap_idx))};
+  AmRequest am{handler_id, heap_idx,
+               static_cast<uint64_t>(static_cast<char *>(dst) - base),
+               {arg0, arg1}, 0};
+
+  if (pe == my_pe) {
+    runActiveMessage(am, my_pe, static_cast<uint64_t *>(src));
+    retire(blockId, seq);
+    return;
+  }
 
-        queue->sfence_flush_hdp();
-      }
-    }
+  // The tag stays taken until the reply has arrived, so no two replies
+  // in flight can match each other's receive.
+  am.reply_tag = acquireAmTag();
+
+  // Post the receive first so that the reply always has a match.
+  MPI_Request reply{};
+  NET_CHECK(MPI_Irecv(src, 1, MPI_UINT64_T, pe, am.reply_tag, am_comm,
+                      &reply));
+  RequestProperties properties{seq, blockId, true};
+  properties.am_tag = am.reply_tag;
+  requests.push_back({reply, properties});
+
+  auto *message{static_cast<AmRequest *>(malloc(sizeof(AmRequest)))};
+  *message = am;
+  MPI_Request send{};
+  NET_CHECK(MPI_Isend(message, sizeof(AmRequest), MPI_BYTE, pe,
+                      AM_REQUEST_TAG, am_comm, &send));
+  requests.push_back({send, {seq, blockId, false, message, true}});
+
+  outstanding[blockId] += 2;
+}
+
+int MPITransport::acquireAmTag() {
+  if (am_next_tag <= AM_REPLY_TAGS) {
+    return am_next_tag++;
+  }
+  while (am_free_tags.empty()) {
+    testRequests(&requests);
+  }
+  int tag{am_free_tags.back()};
+  am_free_tags.pop_back();
+  return tag;
+}
+
+void MPITransport::serveActiveMessages() {
+  // Bounded so that a flood of messages cannot starve the local queue.
+  constexpr int max_messages{16};
 
-    sort(testsome_indices.data(), testsome_indices.data() + outcount,
-         std::greater<int>());
-    for (int i{0}; i < outcount; i++) {
-      int index{testsome_indices[i]};
-      requests.erase(requests.begin() + index);
+  for (int i{0}; i < max_messages; i++) {
+    int flag{0};
+    MPI_Status status{};
+    NET_CHECK(MPI_Iprobe(MPI_ANY_SOURCE, AM_REQUEST_TAG, am_comm, &flag,
+                         &status));
+    if (!flag) {
+      break;
     }
+
+    AmRequest am{};
+    NET_CHECK(MPI_Recv(&am, sizeof(AmRequest), MPI_BYTE, status.MPI_SOURCE,
+                       AM_REQUEST_TAG, am_comm, MPI_STATUS_IGNORE));
+
+    auto &reply{am_replies.emplace_back(AmReply{MPI_REQUEST_NULL, 0})};
+    runActiveMessage(am, status.MPI_SOURCE, &reply.value);
+    NET_CHECK(MPI_Isend(&reply.value, 1, MPI_UINT64_T, status.MPI_SOURCE,
+                        am.reply_tag, am_comm, &reply.request));
+  }
+
+  for (auto it{am_replies.begin()}; it != am_replies.end();) {
+    int done{0};
+    NET_CHECK(MPI_Test(&it->request, &done, MPI_STATUS_IGNORE));
+    it = done ? am_replies.erase(it) : std::next(it);
   }
 }
 
-void MPITransport::quiet(int blockId, int threadId) {
-  auto *bp{backend_proxy->get()};
+void MPITransport::runActiveMessage(const AmRequest &request, int source_pe,
+                                    uint64_t *reply) {
+  // The handler reads data the GPU may have just written.
+  queue->flush_hdp();
+
+  auto *heap{backend_proxy->get()->heap_ptr};
+  auto *base{static_cast<char *>(heap->get_local_heap_base(request.heap_idx))};
+  if (!AmHandlers::GetInstance().execute(request, base, source_pe, reply)) {
+    fprintf(stderr, "No active message handler %d registered on PE %d\n",
+            request.handler_id, my_pe);
+    abort();
+  }
+}
+
+void MPITransport::flushBlock(int blockId) { flushDirty(blockId); }
+
+void MPITransport::quiet(int blockId, uint64_t seq) {
+  // The pending barrier took this block's dirty targets with it.
+  advanceBarrier(true);
+  flushBlock(blockId);
+  completePendingFlushes(true);
 
   if (!outstanding[blockId]) {
-    DPRINTF("Finished Quiet immediately for blockId %d at threadId %d\n", blockId,
-            threadId);
-    queue->notify(blockId, threadId);
+    DPRINTF("Finished Quiet immediately for blockId %d at seq %lu\n",
+            blockId, seq);
+    retire(blockId, seq);
   } else {
-    waiting_quiet[blockId].emplace_back(threadId);
+    waiting_quiet[blockId].emplace_back(seq);
   }
 }
 
-int MPITransport::numOutstandingRequests() { return requests.size() + q.size(); }
+int MPITransport::numOutstandingRequests() {
+  return requests.size() + num_window_requests + pending_flushes.size() +
+         q.size() + pending_alltoallvs.size() + (pending_barrier ? 1 : 0) +
+         (coalescer ? coalescer->pending() : 0);
+}
 
 }  // namespace rocshmem
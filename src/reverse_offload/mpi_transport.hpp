@@ -23,11 +23,21 @@
 #ifndef LIBRARY_SRC_REVERSE_OFFLOAD_MPI_TRANSPORT_HPP_
 #define LIBRARY_SRC_REVERSE_OFFLOAD_MPI_TRANSPORT_HPP_
 
+#include <deque>
+#include <functional>
+#include <list>
 #include <map>
+#include <memory>
 #include <mutex>  // NOLINT
+#include <optional>
 #include <queue>
+#include <utility>
 #include <vector>
 
+#include "../am_handlers.hpp"
+#include "../command_trace.hpp"
+#include "../memory/window_info.hpp"
+#include "../team_cache.hpp"
 #include "queue.hpp"
 #include "transport.hpp"
 
@@ -51,82 +61,123 @@ class MPITransport : public Transport {
                        int my_pe_in_new_team, MPI_Comm team_comm,
                        rocshmem_team_t *new_team) override;
 
-  void barrier(int blockId, int threadId, bool blocking,
+  /**
+   * Free the transport state of a team that is being destroyed. Collective
+   * over the members of team.
+   */
+  void destroyTeam(MPI_Comm team);
+
+  void barrier(int blockId, uint64_t seq, bool blocking,
                  MPI_Comm team) override;
 
   void reduction(void *dst, void *src, int size, int pe, int win_id,
                    int blockId, int start, int logPstride, int sizePE, void *pWrk,
                    long *pSync, ROCSHMEM_OP op, ro_net_types type,
-                   int threadId, bool blocking) override;
+                   uint64_t seq, bool blocking) override;
 
   void team_reduction(void *dst, void *src, int size, int win_id, int blockId,
                         MPI_Comm team, ROCSHMEM_OP op, ro_net_types type,
-                        int threadId, bool blocking) override;
+                        uint64_t seq, bool blocking) override;
+
+  void reduce_scatter(void *dst, void *src, int size, int win_id, int blockId,
+                      MPI_Comm team, ROCSHMEM_OP op, ro_net_types type,
+                      uint64_t seq, bool blocking) override;
 
   void broadcast(void *dst, void *src, int size, int pe, int win_id,
                    int blockId, int start, int logPstride, int sizePE,
-                   int PE_root, long *pSync, ro_net_types type, int threadId,
+                   int PE_root, long *pSync, ro_net_types type, uint64_t seq,
                    bool blocking) override;
 
   void team_broadcast(void *dst, void *src, int size, int win_id, int blockId,
                         MPI_Comm team, int PE_root, ro_net_types type,
-                        int threadId, bool blocking) override;
+                        uint64_t seq, bool blocking) override;
 
   void alltoall(void *dst, void *src, int size, int win_id, int blockId,
                   MPI_Comm team, void *ata_buffptr, ro_net_types type,
-                  int threadId, bool blocking) override;
+                  uint64_t seq, bool blocking) override;
 
   void alltoall_broadcast(void *dst, void *src, int size, int win_id,
                             int blockId, MPI_Comm team, void *ata_buffptr,
-                            ro_net_types type, int threadId, bool blocking);
+                            ro_net_types type, uint64_t seq, bool blocking);
 
   void alltoall_mpi(void *dst, void *src, int size, int blockId, MPI_Comm team,
-                      void *ata_buffptr, ro_net_types type, int threadId,
+                      void *ata_buffptr, ro_net_types type, uint64_t seq,
                       bool blocking);
 
   void alltoall_gcen(void *dst, void *src, int size, int win_id, int blockId,
                        MPI_Comm team, void *ata_buffptr, ro_net_types type,
-                       int threadId, bool blocking);
+                       uint64_t seq, bool blocking);
 
   void alltoall_gcen2(void *dst, void *src, int size, int win_id, int blockId,
                         MPI_Comm team, void *ata_buffptr, ro_net_types type,
-                        int threadId, bool blocking);
+                        uint64_t seq, bool blocking);
 
   void fcollect(void *dst, void *src, int size, int win_id, int blockId,
                   MPI_Comm team, void *ata_buffptr, ro_net_types type,
-                  int threadId, bool blocking) override;
+                  uint64_t seq, bool blocking) override;
 
   void fcollect_broadcast(void *dst, void *src, int size, int win_id,
                             int blockId, MPI_Comm team, void *ata_buffptr,
-                            ro_net_types type, int threadId, bool blocking);
+                            ro_net_types type, uint64_t seq, bool blocking);
 
   void fcollect_mpi(void *dst, void *src, int size, int blockId, MPI_Comm team,
-                      void *ata_buffptr, ro_net_types type, int threadId,
+                      void *ata_buffptr, ro_net_types type, uint64_t seq,
                       bool blocking);
 
   void fcollect_gcen(void *dst, void *src, int size, int win_id, int blockId,
                        MPI_Comm team, void *ata_buffptr, ro_net_types type,
-                       int threadId, bool blocking);
+                       uint64_t seq, bool blocking);
 
   void fcollect_gcen2(void *dst, void *src, int size, int win_id, int blockId,
                         MPI_Comm team, void *ata_buffptr, ro_net_types type,
-                        int threadId, bool blocking);
+                        uint64_t seq, bool blocking);
+
+  void fcollectv(void *dst, void *src, const int *counts, int win_id,
+                 int blockId, MPI_Comm team, ro_net_types type, uint64_t seq,
+                 bool blocking) override;
+
+  void alltoallv(void *dst, void *src, const int *source_counts,
+                 const int *source_displs, const int *dest_counts,
+                 const int *dest_displs, int blockId, MPI_Comm team,
+                 ro_net_types type, uint64_t seq, bool blocking) override;
 
   void putMem(void *dst, void *src, int size, int pe, int win_id, int blockId,
-                int threadId, bool blocking, bool inline_data = false) override;
+                uint64_t seq, bool blocking, bool inline_data = false) override;
 
   void amoFOP(void *dst, void *src, void *val, int pe, int win_id, int blockId,
-                int threadId, bool blocking, ROCSHMEM_OP op,
+                uint64_t seq, bool blocking, ROCSHMEM_OP op,
                 ro_net_types type) override;
 
   void amoFCAS(void *dst, void *src, void *val, int pe, int win_id, int blockId,
-                 int threadId, bool blocking, void *cond,
+                 uint64_t seq, bool blocking, void *cond,
                  ro_net_types type) override;
 
+  void amoVector(void *dst, void *src, size_t *indices, int *pes,
+                 size_t nelems, int win_id, int blockId, uint64_t seq,
+                 ROCSHMEM_OP op, ro_net_types type) override;
+
+  void amoStrided(void *dst, void *src, int stride, size_t nelems, int pe,
+                  int win_id, int blockId, uint64_t seq, ROCSHMEM_OP op,
+                  ro_net_types type) override;
+
   void getMem(void *dst, void *src, int size, int pe, int win_id, int blockId,
-                int threadId, bool blocking) override;
+                uint64_t seq, bool blocking) override;
+
+  void quiet(int blockId, uint64_t seq) override;
+
+  /**
+   * @brief Run handler_id on pe against its copy of dst and receive the
+   * handler's reply into src. Retires seq once the reply has arrived.
+   */
+  void activeMessage(void *dst, void *src, int handler_id, uint64_t arg0,
+                     uint64_t arg1, int pe, int win_id, int blockId,
+                     uint64_t seq);
 
-  void quiet(int blockId, int threadId) override;
+  /**
+   * @brief Order the block's earlier puts before its later ones. MPI
+   * has no cheaper ordering than completion, so this is a quiet.
+   */
+  virtual void fence(int blockId, uint64_t seq) { quiet(blockId, seq); }
 
   void progress() override;
 
@@ -140,75 +191,438 @@ class MPITransport : public Transport {
 
   MPI_Comm get_world_comm() override { return ro_net_comm_world; }
 
+  /**
+   * @brief Thread running threadProgressEngine, exposed for pinning.
+   */
+  std::thread &get_progress_thread() { return progress_thread; }
+
   HostInterface *host_interface{nullptr};
 
- private:
-  struct CommKey {
-    CommKey(int _start, int _logPstride, int _size)
-        : start(_start), logPstride(_logPstride), size(_size) {}
-
-    bool operator<(const CommKey &key) const {
-      return start < key.start ||
-             (start == key.start && logPstride < key.logPstride) ||
-             (start == key.start && logPstride == key.logPstride &&
-              size < key.size);
-    }
-
-    int start{-1};
-    int logPstride{-1};
-    int size{-1};
-  };
+  /**
+   * @brief Backend cache the collective communicators come from.
+   */
+  TeamCommCache *comm_cache{nullptr};
+
+  /**
+   * @brief Grows the backend's window pool, run on every progress step.
+   */
+  std::function<void()> window_growth{};
 
+ protected:
   struct RequestProperties {
-    RequestProperties(int _threadId, int _blockId, bool _blocking, void *_src,
+    RequestProperties(uint64_t _seq, int _blockId, bool _blocking, void *_src,
                       bool _inline_data)
-        : threadId(_threadId),
+        : seq(_seq),
           blockId(_blockId),
           blocking(_blocking),
           src(_src),
           inline_data(_inline_data) {}
 
-    RequestProperties(int _threadId, int _blockId, bool _blocking)
-        : threadId(_threadId),
+    RequestProperties(uint64_t _seq, int _blockId, bool _blocking)
+        : seq(_seq),
           blockId(_blockId),
           blocking(_blocking),
           src(nullptr),
           inline_data(false) {}
 
-    int threadId{-1};
+    uint64_t seq{0};
     int blockId{-1};
     bool blocking{};
     void *src{nullptr};
     bool inline_data{};
+
+    // Striped transfer this request is a chunk of, or -1.
+    int group{-1};
+
+    // Active message reply tag freed when this request completes, or -1.
+    int am_tag{-1};
   };
 
+  /**
+   * Hooks for a transport that carries the device's RMA over another
+   * library. MPITransport keeps the queue handling and completion
+   * tracking; by the time a hook runs the operation is counted as
+   * outstanding for properties.blockId, and the hook calls
+   * completeRequest(properties) once it has completed locally. The
+   * defaults issue everything on the MPI window win_id.
+   */
+  virtual void issuePut(void *dst, void *src, int size, int pe, int win_id,
+                        const RequestProperties &properties);
+
+  virtual void issueGet(void *dst, void *src, int size, int pe, int win_id,
+                        const RequestProperties &properties);
+
+  /**
+   * Fetching atomic of op on dst, or a compare-and-swap against cond when
+   * cond is not nullptr. The old value goes to src.
+   *
+   * @return false to have MPI carry the atomic
+   */
+  virtual bool issueFetchAtomic(void *dst, void *src, const void *val,
+                                const void *cond, int pe, ROCSHMEM_OP op,
+                                ro_net_types type,
+                                const RequestProperties &properties);
+
+  /**
+   * Start completing at their targets the puts blockId issued so far. Work
+   * left in flight is counted with addOutstanding(blockId).
+   */
+  virtual void flushBlock(int blockId);
+
+  /**
+   * Start completing at their targets the puts of every block ahead of a
+   * barrier. Must not block; barrierFlushed is polled from the progress
+   * loop and the barrier starts once it returns true.
+   */
+  virtual void startBarrierFlush() {}
+
+  virtual bool barrierFlushed() { return true; }
+
+  void completeRequest(const RequestProperties &properties);
+
+  void retire(int blockId, uint64_t seq);
+
+  /**
+   * Count an operation of blockId as in flight until completeRequest.
+   */
+  void addOutstanding(int blockId) { outstanding[blockId]++; }
+
+  int numOutstanding(int blockId) const { return outstanding[blockId]; }
+
+ private:
   struct Request {
     MPI_Request request;
     RequestProperties properties;
   };
 
+  /**
+   * Request-less operations in flight on one window, counted per target.
+   * Drives how the window is flushed when the operations are completed.
+   */
+  struct TargetCounters {
+    std::vector<int> ops{};
+    std::vector<int> targets{};
+  };
+
+  /**
+   * Remote targets written by a block since its last quiet. MPI considers
+   * an Rput complete once the origin buffer can be reused, so these targets
+   * still need a flush before the block may observe remote completion.
+   */
+  struct DirtyTargets {
+    bool listed{false};
+
+    // (heap window id, target) pairs, in the order they were first written.
+    std::vector<std::pair<int, int>> targets{};
+
+    // Indexed by heap window id, then target.
+    std::vector<std::vector<bool>> marked{};
+
+    // (stripe window, target) pairs written by striped puts.
+    std::vector<std::pair<MPI_Win, int>> lanes{};
+  };
+
+  /**
+   * A barrier or sync waiting for the flushes that make it also complete
+   * the RMA issued before it. The dirty targets of every block are flushed
+   * a batch at a time from the progress loop, and the barrier is started
+   * once they and the flush of startBarrierFlush are done, so other blocks
+   * keep being served while it drains.
+   */
+  struct PendingBarrier {
+    int blockId{-1};
+    uint64_t seq{0};
+    MPI_Comm team{MPI_COMM_NULL};
+    std::vector<std::pair<MPI_Win, int>> flushes{};
+    size_t flushed{0};
+  };
+
+  /**
+   * Commands of a block retire out of order but the device only sees the
+   * highest sequence number below which everything has retired.
+   */
+  struct Completions {
+    uint64_t completed_seq{0};
+    bool unpublished{false};
+    std::priority_queue<uint64_t, std::vector<uint64_t>,
+                        std::greater<uint64_t>>
+        retired{};
+  };
+
   MPI_Comm createComm(int start, int logPstride, int size);
 
+  void markDirty(int blockId, int win_id, int pe);
+
+  void markLaneDirty(int blockId, MPI_Win win, int pe);
+
+  /**
+   * Issue a put or get of at least stripe_threshold bytes as chunks spread
+   * round-robin over the stripe lanes. The command completes once when its
+   * last chunk does.
+   *
+   * @return false if the transfer is too small to stripe
+   */
+  bool stripeMem(void *dst, void *src, int size, int pe, int win_id,
+                 const RequestProperties &properties, bool is_put);
+
+  /**
+   * Count nelems elements of type sent to every other PE of team in the
+   * traffic matrix.
+   */
+  void recordCollective(MPI_Comm team, int nelems, ro_net_types type);
+
+  /**
+   * Reserve a request group whose command completes when the last of its
+   * num_requests requests does.
+   *
+   * @return the value for RequestProperties::group
+   */
+  int newRequestGroup(int num_requests);
+
+  /**
+   * An alltoallv waiting for its team to agree on the sparse or dense
+   * path. The counts and displacements are copied out of GPU memory.
+   */
+  struct PendingAlltoallv {
+    char *dst{nullptr};
+    const char *src{nullptr};
+    // Source counts, source displacements, destination counts and
+    // destination displacements, pe_size ints each.
+    int *staged{nullptr};
+    int pe_size{0};
+    int rank{0};
+    MPI_Comm comm{MPI_COMM_NULL};
+    ro_net_types type{};
+    int blockId{-1};
+    uint64_t seq{0};
+    bool blocking{};
+    int peers{0};
+    int max_peers{0};
+    MPI_Request decision{MPI_REQUEST_NULL};
+  };
+
+  /**
+   * Give the alltoallv data of a team communicator its own duplicate.
+   * Collective over team, so it is called where every member is.
+   */
+  void registerAlltoallvComm(MPI_Comm team);
+
+  /**
+   * Start the exchange of every alltoallv at the head of
+   * pending_alltoallvs whose path has been agreed on.
+   */
+  void advanceAlltoallv();
+
+  /**
+   * Exchange only the nonzero blocks of an alltoallv with point-to-point
+   * messages.
+   */
+  void alltoallvSparse(const PendingAlltoallv &pending);
+
+  void createStripeLanes();
+
+  void freeStripeLanes();
+
+  void countTarget(int win_id, int pe);
+
+  /**
+   * Issue a run of non-blocking puts merged by the coalescer. Their
+   * commands were retired when they were added, so the put only counts
+   * as outstanding for the quiet of its block.
+   */
+  void issueCoalesced(const CoalescedPut &run);
+
+  void flushDirty(int blockId);
+
+  void takeAllDirty(std::vector<std::pair<MPI_Win, int>> *targets);
+
+  /**
+   * Barrier over team that also completes, at their targets, all puts
+   * issued before it by any block.
+   */
+  void barrierWithCompletion(int blockId, uint64_t seq, MPI_Comm team);
+
+  /**
+   * Flush the next batch of targets of the pending barrier and start the
+   * barrier once none are left.
+   *
+   * @param drain flush every remaining target now
+   */
+  void advanceBarrier(bool drain = false);
+
+  static bool isCollective(ro_net_cmds type);
+
+  /**
+   * Receive the active messages other PEs sent to this one, run them and
+   * start sending their replies.
+   */
+  void serveActiveMessages();
+
+  /**
+   * Run request, sent by source_pe, on this PE's heap. Aborts if no
+   * handler is registered under its id.
+   */
+  void runActiveMessage(const AmRequest &request, int source_pe,
+                        uint64_t *reply);
+
+  /**
+   * Take a reply tag no active message in flight uses. When every tag is
+   * taken, waits for a reply to arrive.
+   */
+  int acquireAmTag();
+
   void threadProgressEngine();
 
   void submitRequestsToMPI();
 
+  int heapWindowId(const queue_element_t &element);
+
+  void publishCompletions();
+
+  void completePendingFlushes(bool force = false);
+
   MPI_Op get_mpi_op(ROCSHMEM_OP op);
 
   Queue *queue{nullptr};
 
-  std::unique_ptr<MPI_Request[]> raw_requests();
+  std::unique_ptr<MPI_Request[]> raw_requests(
+      const std::vector<Request> &list);
+
+  /**
+   * Complete whichever of the requests in list have finished and drop
+   * them from it.
+   */
+  void testRequests(std::vector<Request> *list);
+
+  /**
+   * Track the request of a put, get or fetching atomic on window win_id.
+   */
+  void trackWindowRequest(int win_id, MPI_Request request,
+                          const RequestProperties &properties);
 
   // Unordered vector of in-flight MPI Requests. Can complete out of order.
   std::vector<Request> requests{};
 
-  std::vector<std::vector<int> > waiting_quiet{};
+  /**
+   * In-flight requests of RMA operations, indexed by window id. Each
+   * window is tested on its own, so idle windows cost nothing and a
+   * busy one cannot hide the completions of the others.
+   */
+  std::vector<std::vector<Request>> window_requests{};
+
+  // Windows which have at least one in-flight request.
+  std::vector<int> request_windows{};
+
+  // Sum of the sizes of the window_requests lists.
+  size_t num_window_requests{0};
+
+  // Request-less operations issued but not yet locally flushed.
+  std::vector<RequestProperties> pending_flushes{};
+
+  // Indexed by window id.
+  std::vector<TargetCounters> window_counters{};
+
+  // Windows which have at least one counted target.
+  std::vector<int> counted_windows{};
+
+  // Issue puts and gets without requests and complete them by flushing.
+  bool counter_completion{false};
+
+  // Number of duplicated windows large transfers are striped over. Each
+  // lane has its own communicator, which MPI libraries map to separate
+  // network channels (VCIs or rails). One lane disables striping.
+  int stripe_lanes{1};
+
+  // Puts and gets of at least this many bytes are striped.
+  size_t stripe_threshold{1 << 20};
+
+  // Targets flushed per progress step while a barrier drains.
+  size_t barrier_flush_batch{8};
+
+  std::optional<PendingBarrier> pending_barrier{};
+
+  // Written with every command popped when RO_NET_RECORD is set.
+  std::unique_ptr<TraceWriter> trace_writer{};
+
+  // Merges contiguous non-blocking puts when RO_NET_COALESCE is set.
+  std::unique_ptr<PutCoalescer> coalescer{};
+
+  // Bytes per chunk of a striped transfer.
+  size_t stripe_chunk{256 << 10};
+
+  // One communicator per lane.
+  std::vector<MPI_Comm> stripe_comms{};
+
+  // Lane windows over every heap, indexed by heap * stripe_lanes + lane.
+  std::vector<std::unique_ptr<WindowInfo>> stripe_windows{};
+
+  // An alltoallv goes point-to-point when no PE of the team exchanges
+  // data with more than this percentage of its peers. Zero keeps every
+  // alltoallv on MPI_Ialltoallv.
+  int alltoallv_sparse_percent{25};
+
+  /**
+   * Alltoallv commands in the order they were received. The choice of
+   * path completes at different times on different PEs, so the exchanges
+   * are started strictly in this order, on a communicator nothing else
+   * uses, to keep them matched.
+   */
+  std::deque<PendingAlltoallv> pending_alltoallvs{};
+
+  // Duplicate of each team communicator that carries alltoallv data.
+  std::map<MPI_Comm, MPI_Comm> alltoallv_comms{};
+
+  // Teams are created on the host while the progress thread looks up.
+  std::mutex alltoallv_comms_mutex{};
+
+  // Requests still in flight, indexed by RequestProperties::group.
+  std::vector<int> stripe_remaining{};
+
+  std::vector<int> free_stripe_groups{};
+
+  // Number of pending request-less operations which forces a local flush
+  // even if more commands are waiting to be submitted.
+  size_t pending_flush_threshold{64};
+
+  std::vector<std::vector<uint64_t> > waiting_quiet{};
+
+  std::vector<Completions> completions{};
+
+  // Blocks whose completed_seq advanced since the last publish.
+  std::vector<int> unpublished_blocks{};
 
   std::vector<int> outstanding{};
 
+  std::vector<DirtyTargets> dirty_targets{};
+
+  // Blocks which have at least one entry in dirty_targets.
+  std::vector<int> dirty_blocks{};
+
   MPI_Comm ro_net_comm_world{};
 
-  std::map<CommKey, MPI_Comm> comm_map{};
+  // Active messages and their replies have their own communicator so that
+  // their tags never match other traffic.
+  MPI_Comm am_comm{};
+
+  static constexpr int AM_REQUEST_TAG{0};
+
+  // Replies use the tags after AM_REQUEST_TAG. MPI guarantees tags up to
+  // 32767.
+  static constexpr int AM_REPLY_TAGS{32767};
+
+  // Next tag never handed out, then tags whose reply has arrived.
+  int am_next_tag{AM_REQUEST_TAG + 1};
+
+  std::vector<int> am_free_tags{};
+
+  struct AmReply {
+    MPI_Request request;
+    uint64_t value;
+  };
+
+  // Replies being sent. A list keeps each value in place until its send
+  // completes.
+  std::list<AmReply> am_replies{};
 
   std::queue<queue_element_t> q{};
 
@@ -21,6 +21,9 @@
  *****************************************************************************/
 
 #include "queue.hpp"
+
+#include <algorithm>
+
 #include "mpi_transport.hpp"
 
 namespace rocshmem {
@@ -31,6 +34,9 @@ Queue::Queue() {
   if ((value = getenv("RO_NET_CPU_QUEUE")) != nullptr) {
     gpu_queue = false;
   }
+  if ((value = getenv("RO_NET_QUEUE_PREFETCH")) != nullptr) {
+    prefetch_depth_ = std::min<uint64_t>(atoi(value), QUEUE_SIZE - 1);
+  }
 }
 
 uint64_t Queue::get_read_index(uint64_t queue_index) {
@@ -42,36 +48,57 @@ void Queue::increment_read_index(uint64_t queue_index) {
 }
 
 bool Queue::process(uint64_t queue_index, MPITransport* transport) {
-  auto next_elem{next_element(queue_index)};
-  if (next_elem->notify_cpu.valid) {
-    transport->insertRequest(next_elem, queue_index);
-    auto queues{queue_proxy_.get()};
-    queues[queue_index][get_read_index(queue_index)].notify_cpu.valid = 0;
-    increment_read_index(queue_index);
-    return true;
-  }
-  return false;
-}
+  auto queues{queue_proxy_.get()};
+  auto read_slot{get_read_index(queue_index)};
+  auto slot{&queues[queue_index][read_slot]};
 
-queue_element* Queue::next_element(uint64_t queue_index) {
-  queue_element *next_elem{nullptr};
   if (gpu_queue) {
     hdp_proxy_.get()->hdp_flush();
+  }
+
+  /*
+   * Only the valid line is polled while the slot is empty; the payload
+   * is read once, after the GPU has published it.
+   */
+  if (!slot->notify_cpu.valid) {
+    return false;
+  }
+
+  queue_element *next_elem{slot};
+  if (gpu_queue) {
     copy_element_to_cache(queue_index);
     next_elem = queue_element_cache_proxy_.get();
-  } else {
-    auto queues {queue_proxy_.get()};
-    auto read_slot{get_read_index(queue_index)};
-    next_elem = &queues[queue_index][read_slot];
   }
-  return next_elem;
+
+  transport->insertRequest(next_elem, queue_index);
+  slot->notify_cpu.valid = 0;
+  increment_read_index(queue_index);
+  return true;
 }
 
 void Queue::copy_element_to_cache(uint64_t queue_index) {
-    auto element{queue_element_cache_proxy_.get()};
-    auto read_slot{get_read_index(queue_index)};
-    auto queues {queue_proxy_.get()};
-    ::memcpy(element, &queues[queue_index][read_slot], sizeof(queue_element_t));
+  auto element{queue_element_cache_proxy_.get()};
+  auto read_slot{get_read_index(queue_index)};
+  auto queues{queue_proxy_.get()};
+
+  // The valid line was just polled; copy only what follows it.
+  constexpr size_t payload_offset{sizeof(cacheline_t)};
+  reader_.read(reinterpret_cast<char *>(element) + payload_offset,
+               reinterpret_cast<char *>(&queues[queue_index][read_slot]) +
+                   payload_offset,
+               sizeof(queue_element_t) - payload_offset);
+  element->notify_cpu.valid = 1;
+
+  prefetch_slots(queue_index);
+}
+
+void Queue::prefetch_slots(uint64_t queue_index) {
+  auto queues{queue_proxy_.get()};
+  auto read_slot{get_read_index(queue_index)};
+  for (uint64_t i{1}; i <= prefetch_depth_; i++) {
+    StreamReader::prefetch(&queues[queue_index][(read_slot + i) % QUEUE_SIZE],
+                           sizeof(queue_element_t));
+  }
 }
 
 void Queue::flush_hdp() {
@@ -87,8 +114,8 @@ void Queue::sfence_flush_hdp() {
   }
 }
 
-void Queue::notify(int blockId, int threadId) {
-  descriptor(blockId)->status[threadId] = 1;
+void Queue::notify(int blockId, uint64_t completed_seq) {
+  descriptor(blockId)->completed_seq = completed_seq;
 }
 
 uint64_t Queue::size() {
@@ -24,6 +24,7 @@
 #define LIBRARY_SRC_REVERSE_OFFLOAD_QUEUE_HPP_
 
 #include "../hdp_proxy.hpp"
+#include "../memory/stream_reader.hpp"
 #include "queue_proxy.hpp"
 #include "queue_desc_proxy.hpp"
 
@@ -45,7 +46,7 @@ class Queue {
 
   void sfence_flush_hdp();
 
-  void notify(int blockId, int threadId);
+  void notify(int blockId, uint64_t completed_seq);
 
   uint64_t size();
 
@@ -54,10 +55,14 @@ class Queue {
   queue_element_t* elements(uint64_t index);
 
  private:
-  queue_element* next_element(uint64_t queue_index);
-
   void copy_element_to_cache(uint64_t queue_index);
 
+  /**
+   * @brief Touch the slots after the read index so their lines are on
+   * their way by the time the GPU publishes them.
+   */
+  void prefetch_slots(uint64_t queue_index);
+
   QueueProxyT queue_proxy_{};
 
   QueueDescProxyT queue_desc_proxy_{};
@@ -67,6 +72,17 @@ class Queue {
   HdpProxy<HIPHostAllocator> hdp_proxy_{};
 
   bool gpu_queue{false};
+
+  /**
+   * @brief Pulls elements out of the pinned ring with wide loads.
+   */
+  StreamReader reader_{};
+
+  /**
+   * @brief Number of slots after the read index to prefetch
+   * (RO_NET_QUEUE_PREFETCH).
+   */
+  uint64_t prefetch_depth_{1};
 };
 
 }  // namespace rocshmem
@@ -46,35 +46,27 @@ typedef struct queue_desc {
   uint64_t write_index;
   char padding2[56];
   /**
-   * This bit is used by the GPU to wait on a blocking operation. The initial
-   * value is 0. When a GPU enqueues a blocking operation, it waits for this
-   * value to resolve to 1, which is set by the CPU when the blocking
-   * operation completes. The GPU then resets status back to zero. There is
-   * a separate status variable for each work-item in a work-group
+   * Sequence number of the last command below which every command of this
+   * queue has completed. Commands are numbered by their write ticket plus
+   * one. A work-item blocked on a command waits until this value reaches
+   * its own sequence number. Only written by the CPU.
    */
-  char *status;
+  uint64_t completed_seq;
   char padding3[56];
 } __attribute__((__aligned__(64))) queue_desc_t;
 
 template <typename ALLOCATOR>
 class QueueDescProxy {
   static constexpr size_t MAX_NUM_BLOCKS{65536};
-  static constexpr size_t MAX_THREADS_PER_BLOCK{1024};
-  static constexpr size_t MAX_THREADS{MAX_NUM_BLOCKS * MAX_THREADS_PER_BLOCK};
   using ProxyT = DeviceProxy<ALLOCATOR, queue_desc_t, MAX_NUM_BLOCKS>;
-  using ProxyStatusT = DeviceProxy<ALLOCATOR, char, MAX_THREADS>;
 
  public:
   QueueDescProxy() {
-    auto *status{proxy_status_.get()};
-    size_t status_bytes{sizeof(char) * MAX_THREADS};
-    memset(status, 0, status_bytes);
-
     auto *queue_descs{proxy_.get()};
     for (size_t i{0}; i < MAX_NUM_BLOCKS; i++) {
       queue_descs[i].read_index = 0;
       queue_descs[i].write_index = 0;
-      queue_descs[i].status = status + i * MAX_THREADS_PER_BLOCK;
+      queue_descs[i].completed_seq = 0;
     }
   }
 
@@ -82,8 +74,6 @@ class QueueDescProxy {
 
  private:
   ProxyT proxy_{};
-
-  ProxyStatusT proxy_status_{};
 };
 
 using QueueDescProxyT = QueueDescProxy<HIPDefaultFinegrainedAllocator>;
@@ -59,7 +59,6 @@ typedef struct queue_element {
   void *src{nullptr};
   void *dst{nullptr};
   int ro_net_win_id{-1};
-  int threadId{-1};
   int logPE_stride{-1};
   int PE_size{-1};
   long *pSync{nullptr};
@@ -75,6 +74,28 @@ typedef struct queue_element {
     void *pWrk;
     unsigned long long atomic_cond;
   } ol2;
+  /**
+   * Per-element target PEs of an RO_NET_AMO_VECTOR command. The element
+   * indices travel in ol2.pWrk. RO_NET_FCOLLECTV reuses it for the
+   * per-PE element counts. RO_NET_AM carries its two argument words in
+   * ol1 and ol2 and its handler id in PE_root.
+   */
+  int *pes{nullptr};
+
+  /**
+   * Receive side counts and displacements of an RO_NET_ALLTOALLV command.
+   * Its send side counts travel in pes and its send displacements in
+   * ol2.pWrk.
+   */
+  int *dest_counts{nullptr};
+
+  int *dest_displs{nullptr};
+
+  /**
+   * Completion sequence number. Filled in by the CPU on its private copy
+   * when it consumes the element; never written by the GPU.
+   */
+  uint64_t seq{0};
 } __attribute__((__aligned__(64))) queue_element_t;
 
 template <typename ALLOCATOR>
@@ -128,7 +149,7 @@ class QueueProxy {
   ProxyPerBlockT per_block_queue_proxy_{};
 };
 
-using QueueProxyT = QueueProxy<HIPHostAllocator>;
+using QueueProxyT = QueueProxy<HIPHostNumaAllocator>;
 
 }  // namespace rocshmem
 
@@ -34,7 +34,8 @@ ROTeam::ROTeam(Backend* backend, TeamInfo* team_info_wrt_parent,
            mpi_comm) {
   type = BackendType::RO_BACKEND;
 
-  ata_buffer = malloc(MAX_ATA_BUFF_SIZE);
+  ata_buffer = static_cast<ROBackend*>(backend)->ata_buffer_pool.allocate(
+      MAX_ATA_BUFF_SIZE);
 }
 
 ROTeam::~ROTeam() {
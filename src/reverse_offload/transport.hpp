@@ -50,55 +50,77 @@ class Transport {
                                int my_pe_in_new_team, MPI_Comm team_comm,
                                rocshmem_team_t *new_team) = 0;
 
-  virtual void barrier(int wg_id, int threadId, bool blocking,
+  virtual void barrier(int wg_id, uint64_t seq, bool blocking,
                          MPI_Comm team) = 0;
 
   virtual void reduction(void *dst, void *src, int size, int pe, int win_id,
                            int wg_id, int start, int logPstride, int sizePE,
                            void *pWrk, long *pSync, ROCSHMEM_OP op,
-                           ro_net_types type, int threadId, bool blocking) = 0;
+                           ro_net_types type, uint64_t seq, bool blocking) = 0;
 
   virtual void team_reduction(void *dst, void *src, int size, int win_id,
                                 int wg_id, MPI_Comm team, ROCSHMEM_OP op,
-                                ro_net_types type, int threadId,
+                                ro_net_types type, uint64_t seq,
                                 bool blocking) = 0;
 
+  virtual void reduce_scatter(void *dst, void *src, int size, int win_id,
+                              int wg_id, MPI_Comm team, ROCSHMEM_OP op,
+                              ro_net_types type, uint64_t seq,
+                              bool blocking) = 0;
+
   virtual void broadcast(void *dst, void *src, int size, int pe, int win_id,
                            int wg_id, int start, int logPstride, int sizePE,
                            int PE_root, long *pSync, ro_net_types type,
-                           int threadId, bool blocking) = 0;
+                           uint64_t seq, bool blocking) = 0;
 
   virtual void team_broadcast(void *dst, void *src, int size, int win_id,
                                 int wg_id, MPI_Comm team, int PE_root,
-                                ro_net_types type, int threadId,
+                                ro_net_types type, uint64_t seq,
                                 bool blocking) = 0;
 
   virtual void alltoall(void *dst, void *src, int size, int win_id, int wg_id,
                           MPI_Comm team, void *ata_buffptr, ro_net_types type,
-                          int threadId, bool blocking) = 0;
+                          uint64_t seq, bool blocking) = 0;
 
   virtual void fcollect(void *dst, void *src, int size, int win_id, int wg_id,
                           MPI_Comm team, void *ata_buffptr, ro_net_types type,
-                          int threadId, bool blocking) = 0;
+                          uint64_t seq, bool blocking) = 0;
+
+  virtual void fcollectv(void *dst, void *src, const int *counts, int win_id,
+                         int wg_id, MPI_Comm team, ro_net_types type,
+                         uint64_t seq, bool blocking) = 0;
+
+  virtual void alltoallv(void *dst, void *src, const int *source_counts,
+                         const int *source_displs, const int *dest_counts,
+                         const int *dest_displs, int wg_id, MPI_Comm team,
+                         ro_net_types type, uint64_t seq, bool blocking) = 0;
 
   virtual void putMem(void *dst, void *src, int size, int pe, int win_id,
-                        int wg_id, int threadId, bool blocking,
+                        int wg_id, uint64_t seq, bool blocking,
                         bool inline_data = false) = 0;
 
   virtual void getMem(void *dst, void *src, int size, int pe, int win_id,
-                        int wg_id, int threadId, bool blocking) = 0;
+                        int wg_id, uint64_t seq, bool blocking) = 0;
 
   virtual void amoFOP(void *dst, void *src, void *val, int pe, int win_id,
-                        int wg_id, int threadId, bool blocking, ROCSHMEM_OP op,
+                        int wg_id, uint64_t seq, bool blocking, ROCSHMEM_OP op,
                         ro_net_types type) = 0;
 
   virtual void amoFCAS(void *dst, void *src, void *val, int pe, int win_id,
-                         int wg_id, int threadId, bool blocking, void *cond,
+                         int wg_id, uint64_t seq, bool blocking, void *cond,
                          ro_net_types type) = 0;
 
+  virtual void amoVector(void *dst, void *src, size_t *indices, int *pes,
+                         size_t nelems, int win_id, int wg_id, uint64_t seq,
+                         ROCSHMEM_OP op, ro_net_types type) = 0;
+
+  virtual void amoStrided(void *dst, void *src, int stride, size_t nelems,
+                          int pe, int win_id, int wg_id, uint64_t seq,
+                          ROCSHMEM_OP op, ro_net_types type) = 0;
+
   virtual bool readyForFinalize() = 0;
 
-  virtual void quiet(int wg_id, int threadId) = 0;
+  virtual void quiet(int wg_id, uint64_t seq) = 0;
 
   virtual void progress() = 0;
 
@@ -0,0 +1,465 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "ucx_transport.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "backend_ro.hpp"
+#include "../traffic_matrix.hpp"
+#include "../util.hpp"
+
+namespace rocshmem {
+
+#define NET_CHECK(cmd)                                       \
+  {                                                          \
+    if (cmd != MPI_SUCCESS) {                                \
+      fprintf(stderr, "Unrecoverable error: MPI Failure\n"); \
+      abort() ;                                              \
+    }                                                        \
+  }
+
+#define UCX_CHECK(cmd)                                                 \
+  {                                                                    \
+    ucs_status_t status_ = (cmd);                                      \
+    if (status_ != UCS_OK) {                                           \
+      fprintf(stderr, "Unrecoverable error: UCX Failure: %s\n",        \
+              ucs_status_string(status_));                             \
+      abort();                                                         \
+    }                                                                  \
+  }
+
+/*
+ * Gather a variable sized blob from every rank. Returns the blobs back to
+ * back with their displacements.
+ */
+static std::vector<char> allgather_blobs(const void *blob, int size,
+                                         MPI_Comm comm,
+                                         std::vector<int> *displs) {
+  int num_ranks{};
+  NET_CHECK(MPI_Comm_size(comm, &num_ranks));
+
+  std::vector<int> sizes(num_ranks);
+  NET_CHECK(MPI_Allgather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, comm));
+
+  displs->resize(num_ranks);
+  std::exclusive_scan(sizes.begin(), sizes.end(), displs->begin(), 0);
+
+  std::vector<char> blobs(displs->back() + sizes.back());
+  NET_CHECK(MPI_Allgatherv(blob, size, MPI_BYTE, blobs.data(), sizes.data(),
+                           displs->data(), MPI_BYTE, comm));
+  return blobs;
+}
+
+UCXTransport::UCXTransport(MPI_Comm comm, Queue *queue)
+    : MPITransport(comm, queue) {
+  ucp_params_t params{};
+  params.field_mask = UCP_PARAM_FIELD_FEATURES;
+  params.features = UCP_FEATURE_RMA | UCP_FEATURE_AMO32 | UCP_FEATURE_AMO64;
+
+  ucp_config_t *config{nullptr};
+  UCX_CHECK(ucp_config_read(nullptr, nullptr, &config));
+  UCX_CHECK(ucp_init(&params, config, &context));
+  ucp_config_release(config);
+
+  // The worker is set up and torn down by the main thread and driven by
+  // the progress thread in between, never by both at once.
+  ucp_worker_params_t worker_params{};
+  worker_params.field_mask = UCP_WORKER_PARAM_FIELD_THREAD_MODE;
+  worker_params.thread_mode = UCS_THREAD_MODE_SERIALIZED;
+  UCX_CHECK(ucp_worker_create(context, &worker_params, &worker));
+
+  createEndpoints();
+}
+
+void UCXTransport::createEndpoints() {
+  ucp_address_t *address{nullptr};
+  size_t address_length{};
+  UCX_CHECK(ucp_worker_get_address(worker, &address, &address_length));
+
+  std::vector<int> displs{};
+  auto addresses{allgather_blobs(address, static_cast<int>(address_length),
+                                 get_world_comm(), &displs)};
+  ucp_worker_release_address(worker, address);
+
+  endpoints.resize(num_pes);
+  for (int pe{0}; pe < num_pes; pe++) {
+    ucp_ep_params_t ep_params{};
+    ep_params.field_mask = UCP_EP_PARAM_FIELD_REMOTE_ADDRESS;
+    ep_params.address =
+        reinterpret_cast<const ucp_address_t *>(&addresses[displs[pe]]);
+    UCX_CHECK(ucp_ep_create(worker, &ep_params, &endpoints[pe]));
+  }
+}
+
+void UCXTransport::mapHeaps() {
+  regions.resize(heap->num_heaps());
+  for (int h{0}; h < heap->num_heaps(); h++) {
+    auto &region{regions[h]};
+    region.base = heap->get_local_heap_base(h);
+
+    ucp_mem_map_params_t map_params{};
+    map_params.field_mask =
+        UCP_MEM_MAP_PARAM_FIELD_ADDRESS | UCP_MEM_MAP_PARAM_FIELD_LENGTH;
+    map_params.address = region.base;
+    map_params.length = heap->get_size(h);
+    UCX_CHECK(ucp_mem_map(context, &map_params, &region.memh));
+
+    void *rkey_buffer{nullptr};
+    size_t rkey_size{};
+    UCX_CHECK(ucp_rkey_pack(context, region.memh, &rkey_buffer, &rkey_size));
+
+    std::vector<int> displs{};
+    auto rkeys{allgather_blobs(rkey_buffer, static_cast<int>(rkey_size),
+                               get_world_comm(), &displs)};
+    ucp_rkey_buffer_release(rkey_buffer);
+
+    uint64_t base{reinterpret_cast<uint64_t>(region.base)};
+    region.remote_bases.resize(num_pes);
+    NET_CHECK(MPI_Allgather(&base, 1, MPI_UINT64_T, region.remote_bases.data(),
+                            1, MPI_UINT64_T, get_world_comm()));
+
+    region.rkeys.resize(num_pes);
+    for (int pe{0}; pe < num_pes; pe++) {
+      UCX_CHECK(ucp_ep_rkey_unpack(endpoints[pe], &rkeys[displs[pe]],
+                                   &region.rkeys[pe]));
+    }
+  }
+}
+
+void UCXTransport::initTransport(int num_queues, BackendProxyT *proxy) {
+  heap = proxy->get()->heap_ptr;
+  mapHeaps();
+
+  ucx_inflight.resize(num_queues, 0);
+  dirty_endpoints.resize(num_queues);
+
+  MPITransport::initTransport(num_queues, proxy);
+}
+
+void UCXTransport::finalizeTransport() {
+  MPITransport::finalizeTransport();
+  destroy();
+}
+
+void UCXTransport::destroy() {
+  ucp_request_param_t param{};
+  wait(ucp_worker_flush_nbx(worker, &param));
+
+  for (auto &region : regions) {
+    for (auto rkey : region.rkeys) {
+      ucp_rkey_destroy(rkey);
+    }
+  }
+
+  std::vector<ucs_status_ptr_t> closing{};
+  for (auto endpoint : endpoints) {
+    ucp_request_param_t close_param{};
+    closing.push_back(ucp_ep_close_nbx(endpoint, &close_param));
+  }
+  for (auto status : closing) {
+    wait(status);
+  }
+
+  // Peers may still be closing their endpoints to this worker.
+  NET_CHECK(MPI_Barrier(get_world_comm()));
+
+  for (auto &region : regions) {
+    UCX_CHECK(ucp_mem_unmap(context, region.memh));
+  }
+  regions.clear();
+  endpoints.clear();
+
+  ucp_worker_destroy(worker);
+  ucp_cleanup(context);
+}
+
+uint64_t UCXTransport::remoteAddress(const void *ptr, int pe,
+                                     ucp_rkey_h *rkey) {
+  const auto &region{regions[heap->heap_index(ptr)]};
+  *rkey = region.rkeys[pe];
+  return region.remote_bases[pe] +
+         (static_cast<const char *>(ptr) - region.base);
+}
+
+void UCXTransport::markEndpointDirty(int blockId, int pe) {
+  auto &dirty{dirty_endpoints[blockId]};
+  if (dirty.marked.empty()) {
+    dirty.marked.resize(num_pes, false);
+  }
+  if (!dirty.marked[pe]) {
+    dirty.marked[pe] = true;
+    dirty.pes.push_back(pe);
+  }
+}
+
+void UCXTransport::flushBlock(int blockId) {
+  auto &dirty{dirty_endpoints[blockId]};
+  for (const auto pe : dirty.pes) {
+    DPRINTF("Flushing endpoint of pe %d for blockId %d\n", pe, blockId);
+    addOutstanding(blockId);
+    ucp_request_param_t param{};
+    track(ucp_ep_flush_nbx(endpoints[pe], &param),
+          {nullptr, {0, blockId, false}});
+    dirty.marked[pe] = false;
+  }
+  dirty.pes.clear();
+
+  // Atomics UCP does not provide went through MPI.
+  MPITransport::flushBlock(blockId);
+}
+
+void UCXTransport::track(ucs_status_ptr_t status, const UCXRequest &request) {
+  if (status == nullptr) {
+    finish(request);
+    return;
+  }
+  if (UCS_PTR_IS_ERR(status)) {
+    UCX_CHECK(UCS_PTR_STATUS(status));
+  }
+
+  ucx_requests.push_back(request);
+  ucx_requests.back().request = status;
+  ucx_inflight[request.properties.blockId]++;
+}
+
+void UCXTransport::finish(const UCXRequest &request) {
+  if (request.result) {
+    std::memcpy(request.fetch, request.result, request.fetch_size);
+    free(request.result);
+  }
+  completeRequest(request.properties);
+}
+
+void UCXTransport::wait(ucs_status_ptr_t status) {
+  if (status == nullptr) {
+    return;
+  }
+  if (UCS_PTR_IS_ERR(status)) {
+    UCX_CHECK(UCS_PTR_STATUS(status));
+  }
+  while (ucp_request_check_status(status) == UCS_INPROGRESS) {
+    ucp_worker_progress(worker);
+  }
+  UCX_CHECK(ucp_request_check_status(status));
+  ucp_request_free(status);
+}
+
+void UCXTransport::issuePut(void *dst, void *src, int size, int pe,
+                            [[maybe_unused]] int win_id,
+                            const RequestProperties &properties) {
+  markEndpointDirty(properties.blockId, pe);
+
+  ucp_rkey_h rkey{};
+  uint64_t remote{remoteAddress(dst, pe, &rkey)};
+  ucp_request_param_t param{};
+
+  // Like an MPI_Rput, the request completes once src may be reused; the
+  // endpoint is flushed at the next quiet or barrier.
+  track(ucp_put_nbx(endpoints[pe], src, size, remote, rkey, &param),
+        {nullptr, properties});
+}
+
+void UCXTransport::issueGet(void *dst, void *src, int size, int pe,
+                            [[maybe_unused]] int win_id,
+                            const RequestProperties &properties) {
+  ucp_rkey_h rkey{};
+  uint64_t remote{remoteAddress(src, pe, &rkey)};
+  ucp_request_param_t param{};
+  track(ucp_get_nbx(endpoints[pe], dst, size, remote, rkey, &param),
+        {nullptr, properties});
+}
+
+bool UCXTransport::atomicOp(ROCSHMEM_OP op, ro_net_types type,
+                            ucp_atomic_op_t *opcode, size_t *size) {
+  bool integral{true};
+  switch (type) {
+    case RO_NET_INT:
+      *size = sizeof(int);
+      break;
+    case RO_NET_LONG:
+    case RO_NET_UNSIGNED_LONG:
+    case RO_NET_LONG_LONG:
+      *size = sizeof(long long);
+      break;
+    case RO_NET_FLOAT:
+      *size = sizeof(float);
+      integral = false;
+      break;
+    case RO_NET_DOUBLE:
+      *size = sizeof(double);
+      integral = false;
+      break;
+    default:
+      return false;
+  }
+
+  // Floating point values can only be moved, not combined.
+  switch (op) {
+    case ROCSHMEM_REPLACE:
+      *opcode = UCP_ATOMIC_OP_SWAP;
+      return true;
+    case ROCSHMEM_SUM:
+      *opcode = UCP_ATOMIC_OP_ADD;
+      return integral;
+    case ROCSHMEM_AND:
+      *opcode = UCP_ATOMIC_OP_AND;
+      return integral;
+    case ROCSHMEM_OR:
+      *opcode = UCP_ATOMIC_OP_OR;
+      return integral;
+    case ROCSHMEM_XOR:
+      *opcode = UCP_ATOMIC_OP_XOR;
+      return integral;
+    default:
+      return false;
+  }
+}
+
+bool UCXTransport::issueFetchAtomic(void *dst, void *src, const void *val,
+                                    const void *cond, int pe, ROCSHMEM_OP op,
+                                    ro_net_types type,
+                                    const RequestProperties &properties) {
+  ucp_atomic_op_t opcode{};
+  size_t size{};
+  if (!atomicOp(cond ? ROCSHMEM_REPLACE : op, type, &opcode, &size)) {
+    return false;
+  }
+
+  // The operand lives in the queue element copy, which is gone by the time
+  // the request completes. Keep a private copy until then.
+  void *operand{malloc(size)};
+  std::memcpy(operand, cond ? cond : val, size);
+  RequestProperties owned{properties.seq, properties.blockId, true, operand,
+                          true};
+
+  ucp_rkey_h rkey{};
+  uint64_t remote{remoteAddress(dst, pe, &rkey)};
+
+  ucp_request_param_t param{};
+  param.op_attr_mask =
+      UCP_OP_ATTR_FIELD_DATATYPE | UCP_OP_ATTR_FIELD_REPLY_BUFFER;
+  param.datatype = ucp_dt_make_contig(size);
+
+  if (!cond) {
+    param.reply_buffer = src;
+    track(ucp_atomic_op_nbx(endpoints[pe], opcode, operand, 1, remote, rkey,
+                            &param),
+          {nullptr, owned});
+    return true;
+  }
+
+  // UCP compares against the operand and swaps in the reply buffer, which
+  // then holds the fetched value.
+  void *result{malloc(size)};
+  std::memcpy(result, val, size);
+  param.reply_buffer = result;
+  track(ucp_atomic_op_nbx(endpoints[pe], UCP_ATOMIC_OP_CSWAP, operand, 1,
+                          remote, rkey, &param),
+        {nullptr, owned, result, src, size});
+  return true;
+}
+
+void UCXTransport::fence(int blockId, uint64_t seq) {
+  // Operations that went through MPI cannot be ordered by UCP.
+  if (numOutstanding(blockId) != ucx_inflight[blockId]) {
+    quiet(blockId, seq);
+    return;
+  }
+
+  UCX_CHECK(ucp_worker_fence(worker));
+  retire(blockId, seq);
+}
+
+void UCXTransport::startBarrierFlush() {
+  // The barrier has to complete the puts of every block at their targets.
+  // One worker flush does that for all endpoints at once. A quiet of one
+  // of those blocks waits for it instead of flushing again.
+  for (size_t blockId{0}; blockId < dirty_endpoints.size(); blockId++) {
+    auto &dirty{dirty_endpoints[blockId]};
+    if (dirty.pes.empty()) {
+      continue;
+    }
+    for (const auto pe : dirty.pes) {
+      dirty.marked[pe] = false;
+    }
+    dirty.pes.clear();
+    addOutstanding(blockId);
+    barrier_blocks.push_back(blockId);
+  }
+
+  ucp_request_param_t param{};
+  barrier_flush = ucp_worker_flush_nbx(worker, &param);
+  if (UCS_PTR_IS_ERR(barrier_flush)) {
+    UCX_CHECK(UCS_PTR_STATUS(barrier_flush));
+  }
+}
+
+bool UCXTransport::barrierFlushed() {
+  if (barrier_flush) {
+    ucs_status_t status{ucp_request_check_status(barrier_flush)};
+    if (status == UCS_INPROGRESS) {
+      return false;
+    }
+    UCX_CHECK(status);
+    ucp_request_free(barrier_flush);
+    barrier_flush = nullptr;
+  }
+
+  for (const auto blockId : barrier_blocks) {
+    completeRequest({0, blockId, false});
+  }
+  barrier_blocks.clear();
+  return true;
+}
+
+void UCXTransport::progress() {
+  ucp_worker_progress(worker);
+
+  for (size_t i{0}; i < ucx_requests.size();) {
+    ucs_status_t status{ucp_request_check_status(ucx_requests[i].request)};
+    if (status == UCS_INPROGRESS) {
+      i++;
+      continue;
+    }
+    UCX_CHECK(status);
+    ucp_request_free(ucx_requests[i].request);
+
+    UCXRequest done{ucx_requests[i]};
+    ucx_requests[i] = ucx_requests.back();
+    ucx_requests.pop_back();
+
+    ucx_inflight[done.properties.blockId]--;
+    finish(done);
+  }
+
+  MPITransport::progress();
+}
+
+int UCXTransport::numOutstandingRequests() {
+  return MPITransport::numOutstandingRequests() + ucx_requests.size();
+}
+
+}  // namespace rocshmem
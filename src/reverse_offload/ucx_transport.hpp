@@ -0,0 +1,164 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_REVERSE_OFFLOAD_UCX_TRANSPORT_HPP_
+#define LIBRARY_SRC_REVERSE_OFFLOAD_UCX_TRANSPORT_HPP_
+
+#include <ucp/api/ucp.h>
+
+#include <vector>
+
+#include "mpi_transport.hpp"
+
+namespace rocshmem {
+
+/**
+ * Transport issuing the RMA and atomics of the device over UCP.
+ *
+ * Every PE maps its symmetric heaps with UCP and exchanges worker
+ * addresses and packed rkeys over MPI, so puts, gets and atomics go
+ * straight to ucp_*_nbx without windows or MPI requests. Completions are
+ * driven by ucp_worker_progress from the progress thread. Collectives,
+ * teams, the host API and the atomics UCP does not provide (other types
+ * and operations, vector and strided atomics) still go through MPI.
+ */
+class UCXTransport : public MPITransport {
+ public:
+  UCXTransport(MPI_Comm comm, Queue *queue);
+
+  void initTransport(int num_queues, BackendProxyT *proxy) override;
+
+  void finalizeTransport() override;
+
+  void fence(int blockId, uint64_t seq) override;
+
+  void progress() override;
+
+  int numOutstandingRequests() override;
+
+ protected:
+  void issuePut(void *dst, void *src, int size, int pe, int win_id,
+                const RequestProperties &properties) override;
+
+  void issueGet(void *dst, void *src, int size, int pe, int win_id,
+                const RequestProperties &properties) override;
+
+  bool issueFetchAtomic(void *dst, void *src, const void *val,
+                        const void *cond, int pe, ROCSHMEM_OP op,
+                        ro_net_types type,
+                        const RequestProperties &properties) override;
+
+  void flushBlock(int blockId) override;
+
+  void startBarrierFlush() override;
+
+  bool barrierFlushed() override;
+
+ private:
+  struct UCXRequest {
+    void *request{nullptr};
+    RequestProperties properties;
+
+    // Fetched value of a compare-and-swap, copied to fetch on completion.
+    void *result{nullptr};
+    void *fetch{nullptr};
+    size_t fetch_size{0};
+  };
+
+  /**
+   * One symmetric heap as every PE mapped it.
+   */
+  struct Region {
+    char *base{nullptr};
+    ucp_mem_h memh{nullptr};
+    std::vector<uint64_t> remote_bases{};
+    std::vector<ucp_rkey_h> rkeys{};
+  };
+
+  /**
+   * Endpoints a block has put to since its last quiet.
+   */
+  struct DirtyEndpoints {
+    std::vector<int> pes{};
+    std::vector<bool> marked{};
+  };
+
+  void createEndpoints();
+
+  void mapHeaps();
+
+  void destroy();
+
+  uint64_t remoteAddress(const void *ptr, int pe, ucp_rkey_h *rkey);
+
+  void markEndpointDirty(int blockId, int pe);
+
+
+  /**
+   * Complete the operation when UCP already has, otherwise keep its
+   * request until progress sees it done.
+   */
+  void track(ucs_status_ptr_t status, const UCXRequest &request);
+
+  void finish(const UCXRequest &request);
+
+  /**
+   * Progress the worker until the request is done.
+   */
+  void wait(ucs_status_ptr_t status);
+
+  /**
+   * Map a fetching atomic onto UCP.
+   *
+   * @return false if UCP has no such operation for type
+   */
+  static bool atomicOp(ROCSHMEM_OP op, ro_net_types type,
+                       ucp_atomic_op_t *opcode, size_t *size);
+
+  SymmetricHeap *heap{nullptr};
+
+  ucp_context_h context{nullptr};
+
+  ucp_worker_h worker{nullptr};
+
+  // Indexed by PE.
+  std::vector<ucp_ep_h> endpoints{};
+
+  // Indexed by heap.
+  std::vector<Region> regions{};
+
+  std::vector<UCXRequest> ucx_requests{};
+
+  // Entries of ucx_requests per block.
+  std::vector<int> ucx_inflight{};
+
+  std::vector<DirtyEndpoints> dirty_endpoints{};
+
+  // Worker flush of the pending barrier, and the blocks whose endpoints
+  // it flushes. Each of them counts it as outstanding until it is done.
+  ucs_status_ptr_t barrier_flush{nullptr};
+  std::vector<int> barrier_blocks{};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_REVERSE_OFFLOAD_UCX_TRANSPORT_HPP_
@@ -23,43 +23,193 @@
 #ifndef LIBRARY_SRC_REVERSE_OFFLOAD_WINDOW_PROXY_HPP_
 #define LIBRARY_SRC_REVERSE_OFFLOAD_WINDOW_PROXY_HPP_
 
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
 #include "../device_proxy.hpp"
+#include "../memory/hip_allocator.hpp"
 #include "../memory/window_info.hpp"
 #include "mpi_transport.hpp"
 
 namespace rocshmem {
 
+/*
+ * Window usage shared by the device contexts and the host. It lives in
+ * pinned host memory: the device picks windows and records demand, the
+ * transport's progress thread grows the pool.
+ */
+struct WindowPool {
+  static constexpr int MAX_WINDOWS{32};
+
+  /*
+   * @brief Bind a context to the least loaded window created so far
+   *
+   * @return The window slot of the context
+   */
+  __device__ int acquire() {
+    int created{__hip_atomic_load(&num_windows, __ATOMIC_ACQUIRE,
+                                  __HIP_MEMORY_SCOPE_SYSTEM)};
+    int best{0};
+    int best_load{__hip_atomic_load(&load[0], __ATOMIC_RELAXED,
+                                    __HIP_MEMORY_SCOPE_SYSTEM)};
+    for (int i{1}; i < created; i++) {
+      int l{__hip_atomic_load(&load[i], __ATOMIC_RELAXED,
+                              __HIP_MEMORY_SCOPE_SYSTEM)};
+      if (l < best_load) {
+        best = i;
+        best_load = l;
+      }
+    }
+    __hip_atomic_fetch_add(&load[best], 1, __ATOMIC_RELAXED,
+                           __HIP_MEMORY_SCOPE_SYSTEM);
+
+    int active{__hip_atomic_fetch_add(&active_contexts, 1, __ATOMIC_RELAXED,
+                                      __HIP_MEMORY_SCOPE_SYSTEM) + 1};
+    __hip_atomic_fetch_max(&peak_contexts, active, __ATOMIC_RELAXED,
+                           __HIP_MEMORY_SCOPE_SYSTEM);
+    return best;
+  }
+
+  __device__ void release(int win_id) {
+    __hip_atomic_fetch_sub(&load[win_id], 1, __ATOMIC_RELAXED,
+                           __HIP_MEMORY_SCOPE_SYSTEM);
+    __hip_atomic_fetch_sub(&active_contexts, 1, __ATOMIC_RELAXED,
+                           __HIP_MEMORY_SCOPE_SYSTEM);
+  }
+
+  /*
+   * Windows per heap created so far. Entries below it are published
+   * before the count is raised.
+   */
+  int num_windows{0};
+
+  /*
+   * Contexts alive and the most ever alive at once. The default context
+   * counts as one and always holds window 0.
+   */
+  int active_contexts{1};
+  int peak_contexts{1};
+
+  int load[MAX_WINDOWS]{1};
+};
+
 template <typename ALLOCATOR>
 class WindowProxy {
  public:
-  static constexpr size_t MAX_NUM_WINDOWS{32};
+  static constexpr size_t MAX_NUM_WINDOWS{WindowPool::MAX_WINDOWS};
 
  private:
-  using ProxyT = DeviceProxy<ALLOCATOR, WindowInfo *, MAX_NUM_WINDOWS>;
+  /*
+   * Every symmetric heap gets its own run of MAX_NUM_WINDOWS windows;
+   * heap h owns the entries [h * MAX_NUM_WINDOWS, (h + 1) * MAX_NUM_WINDOWS).
+   * Only the first num_windows entries of each run exist.
+   */
+  using ProxyT = DeviceProxy<ALLOCATOR, WindowInfo *,
+                             MAX_NUM_WINDOWS * NUM_MEMORY_KINDS>;
+
+  using PoolProxyT = DeviceProxy<HIPHostAllocator, WindowPool>;
 
  public:
   /*
-   * Placement new the memory which is allocated by proxy_
+   * Placement new the memory which is allocated by proxy_.
+   *
+   * Each window registers a whole heap and its creation is collective, so
+   * only RO_NET_INITIAL_WINDOWS are created here and the rest on demand.
    */
-  WindowProxy(SymmetricHeap *heap, MPI_Comm comm) {
-    auto *window_info{proxy_.get()};
+  WindowProxy(SymmetricHeap *heap, MPI_Comm comm) : heap_{heap} {
+    char *value{nullptr};
+    if ((value = getenv("RO_NET_MAX_WINDOWS")) != nullptr) {
+      capacity_ = std::clamp(atoi(value), 1,
+                             static_cast<int>(MAX_NUM_WINDOWS));
+    }
+    if ((value = getenv("RO_NET_CONTEXTS_PER_WINDOW")) != nullptr) {
+      contexts_per_window_ = std::max(atoi(value), 1);
+    }
+    int initial{1};
+    if ((value = getenv("RO_NET_INITIAL_WINDOWS")) != nullptr) {
+      initial = std::clamp(atoi(value), 1, capacity_);
+    }
+
+    /*
+     * Growth runs between the other collectives of the progress thread,
+     * so it gets its own communicator.
+     */
+    MPI_Comm_dup(comm, &comm_);
+    MPI_Comm_rank(comm_, &my_pe_);
+    MPI_Comm_size(comm_, &num_pes_);
 
-    for (size_t i{0}; i < MAX_NUM_WINDOWS; i++) {
-      window_info[i] =
-          new WindowInfo(comm, heap->get_local_heap_base(), heap->get_size());
+    new (pool_.get()) WindowPool();
+
+    auto *window_info{proxy_.get()};
+    for (size_t i{0}; i < MAX_NUM_WINDOWS * NUM_MEMORY_KINDS; i++) {
+      window_info[i] = nullptr;
     }
+
+    create_windows(initial);
+
+    post_notice();
   }
 
   /*
    * Since placement new is called in the constructor, then
    * delete must be called manually.
+   *
+   * Collective: it settles growth with every other PE, so it must run
+   * after the progress thread has stopped.
    */
   ~WindowProxy() {
+    finish_growth();
+
     auto *window_info{proxy_.get()};
 
-    for (size_t i{0}; i < MAX_NUM_WINDOWS; i++) {
+    for (size_t i{0}; i < MAX_NUM_WINDOWS * NUM_MEMORY_KINDS; i++) {
       delete window_info[i];
     }
+    MPI_Comm_free(&comm_);
+  }
+
+  /*
+   * @brief Count contexts a team announced with its num_contexts hint
+   *
+   * The pool grows for them ahead of time, as if they were alive.
+   *
+   * @param[in] delta Contexts added by a new team, or removed by a
+   *            destroyed one
+   */
+  void expect_contexts(int delta) {
+    __atomic_fetch_add(&expected_contexts_, delta, __ATOMIC_RELAXED);
+  }
+
+  /*
+   * @brief Grow the pool when device contexts outnumber its windows
+   *
+   * Called on every step of the transport's progress thread. Window
+   * creation is collective, so growth goes in numbered rounds that every
+   * PE enters in the same order. A PE short of windows asks all others
+   * for the next round. Each round agrees on the largest demand with a
+   * non-blocking reduction and then creates the windows.
+   */
+  void progress() {
+    receive_notices();
+
+    if (round_ != MPI_REQUEST_NULL) {
+      int done{0};
+      MPI_Test(&round_, &done, MPI_STATUS_IGNORE);
+      if (!done) {
+        return;
+      }
+      finish_round();
+    }
+
+    if (wanted_windows() > pool_.get()->num_windows &&
+        requested_ <= generation_) {
+      request_round();
+    }
+
+    if (requested_ > generation_) {
+      start_round();
+    }
   }
 
   /*
@@ -67,11 +217,191 @@ class WindowProxy {
    */
   __host__ __device__ WindowInfo **get() { return proxy_.get(); }
 
+  /*
+   * @brief Window usage for binding device contexts
+   */
+  __host__ __device__ WindowPool *pool() { return pool_.get(); }
+
  private:
+  /*
+   * Tag of the messages asking for a growth round.
+   */
+  static constexpr int NOTICE_TAG{1};
+
+  /*
+   * Entries of a round's vote, reduced with MPI_MAX.
+   */
+  enum Vote { WANTED = 0, REQUESTED, FINALIZING, RUNNING, VOTE_SIZE };
+
+  /*
+   * @brief Windows per heap the contexts seen alive at once, or announced
+   * by teams, call for
+   */
+  int wanted_windows() {
+    int peak{__hip_atomic_load(&pool_.get()->peak_contexts, __ATOMIC_RELAXED,
+                               __HIP_MEMORY_SCOPE_SYSTEM)};
+    peak = std::max(peak, 1 + __atomic_load_n(&expected_contexts_,
+                                              __ATOMIC_RELAXED));
+    return std::min((peak + contexts_per_window_ - 1) / contexts_per_window_,
+                    capacity_);
+  }
+
+  void post_notice() {
+    MPI_Irecv(&notice_in_, 1, MPI_INT, MPI_ANY_SOURCE, NOTICE_TAG, comm_,
+              &notice_);
+  }
+
+  /*
+   * @brief Record the rounds other PEs asked for
+   */
+  void receive_notices() {
+    int arrived{0};
+    MPI_Test(&notice_, &arrived, MPI_STATUS_IGNORE);
+    while (arrived) {
+      requested_ = std::max(requested_, notice_in_);
+      post_notice();
+      MPI_Test(&notice_, &arrived, MPI_STATUS_IGNORE);
+    }
+  }
+
+  /*
+   * @brief Ask every PE for the round after the last finished one
+   */
+  void request_round() {
+    // The previous notices reuse the send buffer; they are one int each.
+    MPI_Waitall(static_cast<int>(notices_out_.size()), notices_out_.data(),
+                MPI_STATUSES_IGNORE);
+    notices_out_.clear();
+
+    requested_ = generation_ + 1;
+    notice_out_ = requested_;
+    for (int pe{0}; pe < num_pes_; pe++) {
+      if (pe == my_pe_) {
+        continue;
+      }
+      MPI_Request request{};
+      MPI_Isend(&notice_out_, 1, MPI_INT, pe, NOTICE_TAG, comm_, &request);
+      notices_out_.push_back(request);
+    }
+  }
+
+  void start_round() {
+    vote_[WANTED] = wanted_windows();
+    vote_[REQUESTED] = requested_;
+    vote_[FINALIZING] = finalizing_;
+    vote_[RUNNING] = !finalizing_;
+    MPI_Iallreduce(vote_, agreed_, VOTE_SIZE, MPI_INT, MPI_MAX, comm_,
+                   &round_);
+  }
+
+  void finish_round() {
+    create_windows(agreed_[WANTED]);
+    generation_++;
+    requested_ = std::max(requested_, agreed_[REQUESTED]);
+
+    // A finalizing PE waits in rounds until every PE finalizes, so the
+    // others keep taking part.
+    if (agreed_[FINALIZING]) {
+      requested_ = std::max(requested_, generation_ + 1);
+    }
+  }
+
+  /*
+   * @brief Run rounds until every PE is finalizing and none asked for
+   * more, so that no PE is left waiting in a round
+   */
+  void finish_growth() {
+    finalizing_ = true;
+
+    if (round_ != MPI_REQUEST_NULL) {
+      MPI_Wait(&round_, MPI_STATUS_IGNORE);
+      finish_round();
+    }
+
+    bool settled{false};
+    while (!settled) {
+      receive_notices();
+      if (requested_ <= generation_) {
+        request_round();
+      }
+      start_round();
+      MPI_Wait(&round_, MPI_STATUS_IGNORE);
+      finish_round();
+      settled = !agreed_[RUNNING] && agreed_[REQUESTED] <= generation_;
+    }
+
+    MPI_Cancel(&notice_);
+    MPI_Wait(&notice_, MPI_STATUS_IGNORE);
+    MPI_Waitall(static_cast<int>(notices_out_.size()), notices_out_.data(),
+                MPI_STATUSES_IGNORE);
+    notices_out_.clear();
+  }
+
+  /*
+   * @brief Extend every heap's run of windows to count entries
+   */
+  void create_windows(int count) {
+    auto *pool{pool_.get()};
+    auto *window_info{proxy_.get()};
+
+    for (int i{pool->num_windows}; i < count; i++) {
+      for (int h{0}; h < heap_->num_heaps(); h++) {
+        window_info[h * MAX_NUM_WINDOWS + i] = new WindowInfo(
+            comm_, heap_->get_local_heap_base(h), heap_->get_size(h));
+      }
+    }
+
+    if (count > pool->num_windows) {
+      __hip_atomic_store(&pool->num_windows, count, __ATOMIC_RELEASE,
+                         __HIP_MEMORY_SCOPE_SYSTEM);
+    }
+  }
+
   /*
    * @brief Memory managed by the lifetime of this object
    */
   ProxyT proxy_{};
+
+  /*
+   * @brief Pinned window usage, see @ref WindowPool
+   */
+  PoolProxyT pool_{};
+
+  SymmetricHeap *heap_{nullptr};
+
+  MPI_Comm comm_{MPI_COMM_NULL};
+
+  int capacity_{static_cast<int>(MAX_NUM_WINDOWS)};
+
+  int contexts_per_window_{1};
+
+  /*
+   * Contexts announced by live teams, on top of the default context.
+   */
+  int expected_contexts_{0};
+
+  int my_pe_{0};
+
+  int num_pes_{1};
+
+  /*
+   * Growth rounds finished, and the highest round any PE asked for.
+   */
+  int generation_{0};
+  int requested_{0};
+
+  bool finalizing_{false};
+
+  // Receive for the next notice, and the notices this PE sent.
+  MPI_Request notice_{MPI_REQUEST_NULL};
+  int notice_in_{0};
+  int notice_out_{0};
+  std::vector<MPI_Request> notices_out_{};
+
+  // Reduction of the round in progress.
+  MPI_Request round_{MPI_REQUEST_NULL};
+  int vote_[VOTE_SIZE]{};
+  int agreed_[VOTE_SIZE]{};
 };
 
 using WindowProxyT = WindowProxy<HostAllocator>;
@@ -33,7 +33,9 @@
 
 #include <cstdlib>
 #include <functional>
+#include <type_traits>
 
+#include "am_handlers.hpp"
 #include "backend_bc.hpp"
 #include "context_incl.hpp"
 #ifdef USE_GPU_IB
@@ -46,9 +48,12 @@
 #include "ipc/backend_ipc.hpp"
 #include "ipc/context_ipc_tmpl_host.hpp"
 #endif
+#include "host/thread_pes.hpp"
 #include "mpi_init_singleton.hpp"
 #include "team.hpp"
+#include "team_config.hpp"
 #include "templates_host.hpp"
+#include "traffic_matrix.hpp"
 #include "util.hpp"
 
 namespace rocshmem {
@@ -62,6 +67,15 @@ namespace rocshmem {
     }                                                                         \
   }
 
+/*
+ * Host calls made by a thread started by rocshmem_thread_pes_run are served
+ * by that thread's world; everyone else falls through to the backend.
+ */
+#define THREAD_PES_DISPATCH(...)                                              \
+  if (ThreadPes *thread_pes = ThreadPes::current()) {                         \
+    return thread_pes->__VA_ARGS__;                                           \
+  }
+
 Backend *backend = nullptr;
 
 rocshmem_ctx_t ROCSHMEM_HOST_CTX_DEFAULT;
@@ -70,8 +84,11 @@ rocshmem_ctx_t ROCSHMEM_HOST_CTX_DEFAULT;
  * Begin Host Code
  **/
 
-[[maybe_unused]] __host__ void inline library_init(MPI_Comm comm) {
+[[maybe_unused]] __host__ void inline library_init(MPI_Comm comm,
+                                                   int requested) {
   assert(!backend);
+  MPIInitSingleton::set_thread_level(requested);
+
   int count = 0;
   if (hipGetDeviceCount(&count) != hipSuccess) {
     abort();
@@ -98,29 +115,77 @@ rocshmem_ctx_t ROCSHMEM_HOST_CTX_DEFAULT;
   if (!backend) {
     abort();
   }
+
+  MPIInitSingleton::cap_thread_level_to_mpi();
+
+  if (getenv("ROCSHMEM_TRAFFIC_MATRIX") != nullptr) {
+    TrafficMatrix::GetInstance().enable(
+        get_internal_team(ROCSHMEM_TEAM_WORLD)->mpi_comm);
+  }
+}
+
+/*
+ * Tear down a user-created team and keep its communicator and metadata
+ * for the next split.
+ */
+__host__ static void destroy_team(rocshmem_team_t team) {
+  Team *team_obj{get_internal_team(team)};
+  TeamInfo *team_info_wrt_parent{team_obj->tinfo_wrt_parent};
+  TeamInfo *team_info_wrt_world{team_obj->tinfo_wrt_world};
+  MPI_Comm team_comm{team_obj->mpi_comm};
+
+  backend->team_destroy(team);
+
+  backend->team_comm_cache.release(team_comm);
+  backend->team_metadata_pool.release(team_info_wrt_parent, sizeof(TeamInfo));
+  backend->team_metadata_pool.release(team_info_wrt_world, sizeof(TeamInfo));
 }
 
 [[maybe_unused]] __host__ void rocshmem_init(MPI_Comm comm) {
-  library_init(comm);
+  library_init(comm, ROCSHMEM_THREAD_MULTIPLE);
 }
 
-[[maybe_unused]] __host__ void rocshmem_init_thread(
-    [[maybe_unused]] int required, int *provided, MPI_Comm comm) {
-  library_init(comm);
+[[maybe_unused]] __host__ void rocshmem_init_thread(int required,
+                                                    int *provided,
+                                                    MPI_Comm comm) {
+  library_init(comm, required);
   rocshmem_query_thread(provided);
 }
 
+[[maybe_unused]] __host__ int rocshmem_thread_pes_run(int npes,
+                                                     void (*fn)(void *),
+                                                     void *arg) {
+  if (npes < 1 || !fn || ThreadPes::current()) {
+    return ROCSHMEM_ERROR;
+  }
+
+  size_t heap_size{1UL << 30};
+  if (auto heap_size_cstr = getenv("ROCSHMEM_HEAP_SIZE")) {
+    heap_size = strtoull(heap_size_cstr, nullptr, 10);
+  }
+
+  ThreadPes world{npes, heap_size};
+  world.run(fn, arg);
+  return ROCSHMEM_SUCCESS;
+}
+
 [[maybe_unused]] __host__ int rocshmem_my_pe() {
+  THREAD_PES_DISPATCH(my_pe());
+
   MPIInitSingleton *s = s->GetInstance();
   return s->get_rank();
 }
 
 [[maybe_unused]] __host__ int rocshmem_n_pes() {
+  THREAD_PES_DISPATCH(n_pes());
+
   MPIInitSingleton *s = s->GetInstance();
   return s->get_nprocs();
 }
 
 [[maybe_unused]] __host__ void *rocshmem_malloc(size_t size) {
+  THREAD_PES_DISPATCH(malloc(size));
+
   VERIFY_BACKEND();
 
   void *ptr;
@@ -131,7 +196,24 @@ rocshmem_ctx_t ROCSHMEM_HOST_CTX_DEFAULT;
   return ptr;
 }
 
+[[maybe_unused]] __host__ void *rocshmem_malloc_with_hints(size_t size,
+                                                          long hints) {
+  /* Thread PEs have a single host memory heap; hints do not apply. */
+  THREAD_PES_DISPATCH(malloc(size));
+
+  VERIFY_BACKEND();
+
+  void *ptr;
+  backend->heap.malloc_with_hints(&ptr, size, hints);
+
+  rocshmem_barrier_all();
+
+  return ptr;
+}
+
 [[maybe_unused]] __host__ void rocshmem_free(void *ptr) {
+  THREAD_PES_DISPATCH(free(ptr));
+
   VERIFY_BACKEND();
 
   rocshmem_barrier_all();
@@ -139,6 +221,51 @@ rocshmem_ctx_t ROCSHMEM_HOST_CTX_DEFAULT;
   backend->heap.free(ptr);
 }
 
+[[maybe_unused]] __host__ int rocshmem_heap_snapshot(const char *path) {
+  VERIFY_BACKEND();
+
+  /*
+   * Wait for outstanding device work so the heap is quiescent.
+   */
+  CHECK_HIP(hipDeviceSynchronize());
+  rocshmem_barrier_all();
+
+  int status{backend->heap.snapshot(path, backend->my_pe, backend->num_pes)};
+
+  MPI_Comm comm{backend->team_tracker.get_team_world()->mpi_comm};
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, comm);
+  return status;
+}
+
+[[maybe_unused]] __host__ int rocshmem_heap_restore(const char *path) {
+  VERIFY_BACKEND();
+
+  CHECK_HIP(hipDeviceSynchronize());
+  rocshmem_barrier_all();
+
+  int status{backend->heap.restore(path, backend->my_pe, backend->num_pes)};
+
+  MPI_Comm comm{backend->team_tracker.get_team_world()->mpi_comm};
+  MPI_Allreduce(MPI_IN_PLACE, &status, 1, MPI_INT, MPI_MIN, comm);
+
+  rocshmem_barrier_all();
+  return status;
+}
+
+[[maybe_unused]] __host__ int rocshmem_am_register(
+    int handler_id, rocshmem_am_handler_t handler, void *user_arg) {
+  static_assert(std::is_same_v<rocshmem_am_handler_t, AmHandler>);
+  static_assert(ROCSHMEM_AM_MAX_HANDLERS == AmHandlers::MAX_HANDLERS);
+
+#if defined(USE_RO) && !defined(USE_GPU_IB)
+  bool registered{AmHandlers::GetInstance().register_handler(
+      handler_id, handler, user_arg)};
+  return registered ? ROCSHMEM_SUCCESS : ROCSHMEM_ERROR;
+#else
+  return ROCSHMEM_ERROR;
+#endif
+}
+
 [[maybe_unused]] __host__ void rocshmem_reset_stats() {
   VERIFY_BACKEND();
   backend->reset_stats();
@@ -150,9 +277,30 @@ rocshmem_ctx_t ROCSHMEM_HOST_CTX_DEFAULT;
   backend->dump_stats();
 }
 
+[[maybe_unused]] __host__ int rocshmem_dump_traffic_matrix(const char *path) {
+  VERIFY_BACKEND();
+  return TrafficMatrix::GetInstance().dump(path) ? ROCSHMEM_SUCCESS
+                                                 : ROCSHMEM_ERROR;
+}
+
+[[maybe_unused]] __host__ void rocshmem_reset_traffic_matrix() {
+  VERIFY_BACKEND();
+  TrafficMatrix::GetInstance().reset();
+}
+
 [[maybe_unused]] __host__ void rocshmem_finalize() {
   VERIFY_BACKEND();
 
+  /*
+   * Every PE takes part in the gather, so the matrix is written while MPI
+   * and the world team are still up.
+   */
+  if (const char *path = getenv("ROCSHMEM_TRAFFIC_MATRIX")) {
+    if (!TrafficMatrix::GetInstance().dump(path) && rocshmem_my_pe() == 0) {
+      fprintf(stderr, "Cannot write traffic matrix %s\n", path);
+    }
+  }
+
   /*
    * Destroy all the ctxs that the user
    * created but did not manually destroy
@@ -163,9 +311,7 @@ rocshmem_ctx_t ROCSHMEM_HOST_CTX_DEFAULT;
    * Destroy all the teams that the user
    * created but did not manually destroy
    */
-  auto team_destroy{
-      std::bind(&Backend::team_destroy, backend, std::placeholders::_1)};
-  backend->team_tracker.destroy_all(team_destroy);
+  backend->team_tracker.destroy_all(destroy_team);
 
   backend->~Backend();
   CHECK_HIP(hipHostFree(backend));
@@ -174,11 +320,7 @@ rocshmem_ctx_t ROCSHMEM_HOST_CTX_DEFAULT;
 }
 
 __host__ void rocshmem_query_thread(int *provided) {
-  /*
-   * Host-facing functions always support full
-   * thread flexibility i.e. THREAD_MULTIPLE.
-   */
-  *provided = ROCSHMEM_THREAD_MULTIPLE;
+  *provided = MPIInitSingleton::get_thread_level();
 }
 
 __host__ void rocshmem_global_exit(int status) {
@@ -220,12 +362,23 @@ __host__ inline int pe_in_active_set(int start, int stride, int size, int pe) {
 
 __host__ int rocshmem_team_split_strided(
     rocshmem_team_t parent_team, int start, int stride, int size,
-    [[maybe_unused]] const rocshmem_team_config_t *config,
-    [[maybe_unused]] long config_mask, rocshmem_team_t *new_team) {
+    const rocshmem_team_config_t *config, long config_mask,
+    rocshmem_team_t *new_team) {
   VERIFY_BACKEND();
 
   *new_team = ROCSHMEM_TEAM_INVALID;
 
+  rocshmem_team_config_t team_config;
+  if (!resolve_team_config(config, config_mask, &team_config)) {
+    return -1;
+  }
+
+  /* The contexts a team asks for must all be available at once */
+  if (static_cast<size_t>(team_config.num_contexts) >
+      backend->get_max_num_contexts()) {
+    return -1;
+  }
+
   auto num_user_teams{backend->team_tracker.get_num_user_teams()};
   auto max_num_teams{backend->team_tracker.get_max_num_teams()};
   if (num_user_teams >= max_num_teams - 1) {
@@ -260,45 +413,67 @@ __host__ int rocshmem_team_split_strided(
   int my_pe_in_new_team = pe_in_active_set(pe_start_in_world, stride_in_world,
                                            size, my_pe_in_world);
 
-  /* Create team infos */
-  TeamInfo *team_info_wrt_parent, *team_info_wrt_world;
+  /*
+   * Scratch can only come from the symmetric heap while every PE is
+   * present, so teams split from TEAM_WORLD get theirs before the
+   * non-members leave.
+   */
+  auto *team_world{backend->team_tracker.get_team_world()};
+  if (parent_team == ROCSHMEM_TEAM_WORLD) {
+    backend->reserve_team_scratch(
+        my_pe_in_new_team < 0 ? 0
+                              : backend->team_scratch_bytes(team_config, size),
+        team_world->mpi_comm);
+  }
 
-  CHECK_HIP(hipMalloc(&team_info_wrt_parent, sizeof(TeamInfo)));
+  /* Only the members take part from here on */
+  if (my_pe_in_new_team < 0) {
+    return 0;
+  }
+
+  /* Create team infos */
+  auto &pool{backend->team_metadata_pool};
+  auto *team_info_wrt_parent{
+      static_cast<TeamInfo *>(pool.allocate(sizeof(TeamInfo)))};
   new (team_info_wrt_parent) TeamInfo(parent_team_obj, start, stride, size);
 
-  auto *team_world{backend->team_tracker.get_team_world()};
-  CHECK_HIP(hipMalloc(&team_info_wrt_world, sizeof(TeamInfo)));
+  auto *team_info_wrt_world{
+      static_cast<TeamInfo *>(pool.allocate(sizeof(TeamInfo)))};
   new (team_info_wrt_world)
       TeamInfo(team_world, pe_start_in_world, stride_in_world, size);
 
-  /* Create a new MPI communicator for this team */
-  int color;
-  if (my_pe_in_new_team < 0) {
-    color = MPI_UNDEFINED;
-  } else {
-    color = 1;
-  }
+  /* Get a communicator over the members, reusing one if we can */
+  MPI_Comm team_comm{backend->team_comm_cache.acquire(
+      team_world->mpi_comm, pe_start_in_world, stride_in_world, size)};
 
-  MPI_Comm team_comm;
-  MPI_Comm_split(parent_team_obj->mpi_comm, color, my_pe_in_world, &team_comm);
+  backend->create_new_team(parent_team_obj, team_info_wrt_parent,
+                           team_info_wrt_world, size, my_pe_in_new_team,
+                           team_comm, team_config, new_team);
+  get_internal_team(*new_team)->config = team_config;
 
-  /**
-   * Allocate new team for GPU-inittiated communication with backend-specific
-   * objects
-   * TODO: are there any backend specific objects?
-   */
-  if (my_pe_in_new_team < 0) {
-    *new_team = ROCSHMEM_TEAM_INVALID;
-  } else {
-    backend->create_new_team(parent_team_obj, team_info_wrt_parent,
-                             team_info_wrt_world, size, my_pe_in_new_team,
-                             team_comm, new_team);
+  /* Track the newly created team to destroy it in finalize if the user does
+   * not */
+  backend->team_tracker.track(*new_team);
+
+  return 0;
+}
 
-    /* Track the newly created team to destroy it in finalize if the user does
-     * not */
-    backend->team_tracker.track(*new_team);
+__host__ int rocshmem_team_get_config(rocshmem_team_t team, long config_mask,
+                                      rocshmem_team_config_t *config) {
+  if (team == ROCSHMEM_TEAM_INVALID || config == nullptr) {
+    return -1;
   }
 
+  const rocshmem_team_config_t &team_config{get_internal_team(team)->config};
+  if (config_mask & ROCSHMEM_TEAM_NUM_CONTEXTS) {
+    config->num_contexts = team_config.num_contexts;
+  }
+  if (config_mask & ROCSHMEM_TEAM_MAX_REDUCE_SIZE) {
+    config->max_reduce_size = team_config.max_reduce_size;
+  }
+  if (config_mask & ROCSHMEM_TEAM_COLLECTIVES) {
+    config->collectives = team_config.collectives;
+  }
   return 0;
 }
 
@@ -310,7 +485,7 @@ __host__ void rocshmem_team_destroy(rocshmem_team_t team) {
 
   backend->team_tracker.untrack(team);
 
-  backend->team_destroy(team);
+  destroy_team(team);
 }
 
 __host__ int rocshmem_team_translate_pe(rocshmem_team_t src_team, int src_pe,
@@ -498,6 +673,8 @@ __host__ void rocshmem_put(rocshmem_ctx_t ctx, T *dest, const T *source,
                             size_t nelems, int pe) {
   DPRINTF("Host function: rocshmem_put\n");
 
+  THREAD_PES_DISPATCH(put(dest, source, nelems, pe));
+
   get_internal_ctx(ctx)->put(dest, source, nelems, pe);
 }
 
@@ -505,6 +682,8 @@ __host__ void rocshmem_ctx_putmem(rocshmem_ctx_t ctx, void *dest,
                                    const void *source, size_t nelems, int pe) {
   DPRINTF("Host function: rocshmem_ctx_putmem\n");
 
+  THREAD_PES_DISPATCH(putmem(dest, source, nelems, pe));
+
   get_internal_ctx(ctx)->putmem(dest, source, nelems, pe);
 }
 
@@ -512,6 +691,8 @@ template <typename T>
 __host__ void rocshmem_p(rocshmem_ctx_t ctx, T *dest, T value, int pe) {
   DPRINTF("Host function: rocshmem_p\n");
 
+  THREAD_PES_DISPATCH(p(dest, value, pe));
+
   get_internal_ctx(ctx)->p(dest, value, pe);
 }
 
@@ -520,6 +701,8 @@ __host__ void rocshmem_get(rocshmem_ctx_t ctx, T *dest, const T *source,
                             size_t nelems, int pe) {
   DPRINTF("Host function: rocshmem_get\n");
 
+  THREAD_PES_DISPATCH(get(dest, source, nelems, pe));
+
   get_internal_ctx(ctx)->get(dest, source, nelems, pe);
 }
 
@@ -527,6 +710,8 @@ __host__ void rocshmem_ctx_getmem(rocshmem_ctx_t ctx, void *dest,
                                    const void *source, size_t nelems, int pe) {
   DPRINTF("Host function: rocshmem_ctx_getmem\n");
 
+  THREAD_PES_DISPATCH(getmem(dest, source, nelems, pe));
+
   get_internal_ctx(ctx)->getmem(dest, source, nelems, pe);
 }
 
@@ -534,6 +719,8 @@ template <typename T>
 __host__ T rocshmem_g(rocshmem_ctx_t ctx, const T *source, int pe) {
   DPRINTF("Host function: rocshmem_g\n");
 
+  THREAD_PES_DISPATCH(g(source, pe));
+
   return get_internal_ctx(ctx)->g(source, pe);
 }
 
@@ -542,6 +729,8 @@ __host__ void rocshmem_put_nbi(rocshmem_ctx_t ctx, T *dest, const T *source,
                                 size_t nelems, int pe) {
   DPRINTF("Host function: rocshmem_put_nbi\n");
 
+  THREAD_PES_DISPATCH(put_nbi(dest, source, nelems, pe));
+
   get_internal_ctx(ctx)->put_nbi(dest, source, nelems, pe);
 }
 
@@ -550,6 +739,8 @@ __host__ void rocshmem_ctx_putmem_nbi(rocshmem_ctx_t ctx, void *dest,
                                        int pe) {
   DPRINTF("Host function: rocshmem_ctx_putmem_nbi\n");
 
+  THREAD_PES_DISPATCH(putmem_nbi(dest, source, nelems, pe));
+
   get_internal_ctx(ctx)->putmem_nbi(dest, source, nelems, pe);
 }
 
@@ -558,6 +749,8 @@ __host__ void rocshmem_get_nbi(rocshmem_ctx_t ctx, T *dest, const T *source,
                                 size_t nelems, int pe) {
   DPRINTF("Host function: rocshmem_get_nbi\n");
 
+  THREAD_PES_DISPATCH(get_nbi(dest, source, nelems, pe));
+
   get_internal_ctx(ctx)->get_nbi(dest, source, nelems, pe);
 }
 
@@ -566,6 +759,8 @@ __host__ void rocshmem_ctx_getmem_nbi(rocshmem_ctx_t ctx, void *dest,
                                        int pe) {
   DPRINTF("Host function: rocshmem_ctx_getmem_nbi\n");
 
+  THREAD_PES_DISPATCH(getmem_nbi(dest, source, nelems, pe));
+
   get_internal_ctx(ctx)->getmem_nbi(dest, source, nelems, pe);
 }
 
@@ -574,6 +769,8 @@ __host__ T rocshmem_atomic_fetch_add(rocshmem_ctx_t ctx, T *dest, T val,
                                       int pe) {
   DPRINTF("Host function: rocshmem_atomic_fetch_add\n");
 
+  THREAD_PES_DISPATCH(amo_fetch_add<T>(dest, val, pe));
+
   return get_internal_ctx(ctx)->amo_fetch_add<T>(dest, val, pe);
 }
 
@@ -582,6 +779,8 @@ __host__ T rocshmem_atomic_compare_swap(rocshmem_ctx_t ctx, T *dest, T cond,
                                          T val, int pe) {
   DPRINTF("Host function: rocshmem_atomic_compare_swap\n");
 
+  THREAD_PES_DISPATCH(amo_fetch_cas(dest, val, cond, pe));
+
   return get_internal_ctx(ctx)->amo_fetch_cas(dest, val, cond, pe);
 }
 
@@ -589,6 +788,8 @@ template <typename T>
 __host__ T rocshmem_atomic_fetch_inc(rocshmem_ctx_t ctx, T *dest, int pe) {
   DPRINTF("Host function: rocshmem_atomic_fetch_inc\n");
 
+  THREAD_PES_DISPATCH(amo_fetch_add<T>(dest, 1, pe));
+
   return get_internal_ctx(ctx)->amo_fetch_add<T>(dest, 1, pe);
 }
 
@@ -596,6 +797,8 @@ template <typename T>
 __host__ T rocshmem_atomic_fetch(rocshmem_ctx_t ctx, T *source, int pe) {
   DPRINTF("Host function: rocshmem_atomic_fetch\n");
 
+  THREAD_PES_DISPATCH(amo_fetch(source, pe));
+
   return get_internal_ctx(ctx)->amo_fetch_add<T>(source, 0, pe);
 }
 
@@ -604,6 +807,8 @@ __host__ void rocshmem_atomic_add(rocshmem_ctx_t ctx, T *dest, T val,
                                    int pe) {
   DPRINTF("Host function: rocshmem_atomic_add\n");
 
+  THREAD_PES_DISPATCH(amo_add<T>(dest, val, pe));
+
   get_internal_ctx(ctx)->amo_add<T>(dest, val, pe);
 }
 
@@ -611,6 +816,8 @@ template <typename T>
 __host__ void rocshmem_atomic_inc(rocshmem_ctx_t ctx, T *dest, int pe) {
   DPRINTF("Host function: rocshmem_atomic_inc\n");
 
+  THREAD_PES_DISPATCH(amo_add<T>(dest, 1, pe));
+
   get_internal_ctx(ctx)->amo_add<T>(dest, 1, pe);
 }
 
@@ -619,6 +826,8 @@ __host__ void rocshmem_atomic_set(rocshmem_ctx_t ctx, T *dest, T val,
                                    int pe) {
   DPRINTF("Host function: rocshmem_atomic_set\n");
 
+  THREAD_PES_DISPATCH(amo_set(dest, val, pe));
+
   get_internal_ctx(ctx)->amo_set(dest, val, pe);
 }
 
@@ -626,6 +835,8 @@ template <typename T>
 __host__ T rocshmem_atomic_swap(rocshmem_ctx_t ctx, T *dest, T val, int pe) {
   DPRINTF("Host function: rocshmem_atomic_set\n");
 
+  THREAD_PES_DISPATCH(amo_swap(dest, val, pe));
+
   return get_internal_ctx(ctx)->amo_swap(dest, val, pe);
 }
 
@@ -634,6 +845,8 @@ __host__ T rocshmem_atomic_fetch_and(rocshmem_ctx_t ctx, T *dest, T val,
                                       int pe) {
   DPRINTF("Host function: rocshmem_atomic_fetch_and\n");
 
+  THREAD_PES_DISPATCH(amo_fetch_and(dest, val, pe));
+
   return get_internal_ctx(ctx)->amo_fetch_and(dest, val, pe);
 }
 
@@ -642,6 +855,8 @@ __host__ void rocshmem_atomic_and(rocshmem_ctx_t ctx, T *dest, T val,
                                    int pe) {
   DPRINTF("Host function: rocshmem_atomic_and\n");
 
+  THREAD_PES_DISPATCH(amo_and(dest, val, pe));
+
   get_internal_ctx(ctx)->amo_and(dest, val, pe);
 }
 
@@ -650,6 +865,8 @@ __host__ T rocshmem_atomic_fetch_or(rocshmem_ctx_t ctx, T *dest, T val,
                                      int pe) {
   DPRINTF("Host function: rocshmem_atomic_fetch_or\n");
 
+  THREAD_PES_DISPATCH(amo_fetch_or(dest, val, pe));
+
   return get_internal_ctx(ctx)->amo_fetch_or(dest, val, pe);
 }
 
@@ -657,6 +874,8 @@ template <typename T>
 __host__ void rocshmem_atomic_or(rocshmem_ctx_t ctx, T *dest, T val, int pe) {
   DPRINTF("Host function: rocshmem_atomic_or\n");
 
+  THREAD_PES_DISPATCH(amo_or(dest, val, pe));
+
   get_internal_ctx(ctx)->amo_or(dest, val, pe);
 }
 
@@ -665,6 +884,8 @@ __host__ T rocshmem_atomic_fetch_xor(rocshmem_ctx_t ctx, T *dest, T val,
                                       int pe) {
   DPRINTF("Host function: rocshmem_atomic_fetch_xor\n");
 
+  THREAD_PES_DISPATCH(amo_fetch_xor(dest, val, pe));
+
   return get_internal_ctx(ctx)->amo_fetch_xor(dest, val, pe);
 }
 
@@ -673,30 +894,40 @@ __host__ void rocshmem_atomic_xor(rocshmem_ctx_t ctx, T *dest, T val,
                                    int pe) {
   DPRINTF("Host function: rocshmem_atomic_xor\n");
 
+  THREAD_PES_DISPATCH(amo_xor(dest, val, pe));
+
   get_internal_ctx(ctx)->amo_xor(dest, val, pe);
 }
 
 __host__ void rocshmem_ctx_fence(rocshmem_ctx_t ctx) {
   DPRINTF("Host function: rocshmem_ctx_fence\n");
 
+  THREAD_PES_DISPATCH(fence());
+
   get_internal_ctx(ctx)->fence();
 }
 
 __host__ void rocshmem_ctx_quiet(rocshmem_ctx_t ctx) {
   DPRINTF("Host function: rocshmem_ctx_quiet\n");
 
+  THREAD_PES_DISPATCH(quiet());
+
   get_internal_ctx(ctx)->quiet();
 }
 
 __host__ void rocshmem_barrier_all() {
   DPRINTF("Host function: rocshmem_barrier_all\n");
 
+  THREAD_PES_DISPATCH(barrier_all());
+
   get_internal_ctx(ROCSHMEM_HOST_CTX_DEFAULT)->barrier_all();
 }
 
 __host__ void rocshmem_sync_all() {
   DPRINTF("Host function: rocshmem_sync_all\n");
 
+  THREAD_PES_DISPATCH(sync_all());
+
   get_internal_ctx(ROCSHMEM_HOST_CTX_DEFAULT)->sync_all();
 }
 
@@ -718,10 +949,29 @@ __host__ void rocshmem_broadcast([[maybe_unused]] rocshmem_ctx_t ctx,
                                   const T *source, int nelem, int pe_root) {
   DPRINTF("Host function: Team-based rocshmem_broadcast\n");
 
+  THREAD_PES_DISPATCH(broadcast<T>(dest, source, nelem, pe_root));
+
   get_internal_ctx(ROCSHMEM_HOST_CTX_DEFAULT)
       ->broadcast<T>(team, dest, source, nelem, pe_root);
 }
 
+template <typename T>
+__host__ void rocshmem_alltoallv([[maybe_unused]] rocshmem_ctx_t ctx,
+                                  rocshmem_team_t team, T *dest,
+                                  const T *source, const int *source_counts,
+                                  const int *source_displs,
+                                  const int *dest_counts,
+                                  const int *dest_displs) {
+  DPRINTF("Host function: Team-based rocshmem_alltoallv\n");
+
+  THREAD_PES_DISPATCH(alltoallv<T>(dest, source, source_counts, source_displs,
+                                   dest_counts, dest_displs));
+
+  get_internal_ctx(ROCSHMEM_HOST_CTX_DEFAULT)
+      ->alltoallv<T>(team, dest, source, source_counts, source_displs,
+                     dest_counts, dest_displs);
+}
+
 template <typename T, ROCSHMEM_OP Op>
 __host__ void rocshmem_to_all([[maybe_unused]] rocshmem_ctx_t ctx, T *dest,
                                const T *source, int nreduce, int PE_start,
@@ -740,6 +990,8 @@ __host__ int rocshmem_reduce([[maybe_unused]] rocshmem_ctx_t ctx,
                                int nreduce) {
   DPRINTF("Host function: Team-based rocshmem_reduce\n");
 
+  THREAD_PES_DISPATCH(reduce<T, Op>(dest, source, nreduce));
+
   return get_internal_ctx(ROCSHMEM_HOST_CTX_DEFAULT)
               ->reduce<T, Op>(team, dest, source, nreduce);
 }
@@ -748,6 +1000,8 @@ template <typename T>
 __host__ void rocshmem_wait_until(T *ivars, int cmp, T val) {
   DPRINTF("Host function: rocshmem_wait_until\n");
 
+  THREAD_PES_DISPATCH(wait_until(ivars, cmp, val));
+
   get_internal_ctx(ROCSHMEM_HOST_CTX_DEFAULT)->wait_until(ivars, cmp, val);
 }
 
@@ -812,6 +1066,8 @@ template <typename T>
 __host__ int rocshmem_test(T *ivars, int cmp, T val) {
   DPRINTF("Host function: rocshmem_testl\n");
 
+  THREAD_PES_DISPATCH(test(ivars, cmp, val));
+
   return get_internal_ctx(ROCSHMEM_HOST_CTX_DEFAULT)->test(ivars, cmp, val);
 }
 
@@ -874,7 +1130,11 @@ __host__ int rocshmem_test(T *ivars, int cmp, T val) {
       int pe_start, int log_pe_stride, int pe_size, long *p_sync);            \
   template __host__ void rocshmem_broadcast<T>(                               \
       rocshmem_ctx_t ctx, rocshmem_team_t team, T * dest, const T *source,    \
-      int nelem, int pe_root);
+      int nelem, int pe_root);                                                \
+  template __host__ void rocshmem_alltoallv<T>(                               \
+      rocshmem_ctx_t ctx, rocshmem_team_t team, T * dest, const T *source,    \
+      const int *source_counts, const int *source_displs,                     \
+      const int *dest_counts, const int *dest_displs);
 
 /**
  * Declare templates for the standard amo types
@@ -1058,6 +1318,13 @@ __host__ int rocshmem_test(T *ivars, int cmp, T val) {
       rocshmem_ctx_t ctx, rocshmem_team_t team, T *dest, const T *source,     \
       int nelem, int pe_root) {                                               \
     rocshmem_broadcast<T>(ctx, team, dest, source, nelem, pe_root);           \
+  }                                                                           \
+  __host__ void rocshmem_ctx_##TNAME##_alltoallv(                             \
+      rocshmem_ctx_t ctx, rocshmem_team_t team, T *dest, const T *source,     \
+      const int *source_counts, const int *source_displs,                     \
+      const int *dest_counts, const int *dest_displs) {                       \
+    rocshmem_alltoallv<T>(ctx, team, dest, source, source_counts,             \
+                          source_displs, dest_counts, dest_displs);           \
   }
 
 #define AMO_STANDARD_DEF_GEN(T, TNAME)                                        \
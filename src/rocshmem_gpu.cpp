@@ -190,6 +190,22 @@ __device__ void rocshmem_atomic_add(T *dest, T val, int pe) {
   rocshmem_atomic_add(ROCSHMEM_CTX_DEFAULT, dest, val, pe);
 }
 
+template <typename T>
+__device__ void rocshmem_atomic_add_vector(T *dest, const size_t *indices,
+                                            const T *values, const int *pes,
+                                            size_t nelems) {
+  rocshmem_atomic_add_vector(ROCSHMEM_CTX_DEFAULT, dest, indices, values, pes,
+                              nelems);
+}
+
+template <typename T>
+__device__ void rocshmem_atomic_add_strided(T *dest, ptrdiff_t dst_stride,
+                                             const T *values, size_t nelems,
+                                             int pe) {
+  rocshmem_atomic_add_strided(ROCSHMEM_CTX_DEFAULT, dest, dst_stride, values,
+                               nelems, pe);
+}
+
 template <typename T>
 __device__ void rocshmem_atomic_inc(T *dest, int pe) {
   rocshmem_atomic_inc(ROCSHMEM_CTX_DEFAULT, dest, pe);
@@ -454,6 +470,22 @@ __device__ void *rocshmem_ptr(const void *dest, int pe) {
   return get_internal_ctx(ROCSHMEM_CTX_DEFAULT)->shmem_ptr(dest, pe);
 }
 
+__device__ uint64_t rocshmem_ctx_am(rocshmem_ctx_t ctx, void *dest,
+                                    int handler_id, uint64_t arg0,
+                                    uint64_t arg1, int pe) {
+  GPU_DPRINTF("Function: rocshmem_ctx_am\n");
+
+  return get_internal_ctx(ctx)->am(dest, handler_id, arg0, arg1, pe);
+}
+
+__device__ uint64_t rocshmem_am(void *dest, int handler_id, uint64_t arg0,
+                                uint64_t arg1, int pe) {
+  GPU_DPRINTF("Function: rocshmem_am\n");
+
+  return rocshmem_ctx_am(ROCSHMEM_CTX_DEFAULT, dest, handler_id, arg0, arg1,
+                         pe);
+}
+
 template <typename T, ROCSHMEM_OP Op>
 __device__ int rocshmem_wg_reduce(rocshmem_ctx_t ctx, rocshmem_team_t team,
                                    T *dest, const T *source, int nreduce) {
@@ -462,6 +494,16 @@ __device__ int rocshmem_wg_reduce(rocshmem_ctx_t ctx, rocshmem_team_t team,
   return get_internal_ctx(ctx)->reduce<T, Op>(team, dest, source, nreduce);
 }
 
+template <typename T, ROCSHMEM_OP Op>
+__device__ int rocshmem_wg_reduce_scatter(rocshmem_ctx_t ctx,
+                                           rocshmem_team_t team, T *dest,
+                                           const T *source, int nreduce) {
+  GPU_DPRINTF("Function: rocshmem_reduce_scatter\n");
+
+  return get_internal_ctx(ctx)->reduce_scatter<T, Op>(team, dest, source,
+                                                      nreduce);
+}
+
 template <typename T>
 __device__ void rocshmem_wg_broadcast(rocshmem_ctx_t ctx,
                                        rocshmem_team_t team, T *dest,
@@ -490,6 +532,30 @@ __device__ void rocshmem_wg_fcollect(rocshmem_ctx_t ctx,
   get_internal_ctx(ctx)->fcollect<T>(team, dest, source, nelem);
 }
 
+template <typename T>
+__device__ void rocshmem_wg_fcollectv(rocshmem_ctx_t ctx,
+                                       rocshmem_team_t team, T *dest,
+                                       const T *source, const int *counts) {
+  GPU_DPRINTF("Function: rocshmem_fcollectv\n");
+
+  get_internal_ctx(ctx)->fcollectv<T>(team, dest, source, counts);
+}
+
+template <typename T>
+__device__ void rocshmem_wg_alltoallv(rocshmem_ctx_t ctx,
+                                       rocshmem_team_t team, T *dest,
+                                       const T *source,
+                                       const int *source_counts,
+                                       const int *source_displs,
+                                       const int *dest_counts,
+                                       const int *dest_displs) {
+  GPU_DPRINTF("Function: rocshmem_alltoallv\n");
+
+  get_internal_ctx(ctx)->alltoallv<T>(team, dest, source, source_counts,
+                                      source_displs, dest_counts,
+                                      dest_displs);
+}
+
 template <typename T>
 __device__ void rocshmem_wait_until(T *ivars, int cmp, T val) {
   GPU_DPRINTF("Function: rocshmem_wait_until\n");
@@ -682,6 +748,27 @@ __device__ void rocshmem_atomic_add(rocshmem_ctx_t ctx, T *dest, T val,
   get_internal_ctx(ctx)->amo_add<T>(dest, val, pe);
 }
 
+template <typename T>
+__device__ void rocshmem_atomic_add_vector(rocshmem_ctx_t ctx, T *dest,
+                                            const size_t *indices,
+                                            const T *values, const int *pes,
+                                            size_t nelems) {
+  GPU_DPRINTF("Function: rocshmem_atomic_add_vector\n");
+
+  get_internal_ctx(ctx)->amo_add_vector<T>(dest, indices, values, pes, nelems);
+}
+
+template <typename T>
+__device__ void rocshmem_atomic_add_strided(rocshmem_ctx_t ctx, T *dest,
+                                             ptrdiff_t dst_stride,
+                                             const T *values, size_t nelems,
+                                             int pe) {
+  GPU_DPRINTF("Function: rocshmem_atomic_add_strided\n");
+
+  get_internal_ctx(ctx)->amo_add_strided<T>(dest, dst_stride, values, nelems,
+                                            pe);
+}
+
 template <typename T>
 __device__ void rocshmem_atomic_inc(rocshmem_ctx_t ctx, T *dest, int pe) {
   GPU_DPRINTF("Function: rocshmem_atomic_inc\n");
@@ -946,6 +1033,9 @@ __device__ int rocshmem_team_translate_pe(rocshmem_team_t src_team,
  */
 #define REDUCTION_GEN(T, Op)                                                   \
   template __device__ int rocshmem_wg_reduce<T, Op>(                           \
+      rocshmem_ctx_t ctx, rocshmem_team_t team, T * dest, const T *source,     \
+      int nreduce);                                                            \
+  template __device__ int rocshmem_wg_reduce_scatter<T, Op>(                   \
       rocshmem_ctx_t ctx, rocshmem_team_t team, T * dest, const T *source,     \
       int nreduce);
 
@@ -984,6 +1074,13 @@ __device__ int rocshmem_team_translate_pe(rocshmem_team_t src_team,
   template __device__ void rocshmem_wg_fcollect<T>(                            \
       rocshmem_ctx_t ctx, rocshmem_team_t team, T * dest, const T *source,     \
       int nelem);                                                              \
+  template __device__ void rocshmem_wg_fcollectv<T>(                           \
+      rocshmem_ctx_t ctx, rocshmem_team_t team, T * dest, const T *source,     \
+      const int *counts);                                                      \
+  template __device__ void rocshmem_wg_alltoallv<T>(                           \
+      rocshmem_ctx_t ctx, rocshmem_team_t team, T * dest, const T *source,     \
+      const int *source_counts, const int *source_displs,                      \
+      const int *dest_counts, const int *dest_displs);                         \
   template __device__ void rocshmem_put_wave<T>(                               \
       rocshmem_ctx_t ctx, T * dest, const T *source, size_t nelems, int pe);   \
   template __device__ void rocshmem_put_wg<T>(                                 \
@@ -1037,7 +1134,18 @@ __device__ int rocshmem_team_translate_pe(rocshmem_team_t src_team,
                                                       int pe);                 \
   template __device__ void rocshmem_atomic_add<T>(rocshmem_ctx_t ctx,          \
                                                    T * dest, T value, int pe); \
-  template __device__ void rocshmem_atomic_add<T>(T * dest, T value, int pe);
+  template __device__ void rocshmem_atomic_add<T>(T * dest, T value, int pe); \
+  template __device__ void rocshmem_atomic_add_vector<T>(                      \
+      rocshmem_ctx_t ctx, T * dest, const size_t *indices, const T *values,    \
+      const int *pes, size_t nelems);                                          \
+  template __device__ void rocshmem_atomic_add_vector<T>(                      \
+      T * dest, const size_t *indices, const T *values, const int *pes,        \
+      size_t nelems);                                                          \
+  template __device__ void rocshmem_atomic_add_strided<T>(                     \
+      rocshmem_ctx_t ctx, T * dest, ptrdiff_t dst_stride, const T *values,     \
+      size_t nelems, int pe);                                                  \
+  template __device__ void rocshmem_atomic_add_strided<T>(                     \
+      T * dest, ptrdiff_t dst_stride, const T *values, size_t nelems, int pe);
 
 /**
  * Declare templates for the extended amo types
@@ -1157,6 +1265,12 @@ __device__ int rocshmem_team_translate_pe(rocshmem_team_t src_team,
       rocshmem_ctx_t ctx, rocshmem_team_t team, T *dest, const T *source,     \
       int nreduce) {                                                          \
     return rocshmem_wg_reduce<T, Op>(ctx, team, dest, source, nreduce);       \
+  }                                                                           \
+  __device__ int rocshmem_ctx_##TNAME##_##Op_API##_wg_reduce_scatter(         \
+      rocshmem_ctx_t ctx, rocshmem_team_t team, T *dest, const T *source,     \
+      int nreduce) {                                                          \
+    return rocshmem_wg_reduce_scatter<T, Op>(ctx, team, dest, source,         \
+                                             nreduce);                        \
   }
 
 #define ARITH_REDUCTION_DEF_GEN(T, TNAME)         \
@@ -1301,6 +1415,18 @@ __device__ int rocshmem_team_translate_pe(rocshmem_team_t src_team,
       rocshmem_ctx_t ctx, rocshmem_team_t team, T *dest, const T *source,     \
       int nelem) {                                                            \
     rocshmem_wg_fcollect<T>(ctx, team, dest, source, nelem);                  \
+  }                                                                           \
+  __device__ void rocshmem_ctx_##TNAME##_wg_fcollectv(                        \
+      rocshmem_ctx_t ctx, rocshmem_team_t team, T *dest, const T *source,     \
+      const int *counts) {                                                    \
+    rocshmem_wg_fcollectv<T>(ctx, team, dest, source, counts);                \
+  }                                                                           \
+  __device__ void rocshmem_ctx_##TNAME##_wg_alltoallv(                        \
+      rocshmem_ctx_t ctx, rocshmem_team_t team, T *dest, const T *source,     \
+      const int *source_counts, const int *source_displs,                     \
+      const int *dest_counts, const int *dest_displs) {                       \
+    rocshmem_wg_alltoallv<T>(ctx, team, dest, source, source_counts,          \
+                             source_displs, dest_counts, dest_displs);        \
   }
 
 #define AMO_STANDARD_DEF_GEN(T, TNAME)                                        \
@@ -1340,6 +1466,26 @@ __device__ int rocshmem_team_translate_pe(rocshmem_team_t src_team,
   }                                                                           \
   __device__ void rocshmem_##TNAME##_atomic_add(T *dest, T value, int pe) {   \
     rocshmem_atomic_add<T>(dest, value, pe);                                  \
+  }                                                                           \
+  __device__ void rocshmem_ctx_##TNAME##_atomic_add_vector(                   \
+      rocshmem_ctx_t ctx, T *dest, const size_t *indices, const T *values,    \
+      const int *pes, size_t nelems) {                                        \
+    rocshmem_atomic_add_vector<T>(ctx, dest, indices, values, pes, nelems);   \
+  }                                                                           \
+  __device__ void rocshmem_##TNAME##_atomic_add_vector(                       \
+      T *dest, const size_t *indices, const T *values, const int *pes,        \
+      size_t nelems) {                                                        \
+    rocshmem_atomic_add_vector<T>(dest, indices, values, pes, nelems);        \
+  }                                                                           \
+  __device__ void rocshmem_ctx_##TNAME##_atomic_add_strided(                  \
+      rocshmem_ctx_t ctx, T *dest, ptrdiff_t dst_stride, const T *values,     \
+      size_t nelems, int pe) {                                                \
+    rocshmem_atomic_add_strided<T>(ctx, dest, dst_stride, values, nelems,     \
+                                   pe);                                       \
+  }                                                                           \
+  __device__ void rocshmem_##TNAME##_atomic_add_strided(                      \
+      T *dest, ptrdiff_t dst_stride, const T *values, size_t nelems, int pe) { \
+    rocshmem_atomic_add_strided<T>(dest, dst_stride, values, nelems, pe);     \
   }
 
 #define AMO_EXTENDED_DEF_GEN(T, TNAME)                                        \
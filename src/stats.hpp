@@ -88,6 +88,12 @@ enum rocshmem_stats {
   NUM_PUT_SIGNAL_NBI,
   NUM_PUT_SIGNAL_NBI_WG,
   NUM_PUT_SIGNAL_NBI_WAVE,
+  NUM_ATOMIC_ADD_VECTOR,
+  NUM_ATOMIC_ADD_STRIDED,
+  NUM_REDUCE_SCATTER,
+  NUM_FCOLLECTV,
+  NUM_AM,
+  NUM_ALLTOALLV,
   NUM_STATS
 };
 
@@ -129,6 +135,7 @@ enum rocshmem_host_stats {
   NUM_HOST_SHMEM_PTR,
   NUM_HOST_SYNC_ALL,
   NUM_HOST_BROADCAST,
+  NUM_HOST_ALLTOALLV,
   NUM_HOST_STATS
 };
 
@@ -166,6 +173,12 @@ template <int I>
 class HostStats {
   AtomicStatType stats[I] = {};
 
+  /*
+   * Below THREAD_MULTIPLE a single thread updates the counters at a time,
+   * so a relaxed load/store replaces the locked read-modify-write.
+   */
+  bool shared_{true};
+
  public:
   __host__ uint64_t startTimer() const { return MPI_Wtime(); }
 
@@ -173,7 +186,16 @@ class HostStats {
     incStat(index, MPI_Wtime() - start);
   }
 
-  __host__ void incStat(int index, int value = 1) { stats[index] += value; }
+  __host__ void set_shared(bool shared) { shared_ = shared; }
+
+  __host__ void incStat(int index, int value = 1) {
+    if (shared_) {
+      stats[index].fetch_add(value, std::memory_order_relaxed);
+    } else {
+      stats[index].store(stats[index].load(std::memory_order_relaxed) + value,
+                         std::memory_order_relaxed);
+    }
+  }
 
   __host__ void accumulateStats(const HostStats<I> &otherStats) {
     for (int i = 0; i < I; i++) incStat(i, otherStats.getStat(i));
@@ -194,6 +216,7 @@ class NullStats {
  public:
   __host__ __device__ uint64_t startTimer() const { return 0; }
   __host__ __device__ void endTimer(uint64_t start, int index) {}
+  __host__ void set_shared(bool shared) {}
   __host__ __device__ void incStat(int index, int value = 1) {}
   __host__ __device__ void accumulateStats(const NullStats<I> &otherStats) {}
   __host__ __device__ void resetStats() {}
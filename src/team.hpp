@@ -155,6 +155,11 @@ class Team {
    * @note This is required to do some reinterpret_casts.
    */
   BackendType type{BackendType::GPU_IB_BACKEND};
+
+  /**
+   * @brief Hints the team was created with (see team_config.hpp).
+   */
+  rocshmem_team_config_t config{0, 0, ROCSHMEM_TEAM_COLL_ALL};
 };
 
 __host__ __device__ Team* get_internal_team(rocshmem_team_t team);
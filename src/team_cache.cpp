@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "team_cache.hpp"
+
+#include <iterator>
+
+#include "util.hpp"
+
+namespace rocshmem {
+
+TeamCommCache::~TeamCommCache() {
+  int finalized{0};
+  MPI_Finalized(&finalized);
+  if (finalized) {
+    return;
+  }
+
+  for (auto &[key, entries] : entries_) {
+    for (auto &entry : entries) {
+      MPI_Comm_free(&entry.comm);
+    }
+  }
+  for (auto &[key, comm] : shared_) {
+    MPI_Comm_free(&comm);
+  }
+}
+
+MPI_Comm TeamCommCache::create(MPI_Comm world_comm, int start, int stride,
+                               int size, int tag) {
+  MPI_Group world_group{};
+  MPI_Comm_group(world_comm, &world_group);
+
+  int range[1][3]{{start, start + stride * (size - 1), stride}};
+  MPI_Group group{};
+  MPI_Group_range_incl(world_group, 1, range, &group);
+
+  MPI_Comm comm{MPI_COMM_NULL};
+  MPI_Comm_create_group(world_comm, group, tag, &comm);
+
+  MPI_Group_free(&group);
+  MPI_Group_free(&world_group);
+
+  DPRINTF("Created communicator for start %d stride %d size %d\n", start,
+          stride, size);
+  return comm;
+}
+
+MPI_Comm TeamCommCache::acquire(MPI_Comm world_comm, int start, int stride,
+                                int size) {
+  auto &entries{entries_[Key{start, stride, size}]};
+  for (auto &entry : entries) {
+    if (!entry.busy) {
+      DPRINTF("Reusing communicator for start %d stride %d size %d\n", start,
+              stride, size);
+      entry.busy = true;
+      return entry.comm;
+    }
+  }
+
+  entries.push_back(
+      {create(world_comm, start, stride, size, ACQUIRE_TAG), true});
+  return entries.back().comm;
+}
+
+void TeamCommCache::release(MPI_Comm comm) {
+  for (auto &[key, entries] : entries_) {
+    for (auto &entry : entries) {
+      if (entry.comm == comm) {
+        entry.busy = false;
+        return;
+      }
+    }
+  }
+}
+
+MPI_Comm TeamCommCache::shared(MPI_Comm world_comm, int start, int stride,
+                               int size) {
+  Key key{start, stride, size};
+  auto it{shared_.find(key)};
+  if (it != shared_.end()) {
+    return it->second;
+  }
+
+  MPI_Comm comm{create(world_comm, start, stride, size, SHARED_TAG)};
+  shared_.emplace(key, comm);
+  return comm;
+}
+
+void TeamScratchArena::init(void *base) {
+  base_ = static_cast<char *>(base);
+  reserved_ = -1;
+  chunks_.clear();
+  free_.clear();
+  used_.clear();
+}
+
+bool TeamScratchArena::reserve(size_t size, bool member, MPI_Comm comm) {
+  size_t length{round_up(size)};
+  long offset{first_fit(length)};  // NOLINT(runtime/int)
+
+  long bounds[2]{offset, -offset};  // NOLINT(runtime/int)
+  MPI_Allreduce(MPI_IN_PLACE, bounds, 2, MPI_LONG, MPI_MIN, comm);
+  if (bounds[0] < 0 || bounds[0] != -bounds[1]) {
+    return false;
+  }
+
+  if (member) {
+    take(offset, length);
+    reserved_ = offset;
+  }
+  return true;
+}
+
+void TeamScratchArena::add(void *chunk, size_t size, bool member) {
+  chunks_.push_back(chunk);
+
+  size_t offset = static_cast<char *>(chunk) - base_;
+  size_t length{size / ALIGNMENT * ALIGNMENT};
+  if (member) {
+    used_.emplace(offset, length);
+    reserved_ = offset;
+  } else {
+    give_back(offset, length);
+  }
+}
+
+void *TeamScratchArena::allocate(size_t size, MPI_Comm team_comm) {
+  size_t length{round_up(size)};
+
+  long offset{-1};  // NOLINT(runtime/int)
+  if (reserved_ >= 0 && used_.at(reserved_) >= length) {
+    offset = reserved_;
+  } else {
+    offset = first_fit(length);
+    if (offset >= 0) {
+      take(offset, length);
+    }
+  }
+  reserved_ = -1;
+
+  // One MIN reduction gives both the smallest and the largest offset.
+  long bounds[2]{offset, -offset};  // NOLINT(runtime/int)
+  MPI_Allreduce(MPI_IN_PLACE, bounds, 2, MPI_LONG, MPI_MIN, team_comm);
+
+  if (bounds[0] < 0 || bounds[0] != -bounds[1]) {
+    if (offset >= 0) {
+      release(base_ + offset);
+    }
+    DPRINTF("No common team scratch offset for %zu bytes\n", size);
+    return nullptr;
+  }
+  return base_ + offset;
+}
+
+void TeamScratchArena::release(void *block) {
+  if (!block) {
+    return;
+  }
+  auto used{used_.find(static_cast<char *>(block) - base_)};
+  if (used == used_.end()) {
+    return;
+  }
+
+  size_t offset{used->first};
+  size_t length{used->second};
+  used_.erase(used);
+  give_back(offset, length);
+}
+
+long TeamScratchArena::first_fit(size_t length) const {  // NOLINT
+  for (const auto &[offset, free_length] : free_) {
+    if (free_length >= length) {
+      return offset;
+    }
+  }
+  return -1;
+}
+
+void TeamScratchArena::take(size_t offset, size_t length) {
+  auto it{free_.find(offset)};
+  if (it->second > length) {
+    free_.emplace(offset + length, it->second - length);
+  }
+  free_.erase(it);
+  used_.emplace(offset, length);
+}
+
+void TeamScratchArena::give_back(size_t offset, size_t length) {
+  auto it{free_.emplace(offset, length).first};
+
+  // Merge with the free neighbours so large blocks can be found again.
+  auto next{std::next(it)};
+  if (next != free_.end() && it->first + it->second == next->first) {
+    it->second += next->second;
+    free_.erase(next);
+  }
+  if (it != free_.begin()) {
+    auto prev{std::prev(it)};
+    if (prev->first + prev->second == it->first) {
+      prev->second += it->second;
+      free_.erase(it);
+    }
+  }
+}
+
+}  // namespace rocshmem
@@ -0,0 +1,303 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_TEAM_CACHE_HPP_
+#define LIBRARY_SRC_TEAM_CACHE_HPP_
+
+/**
+ * @file team_cache.hpp
+ * Defines the TeamCommCache, TeamBlockPool and TeamScratchArena classes
+ *
+ * Frameworks that rebuild their teams every phase pay for a new
+ * communicator and fresh allocations on each split. These classes keep
+ * both around once the team using them is destroyed.
+ */
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace rocshmem {
+
+/**
+ * @class TeamCommCache team_cache.hpp
+ *
+ * @brief Communicators over strided sets of world ranks
+ *
+ * Communicators are created with MPI_Comm_create_group, so only the
+ * members of a set take part. Each member process keeps its cached
+ * communicators for a set in creation order and always hands out the
+ * first idle one; since members create and destroy teams collectively,
+ * they all pick the same communicator.
+ */
+class TeamCommCache {
+ public:
+  /**
+   * @brief Destructor frees every cached communicator
+   */
+  ~TeamCommCache();
+
+  /**
+   * @brief Get a communicator for a team's exclusive use
+   *
+   * Collective over the members of the set.
+   *
+   * @param[in] world_comm Communicator the ranks refer to
+   * @param[in] start First rank of the set in world_comm
+   * @param[in] stride Distance between ranks of the set
+   * @param[in] size Number of ranks in the set
+   *
+   * @return Communicator ordered like the set
+   */
+  MPI_Comm acquire(MPI_Comm world_comm, int start, int stride, int size);
+
+  /**
+   * @brief Return a communicator from acquire once its team is gone
+   *
+   * @param[in] comm Communicator to keep for the next team over the set
+   */
+  void release(MPI_Comm comm);
+
+  /**
+   * @brief Get the communicator shared by internal users of a set
+   *
+   * Unlike acquire, every call for the same set returns the same
+   * communicator. Collective over the members of the set the first time.
+   *
+   * @param[in] world_comm Communicator the ranks refer to
+   * @param[in] start First rank of the set in world_comm
+   * @param[in] stride Distance between ranks of the set
+   * @param[in] size Number of ranks in the set
+   *
+   * @return Communicator ordered like the set
+   */
+  MPI_Comm shared(MPI_Comm world_comm, int start, int stride, int size);
+
+ private:
+  using Key = std::tuple<int, int, int>;
+
+  struct Entry {
+    MPI_Comm comm{MPI_COMM_NULL};
+    bool busy{false};
+  };
+
+  MPI_Comm create(MPI_Comm world_comm, int start, int stride, int size,
+                  int tag);
+
+  /**
+   * @brief Tags of the two kinds of communicators, which internal users
+   * may create from another thread while a team is being split
+   */
+  static constexpr int ACQUIRE_TAG{1};
+  static constexpr int SHARED_TAG{2};
+
+  /**
+   * @brief Communicators handed out by acquire, per set
+   */
+  std::map<Key, std::vector<Entry>> entries_{};
+
+  /**
+   * @brief Communicators handed out by shared, per set
+   */
+  std::map<Key, MPI_Comm> shared_{};
+};
+
+/**
+ * @class TeamBlockPool team_cache.hpp
+ *
+ * @brief Recycles fixed-size allocations made for teams
+ *
+ * Blocks come from ALLOC_T and are kept per size when released; they are
+ * only given back to ALLOC_T when the pool is destroyed.
+ */
+template <typename ALLOC_T>
+class TeamBlockPool {
+ public:
+  /**
+   * @brief Destructor frees every cached block
+   */
+  ~TeamBlockPool() {
+    for (auto &[size, blocks] : free_) {
+      for (auto *block : blocks) {
+        allocator_.deallocate(block);
+      }
+    }
+  }
+
+  /**
+   * @brief Get a block of size bytes
+   *
+   * @param[in] size Bytes needed
+   *
+   * @return Pointer to the block
+   */
+  void *allocate(size_t size) {
+    auto &blocks{free_[size]};
+    if (!blocks.empty()) {
+      void *block{blocks.back()};
+      blocks.pop_back();
+      return block;
+    }
+
+    void *block{nullptr};
+    allocator_.allocate(&block, size);
+    return block;
+  }
+
+  /**
+   * @brief Keep a block from allocate for reuse
+   *
+   * @param[in] block Block to release
+   * @param[in] size Size it was allocated with
+   */
+  void release(void *block, size_t size) {
+    if (block) {
+      free_[size].push_back(block);
+    }
+  }
+
+ private:
+  ALLOC_T allocator_{};
+
+  std::map<size_t, std::vector<void *>> free_{};
+};
+
+/**
+ * @class TeamScratchArena team_cache.hpp
+ *
+ * @brief Symmetric scratch for teams, taken from the heap as teams need it
+ *
+ * Teams are created by their members only, so allocating their scratch
+ * from the symmetric heap would move the heap allocator on some PEs and
+ * not on others. Chunks are therefore only taken from the heap while a
+ * team is split from TEAM_WORLD, when every PE is present, and stay in
+ * the arena until teardown. Blocks are only kept when every team member
+ * got the same offset.
+ */
+class TeamScratchArena {
+ public:
+  /**
+   * @brief Set the address offsets are measured from
+   *
+   * @param[in] base Start of the symmetric heap
+   */
+  void init(void *base);
+
+  /**
+   * @brief Look for a free block at the same offset on every PE
+   *
+   * Must be called by every member of comm. On success a member keeps the
+   * block for its next allocate.
+   *
+   * @param[in] size Bytes needed
+   * @param[in] member Whether this PE joins the team being created
+   * @param[in] comm Communicator over every PE
+   *
+   * @return Whether the PEs agreed on a block
+   */
+  bool reserve(size_t size, bool member, MPI_Comm comm);
+
+  /**
+   * @brief Hand a chunk taken from the heap to the arena
+   *
+   * @param[in] chunk Start of the chunk, the same offset on every PE
+   * @param[in] size Bytes in the chunk
+   * @param[in] member Keep the chunk for the next allocate instead of
+   *            freeing it
+   */
+  void add(void *chunk, size_t size, bool member);
+
+  /**
+   * @brief Get a block at the same offset on every member of team_comm
+   *
+   * Takes the block kept by reserve or add if there is one. Must be called
+   * by every member of team_comm.
+   *
+   * @param[in] size Bytes needed
+   * @param[in] team_comm Communicator over the team members
+   *
+   * @return The block, or nullptr if the members could not agree on one
+   */
+  void *allocate(size_t size, MPI_Comm team_comm);
+
+  /**
+   * @brief Return a block from allocate to the arena
+   *
+   * @param[in] block Block to release
+   */
+  void release(void *block);
+
+  /**
+   * @brief Chunks taken from the heap, in the order every PE took them
+   */
+  const std::vector<void *> &chunks() const { return chunks_; }
+
+  /**
+   * @brief Round a request up to the step between blocks
+   */
+  static size_t round_up(size_t size) {
+    return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+  }
+
+  /**
+   * @brief Smallest step between blocks
+   */
+  static constexpr size_t ALIGNMENT{256};
+
+ private:
+  /**
+   * @brief Offset of the first free range that holds length, or -1
+   */
+  long first_fit(size_t length) const;  // NOLINT(runtime/int)
+
+  /**
+   * @brief Move length bytes at offset from the free ranges to the used ones
+   */
+  void take(size_t offset, size_t length);
+
+  /**
+   * @brief Add a range to the free ones, merging it with its neighbours
+   */
+  void give_back(size_t offset, size_t length);
+
+  char *base_{nullptr};
+
+  /**
+   * @brief Offset of the block kept for the next allocate, or -1
+   */
+  long reserved_{-1};  // NOLINT(runtime/int)
+
+  std::vector<void *> chunks_{};
+
+  /**
+   * @brief Free and handed out ranges, offset to length
+   */
+  std::map<size_t, size_t> free_{};
+  std::map<size_t, size_t> used_{};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_TEAM_CACHE_HPP_
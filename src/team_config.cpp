@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "team_config.hpp"
+
+#include <algorithm>
+
+namespace rocshmem {
+
+rocshmem_team_config_t default_team_config() {
+  rocshmem_team_config_t config{};
+  config.num_contexts = 0;
+  config.max_reduce_size = 0;
+  config.collectives = ROCSHMEM_TEAM_COLL_ALL;
+  return config;
+}
+
+bool resolve_team_config(const rocshmem_team_config_t *config,
+                         long config_mask,  // NOLINT(runtime/int)
+                         rocshmem_team_config_t *resolved) {
+  *resolved = default_team_config();
+  if (config_mask == ROCSHMEM_TEAM_DEFAULT_CONFIGS) {
+    return true;
+  }
+  if (config == nullptr) {
+    return false;
+  }
+
+  if (config_mask & ROCSHMEM_TEAM_NUM_CONTEXTS) {
+    if (config->num_contexts < 0) {
+      return false;
+    }
+    resolved->num_contexts = config->num_contexts;
+  }
+  if (config_mask & ROCSHMEM_TEAM_MAX_REDUCE_SIZE) {
+    resolved->max_reduce_size = config->max_reduce_size;
+  }
+  if (config_mask & ROCSHMEM_TEAM_COLLECTIVES) {
+    if (config->collectives & ~ROCSHMEM_TEAM_COLL_ALL) {
+      return false;
+    }
+    resolved->collectives = config->collectives;
+  }
+  return true;
+}
+
+size_t team_reduce_scratch_elems(const rocshmem_team_config_t &config,
+                                 int num_slots) {
+  if (!team_uses(config, ROCSHMEM_TEAM_COLL_REDUCE)) {
+    return 0;
+  }
+  return std::max(ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE,
+                  config.max_reduce_size * static_cast<size_t>(num_slots));
+}
+
+bool team_uses(const rocshmem_team_config_t &config,
+               rocshmem_team_collectives coll) {
+  return config.collectives & coll;
+}
+
+}  // namespace rocshmem
@@ -0,0 +1,79 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_TEAM_CONFIG_HPP_
+#define LIBRARY_SRC_TEAM_CONFIG_HPP_
+
+/**
+ * @file team_config.hpp
+ * Resolution of the rocshmem_team_config_t hints given at team creation
+ */
+
+#include <cstddef>
+
+#include "rocshmem/rocshmem.hpp"
+
+namespace rocshmem {
+
+/**
+ * @brief The configuration a team gets when no hints are given.
+ */
+rocshmem_team_config_t default_team_config();
+
+/**
+ * @brief Merge the parameters selected by config_mask over the defaults.
+ *
+ * @param[in] config      Hints from the caller; may be null when the
+ *                        mask is zero.
+ * @param[in] config_mask Bitwise OR of rocshmem_team_configs.
+ * @param[out] resolved   The configuration the team is created with.
+ *
+ * @return false if a selected parameter is out of range.
+ */
+bool resolve_team_config(const rocshmem_team_config_t *config,
+                         long config_mask,  // NOLINT(runtime/int)
+                         rocshmem_team_config_t *resolved);
+
+/**
+ * @brief Elements (of the largest reduction type) of reduce scratch a
+ * team needs.
+ *
+ * @param[in] config    Resolved team configuration.
+ * @param[in] num_slots Number of per-PE slots the backend's direct
+ *                      reduction indexes pWrk with.
+ *
+ * @return Zero if the team does not reduce. Otherwise enough for a
+ *         single-pass reduction of max_reduce_size elements, and never
+ *         less than ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE.
+ */
+size_t team_reduce_scratch_elems(const rocshmem_team_config_t &config,
+                                 int num_slots);
+
+/**
+ * @brief Whether a team configured this way runs the collective.
+ */
+bool team_uses(const rocshmem_team_config_t &config,
+               rocshmem_team_collectives coll);
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_TEAM_CONFIG_HPP_
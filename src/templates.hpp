@@ -324,6 +324,61 @@ __device__ void rocshmem_atomic_add(rocshmem_ctx_t ctx, T *dest, T val,
 template <typename T>
 __device__ void rocshmem_atomic_add(T *dest, T val, int pe);
 
+/**
+ * @brief Atomically add values[i] to dest[indices[i]] on pes[i] for each of
+ * the \p nelems elements.
+ *
+ * The operation is blocking. The reverse offload backend submits the whole
+ * vector as one command; other backends issue one atomic per element.
+ *
+ * @param[in] ctx     Context with which to perform this operation.
+ * @param[in] dest    Destination base address on the symmetric heap.
+ * @param[in] indices Element offsets from \p dest.
+ * @param[in] values  Values to be atomically added.
+ * @param[in] pes     Target PE of each element.
+ * @param[in] nelems  Number of elements.
+ *
+ * @return void
+ *
+ */
+template <typename T>
+__device__ void rocshmem_atomic_add_vector(rocshmem_ctx_t ctx, T *dest,
+                                            const size_t *indices,
+                                            const T *values, const int *pes,
+                                            size_t nelems);
+
+template <typename T>
+__device__ void rocshmem_atomic_add_vector(T *dest, const size_t *indices,
+                                            const T *values, const int *pes,
+                                            size_t nelems);
+
+/**
+ * @brief Atomically add values[i] to dest[i * dst_stride] on \p pe for each
+ * of the \p nelems elements.
+ *
+ * The operation is blocking.
+ *
+ * @param[in] ctx        Context with which to perform this operation.
+ * @param[in] dest       Destination base address on the symmetric heap.
+ * @param[in] dst_stride Positive stride, in elements, between destinations.
+ * @param[in] values     Contiguous values to be atomically added.
+ * @param[in] nelems     Number of elements.
+ * @param[in] pe         PE of the remote process.
+ *
+ * @return void
+ *
+ */
+template <typename T>
+__device__ void rocshmem_atomic_add_strided(rocshmem_ctx_t ctx, T *dest,
+                                             ptrdiff_t dst_stride,
+                                             const T *values, size_t nelems,
+                                             int pe);
+
+template <typename T>
+__device__ void rocshmem_atomic_add_strided(T *dest, ptrdiff_t dst_stride,
+                                             const T *values, size_t nelems,
+                                             int pe);
+
 /**
  * @brief Atomically add 1 to \p dest on \p pe.
  *
@@ -0,0 +1,205 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "traffic_matrix.hpp"
+
+#include <fstream>
+
+namespace rocshmem {
+
+static constexpr int NUM_CLASSES{static_cast<int>(TrafficClass::NUM_CLASSES)};
+
+const char *traffic_class_name(TrafficClass cls) {
+  switch (cls) {
+    case TrafficClass::PUT:
+      return "put";
+    case TrafficClass::GET:
+      return "get";
+    case TrafficClass::AMO:
+      return "amo";
+    case TrafficClass::COLL:
+      return "coll";
+    default:
+      return "unknown";
+  }
+}
+
+TrafficMatrix &TrafficMatrix::GetInstance() {
+  static TrafficMatrix matrix{};
+  return matrix;
+}
+
+TrafficMatrix::~TrafficMatrix() {
+  /*
+   * The process-wide matrix is destroyed after MPI is finalized; only an
+   * instance freed while MPI is up releases its handles.
+   */
+  int finalized{};
+  MPI_Finalized(&finalized);
+  if (finalized || world_ == MPI_COMM_NULL) {
+    return;
+  }
+  MPI_Group_free(&world_group_);
+  MPI_Comm_free(&world_);
+}
+
+void TrafficMatrix::enable(MPI_Comm world) {
+  if (enabled()) {
+    return;
+  }
+  MPI_Comm_dup(world, &world_);
+  MPI_Comm_rank(world_, &my_pe_);
+  MPI_Comm_size(world_, &num_pes_);
+  MPI_Comm_group(world_, &world_group_);
+
+  size_t size{static_cast<size_t>(NUM_CLASSES) * num_pes_ * CELL_WIDTH};
+  counters_ = std::make_unique<std::atomic<uint64_t>[]>(size);
+  for (size_t i{0}; i < size; i++) {
+    counters_[i].store(0, std::memory_order_relaxed);
+  }
+  enabled_.store(true, std::memory_order_release);
+}
+
+std::vector<int> TrafficMatrix::world_pes(MPI_Comm team) const {
+  int size{};
+  MPI_Comm_size(team, &size);
+
+  std::vector<int> ranks(size);
+  for (int i{0}; i < size; i++) {
+    ranks[i] = i;
+  }
+
+  MPI_Group group{};
+  MPI_Comm_group(team, &group);
+  std::vector<int> pes(size);
+  MPI_Group_translate_ranks(group, size, ranks.data(), world_group_,
+                            pes.data());
+  MPI_Group_free(&group);
+  return pes;
+}
+
+void TrafficMatrix::record_team(TrafficClass cls, MPI_Comm team,
+                                uint64_t bytes) {
+  if (!enabled()) {
+    return;
+  }
+  for (const auto pe : world_pes(team)) {
+    if (pe != my_pe_) {
+      record(cls, pe, bytes);
+    }
+  }
+}
+
+void TrafficMatrix::record_team(TrafficClass cls, MPI_Comm team,
+                                const int *counts, size_t elem_size) {
+  if (!enabled()) {
+    return;
+  }
+  auto pes{world_pes(team)};
+  for (size_t i{0}; i < pes.size(); i++) {
+    if (pes[i] != my_pe_ && counts[i]) {
+      record(cls, pes[i], counts[i] * elem_size);
+    }
+  }
+}
+
+uint64_t TrafficMatrix::ops(TrafficClass cls, int pe) const {
+  if (!enabled()) {
+    return 0;
+  }
+  return counters_[index(cls, pe)].load(std::memory_order_relaxed);
+}
+
+uint64_t TrafficMatrix::bytes(TrafficClass cls, int pe) const {
+  if (!enabled()) {
+    return 0;
+  }
+  return counters_[index(cls, pe) + 1].load(std::memory_order_relaxed);
+}
+
+void TrafficMatrix::reset() {
+  if (!enabled()) {
+    return;
+  }
+  size_t size{static_cast<size_t>(NUM_CLASSES) * num_pes_ * CELL_WIDTH};
+  for (size_t i{0}; i < size; i++) {
+    counters_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+std::vector<uint64_t> TrafficMatrix::row() const {
+  std::vector<uint64_t> values(static_cast<size_t>(NUM_CLASSES) * num_pes_ *
+                               CELL_WIDTH);
+  for (size_t i{0}; i < values.size(); i++) {
+    values[i] = counters_[i].load(std::memory_order_relaxed);
+  }
+  return values;
+}
+
+bool TrafficMatrix::dump(const char *path) {
+  if (!enabled()) {
+    return false;
+  }
+
+  auto mine{row()};
+  std::vector<uint64_t> matrix{};
+  if (my_pe_ == 0) {
+    matrix.resize(mine.size() * num_pes_);
+  }
+  MPI_Gather(mine.data(), static_cast<int>(mine.size()), MPI_UINT64_T,
+             matrix.data(), static_cast<int>(mine.size()), MPI_UINT64_T, 0,
+             world_);
+
+  int ok{1};
+  if (my_pe_ == 0) {
+    std::ofstream out{path};
+    write_csv(out, matrix, num_pes_);
+    ok = static_cast<bool>(out);
+  }
+  MPI_Bcast(&ok, 1, MPI_INT, 0, world_);
+  return ok;
+}
+
+void TrafficMatrix::write_csv(std::ostream &out,
+                              const std::vector<uint64_t> &matrix,
+                              int num_pes) {
+  // The PE count is recorded so that idle PEs still get a row and column.
+  out << "# pes " << num_pes << "\n";
+  out << "class,src,dst,ops,bytes\n";
+
+  size_t row_size{static_cast<size_t>(NUM_CLASSES) * num_pes * CELL_WIDTH};
+  for (int cls{0}; cls < NUM_CLASSES; cls++) {
+    for (int src{0}; src < num_pes; src++) {
+      for (int dst{0}; dst < num_pes; dst++) {
+        size_t idx{src * row_size + (cls * num_pes + dst) * CELL_WIDTH};
+        if (!matrix[idx]) {
+          continue;
+        }
+        out << traffic_class_name(static_cast<TrafficClass>(cls)) << ","
+            << src << "," << dst << "," << matrix[idx] << ","
+            << matrix[idx + 1] << "\n";
+      }
+    }
+  }
+}
+
+}  // namespace rocshmem
@@ -0,0 +1,169 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef LIBRARY_SRC_TRAFFIC_MATRIX_HPP_
+#define LIBRARY_SRC_TRAFFIC_MATRIX_HPP_
+
+/**
+ * @file traffic_matrix.hpp
+ * Per destination traffic counters
+ *
+ * When ROCSHMEM_TRAFFIC_MATRIX is set, every PE counts the operations and
+ * bytes it sends to each other PE, split by operation class. Gathering the
+ * rows of all PEs gives the N x N matrix used to choose rank placement and
+ * team layout.
+ *
+ * The PE issuing an operation owns the count, so for gets the bytes flow
+ * the other way. Collectives are counted as the payload each PE logically
+ * contributes to each peer, whatever algorithm MPI picks to move it.
+ */
+
+#include <mpi.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace rocshmem {
+
+enum class TrafficClass : int {
+  PUT = 0,
+  GET,
+  AMO,
+  COLL,
+  NUM_CLASSES,
+};
+
+/**
+ * @brief Name of cls in dumps
+ */
+const char *traffic_class_name(TrafficClass cls);
+
+/**
+ * @class TrafficMatrix traffic_matrix.hpp
+ *
+ * @brief This PE's row of the traffic matrix
+ *
+ * Records come from the RO proxy thread and from any host thread, so the
+ * counters are atomics. Recording is a no-op until enable is called.
+ */
+class TrafficMatrix {
+ public:
+  /**
+   * @brief The matrix of this process
+   */
+  static TrafficMatrix &GetInstance();
+
+  ~TrafficMatrix();
+
+  /**
+   * @brief Start recording with PE numbers taken from world
+   */
+  void enable(MPI_Comm world);
+
+  bool enabled() const { return enabled_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Count one operation of cls moving bytes to pe
+   */
+  void record(TrafficClass cls, int pe, uint64_t bytes) {
+    if (!enabled()) {
+      return;
+    }
+    size_t idx{index(cls, pe)};
+    counters_[idx].fetch_add(1, std::memory_order_relaxed);
+    counters_[idx + 1].fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Count a collective sending bytes to every other PE of team
+   */
+  void record_team(TrafficClass cls, MPI_Comm team, uint64_t bytes);
+
+  /**
+   * @brief Count a collective sending counts[i] * elem_size bytes to team
+   * rank i
+   */
+  void record_team(TrafficClass cls, MPI_Comm team, const int *counts,
+                   size_t elem_size);
+
+  uint64_t ops(TrafficClass cls, int pe) const;
+
+  uint64_t bytes(TrafficClass cls, int pe) const;
+
+  void reset();
+
+  /**
+   * @brief Gather every row on PE 0 and write the matrix to path
+   *
+   * Collective over the world communicator given to enable.
+   *
+   * @return false if recording is off or PE 0 could not write path
+   */
+  bool dump(const char *path);
+
+  /**
+   * @brief Write the nonzero cells of matrix as CSV
+   *
+   * @param[in] matrix num_pes rows laid out as row() returns them
+   */
+  static void write_csv(std::ostream &out, const std::vector<uint64_t> &matrix,
+                        int num_pes);
+
+  /**
+   * @brief Snapshot of this PE's counters
+   *
+   * Ordered by class, then destination PE, then ops before bytes.
+   */
+  std::vector<uint64_t> row() const;
+
+ private:
+  size_t index(TrafficClass cls, int pe) const {
+    return (static_cast<size_t>(cls) * num_pes_ + pe) * CELL_WIDTH;
+  }
+
+  // Each cell holds an operation count and a byte count.
+  static constexpr size_t CELL_WIDTH{2};
+
+  /**
+   * @brief World PE of every rank of team
+   */
+  std::vector<int> world_pes(MPI_Comm team) const;
+
+  std::atomic<bool> enabled_{false};
+
+  int my_pe_{0};
+
+  int num_pes_{0};
+
+  MPI_Comm world_{MPI_COMM_NULL};
+
+  MPI_Group world_group_{MPI_GROUP_NULL};
+
+  std::unique_ptr<std::atomic<uint64_t>[]> counters_{};
+};
+
+}  // namespace rocshmem
+
+#endif  // LIBRARY_SRC_TRAFFIC_MATRIX_HPP_
@@ -0,0 +1,151 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "alltoallv_tester.hpp"
+
+#include <rocshmem/rocshmem.hpp>
+
+using namespace rocshmem;
+
+rocshmem_team_t team_alltoallv_world_dup;
+
+/******************************************************************************
+ * DEVICE TEST KERNEL
+ *****************************************************************************/
+__global__ void AlltoallvTest(int loop, int skip, uint64_t *timer,
+                              int64_t *source_buf, int64_t *dest_buf,
+                              int *source_counts, int *source_displs,
+                              int *dest_counts, int *dest_displs,
+                              ShmemContextType ctx_type,
+                              rocshmem_team_t team) {
+  __shared__ rocshmem_ctx_t ctx;
+
+  rocshmem_wg_init();
+  rocshmem_wg_ctx_create(ctx_type, &ctx);
+
+  __syncthreads();
+
+  uint64_t start;
+  for (int i = 0; i < loop + skip; i++) {
+    if (i == skip && hipThreadIdx_x == 0) {
+      start = rocshmem_timer();
+    }
+    rocshmem_ctx_long_wg_alltoallv(ctx, team, dest_buf, source_buf,
+                                   source_counts, source_displs, dest_counts,
+                                   dest_displs);
+  }
+
+  __syncthreads();
+
+  if (hipThreadIdx_x == 0) {
+    timer[hipBlockIdx_x] = rocshmem_timer() - start;
+  }
+
+  rocshmem_wg_ctx_destroy(&ctx);
+  rocshmem_wg_finalize();
+}
+
+/******************************************************************************
+ * HOST TESTER CLASS METHODS
+ *****************************************************************************/
+AlltoallvTester::AlltoallvTester(TesterArguments args) : Tester(args) {
+  int n_pes = rocshmem_team_n_pes(ROCSHMEM_TEAM_WORLD);
+  // No block is larger than twice the message size.
+  size_t buf_size = 2 * args.max_msg_size * sizeof(int64_t) * n_pes;
+  source_buf = (int64_t *)rocshmem_malloc(buf_size);
+  dest_buf = (int64_t *)rocshmem_malloc(buf_size);
+  source_counts = (int *)rocshmem_malloc(4 * sizeof(int) * n_pes);
+  source_displs = source_counts + n_pes;
+  dest_counts = source_counts + 2 * n_pes;
+  dest_displs = source_counts + 3 * n_pes;
+}
+
+AlltoallvTester::~AlltoallvTester() {
+  rocshmem_free(source_counts);
+  rocshmem_free(source_buf);
+  rocshmem_free(dest_buf);
+}
+
+void AlltoallvTester::preLaunchKernel() {
+  int n_pes = rocshmem_team_n_pes(ROCSHMEM_TEAM_WORLD);
+  bw_factor = sizeof(int64_t) * n_pes;
+
+  team_alltoallv_world_dup = ROCSHMEM_TEAM_INVALID;
+  rocshmem_team_split_strided(ROCSHMEM_TEAM_WORLD, 0, 1, n_pes, nullptr, 0,
+                               &team_alltoallv_world_dup);
+}
+
+void AlltoallvTester::launchKernel(dim3 gridSize, dim3 blockSize, int loop,
+                                   uint64_t size) {
+  size_t shared_bytes = 0;
+
+  hipLaunchKernelGGL(AlltoallvTest, gridSize, blockSize, shared_bytes,
+                     stream, loop, args.skip, timer, source_buf, dest_buf,
+                     source_counts, source_displs, dest_counts, dest_displs,
+                     _shmem_context, team_alltoallv_world_dup);
+
+  num_msgs = loop + args.skip;
+  num_timed_msgs = loop;
+}
+
+void AlltoallvTester::postLaunchKernel() {
+  rocshmem_team_destroy(team_alltoallv_world_dup);
+}
+
+void AlltoallvTester::resetBuffers(uint64_t size) {
+  int rank = rocshmem_my_pe();
+  int n_pes = rocshmem_team_n_pes(ROCSHMEM_TEAM_WORLD);
+  int sent = 0;
+  int received = 0;
+  for (int i = 0; i < n_pes; i++) {
+    source_counts[i] = block_size(rank, i, size);
+    source_displs[i] = sent;
+    dest_counts[i] = block_size(i, rank, size);
+    dest_displs[i] = received;
+    for (int j = 0; j < source_counts[i]; j++) {
+      // Make value for each src, dst pair unique
+      source_buf[sent + j] = ((int64_t)rank << 16) + i;
+    }
+    for (int j = 0; j < dest_counts[i]; j++) {
+      dest_buf[received + j] = -1;
+    }
+    sent += source_counts[i];
+    received += dest_counts[i];
+  }
+}
+
+void AlltoallvTester::verifyResults(uint64_t size) {
+  int rank = rocshmem_my_pe();
+  int n_pes = rocshmem_team_n_pes(ROCSHMEM_TEAM_WORLD);
+  for (int i = 0; i < n_pes; i++) {
+    int64_t expected_val = ((int64_t)i << 16) + rank;
+    for (int j = 0; j < dest_counts[i]; j++) {
+      int64_t v = dest_buf[dest_displs[i] + j];
+      if (v != expected_val) {
+        fprintf(stderr, "Data validation error at idx %d\n", j);
+        fprintf(stderr, "Rank %d, Got %ld, Expect %ld.\n", rank, v,
+                expected_val);
+        exit(-1);
+      }
+    }
+  }
+}
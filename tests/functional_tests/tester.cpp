@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "alltoall_tester.hpp"
+#include "alltoallv_tester.hpp"
 #include "amo_bitwise_tester.hpp"
 #include "amo_extended_tester.hpp"
 #include "amo_standard_tester.hpp"
@@ -218,6 +219,12 @@ std::vector<Tester*> Tester::create(TesterArguments args) {
                                         std::to_string(expected_val));
           }));
       return testers;
+    case AllToAllsTestType:
+      if (rank == 0) {
+        std::cout << "Alltoallv Test ###" << std::endl;
+      }
+      testers.push_back(new AlltoallvTester(args));
+      return testers;
     case FCollectTestType:
       if (rank == 0) {
         std::cout << "Fcollect Test ###" << std::endl;
@@ -576,7 +583,8 @@ bool Tester::peLaunchesKernel() {
    */
   is_launcher = is_launcher || (_type == TeamReductionTestType) ||
                 (_type == TeamBroadcastTestType) || (_type == TeamCtxInfraTestType) ||
-                (_type == AllToAllTestType) || (_type == FCollectTestType) ||
+                (_type == AllToAllTestType) || (_type == AllToAllsTestType) ||
+                (_type == FCollectTestType) ||
                 (_type == PingPongTestType) || (_type == BarrierAllTestType) ||
                 (_type == SyncTestType) || (_type == SyncAllTestType) ||
                 (_type == RandomAccessTestType) || (_type == PingAllTestType);
@@ -138,6 +138,7 @@ void TesterArguments::get_rocshmem_arguments() {
   TestType type = (TestType)algorithm;
   if ((type != BarrierAllTestType) && (type != SyncAllTestType) &&
       (type != SyncTestType) && (type != AllToAllTestType) &&
+      (type != AllToAllsTestType) &&
       (type != FCollectTestType) && (type != TeamReductionTestType) &&
       (type != TeamBroadcastTestType) && (type != PingAllTestType)) {
     if (numprocs != 2) {
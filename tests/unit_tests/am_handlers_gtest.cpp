@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "am_handlers_gtest.hpp"
+
+using namespace rocshmem;
+
+TEST_F(AmHandlersTestFixture, register_rejects_bad_handlers) {
+    ASSERT_FALSE(handlers_.register_handler(-1, hash_insert, nullptr));
+    ASSERT_FALSE(handlers_.register_handler(AmHandlers::MAX_HANDLERS,
+                                            hash_insert, nullptr));
+    ASSERT_FALSE(handlers_.register_handler(0, nullptr, nullptr));
+    ASSERT_TRUE(handlers_.register_handler(AmHandlers::MAX_HANDLERS - 1,
+                                           hash_insert, nullptr));
+}
+
+TEST_F(AmHandlersTestFixture, execute_without_handler_fails) {
+    uint64_t reply {42};
+    ASSERT_FALSE(handlers_.execute(request(HASH_INSERT, table_offset_, 1),
+                                   heap_.data(), 0, &reply));
+    ASSERT_FALSE(handlers_.execute(request(-1, table_offset_, 1),
+                                   heap_.data(), 0, &reply));
+    ASSERT_EQ(reply, 42);
+}
+
+TEST_F(AmHandlersTestFixture, hash_insert_runs_on_heap_object) {
+    ASSERT_TRUE(handlers_.register_handler(HASH_INSERT, hash_insert,
+                                           nullptr));
+
+    ASSERT_EQ(run(request(HASH_INSERT, table_offset_, 3, 30)), 3);
+    ASSERT_EQ(run(request(HASH_INSERT, table_offset_, 11, 110)), 4);
+    ASSERT_EQ(run(request(HASH_INSERT, table_offset_, 3, 31)), 3);
+
+    auto *table {reinterpret_cast<AmHashTable *>(&heap_[table_offset_])};
+    ASSERT_EQ(table->keys[3], 3);
+    ASSERT_EQ(table->values[3], 31);
+    ASSERT_EQ(table->keys[4], 11);
+    ASSERT_EQ(table->values[4], 110);
+
+    for (uint64_t key {100}; key < 100 + AmHashTable::SLOTS - 2; key++) {
+        ASSERT_NE(run(request(HASH_INSERT, table_offset_, key, key)), FULL);
+    }
+    ASSERT_EQ(run(request(HASH_INSERT, table_offset_, 7, 7)), FULL);
+}
+
+TEST_F(AmHandlersTestFixture, queue_append_passes_source_and_user_arg) {
+    ASSERT_TRUE(handlers_.register_handler(QUEUE_APPEND, queue_append,
+                                           &appends_));
+
+    for (int pe {0}; pe < 6; pe++) {
+        ASSERT_EQ(run(request(QUEUE_APPEND, queue_offset_, 10 + pe), pe),
+                  pe);
+    }
+    ASSERT_EQ(appends_, 6);
+
+    auto *queue {reinterpret_cast<AmQueue *>(&heap_[queue_offset_])};
+    ASSERT_EQ(queue->tail, 6);
+    for (uint64_t i {0}; i < AmQueue::CAPACITY; i++) {
+        ASSERT_EQ(queue->items[i], 10 + i);
+        ASSERT_EQ(queue->sources[i], i);
+    }
+}
+
+TEST_F(AmHandlersTestFixture, register_replaces_handler) {
+    ASSERT_TRUE(handlers_.register_handler(HASH_INSERT, hash_insert,
+                                           nullptr));
+    ASSERT_TRUE(handlers_.register_handler(HASH_INSERT, queue_append,
+                                           &appends_));
+
+    ASSERT_EQ(run(request(HASH_INSERT, queue_offset_, 9)), 0);
+    ASSERT_EQ(appends_, 1);
+    auto *table {reinterpret_cast<AmHashTable *>(&heap_[table_offset_])};
+    ASSERT_EQ(table->keys[0], 0);
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef ROCSHMEM_AM_HANDLERS_GTEST_HPP
+#define ROCSHMEM_AM_HANDLERS_GTEST_HPP
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "../src/am_handlers.hpp"
+
+namespace rocshmem {
+
+/**
+ * @brief Open addressing table of nonzero keys as laid out on the heap.
+ */
+struct AmHashTable {
+    static constexpr uint64_t SLOTS {8};
+
+    uint64_t keys[SLOTS];
+
+    uint64_t values[SLOTS];
+};
+
+/**
+ * @brief Bounded queue whose tail counts every append.
+ */
+struct AmQueue {
+    static constexpr uint64_t CAPACITY {4};
+
+    uint64_t tail;
+
+    uint64_t items[CAPACITY];
+
+    int sources[CAPACITY];
+};
+
+class AmHandlersTestFixture : public ::testing::Test
+{
+  protected:
+    static constexpr uint64_t FULL {~uint64_t {0}};
+
+    static constexpr int HASH_INSERT {3};
+
+    static constexpr int QUEUE_APPEND {5};
+
+    /**
+     * @brief Stores args[1] under key args[0] and returns its slot.
+     */
+    static uint64_t hash_insert(void *dest, const uint64_t *args,
+                                [[maybe_unused]] int source_pe,
+                                [[maybe_unused]] void *user_arg) {
+        auto *table {static_cast<AmHashTable *>(dest)};
+        for (uint64_t i {0}; i < AmHashTable::SLOTS; i++) {
+            uint64_t slot {(args[0] + i) % AmHashTable::SLOTS};
+            if (table->keys[slot] == 0 || table->keys[slot] == args[0]) {
+                table->keys[slot] = args[0];
+                table->values[slot] = args[1];
+                return slot;
+            }
+        }
+        return FULL;
+    }
+
+    /**
+     * @brief Appends args[0] and returns the previous tail. Counts its
+     * calls in the int user_arg points to.
+     */
+    static uint64_t queue_append(void *dest, const uint64_t *args,
+                                 int source_pe, void *user_arg) {
+        auto *queue {static_cast<AmQueue *>(dest)};
+        ++*static_cast<int *>(user_arg);
+        uint64_t tail {queue->tail++};
+        if (tail < AmQueue::CAPACITY) {
+            queue->items[tail] = args[0];
+            queue->sources[tail] = source_pe;
+        }
+        return tail;
+    }
+
+    /**
+     * @brief Message for handler_id on the object at offset of heap_.
+     */
+    AmRequest request(int handler_id, uint64_t offset, uint64_t arg0,
+                      uint64_t arg1 = 0) {
+        return {handler_id, 0, offset, {arg0, arg1}, 1};
+    }
+
+    uint64_t run(const AmRequest &am, int source_pe = 1) {
+        uint64_t reply {0};
+        EXPECT_TRUE(handlers_.execute(am, heap_.data(), source_pe, &reply));
+        return reply;
+    }
+
+    AmHandlers handlers_ {};
+
+    std::vector<char> heap_ = std::vector<char>(4096);
+
+    const uint64_t table_offset_ {64};
+
+    const uint64_t queue_offset_ {1024};
+
+    int appends_ {0};
+};
+
+} // namespace rocshmem
+
+#endif // ROCSHMEM_AM_HANDLERS_GTEST_HPP
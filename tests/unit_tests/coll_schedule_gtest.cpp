@@ -0,0 +1,94 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "coll_schedule_gtest.hpp"
+
+using namespace rocshmem;
+
+TEST_F(CollScheduleTestFixture, ring_allreduce) {
+  for (int num_pes : {1, 2, 3, 4, 7, 8}) {
+    check_allreduce(num_pes, [num_pes](int pe) {
+      return compile_ring_allreduce(pe, num_pes);
+    });
+    ASSERT_EQ(scheds_[0].steps.size(), 2 * num_pes - 2);
+  }
+}
+
+TEST_F(CollScheduleTestFixture, recursive_doubling_allreduce) {
+  for (int num_pes : {1, 2, 4, 8, 16}) {
+    check_allreduce(num_pes, [num_pes](int pe) {
+      return compile_recursive_doubling_allreduce(pe, num_pes);
+    });
+  }
+  ASSERT_EQ(scheds_[0].steps.size(), 4);
+}
+
+TEST_F(CollScheduleTestFixture, hierarchical_allreduce) {
+  std::vector<std::pair<int, int>> shapes {
+      {4, 2}, {6, 2}, {6, 3}, {8, 4}, {12, 4}, {5, 5}, {5, 1}};
+  for (auto [num_pes, group_size] : shapes) {
+    check_allreduce(num_pes, [num_pes = num_pes, group_size = group_size](
+                                 int pe) {
+      return compile_hierarchical_allreduce(pe, num_pes, group_size);
+    });
+  }
+}
+
+TEST_F(CollScheduleTestFixture, ring_allgather) {
+  for (int num_pes : {1, 2, 3, 5, 8}) {
+    check_allgather(num_pes, [num_pes](int pe) {
+      return compile_ring_allgather(pe, num_pes);
+    });
+  }
+}
+
+TEST_F(CollScheduleTestFixture, recursive_doubling_allgather) {
+  for (int num_pes : {1, 2, 4, 8, 16}) {
+    check_allgather(num_pes, [num_pes](int pe) {
+      return compile_recursive_doubling_allgather(pe, num_pes);
+    });
+  }
+}
+
+TEST_F(CollScheduleTestFixture, bruck_allgather) {
+  for (int num_pes {1}; num_pes <= 13; num_pes++) {
+    check_allgather(num_pes, [num_pes](int pe) {
+      return compile_bruck_allgather(pe, num_pes);
+    });
+  }
+  ASSERT_EQ(scheds_[0].steps.size(), 4);
+}
+
+TEST_F(CollScheduleTestFixture, default_selection) {
+  ASSERT_EQ(compile_allreduce(0, 6).algorithm, CollAlgorithm::RING);
+  ASSERT_EQ(compile_allgather(0, 8).algorithm,
+            CollAlgorithm::RECURSIVE_DOUBLING);
+  ASSERT_EQ(compile_allgather(0, 6).algorithm, CollAlgorithm::BRUCK);
+}
+
+TEST_F(CollScheduleTestFixture, to_world) {
+  auto sched {compile_ring_allreduce(1, 4)};
+  sched.to_world(2, 3);
+  ASSERT_EQ(sched.steps[0].send_peer, 2 + 2 * 3);
+  ASSERT_EQ(sched.steps[0].recv_peer, 2 + 0 * 3);
+  ASSERT_EQ(sched.num_sync_slots(), 6);
+}
@@ -0,0 +1,198 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef ROCSHMEM_COLL_SCHEDULE_GTEST_HPP
+#define ROCSHMEM_COLL_SCHEDULE_GTEST_HPP
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "../src/coll_schedule.hpp"
+
+namespace rocshmem {
+
+class CollScheduleTestFixture : public ::testing::Test
+{
+  protected:
+    using Buffer = std::vector<int64_t>;
+
+    using Compiler = std::function<HostCollSchedule(int my_pe)>;
+
+    /**
+     * @brief Elements per block; more than one catches offset mistakes.
+     */
+    static constexpr int BLOCK_ELEMS {3};
+
+    static int64_t
+    value(int pe, int elem) {
+        return pe * 1000 + elem;
+    }
+
+    void
+    compile(int num_pes, Compiler compiler) {
+        scheds_.clear();
+        for (int pe {0}; pe < num_pes; pe++) {
+            scheds_.push_back(compiler(pe));
+        }
+    }
+
+    /**
+     * @brief Check that every send is matched by the receiver's step.
+     */
+    void
+    validate() {
+        int num_pes = scheds_.size();
+        size_t num_steps {scheds_[0].steps.size()};
+        for (const auto& sched : scheds_) {
+            ASSERT_EQ(sched.steps.size(), num_steps);
+            ASSERT_EQ(sched.num_blocks, scheds_[0].num_blocks);
+        }
+        for (size_t i {0}; i < num_steps; i++) {
+            for (int pe {0}; pe < num_pes; pe++) {
+                const auto& out {scheds_[pe].steps[i]};
+                ASSERT_GE(out.send_peer, 0);
+                ASSERT_LT(out.send_peer, num_pes);
+                ASSERT_NE(out.send_peer, pe);
+                const auto& in {scheds_[out.send_peer].steps[i]};
+                ASSERT_EQ(in.recv_peer, pe);
+                ASSERT_EQ(in.nblocks, out.nblocks);
+                ASSERT_EQ(in.sync_slot, out.sync_slot);
+                ASSERT_EQ(in.op, out.op);
+                ASSERT_EQ(in.recv_block, out.send_block);
+                if (out.op == CollStepOp::REDUCE) {
+                    ASSERT_EQ(in.recv_stage, out.send_stage);
+                    ASSERT_LE(out.send_stage + out.nblocks,
+                              scheds_[pe].num_stage_blocks);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Run all PEs' schedules in lockstep, as the sync slots force
+     * the device to do.
+     */
+    void
+    simulate() {
+        int num_pes = scheds_.size();
+        int num_blocks {scheds_[0].num_blocks};
+        std::vector<Buffer> stage(num_pes);
+        for (int pe {0}; pe < num_pes; pe++) {
+            stage[pe].assign(scheds_[pe].num_stage_blocks * BLOCK_ELEMS, -1);
+        }
+
+        for (size_t i {0}; i < scheds_[0].steps.size(); i++) {
+            std::vector<Buffer> snapshot {dst_};
+            for (int pe {0}; pe < num_pes; pe++) {
+                const auto& step {scheds_[pe].steps[i]};
+                for (int b {0}; b < step.nblocks; b++) {
+                    int block {(step.send_block + b) % num_blocks};
+                    for (int e {0}; e < BLOCK_ELEMS; e++) {
+                        int64_t v {snapshot[pe][block * BLOCK_ELEMS + e]};
+                        if (step.op == CollStepOp::COPY) {
+                            dst_[step.send_peer][block * BLOCK_ELEMS + e] = v;
+                        } else {
+                            int slot {step.send_stage + b};
+                            stage[step.send_peer][slot * BLOCK_ELEMS + e] = v;
+                        }
+                    }
+                }
+            }
+            for (int pe {0}; pe < num_pes; pe++) {
+                const auto& step {scheds_[pe].steps[i]};
+                if (step.op != CollStepOp::REDUCE) {
+                    continue;
+                }
+                for (int b {0}; b < step.nblocks; b++) {
+                    int block {(step.recv_block + b) % num_blocks};
+                    int slot {step.recv_stage + b};
+                    for (int e {0}; e < BLOCK_ELEMS; e++) {
+                        dst_[pe][block * BLOCK_ELEMS + e] +=
+                            stage[pe][slot * BLOCK_ELEMS + e];
+                    }
+                }
+            }
+        }
+    }
+
+    void
+    check_allreduce(int num_pes, Compiler compiler) {
+        compile(num_pes, compiler);
+        validate();
+        int nelems {scheds_[0].num_blocks * BLOCK_ELEMS};
+        dst_.assign(num_pes, Buffer(nelems));
+        for (int pe {0}; pe < num_pes; pe++) {
+            for (int e {0}; e < nelems; e++) {
+                dst_[pe][e] = value(pe, e);
+            }
+        }
+        simulate();
+        for (int pe {0}; pe < num_pes; pe++) {
+            for (int e {0}; e < nelems; e++) {
+                int64_t expected {0};
+                for (int src {0}; src < num_pes; src++) {
+                    expected += value(src, e);
+                }
+                ASSERT_EQ(dst_[pe][e], expected) << "pe " << pe << " elem " << e;
+            }
+        }
+    }
+
+    void
+    check_allgather(int num_pes, Compiler compiler) {
+        compile(num_pes, compiler);
+        validate();
+        ASSERT_EQ(scheds_[0].num_blocks, num_pes);
+        dst_.assign(num_pes, Buffer(num_pes * BLOCK_ELEMS, -1));
+        for (int pe {0}; pe < num_pes; pe++) {
+            for (int e {0}; e < BLOCK_ELEMS; e++) {
+                dst_[pe][pe * BLOCK_ELEMS + e] = value(pe, e);
+            }
+        }
+        simulate();
+        for (int pe {0}; pe < num_pes; pe++) {
+            for (int b {0}; b < num_pes; b++) {
+                for (int e {0}; e < BLOCK_ELEMS; e++) {
+                    ASSERT_EQ(dst_[pe][b * BLOCK_ELEMS + e], value(b, e))
+                        << "pe " << pe << " block " << b;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief One compiled schedule per PE in the simulated team.
+     */
+    std::vector<HostCollSchedule> scheds_ {};
+
+    /**
+     * @brief Destination buffer of each simulated PE.
+     */
+    std::vector<Buffer> dst_ {};
+};
+
+} // namespace rocshmem
+
+#endif // ROCSHMEM_COLL_SCHEDULE_GTEST_HPP
@@ -0,0 +1,195 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "command_trace_gtest.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace rocshmem;
+
+TEST_F(CommandTraceTestFixture, trace_round_trip) {
+    put(0, 1, 64);
+    command(0, RO_NET_QUIET);
+
+    std::string path {testing::TempDir() + "command_trace_gtest.trace"};
+    TraceWriter writer {};
+    ASSERT_TRUE(writer.open(path));
+    for (const auto &record : records_) {
+        writer.record(record);
+    }
+    writer.close();
+
+    std::vector<TraceRecord> read {};
+    ASSERT_TRUE(read_trace(path, &read));
+    remove(path.c_str());
+
+    ASSERT_EQ(read.size(), records_.size());
+    ASSERT_EQ(read[0].dst, records_[0].dst);
+    ASSERT_EQ(read[0].size, 64);
+    ASSERT_EQ(read[1].type, RO_NET_QUIET);
+}
+
+TEST_F(CommandTraceTestFixture, analyze_counts_adjacency_per_window) {
+    put(0, 1, 64);
+    put(0, 1, 64);
+    put(1, 1, 64);
+    put(1, 2, 64, false);
+    put(0, 1, 64);
+    put(0, 1, 64);
+
+    auto windows {analyze_trace(records_, 4)};
+    ASSERT_EQ(windows.size(), 2);
+
+    ASSERT_EQ(windows[0].commands, 4);
+    ASSERT_EQ(windows[0].puts, 4);
+    ASSERT_EQ(windows[0].bytes, 256);
+    ASSERT_EQ(windows[0].same_dest, 2);
+    ASSERT_EQ(windows[0].adjacent, 1);
+    ASSERT_EQ(windows[0].adjacent_same_block, 1);
+
+    // The first put of a window has nothing to be compared with.
+    ASSERT_EQ(windows[1].adjacent, 1);
+}
+
+TEST_F(CommandTraceTestFixture, parse_policy) {
+    CoalescePolicy policy {};
+    ASSERT_TRUE(parse_coalesce_policy("16,65536,20", &policy));
+    ASSERT_EQ(policy.window, 16);
+    ASSERT_EQ(policy.max_bytes, 65536);
+    ASSERT_EQ(policy.timeout_ns, 20000);
+    ASSERT_EQ(to_string(policy), "16,65536,20");
+
+    ASSERT_FALSE(parse_coalesce_policy("16,65536", &policy));
+    ASSERT_FALSE(parse_coalesce_policy("16,65536,20x", &policy));
+}
+
+TEST_F(CommandTraceTestFixture, coalescer_merges_contiguous_puts) {
+    std::vector<CoalescedPut> out {};
+    PutCoalescer coalescer {{4, 1 << 20, 0},
+        [&](const CoalescedPut &run, FlushReason) { out.push_back(run); }};
+
+    for (int i {0}; i < 6; i++) {
+        put(0, 1, 64);
+        coalescer.add(records_.back());
+    }
+    ASSERT_EQ(out.size(), 1);
+    ASSERT_EQ(out[0].puts, 4);
+    ASSERT_EQ(out[0].size, 256);
+    ASSERT_EQ(out[0].dst, records_[0].dst);
+    ASSERT_EQ(coalescer.pending(), 1);
+
+    coalescer.flush(0, FlushReason::SYNC);
+    ASSERT_EQ(out.size(), 2);
+    ASSERT_EQ(out[1].puts, 2);
+    ASSERT_EQ(out[1].dst, records_[4].dst);
+    ASSERT_EQ(coalescer.pending(), 0);
+}
+
+TEST_F(CommandTraceTestFixture, coalescer_breaks_on_gap_and_pe) {
+    std::vector<CoalescedPut> out {};
+    PutCoalescer coalescer {{16, 1 << 20, 0},
+        [&](const CoalescedPut &run, FlushReason) { out.push_back(run); }};
+
+    put(0, 1, 64);
+    coalescer.add(records_.back());
+    put(0, 1, 64, false);
+    coalescer.add(records_.back());
+    put(0, 2, 64);
+    coalescer.add(records_.back());
+
+    ASSERT_EQ(out.size(), 2);
+    ASSERT_EQ(out[0].puts, 1);
+    ASSERT_EQ(out[1].puts, 1);
+}
+
+TEST_F(CommandTraceTestFixture, coalescer_respects_max_bytes) {
+    std::vector<CoalescedPut> out {};
+    PutCoalescer coalescer {{16, 128, 0},
+        [&](const CoalescedPut &run, FlushReason) { out.push_back(run); }};
+
+    for (int i {0}; i < 3; i++) {
+        put(0, 1, 96);
+        coalescer.add(records_.back());
+    }
+    ASSERT_EQ(out.size(), 2);
+    for (const auto &run : out) {
+        ASSERT_LE(run.size, 128);
+    }
+}
+
+TEST_F(CommandTraceTestFixture, coalescer_expires_old_runs) {
+    std::vector<FlushReason> reasons {};
+    PutCoalescer coalescer {{16, 1 << 20, 5000},
+        [&](const CoalescedPut &, FlushReason reason) {
+            reasons.push_back(reason);
+        }};
+
+    put(0, 1, 64);
+    coalescer.add(records_.back());
+    put(1, 1, 64);
+    coalescer.add(records_.back());
+
+    coalescer.expire(records_[0].time_ns + 4999);
+    ASSERT_TRUE(reasons.empty());
+
+    coalescer.expire(records_[0].time_ns + 5000);
+    ASSERT_EQ(reasons.size(), 1);
+    ASSERT_EQ(reasons[0], FlushReason::TIMEOUT);
+    ASSERT_EQ(coalescer.pending(), 1);
+}
+
+TEST_F(CommandTraceTestFixture, simulate_flushes_on_other_commands) {
+    for (int i {0}; i < 4; i++) {
+        put(0, 1, 64);
+        put(1, 1, 64);
+    }
+    command(0, RO_NET_QUIET);
+    put(1, 1, 64);
+    command(1, RO_NET_GET);
+    put(0, 1, 64);
+    put(1, 1, 64);
+    command(2, RO_NET_BARRIER_ALL);
+
+    auto stats {simulate_coalescing(records_, {16, 1 << 20, 0})};
+    ASSERT_EQ(stats.puts_in, 11);
+    ASSERT_EQ(stats.puts_out, 4);
+    ASSERT_EQ(stats.flushes[static_cast<int>(FlushReason::BREAK)], 1);
+    ASSERT_EQ(stats.flushes[static_cast<int>(FlushReason::SYNC)], 3);
+
+    // Blocking puts are never held back.
+    records_.clear();
+    put(0, 1, 64, true, RO_NET_PUT);
+    put(0, 1, 64, true, RO_NET_PUT);
+    stats = simulate_coalescing(records_, {16, 1 << 20, 0});
+    ASSERT_EQ(stats.puts_in, 0);
+    ASSERT_EQ(stats.puts_out, 0);
+}
+
+TEST_F(CommandTraceTestFixture, simulate_without_policy_keeps_puts) {
+    for (int i {0}; i < 8; i++) {
+        put(0, 1, 64);
+    }
+    auto stats {simulate_coalescing(records_, {})};
+    ASSERT_EQ(stats.puts_in, 8);
+    ASSERT_EQ(stats.puts_out, 8);
+}
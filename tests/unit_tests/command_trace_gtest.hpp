@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef ROCSHMEM_COMMAND_TRACE_GTEST_HPP
+#define ROCSHMEM_COMMAND_TRACE_GTEST_HPP
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "../src/command_trace.hpp"
+#include "../src/reverse_offload/commands_types.hpp"
+
+namespace rocshmem {
+
+class CommandTraceTestFixture : public ::testing::Test
+{
+  protected:
+    /**
+     * @brief Appends a put of size bytes continuing the previous put of
+     * block when contiguous is set.
+     */
+    void put(int block, int pe, uint64_t size, bool contiguous = true,
+             int32_t type = RO_NET_PUT_NBI) {
+        if (!contiguous) {
+            next_[block] += 1 << 20;
+        }
+        uint64_t offset {next_[block] + block * (uint64_t {1} << 32)};
+        records_.push_back({now_ns_, 0x10000000 + offset,
+                            0x80000000 + offset, size, type, block, pe, 0});
+        next_[block] += size;
+        now_ns_ += 1000;
+    }
+
+    void command(int block, int32_t type) {
+        records_.push_back({now_ns_, 0, 0, 0, type, block, 0, 0});
+        now_ns_ += 1000;
+    }
+
+    std::vector<TraceRecord> records_ {};
+
+    uint64_t next_[4] {};
+
+    uint64_t now_ns_ {0};
+};
+
+} // namespace rocshmem
+
+#endif // ROCSHMEM_COMMAND_TRACE_GTEST_HPP
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "dev_size_classes_gtest.hpp"
+
+#include <cstring>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace rocshmem;
+
+TEST_F(DevSizeClassesTestFixture, size_classes) {
+    ASSERT_EQ(strat_.allocate(0, 0), nullptr);
+
+    char *tiny {strat_.allocate(1, 0)};
+    char *small {strat_.allocate(100, 0)};
+    char *slab {strat_.allocate(STRAT_T::SLAB_SIZE, 0)};
+    char *large {strat_.allocate(STRAT_T::SLAB_SIZE + 1, 0)};
+
+    ASSERT_EQ(strat_.block_size(tiny), STRAT_T::MIN_BLOCK);
+    ASSERT_EQ(strat_.block_size(small), 128);
+    ASSERT_EQ(strat_.block_size(slab), STRAT_T::SLAB_SIZE);
+    ASSERT_EQ(strat_.block_size(large), 2 * STRAT_T::SLAB_SIZE);
+
+    for (char *ptr : {tiny, small, slab, large}) {
+        ASSERT_NE(ptr, nullptr);
+        uintptr_t address {reinterpret_cast<uintptr_t>(ptr)};
+        ASSERT_EQ(address % std::min(strat_.block_size(ptr),
+                                     STRAT_T::SLAB_SIZE), 0);
+        ASSERT_GE(ptr, heap_mem_.get_ptr());
+        ASSERT_LE(ptr + strat_.block_size(ptr),
+                  heap_mem_.get_ptr() + HEAP_SIZE);
+        strat_.release(ptr, 0);
+    }
+}
+
+TEST_F(DevSizeClassesTestFixture, free_then_reuse) {
+    char *first {strat_.allocate(256, 3)};
+    strat_.release(first, 3);
+    ASSERT_EQ(strat_.allocate(256, 3), first);
+}
+
+TEST_F(DevSizeClassesTestFixture, overallocate) {
+    ASSERT_EQ(strat_.allocate(HEAP_SIZE, 0), nullptr);
+    ASSERT_EQ(strat_.allocate(1UL << 31, 0), nullptr);
+    ASSERT_NE(strat_.allocate(64, 0), nullptr);
+}
+
+TEST_F(DevSizeClassesTestFixture, exhaust_and_recover) {
+    std::vector<char*> ptrs {};
+    while (char *ptr = strat_.allocate(4096, 0)) {
+        ptrs.push_back(ptr);
+    }
+    ASSERT_GT(ptrs.size(), (HEAP_SIZE / 4096) * 9 / 10);
+    size_t carved {strat_.carved()};
+
+    for (auto ptr : ptrs) {
+        strat_.release(ptr, 0);
+    }
+
+    /*
+     * Everything comes back without carving new slabs, through another
+     * cache: the first cache returned its excess to the shared pool.
+     */
+    size_t count {0};
+    while (char *ptr = strat_.allocate(4096, 1)) {
+        count++;
+        (void)ptr;
+        if (count > ptrs.size()) {
+            break;
+        }
+    }
+    ASSERT_GE(count + STRAT_T::CACHE_DEPTH, ptrs.size());
+    ASSERT_EQ(strat_.carved(), carved);
+}
+
+TEST_F(DevSizeClassesTestFixture, large_run_recycled) {
+    char *large {strat_.allocate(4 * STRAT_T::SLAB_SIZE, 0)};
+    ASSERT_NE(large, nullptr);
+    size_t carved {strat_.carved()};
+    strat_.release(large, 0);
+
+    std::set<char*> reused {};
+    for (int i {0}; i < 4; i++) {
+        reused.insert(strat_.allocate(STRAT_T::SLAB_SIZE, 0));
+    }
+    ASSERT_EQ(strat_.carved(), carved);
+    for (int i {0}; i < 4; i++) {
+        ASSERT_EQ(reused.count(large + i * STRAT_T::SLAB_SIZE), 1);
+    }
+}
+
+TEST_F(DevSizeClassesTestFixture, threads_share_heap) {
+    constexpr int NUM_THREADS {8};
+    constexpr int ITERATIONS {20000};
+
+    auto worker = [this](int id) {
+        std::mt19937 gen(id);
+        std::uniform_int_distribution<size_t> size_dist(1, 2048);
+        std::vector<std::pair<char*, size_t>> live {};
+
+        for (int i {0}; i < ITERATIONS; i++) {
+            /*
+             * Half the threads share cache 0 to exercise the contended
+             * path straight to the shared pool.
+             */
+            unsigned cache = id % 2 ? id : 0;
+            if (live.size() < 64 && (gen() % 3 || live.empty())) {
+                size_t size {size_dist(gen)};
+                char *ptr {strat_.allocate(size, cache)};
+                ASSERT_NE(ptr, nullptr);
+                memset(ptr, id + 1, size);
+                live.emplace_back(ptr, size);
+            } else {
+                size_t pick {gen() % live.size()};
+                auto [ptr, size] = live[pick];
+                for (size_t b {0}; b < size; b++) {
+                    ASSERT_EQ(ptr[b], static_cast<char>(id + 1));
+                }
+                strat_.release(ptr, cache);
+                live[pick] = live.back();
+                live.pop_back();
+            }
+        }
+        for (auto [ptr, size] : live) {
+            strat_.release(ptr, id);
+        }
+    };
+
+    std::vector<std::thread> threads {};
+    for (int id {0}; id < NUM_THREADS; id++) {
+        threads.emplace_back(worker, id);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+}
@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef ROCSHMEM_DEV_SIZE_CLASSES_GTEST_HPP
+#define ROCSHMEM_DEV_SIZE_CLASSES_GTEST_HPP
+
+#include "gtest/gtest.h"
+
+#include "../src/memory/dev_size_classes.hpp"
+#include "../src/memory/heap_memory.hpp"
+#include "../src/memory/hip_allocator.hpp"
+
+namespace rocshmem {
+
+class DevSizeClassesTestFixture : public ::testing::Test
+{
+  protected:
+    /**
+     * @brief Host memory, so the strategy runs without a GPU
+     */
+    using HEAP_T = HeapMemory<HostAllocator>;
+
+    /**
+     * @brief Allocation strategy under test
+     */
+    using STRAT_T = DevSizeClasses<HEAP_T>;
+
+    static constexpr size_t HEAP_SIZE {16 << 20};
+
+    /**
+     * @brief Heap memory object
+     */
+    HEAP_T heap_mem_ {HEAP_SIZE};
+
+    /**
+     * @brief Allocation strategy object
+     */
+    STRAT_T strat_ {&heap_mem_};
+};
+
+} // namespace rocshmem
+
+#endif // ROCSHMEM_DEV_SIZE_CLASSES_GTEST_HPP
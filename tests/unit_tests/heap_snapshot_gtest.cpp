@@ -0,0 +1,100 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "heap_snapshot_gtest.hpp"
+
+using namespace rocshmem;
+
+TEST_F(HeapSnapshotTestFixture, round_trip) {
+    char *small {nullptr};
+    char *large {nullptr};
+    char *freed {nullptr};
+    source_.malloc(reinterpret_cast<void**>(&small), 1000);
+    source_.malloc(reinterpret_cast<void**>(&freed), 4096);
+    source_.malloc(reinterpret_cast<void**>(&large), 20 << 20);
+    source_.free(freed);
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(large, nullptr);
+
+    for (size_t i {0}; i < 1000; i++) {
+        small[i] = static_cast<char>(i * 7);
+    }
+    for (size_t i {0}; i < (20 << 20); i += 4093) {
+        large[i] = static_cast<char>(i >> 12);
+    }
+
+    HeapSnapshot writer {0, 1};
+    auto file {HeapSnapshot::file_name(path_.c_str(), 0)};
+    ASSERT_EQ(writer.write(file, images(&source_)), 0);
+
+    HeapImage image {};
+    image.base = target_.get_base_ptr();
+    image.size = target_.get_size();
+    image.on_host = true;
+    std::vector<HeapImage> restored {image};
+
+    HeapSnapshot reader {0, 1};
+    ASSERT_EQ(reader.read(file, &restored), 0);
+    target_.get_strat()->restore(restored[0].free_records,
+                                 restored[0].proffered);
+
+    ASSERT_EQ(target_.get_used(), source_.get_used());
+
+    char *base {target_.get_base_ptr()};
+    char *small_copy {base + (small - source_.get_base_ptr())};
+    char *large_copy {base + (large - source_.get_base_ptr())};
+    for (size_t i {0}; i < 1000; i++) {
+        ASSERT_EQ(small_copy[i], static_cast<char>(i * 7));
+    }
+    for (size_t i {0}; i < (20 << 20); i += 4093) {
+        ASSERT_EQ(large_copy[i], static_cast<char>(i >> 12));
+    }
+
+    // The restored allocator hands out the same offsets as the original.
+    char *next {nullptr};
+    char *next_copy {nullptr};
+    source_.malloc(reinterpret_cast<void**>(&next), 4096);
+    target_.malloc(reinterpret_cast<void**>(&next_copy), 4096);
+    ASSERT_EQ(next - source_.get_base_ptr(), next_copy - base);
+
+    // Restored allocations can be freed.
+    target_.free(small_copy);
+    target_.free(large_copy);
+    target_.free(next_copy);
+    ASSERT_EQ(target_.get_used(), 0);
+}
+
+TEST_F(HeapSnapshotTestFixture, rejects_other_pe) {
+    HeapSnapshot writer {0, 2};
+    auto file {HeapSnapshot::file_name(path_.c_str(), 0)};
+    ASSERT_EQ(writer.write(file, images(&source_)), 0);
+
+    auto restored {images(&target_)};
+    HeapSnapshot other_job {0, 4};
+    ASSERT_EQ(other_job.read(file, &restored), -1);
+}
+
+TEST_F(HeapSnapshotTestFixture, rejects_missing_file) {
+    auto restored {images(&target_)};
+    HeapSnapshot reader {0, 1};
+    ASSERT_EQ(reader.read(path_ + ".missing", &restored), -1);
+}
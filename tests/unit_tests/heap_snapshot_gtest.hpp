@@ -0,0 +1,80 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef ROCSHMEM_HEAP_SNAPSHOT_GTEST_HPP
+#define ROCSHMEM_HEAP_SNAPSHOT_GTEST_HPP
+
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+
+#include "../src/memory/heap_snapshot.hpp"
+#include "../src/memory/hip_allocator.hpp"
+#include "../src/memory/kind_heap.hpp"
+
+namespace rocshmem {
+
+class HeapSnapshotTestFixture : public ::testing::Test
+{
+  protected:
+    /**
+     * @brief Large enough that a big allocation spans several chunks
+     */
+    static constexpr size_t HEAP_SIZE {1 << 26};
+
+    void TearDown() override {
+        std::remove(HeapSnapshot::file_name(path_.c_str(), 0).c_str());
+    }
+
+    /**
+     * @brief Snapshot view of a host heap including allocator state
+     */
+    std::vector<HeapImage> images(KindHeap *heap) {
+        HeapImage image {};
+        image.base = heap->get_base_ptr();
+        image.size = heap->get_size();
+        image.on_host = true;
+        image.free_records = heap->get_strat()->free_records();
+        image.proffered = heap->get_strat()->proffered_records();
+        return {image};
+    }
+
+    std::string path_ {"/tmp/rocshmem_heap_snapshot_gtest." +
+                       std::to_string(getpid())};
+
+    /**
+     * @brief Heap the snapshot is taken from
+     */
+    KindHeap source_ {MemoryKind::FINE_GRAINED, HostAllocator{}, HEAP_SIZE};
+
+    /**
+     * @brief Fresh heap the snapshot is restored into
+     */
+    KindHeap target_ {MemoryKind::FINE_GRAINED, HostAllocator{}, HEAP_SIZE};
+};
+
+} // namespace rocshmem
+
+#endif // ROCSHMEM_HEAP_SNAPSHOT_GTEST_HPP
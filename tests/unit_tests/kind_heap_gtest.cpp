@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "kind_heap_gtest.hpp"
+
+#include "rocshmem/rocshmem.hpp"
+
+using namespace rocshmem;
+
+TEST_F(KindHeapTestFixture, kind_and_size) {
+  ASSERT_EQ(kind_heap_.kind(), MemoryKind::FINE_GRAINED);
+  ASSERT_EQ(kind_heap_.get_size(), HEAP_SIZE);
+  ASSERT_NE(kind_heap_.get_base_ptr(), nullptr);
+  ASSERT_EQ(kind_heap_.get_used(), 0);
+}
+
+TEST_F(KindHeapTestFixture, malloc_free) {
+  void *ptr {nullptr};
+  kind_heap_.malloc(&ptr, 256);
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_TRUE(kind_heap_.contains(ptr));
+  ASSERT_GE(kind_heap_.get_used(), 256);
+
+  kind_heap_.free(ptr);
+  ASSERT_EQ(kind_heap_.get_used(), 0);
+}
+
+TEST_F(KindHeapTestFixture, contains_bounds) {
+  char *base {kind_heap_.get_base_ptr()};
+  ASSERT_TRUE(kind_heap_.contains(base));
+  ASSERT_TRUE(kind_heap_.contains(base + HEAP_SIZE - 1));
+  ASSERT_FALSE(kind_heap_.contains(base + HEAP_SIZE));
+  ASSERT_FALSE(kind_heap_.contains(base - 1));
+
+  int on_stack {0};
+  ASSERT_FALSE(kind_heap_.contains(&on_stack));
+}
+
+TEST_F(KindHeapTestFixture, hints_select_kind) {
+  ASSERT_EQ(memory_kind_for_hints(0), MemoryKind::DEFAULT);
+  ASSERT_EQ(memory_kind_for_hints(ROCSHMEM_MALLOC_ATOMICS_REMOTE),
+            MemoryKind::FINE_GRAINED);
+  ASSERT_EQ(memory_kind_for_hints(ROCSHMEM_MALLOC_SIGNAL_REMOTE),
+            MemoryKind::FINE_GRAINED);
+  ASSERT_EQ(memory_kind_for_hints(ROCSHMEM_MALLOC_BULK_DATA),
+            MemoryKind::COARSE_GRAINED);
+  // Remote atomics need fine-grained memory even for bulk buffers.
+  ASSERT_EQ(memory_kind_for_hints(ROCSHMEM_MALLOC_BULK_DATA |
+                                  ROCSHMEM_MALLOC_ATOMICS_REMOTE),
+            MemoryKind::FINE_GRAINED);
+}
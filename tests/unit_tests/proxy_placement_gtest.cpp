@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "proxy_placement_gtest.hpp"
+
+using namespace rocshmem;
+
+TEST_F(ProxyPlacementTestFixture, parse_ranges) {
+  std::vector<int> expected {16, 17, 18, 19, 80, 81, 82, 83};
+  ASSERT_EQ(node_cpus_, expected);
+}
+
+TEST_F(ProxyPlacementTestFixture, parse_singles_and_empty) {
+  std::vector<int> expected {0, 2, 4, 5};
+  ASSERT_EQ(ProxyPlacement::parse_cpulist("0,2,4-5"), expected);
+  ASSERT_TRUE(ProxyPlacement::parse_cpulist("").empty());
+}
+
+TEST_F(ProxyPlacementTestFixture, choose_highest_pair) {
+  auto [proxy, progress] = ProxyPlacement::choose_cpus(node_cpus_, 0);
+  ASSERT_EQ(proxy, 83);
+  ASSERT_EQ(progress, 82);
+}
+
+TEST_F(ProxyPlacementTestFixture, local_ranks_do_not_share) {
+  auto [proxy0, progress0] = ProxyPlacement::choose_cpus(node_cpus_, 0);
+  auto [proxy1, progress1] = ProxyPlacement::choose_cpus(node_cpus_, 1);
+  ASSERT_EQ(proxy1, 81);
+  ASSERT_EQ(progress1, 80);
+  ASSERT_NE(proxy0, proxy1);
+  ASSERT_NE(progress0, progress1);
+}
+
+TEST_F(ProxyPlacementTestFixture, single_and_no_candidate) {
+  auto [proxy, progress] = ProxyPlacement::choose_cpus({7}, 3);
+  ASSERT_EQ(proxy, 7);
+  ASSERT_EQ(progress, 7);
+  auto [none_proxy, none_progress] = ProxyPlacement::choose_cpus({}, 0);
+  ASSERT_EQ(none_proxy, -1);
+  ASSERT_EQ(none_progress, -1);
+}
+
+TEST_F(ProxyPlacementTestFixture, report_only_when_verbose) {
+  setenv("RO_NET_PIN_THREADS", "0", 1);
+  ProxyPlacement placement {};
+  unsetenv("RO_NET_PIN_THREADS");
+
+  unsetenv("RO_NET_PLACEMENT_VERBOSE");
+  testing::internal::CaptureStdout();
+  placement.report(0);
+  ASSERT_TRUE(testing::internal::GetCapturedStdout().empty());
+
+  setenv("RO_NET_PLACEMENT_VERBOSE", "0", 1);
+  testing::internal::CaptureStdout();
+  placement.report(0);
+  ASSERT_TRUE(testing::internal::GetCapturedStdout().empty());
+
+  setenv("RO_NET_PLACEMENT_VERBOSE", "1", 1);
+  testing::internal::CaptureStdout();
+  placement.report(3);
+  ASSERT_NE(testing::internal::GetCapturedStdout().find("PE 3"),
+            std::string::npos);
+  unsetenv("RO_NET_PLACEMENT_VERBOSE");
+}
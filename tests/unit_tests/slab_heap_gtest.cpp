@@ -35,6 +35,47 @@ TEST_F(SlabHeapTestFixture, malloc_free) {
   ASSERT_NO_FATAL_FAILURE(slab->free(ptr));
 }
 
+TEST_F(SlabHeapTestFixture, free_reuses_memory) {
+  auto slab{slab_.get()};
+
+  void *first{nullptr};
+  slab->malloc(&first, 48);
+  ASSERT_NE(first, nullptr);
+  size_t used{slab->get_used()};
+
+  slab->free(first);
+
+  void *second{nullptr};
+  slab->malloc(&second, 48);
+  ASSERT_EQ(second, first);
+  ASSERT_EQ(slab->get_used(), used);
+  slab->free(second);
+}
+
+TEST_F(SlabHeapTestFixture, realloc_grows) {
+  auto slab{slab_.get()};
+
+  void *ptr{slab->realloc(nullptr, 32)};
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(slab->realloc(ptr, 40), ptr);
+
+  void *grown{slab->realloc(ptr, 4096)};
+  ASSERT_NE(grown, nullptr);
+  ASSERT_NE(grown, ptr);
+  ASSERT_EQ(slab->realloc(grown, 0), nullptr);
+}
+
+TEST_F(SlabHeapTestFixture, malign_alignment) {
+  auto slab{slab_.get()};
+
+  void *ptr{slab->malign(4096, 100)};
+  ASSERT_NE(ptr, nullptr);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(ptr) % 4096, 0);
+  slab->free(ptr);
+
+  ASSERT_EQ(slab->malign(3, 100), nullptr);
+}
+
 TEST_F(SlabHeapTestFixture, overallocate_2GiB) {
   void *ptr{nullptr};
   size_t request_bytes{1UL << 31};
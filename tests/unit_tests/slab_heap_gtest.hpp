@@ -25,6 +25,10 @@
 
 #include "gtest/gtest.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "../src/memory/hip_allocator.hpp"
 #include "../src/memory/slab_heap.hpp"
 #include "../src/util.hpp"
 
@@ -62,9 +66,12 @@ allocate_memory(SlabHeap* slab) {
 
 __global__
 void
-all_threads_once(SlabHeap* slab) {
+all_threads_once(SlabHeap* slab, TYPE** block_mems) {
     auto block_mem {allocate_memory(slab)};
     write_to_memory(block_mem);
+    if (is_thread_zero_in_block()) {
+        block_mems[get_flat_grid_id()] = block_mem;
+    }
 }
 
 class SlabHeapTestFixture : public ::testing::Test {
@@ -76,6 +83,10 @@ class SlabHeapTestFixture : public ::testing::Test {
                          uint32_t x_grid_dim) {
         auto slab {slab_.get()};
 
+        TYPE** block_mems {nullptr};
+        hip_allocator_.allocate(reinterpret_cast<void**>(&block_mems),
+                                x_grid_dim * sizeof(TYPE*));
+
         const dim3 hip_blocksize(x_block_dim, 1, 1);
         const dim3 hip_gridsize(x_grid_dim, 1, 1);
 
@@ -84,7 +95,8 @@ class SlabHeapTestFixture : public ::testing::Test {
                            hip_blocksize,
                            0,
                            nullptr,
-                           slab);
+                           slab,
+                           block_mems);
 
         hipError_t return_code = hipStreamSynchronize(nullptr);
         if (return_code != hipSuccess) {
@@ -92,12 +104,24 @@ class SlabHeapTestFixture : public ::testing::Test {
             assert(return_code == hipSuccess);
         }
 
-        TYPE* ptr {reinterpret_cast<TYPE*>(slab->get_base_ptr())};
-
-        size_t number_threads {x_block_dim * x_grid_dim};
-
-        for (size_t i {0}; i < number_threads; i++) {
-            ASSERT_EQ(ptr[i], THREAD_VALUE);
+        /*
+         * Blocks no longer come back contiguous; check each block's own
+         * allocation and that no two allocations overlap.
+         */
+        std::vector<TYPE*> ptrs(block_mems, block_mems + x_grid_dim);
+        hip_allocator_.deallocate(block_mems);
+
+        size_t block_bytes {x_block_dim * sizeof(TYPE)};
+        for (auto ptr : ptrs) {
+            ASSERT_NE(ptr, nullptr);
+            for (size_t i {0}; i < x_block_dim; i++) {
+                ASSERT_EQ(ptr[i], THREAD_VALUE);
+            }
+        }
+        std::sort(ptrs.begin(), ptrs.end());
+        for (size_t i {1}; i < ptrs.size(); i++) {
+            ASSERT_GE(reinterpret_cast<char*>(ptrs[i]) -
+                      reinterpret_cast<char*>(ptrs[i - 1]), block_bytes);
         }
     }
 
@@ -106,6 +130,11 @@ class SlabHeapTestFixture : public ::testing::Test {
      * @brief Slab heap object
      */
     SLAB_PROXY_T slab_ {};
+
+    /**
+     * @brief Allocates the table of per-block results
+     */
+    HIPAllocator hip_allocator_ {};
 };
 
 } // namespace rocshmem
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "stream_reader_gtest.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace rocshmem;
+
+namespace {
+
+const StreamReader::Strategy strategies[] {
+    StreamReader::MEMCPY,
+    StreamReader::SIMD,
+    StreamReader::STREAM,
+};
+
+} // namespace
+
+TEST_F(StreamReaderTestFixture, copies_aligned_lines) {
+    for (auto strategy : strategies) {
+        StreamReader reader {strategy};
+        std::vector<char> out(slot_size_);
+        reader.read(out.data(), pinned_ + slot_size_, slot_size_);
+        ASSERT_EQ(std::memcmp(out.data(), pinned_ + slot_size_, slot_size_), 0)
+            << StreamReader::name(reader.strategy());
+    }
+}
+
+TEST_F(StreamReaderTestFixture, copies_unaligned_head_and_tail) {
+    for (auto strategy : strategies) {
+        StreamReader reader {strategy};
+        for (size_t offset : {1, 5, 15, 16, 33}) {
+            for (size_t bytes : {0, 1, 15, 17, 64, 100, 191}) {
+                std::vector<char> out(bytes + 1, 0);
+                reader.read(out.data(), pinned_ + offset, bytes);
+                ASSERT_EQ(std::memcmp(out.data(), pinned_ + offset, bytes), 0)
+                    << StreamReader::name(reader.strategy())
+                    << " offset " << offset << " bytes " << bytes;
+                ASSERT_EQ(out[bytes], 0);
+            }
+        }
+    }
+}
+
+TEST_F(StreamReaderTestFixture, unsupported_falls_back_to_memcpy) {
+    for (auto strategy : strategies) {
+        StreamReader reader {strategy};
+        if (StreamReader::supported(strategy)) {
+            ASSERT_EQ(reader.strategy(), strategy);
+        } else {
+            ASSERT_EQ(reader.strategy(), StreamReader::MEMCPY);
+        }
+    }
+}
+
+/*
+ * Microbenchmark: drain the whole ring once per pass, the way the proxy
+ * does when every slot is full. Reports the cost per slot so the read
+ * strategies can be compared on the machine at hand.
+ */
+TEST_F(StreamReaderTestFixture, read_strategy_cost) {
+    constexpr int passes {200};
+    std::vector<char> out(slot_size_);
+
+    for (auto strategy : strategies) {
+        if (!StreamReader::supported(strategy)) {
+            continue;
+        }
+        StreamReader reader {strategy};
+        for (bool prefetch : {false, true}) {
+            auto start {std::chrono::steady_clock::now()};
+            for (int pass {0}; pass < passes; pass++) {
+                for (size_t slot {0}; slot < slots_; slot++) {
+                    if (prefetch) {
+                        StreamReader::prefetch(
+                            pinned_ + ((slot + 1) % slots_) * slot_size_,
+                            slot_size_);
+                    }
+                    reader.read(out.data(), pinned_ + slot * slot_size_,
+                                slot_size_);
+                }
+            }
+            auto stop {std::chrono::steady_clock::now()};
+            double ns {std::chrono::duration<double, std::nano>(
+                           stop - start).count()};
+            printf("%-7s prefetch=%d  %8.1f ns/slot\n",
+                   StreamReader::name(strategy), prefetch,
+                   ns / (passes * slots_));
+        }
+        ASSERT_EQ(std::memcmp(out.data(),
+                              pinned_ + (slots_ - 1) * slot_size_,
+                              slot_size_), 0);
+    }
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef ROCSHMEM_STREAM_READER_GTEST_HPP
+#define ROCSHMEM_STREAM_READER_GTEST_HPP
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+#include "../src/memory/hip_allocator.hpp"
+#include "../src/memory/stream_reader.hpp"
+
+namespace rocshmem {
+
+class StreamReaderTestFixture : public ::testing::Test
+{
+  protected:
+    void SetUp() override {
+        allocator_.allocate(reinterpret_cast<void**>(&pinned_), size_);
+        ASSERT_NE(pinned_, nullptr);
+        for (size_t i {0}; i < size_; i++) {
+            pinned_[i] = static_cast<char>(i * 7 + 3);
+        }
+    }
+
+    void TearDown() override {
+        allocator_.deallocate(pinned_);
+    }
+
+    /**
+     * @brief Number of ring slots used by the read benchmark.
+     */
+    static constexpr size_t slots_ {512};
+
+    /**
+     * @brief Bytes in one slot, matching a queue element.
+     */
+    static constexpr size_t slot_size_ {256};
+
+    size_t size_ {slots_ * slot_size_};
+
+    /**
+     * @brief Same memory type the RO queues live in.
+     */
+    HIPHostAllocator allocator_ {};
+
+    char *pinned_ {nullptr};
+};
+
+} // namespace rocshmem
+
+#endif // ROCSHMEM_STREAM_READER_GTEST_HPP
@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "team_cache_gtest.hpp"
+
+using namespace rocshmem;
+
+TEST_F(TeamCacheTestFixture, acquire_builds_member_comm) {
+    MPI_Comm comm {acquire_self()};
+    ASSERT_NE(comm, MPI_COMM_NULL);
+
+    int size {-1};
+    int rank {-1};
+    MPI_Comm_size(comm, &size);
+    MPI_Comm_rank(comm, &rank);
+    ASSERT_EQ(size, 1);
+    ASSERT_EQ(rank, 0);
+}
+
+TEST_F(TeamCacheTestFixture, busy_comm_is_not_shared) {
+    MPI_Comm first {acquire_self()};
+    MPI_Comm second {acquire_self()};
+    ASSERT_NE(first, second);
+}
+
+TEST_F(TeamCacheTestFixture, released_comm_is_reused) {
+    MPI_Comm first {acquire_self()};
+    MPI_Comm second {acquire_self()};
+
+    cache_.release(first);
+    ASSERT_EQ(acquire_self(), first);
+
+    cache_.release(second);
+    cache_.release(first);
+    ASSERT_EQ(acquire_self(), first);
+    ASSERT_EQ(acquire_self(), second);
+}
+
+TEST_F(TeamCacheTestFixture, shared_comm_is_stable) {
+    MPI_Comm shared {cache_.shared(MPI_COMM_WORLD, my_rank_, 1, 1)};
+    ASSERT_EQ(cache_.shared(MPI_COMM_WORLD, my_rank_, 1, 1), shared);
+    ASSERT_NE(acquire_self(), shared);
+}
+
+TEST_F(TeamCacheTestFixture, pool_recycles_by_size) {
+    void *small {pool_.allocate(64)};
+    void *large {pool_.allocate(4096)};
+    ASSERT_NE(small, nullptr);
+    ASSERT_NE(large, nullptr);
+
+    pool_.release(small, 64);
+    pool_.release(large, 4096);
+
+    ASSERT_EQ(pool_.allocate(4096), large);
+    ASSERT_EQ(pool_.allocate(64), small);
+    ASSERT_NE(pool_.allocate(64), small);
+}
+
+TEST_F(TeamCacheTestFixture, arena_rounds_to_alignment) {
+    arena_.init(arena_buffer_);
+    arena_.add(arena_buffer_, ARENA_SIZE, false);
+
+    char *first {static_cast<char*>(arena_.allocate(1, MPI_COMM_WORLD))};
+    char *second {static_cast<char*>(arena_.allocate(1, MPI_COMM_WORLD))};
+    ASSERT_EQ(first, arena_buffer_);
+    ASSERT_EQ(second, arena_buffer_ + TeamScratchArena::ALIGNMENT);
+}
+
+TEST_F(TeamCacheTestFixture, arena_merges_released_blocks) {
+    arena_.init(arena_buffer_);
+    arena_.add(arena_buffer_, ARENA_SIZE, false);
+
+    size_t half {ARENA_SIZE / 2};
+    void *low {arena_.allocate(half, MPI_COMM_WORLD)};
+    void *high {arena_.allocate(half, MPI_COMM_WORLD)};
+    ASSERT_NE(low, nullptr);
+    ASSERT_NE(high, nullptr);
+    ASSERT_EQ(arena_.allocate(1, MPI_COMM_WORLD), nullptr);
+
+    arena_.release(high);
+    arena_.release(low);
+    ASSERT_EQ(arena_.allocate(ARENA_SIZE, MPI_COMM_WORLD), arena_buffer_);
+}
+
+TEST_F(TeamCacheTestFixture, arena_rejects_mismatched_offsets) {
+    int num_ranks {0};
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+    if (num_ranks < 2) {
+        GTEST_SKIP() << "needs at least two ranks";
+    }
+
+    arena_.init(arena_buffer_);
+    arena_.add(arena_buffer_, ARENA_SIZE, false);
+
+    // Only rank 0 takes a block, so the next offsets differ.
+    MPI_Comm self {acquire_self()};
+    if (my_rank_ == 0) {
+        ASSERT_NE(arena_.allocate(1, self), nullptr);
+    }
+    ASSERT_EQ(arena_.allocate(1, MPI_COMM_WORLD), nullptr);
+
+    // The failed block went back, so rank 0 still has one in use.
+    size_t expected {my_rank_ == 0 ? ARENA_SIZE - TeamScratchArena::ALIGNMENT
+                                   : ARENA_SIZE};
+    ASSERT_NE(arena_.allocate(expected, self), nullptr);
+}
+
+TEST_F(TeamCacheTestFixture, empty_arena_hands_out_nothing) {
+    arena_.init(arena_buffer_);
+    ASSERT_EQ(arena_.allocate(1, MPI_COMM_WORLD), nullptr);
+}
+
+TEST_F(TeamCacheTestFixture, arena_keeps_member_chunk_for_next_allocate) {
+    size_t half {ARENA_SIZE / 2};
+    arena_.init(arena_buffer_);
+    arena_.add(arena_buffer_, half, true);
+    arena_.add(arena_buffer_ + half, half, false);
+
+    ASSERT_EQ(arena_.allocate(half, MPI_COMM_WORLD), arena_buffer_);
+    ASSERT_EQ(arena_.allocate(1, MPI_COMM_WORLD), arena_buffer_ + half);
+    ASSERT_EQ(arena_.chunks().size(), 2u);
+}
+
+TEST_F(TeamCacheTestFixture, arena_reserve_reuses_released_block) {
+    size_t half {ARENA_SIZE / 2};
+    arena_.init(arena_buffer_);
+    arena_.add(arena_buffer_, ARENA_SIZE, false);
+
+    ASSERT_TRUE(arena_.reserve(half, true, MPI_COMM_WORLD));
+    void *block {arena_.allocate(half, MPI_COMM_WORLD)};
+    ASSERT_EQ(block, arena_buffer_);
+
+    // Only the other half is free, so a larger block needs a new chunk.
+    ASSERT_FALSE(arena_.reserve(ARENA_SIZE, true, MPI_COMM_WORLD));
+
+    arena_.release(block);
+    ASSERT_TRUE(arena_.reserve(ARENA_SIZE, true, MPI_COMM_WORLD));
+    ASSERT_EQ(arena_.allocate(ARENA_SIZE, MPI_COMM_WORLD), arena_buffer_);
+}
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "team_config_gtest.hpp"
+
+using namespace rocshmem;
+
+TEST_F(TeamConfigTestFixture, default_mask_ignores_config) {
+  ASSERT_TRUE(resolve_team_config(nullptr, ROCSHMEM_TEAM_DEFAULT_CONFIGS,
+                                  &resolved_));
+  ASSERT_EQ(resolved_.num_contexts, 0);
+  ASSERT_EQ(resolved_.max_reduce_size, 0);
+  ASSERT_EQ(resolved_.collectives, ROCSHMEM_TEAM_COLL_ALL);
+}
+
+TEST_F(TeamConfigTestFixture, mask_selects_fields) {
+  ASSERT_TRUE(resolve_team_config(&hints_, ROCSHMEM_TEAM_MAX_REDUCE_SIZE,
+                                  &resolved_));
+  ASSERT_EQ(resolved_.num_contexts, 0);
+  ASSERT_EQ(resolved_.max_reduce_size, 1 << 20);
+  ASSERT_EQ(resolved_.collectives, ROCSHMEM_TEAM_COLL_ALL);
+
+  long all_fields {ROCSHMEM_TEAM_NUM_CONTEXTS |
+                   ROCSHMEM_TEAM_MAX_REDUCE_SIZE | ROCSHMEM_TEAM_COLLECTIVES};
+  ASSERT_TRUE(resolve_team_config(&hints_, all_fields, &resolved_));
+  ASSERT_EQ(resolved_.num_contexts, 4);
+  ASSERT_EQ(resolved_.collectives, ROCSHMEM_TEAM_COLL_REDUCE);
+}
+
+TEST_F(TeamConfigTestFixture, rejects_bad_hints) {
+  ASSERT_FALSE(resolve_team_config(nullptr, ROCSHMEM_TEAM_NUM_CONTEXTS,
+                                   &resolved_));
+  hints_.num_contexts = -1;
+  ASSERT_FALSE(resolve_team_config(&hints_, ROCSHMEM_TEAM_NUM_CONTEXTS,
+                                   &resolved_));
+  hints_.collectives = ROCSHMEM_TEAM_COLL_ALL + 1;
+  ASSERT_FALSE(resolve_team_config(&hints_, ROCSHMEM_TEAM_COLLECTIVES,
+                                   &resolved_));
+}
+
+TEST_F(TeamConfigTestFixture, reduce_scratch_sizing) {
+  rocshmem_team_config_t config {default_team_config()};
+  ASSERT_EQ(team_reduce_scratch_elems(config, 8),
+            ROCSHMEM_REDUCE_MIN_WRKDATA_SIZE);
+
+  config.max_reduce_size = 4096;
+  ASSERT_EQ(team_reduce_scratch_elems(config, 8), 4096 * 8);
+
+  config.collectives = ROCSHMEM_TEAM_COLL_BROADCAST;
+  ASSERT_EQ(team_reduce_scratch_elems(config, 8), 0);
+  ASSERT_FALSE(team_uses(config, ROCSHMEM_TEAM_COLL_REDUCE));
+  ASSERT_TRUE(team_uses(config, ROCSHMEM_TEAM_COLL_BROADCAST));
+}
@@ -0,0 +1,209 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "thread_pes_gtest.hpp"
+
+#include <atomic>
+
+using namespace rocshmem;
+
+TEST_F(ThreadPesTestFixture, pe_identity) {
+    std::atomic<int> seen {0};
+    run([&](ThreadPes &world) {
+        EXPECT_EQ(ThreadPes::current(), &world);
+        EXPECT_EQ(world.n_pes(), NUM_PES);
+        seen.fetch_or(1 << world.my_pe());
+    });
+    ASSERT_EQ(seen.load(), (1 << NUM_PES) - 1);
+    ASSERT_EQ(ThreadPes::current(), nullptr);
+}
+
+TEST_F(ThreadPesTestFixture, put_get_ring) {
+    run([](ThreadPes &world) {
+        int me {world.my_pe()};
+        int next {(me + 1) % NUM_PES};
+        int prev {(me + NUM_PES - 1) % NUM_PES};
+
+        int *buf {static_cast<int*>(world.malloc(64 * sizeof(int)))};
+        ASSERT_NE(buf, nullptr);
+
+        int src[64];
+        for (int i {0}; i < 64; i++) {
+            src[i] = me * 100 + i;
+        }
+        world.put(buf, src, 64, next);
+        world.barrier_all();
+
+        for (int i {0}; i < 64; i++) {
+            EXPECT_EQ(buf[i], prev * 100 + i);
+        }
+
+        int fetched[64];
+        world.get(fetched, buf, 64, next);
+        EXPECT_EQ(fetched[5], me * 100 + 5);
+        EXPECT_EQ(world.g(buf + 7, prev), ((prev + NUM_PES - 1) % NUM_PES) *
+                                          100 + 7);
+
+        world.free(buf);
+    });
+}
+
+TEST_F(ThreadPesTestFixture, symmetric_addresses) {
+    char *first[NUM_PES] {};
+    char *second[NUM_PES] {};
+    run([&](ThreadPes &world) {
+        first[world.my_pe()] = static_cast<char*>(world.malloc(1000));
+        second[world.my_pe()] = static_cast<char*>(world.malloc(4096));
+        world.free(second[world.my_pe()]);
+        world.free(first[world.my_pe()]);
+    });
+
+    /*
+     * Every PE gets the same offset into its own slice of the mapping.
+     */
+    ASSERT_NE(first[0], nullptr);
+    ASSERT_NE(second[0], nullptr);
+    ASSERT_NE(first[0], second[0]);
+    for (int pe {1}; pe < NUM_PES; pe++) {
+        ASSERT_EQ(first[pe] - first[0], pe * HEAP_SIZE);
+        ASSERT_EQ(second[pe] - second[0], pe * HEAP_SIZE);
+    }
+}
+
+TEST_F(ThreadPesTestFixture, atomics) {
+    run([](ThreadPes &world) {
+        long *counter {static_cast<long*>(world.malloc(sizeof(long)))};
+        *counter = 0;
+        world.barrier_all();
+
+        for (int i {0}; i < 1000; i++) {
+            world.amo_add(counter, 1L, 0);
+        }
+        world.barrier_all();
+
+        if (world.my_pe() == 0) {
+            EXPECT_EQ(*counter, 1000L * NUM_PES);
+        }
+        world.barrier_all();
+
+        /*
+         * Exactly one PE wins the swap.
+         */
+        long old {world.amo_fetch_cas(counter, -1L, 1000L * NUM_PES, 0)};
+        int won {old == 1000L * NUM_PES};
+        int *winners {static_cast<int*>(world.malloc(sizeof(int)))};
+        *winners = 0;
+        world.barrier_all();
+        world.amo_add(winners, won, 0);
+        world.barrier_all();
+        if (world.my_pe() == 0) {
+            EXPECT_EQ(*winners, 1);
+            EXPECT_EQ(*counter, -1L);
+        }
+
+        world.free(winners);
+        world.free(counter);
+    });
+}
+
+TEST_F(ThreadPesTestFixture, reduce_and_broadcast) {
+    run([](ThreadPes &world) {
+        int me {world.my_pe()};
+        int *data {static_cast<int*>(world.malloc(8 * sizeof(int)))};
+        for (int i {0}; i < 8; i++) {
+            data[i] = me + i;
+        }
+
+        /*
+         * In place: every PE's source is also its dest.
+         */
+        int rc {world.reduce<int, ROCSHMEM_SUM>(data, data, 8)};
+        EXPECT_EQ(rc, ROCSHMEM_SUCCESS);
+        int pe_sum {NUM_PES * (NUM_PES - 1) / 2};
+        for (int i {0}; i < 8; i++) {
+            EXPECT_EQ(data[i], pe_sum + NUM_PES * i);
+        }
+
+        int *root {static_cast<int*>(world.malloc(8 * sizeof(int)))};
+        for (int i {0}; i < 8; i++) {
+            root[i] = me * 1000 + i;
+        }
+        world.broadcast(data, root, 8, 2);
+        for (int i {0}; i < 8; i++) {
+            EXPECT_EQ(data[i], 2000 + i);
+        }
+
+        world.free(root);
+        world.free(data);
+    });
+}
+
+TEST_F(ThreadPesTestFixture, alltoallv) {
+    run([](ThreadPes &world) {
+        int me {world.my_pe()};
+
+        /*
+         * PE s sends (s + d) % 3 elements to PE d, so some blocks are empty.
+         * The send displacements are read remotely and must be symmetric.
+         */
+        auto count = [](int s, int d) { return (s + d) % 3; };
+        size_t counts_size {NUM_PES * sizeof(int)};
+        int *source_counts {static_cast<int*>(world.malloc(counts_size))};
+        int *source_displs {static_cast<int*>(world.malloc(counts_size))};
+        int dest_counts[NUM_PES];
+        int dest_displs[NUM_PES];
+        int sent {0};
+        int received {0};
+        for (int pe {0}; pe < NUM_PES; pe++) {
+            source_counts[pe] = count(me, pe);
+            source_displs[pe] = sent;
+            sent += source_counts[pe];
+            dest_counts[pe] = count(pe, me);
+            dest_displs[pe] = received;
+            received += dest_counts[pe];
+        }
+
+        // No block holds more than two elements.
+        size_t data_size {2 * NUM_PES * sizeof(int)};
+        int *source {static_cast<int*>(world.malloc(data_size))};
+        int *dest {static_cast<int*>(world.malloc(data_size))};
+        for (int pe {0}; pe < NUM_PES; pe++) {
+            for (int i {0}; i < source_counts[pe]; i++) {
+                source[source_displs[pe] + i] = me * 100 + pe * 10 + i;
+            }
+        }
+
+        world.alltoallv(dest, source, source_counts, source_displs,
+                        dest_counts, dest_displs);
+
+        for (int pe {0}; pe < NUM_PES; pe++) {
+            for (int i {0}; i < dest_counts[pe]; i++) {
+                EXPECT_EQ(dest[dest_displs[pe] + i], pe * 100 + me * 10 + i);
+            }
+        }
+
+        world.free(dest);
+        world.free(source);
+        world.free(source_displs);
+        world.free(source_counts);
+    });
+}
@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#ifndef ROCSHMEM_THREAD_PES_GTEST_HPP
+#define ROCSHMEM_THREAD_PES_GTEST_HPP
+
+#include "gtest/gtest.h"
+
+#include "../src/host/thread_pes.hpp"
+
+namespace rocshmem {
+
+class ThreadPesTestFixture : public ::testing::Test
+{
+  protected:
+    static constexpr int NUM_PES {4};
+
+    static constexpr size_t HEAP_SIZE {1 << 20};
+
+    /**
+     * @brief Run fn(world_) on every PE
+     */
+    template <typename FN_T>
+    void run(FN_T fn) {
+        auto trampoline = [](void *arg) {
+            auto *self {static_cast<std::pair<FN_T*, ThreadPes*>*>(arg)};
+            (*self->first)(*self->second);
+        };
+        std::pair<FN_T*, ThreadPes*> args {&fn, &world_};
+        world_.run(trampoline, &args);
+    }
+
+    ThreadPes world_ {NUM_PES, HEAP_SIZE};
+};
+
+} // namespace rocshmem
+
+#endif // ROCSHMEM_THREAD_PES_GTEST_HPP
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+#include "traffic_matrix_gtest.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace rocshmem;
+
+TEST(TrafficMatrixTest, disabled_records_nothing) {
+    TrafficMatrix matrix {};
+    matrix.record(TrafficClass::PUT, 0, 64);
+    ASSERT_FALSE(matrix.enabled());
+    ASSERT_EQ(matrix.ops(TrafficClass::PUT, 0), 0);
+    ASSERT_FALSE(matrix.dump("unused"));
+}
+
+TEST_F(TrafficMatrixTestFixture, record_counts_ops_and_bytes) {
+    int peer {(my_pe_ + 1) % num_pes_};
+    matrix_.record(TrafficClass::PUT, peer, 64);
+    matrix_.record(TrafficClass::PUT, peer, 32);
+    matrix_.record(TrafficClass::AMO, peer, 8);
+
+    ASSERT_EQ(matrix_.ops(TrafficClass::PUT, peer), 2);
+    ASSERT_EQ(matrix_.bytes(TrafficClass::PUT, peer), 96);
+    ASSERT_EQ(matrix_.ops(TrafficClass::AMO, peer), 1);
+    ASSERT_EQ(matrix_.ops(TrafficClass::GET, peer), 0);
+
+    matrix_.reset();
+    ASSERT_EQ(matrix_.ops(TrafficClass::PUT, peer), 0);
+    ASSERT_EQ(matrix_.bytes(TrafficClass::PUT, peer), 0);
+}
+
+TEST_F(TrafficMatrixTestFixture, team_records_skip_self) {
+    matrix_.record_team(TrafficClass::COLL, MPI_COMM_WORLD, 16);
+
+    std::vector<int> counts(num_pes_, 0);
+    counts[(my_pe_ + 1) % num_pes_] = 3;
+    matrix_.record_team(TrafficClass::COLL, MPI_COMM_WORLD, counts.data(),
+                        sizeof(int));
+
+    ASSERT_EQ(matrix_.ops(TrafficClass::COLL, my_pe_), 0);
+    for (int pe {0}; pe < num_pes_; pe++) {
+        if (pe == my_pe_) {
+            continue;
+        }
+        bool counted {pe == (my_pe_ + 1) % num_pes_};
+        ASSERT_EQ(matrix_.ops(TrafficClass::COLL, pe), counted ? 2 : 1);
+        ASSERT_EQ(matrix_.bytes(TrafficClass::COLL, pe), counted ? 28 : 16);
+    }
+}
+
+TEST_F(TrafficMatrixTestFixture, team_records_use_world_pes) {
+    /*
+     * In a team of the odd world PEs, team rank 0 is world PE 1.
+     */
+    MPI_Comm odd {};
+    MPI_Comm_split(MPI_COMM_WORLD, my_pe_ % 2, my_pe_, &odd);
+    if (my_pe_ % 2 && my_pe_ != 1) {
+        matrix_.record_team(TrafficClass::COLL, odd, 8);
+        ASSERT_EQ(matrix_.ops(TrafficClass::COLL, 1), 1);
+        ASSERT_EQ(matrix_.ops(TrafficClass::COLL, 0), 0);
+    }
+    MPI_Comm_free(&odd);
+}
+
+TEST_F(TrafficMatrixTestFixture, csv_lists_nonzero_cells) {
+    // Two PEs, each row holding an ops and a bytes cell per class and PE.
+    size_t row_size {static_cast<size_t>(TrafficClass::NUM_CLASSES) * 2 * 2};
+    std::vector<uint64_t> rows(2 * row_size, 0);
+    // Row 1, put class, destination 0: 3 ops of 24 bytes in total.
+    rows[row_size] = 3;
+    rows[row_size + 1] = 24;
+
+    std::ostringstream out {};
+    TrafficMatrix::write_csv(out, rows, 2);
+    ASSERT_EQ(out.str(), "# pes 2\nclass,src,dst,ops,bytes\nput,1,0,3,24\n");
+}
+
+TEST_F(TrafficMatrixTestFixture, dump_gathers_every_row) {
+    int peer {(my_pe_ + 1) % num_pes_};
+    matrix_.record(TrafficClass::GET, peer, my_pe_ + 1);
+
+    std::string path {testing::TempDir() + "traffic_matrix_gtest.csv"};
+    ASSERT_TRUE(matrix_.dump(path.c_str()));
+
+    if (my_pe_ == 0) {
+        std::ifstream in {path};
+        std::string line {};
+        std::getline(in, line);
+        ASSERT_EQ(line, "# pes " + std::to_string(num_pes_));
+        std::getline(in, line);
+        int rows {0};
+        while (std::getline(in, line)) {
+            std::string expected {"get," + std::to_string(rows) + "," +
+                                  std::to_string((rows + 1) % num_pes_) +
+                                  ",1," + std::to_string(rows + 1)};
+            ASSERT_EQ(line, expected);
+            rows++;
+        }
+        ASSERT_EQ(rows, num_pes_);
+        remove(path.c_str());
+    }
+}
@@ -0,0 +1,174 @@
+/******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************/
+
+/*
+ * Offline analysis of RO command traces.
+ *
+ * Record one trace per PE with RO_NET_RECORD=<prefix>, then run
+ *
+ *   ro_coal_analyze [-n commands] [-d max_hold_us] [-p policy]... \
+ *       <prefix>.0 <prefix>.1 ...
+ *
+ * to see how many puts could be merged within windows of -n commands and
+ * how each coalescing policy would have done. Without -p a grid of
+ * policies is swept. The policy with the fewest puts whose mean hold time
+ * stays under -d is printed in the form RO_NET_COALESCE takes.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "command_trace.hpp"
+
+using namespace rocshmem;
+
+static void usage(const char *name) {
+  fprintf(stderr,
+          "usage: %s [-n commands] [-d max_hold_us] [-p window,bytes,us]... "
+          "[-v] trace...\n",
+          name);
+  exit(1);
+}
+
+static double percent(uint64_t part, uint64_t whole) {
+  return whole ? 100.0 * part / whole : 0.0;
+}
+
+int main(int argc, char **argv) {
+  size_t window_size{64};
+  double max_hold_us{50.0};
+  bool verbose{false};
+  std::vector<CoalescePolicy> policies{};
+  std::vector<std::string> paths{};
+
+  for (int i{1}; i < argc; i++) {
+    if (!strcmp(argv[i], "-n") && i + 1 < argc) {
+      window_size = strtoull(argv[++i], nullptr, 0);
+    } else if (!strcmp(argv[i], "-d") && i + 1 < argc) {
+      max_hold_us = atof(argv[++i]);
+    } else if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+      CoalescePolicy policy{};
+      if (!parse_coalesce_policy(argv[++i], &policy)) {
+        usage(argv[0]);
+      }
+      policies.push_back(policy);
+    } else if (!strcmp(argv[i], "-v")) {
+      verbose = true;
+    } else if (argv[i][0] == '-') {
+      usage(argv[0]);
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty()) {
+    usage(argv[0]);
+  }
+
+  if (policies.empty()) {
+    for (size_t window : {2, 4, 8, 16, 32, 64}) {
+      for (size_t max_bytes : {4 << 10, 64 << 10, 1 << 20}) {
+        for (uint64_t timeout_us : {0, 5, 20, 100}) {
+          policies.push_back({window, max_bytes, timeout_us * 1000});
+        }
+      }
+    }
+  }
+
+  std::vector<std::vector<TraceRecord>> traces(paths.size());
+  WindowStats total{};
+  for (size_t t{0}; t < paths.size(); t++) {
+    if (!read_trace(paths[t], &traces[t])) {
+      fprintf(stderr, "%s: not a RO command trace\n", paths[t].c_str());
+      return 1;
+    }
+
+    auto windows{analyze_trace(traces[t], window_size)};
+    WindowStats trace_total{};
+    for (size_t w{0}; w < windows.size(); w++) {
+      const auto &stats{windows[w]};
+      trace_total += stats;
+      if (verbose && stats.puts) {
+        printf("%s window %zu: %lu puts, %lu bytes, same pe %.1f%%, "
+               "adjacent %.1f%% (same block %.1f%%)\n",
+               paths[t].c_str(), w, stats.puts, stats.bytes,
+               percent(stats.same_dest, stats.puts),
+               percent(stats.adjacent, stats.puts),
+               percent(stats.adjacent_same_block, stats.puts));
+      }
+    }
+    printf("%s: %lu commands, %lu puts, %lu bytes\n", paths[t].c_str(),
+           trace_total.commands, trace_total.puts, trace_total.bytes);
+    total += trace_total;
+  }
+
+  printf("\nper window of %zu commands:\n", window_size);
+  printf("  puts to a PE already targeted   %6.1f%%\n",
+         percent(total.same_dest, total.puts));
+  printf("  puts adjacent to an earlier put %6.1f%%\n",
+         percent(total.adjacent, total.puts));
+  printf("    from the same block           %6.1f%%\n",
+         percent(total.adjacent_same_block, total.puts));
+  printf("    from another block            %6.1f%%\n",
+         percent(total.adjacent - total.adjacent_same_block, total.puts));
+
+  printf("\n%-20s %10s %10s %8s %10s %8s %8s %8s %8s\n", "policy", "puts in",
+         "puts out", "saved", "hold us", "full", "break", "sync", "timeout");
+
+  const CoalescePolicy *best{nullptr};
+  uint64_t best_out{0};
+  for (const auto &policy : policies) {
+    CoalesceStats stats{};
+    for (const auto &records : traces) {
+      auto trace_stats{simulate_coalescing(records, policy)};
+      stats.puts_in += trace_stats.puts_in;
+      stats.puts_out += trace_stats.puts_out;
+      stats.bytes += trace_stats.bytes;
+      stats.delay_ns += trace_stats.delay_ns;
+      for (int r{0}; r < 4; r++) {
+        stats.flushes[r] += trace_stats.flushes[r];
+      }
+    }
+
+    double hold_us{stats.puts_out ? stats.delay_ns / 1e3 / stats.puts_out
+                                  : 0.0};
+    printf("%-20s %10lu %10lu %7.1f%% %10.2f %8lu %8lu %8lu %8lu\n",
+           to_string(policy).c_str(), stats.puts_in, stats.puts_out,
+           percent(stats.puts_in - stats.puts_out, stats.puts_in), hold_us,
+           stats.flushes[0], stats.flushes[1], stats.flushes[2],
+           stats.flushes[3]);
+
+    if (hold_us <= max_hold_us && (!best || stats.puts_out < best_out)) {
+      best = &policy;
+      best_out = stats.puts_out;
+    }
+  }
+
+  if (best) {
+    printf("\nbest policy with a mean hold under %.1f us:\n"
+           "  RO_NET_COALESCE=%s\n",
+           max_hold_us, to_string(*best).c_str());
+  }
+  return 0;
+}
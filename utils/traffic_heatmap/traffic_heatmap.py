@@ -0,0 +1,122 @@
+"""
+******************************************************************************
+ * Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *****************************************************************************
+ """
+
+"""
+Render a traffic matrix written by rocshmem_dump_traffic_matrix or at
+finalize with ROCSHMEM_TRAFFIC_MATRIX set.
+
+Rows are the PEs that issued the operations and columns their targets.
+Without --output the matrix is printed as a text heatmap.
+
+    python3 traffic_heatmap.py traffic.csv --metric bytes --class put
+    python3 traffic_heatmap.py traffic.csv --output traffic.png
+"""
+
+import argparse
+import csv
+import sys
+
+CLASSES = ['put', 'get', 'amo', 'coll']
+
+# Shades from idle to busiest cell of the text heatmap.
+SHADES = ' .:-=+*#%@'
+
+
+def read_matrix(path, metric, classes):
+    num_pes = 0
+    cells = {}
+    with open(path) as f:
+        header = f.readline().split()
+        if header[:2] != ['#', 'pes']:
+            sys.exit(f'{path}: not a rocshmem traffic matrix')
+        num_pes = int(header[2])
+        for row in csv.DictReader(f):
+            if row['class'] not in classes:
+                continue
+            key = (int(row['src']), int(row['dst']))
+            cells[key] = cells.get(key, 0) + int(row[metric])
+
+    matrix = [[0] * num_pes for _ in range(num_pes)]
+    for (src, dst), value in cells.items():
+        matrix[src][dst] = value
+    return matrix
+
+
+def print_heatmap(matrix, title):
+    peak = max((max(row) for row in matrix), default=0)
+    print(title)
+    print(f'peak {peak}; rows are sources, columns destinations')
+    width = len(str(len(matrix) - 1))
+    for src, row in enumerate(matrix):
+        shades = ''
+        for value in row:
+            level = 0
+            if peak and value:
+                level = max(1, value * (len(SHADES) - 1) // peak)
+            shades += SHADES[level]
+        print(f'{src:>{width}} |{shades}| {sum(row)}')
+
+
+def plot_heatmap(matrix, title, output):
+    try:
+        import matplotlib
+        matplotlib.use('Agg')
+        import matplotlib.pyplot as plt
+    except ImportError:
+        sys.exit('--output needs matplotlib')
+
+    fig, ax = plt.subplots(figsize=(8, 7))
+    image = ax.imshow(matrix, cmap='viridis', interpolation='nearest')
+    ax.set_title(title)
+    ax.set_xlabel('destination PE')
+    ax.set_ylabel('source PE')
+    fig.colorbar(image, ax=ax)
+    fig.savefig(output, bbox_inches='tight')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Render a rocSHMEM traffic matrix as a heatmap.')
+    parser.add_argument('matrix', help='CSV written by rocSHMEM')
+    parser.add_argument('--metric', choices=['bytes', 'ops'],
+                        default='bytes')
+    parser.add_argument('--class', dest='classes', choices=CLASSES,
+                        action='append',
+                        help='operation class to include; repeatable, '
+                             'all classes by default')
+    parser.add_argument('--output', help='image file to write')
+    args = parser.parse_args()
+
+    classes = args.classes or CLASSES
+    matrix = read_matrix(args.matrix, args.metric, classes)
+    title = f'{args.metric} ({"+".join(classes)})'
+
+    if args.output:
+        plot_heatmap(matrix, title, args.output)
+    else:
+        print_heatmap(matrix, title)
+
+
+if __name__ == '__main__':
+    main()